@@ -3,7 +3,7 @@
 struct TransformationMatrix
 {
     float4x4 WVP;
-    float4x4 world;
+    float3x4 world; // 最後の列が(0,0,0,1)のワールド行列を転置して3行に詰めたもの
 };
 ConstantBuffer<TransformationMatrix> gTransformationMatrix : register(b0);
 
@@ -19,6 +19,6 @@ VertexShaderOutput main(VertexShaderInput input)
     VertexShaderOutput output;
     output.position = mul(input.position, gTransformationMatrix.WVP);
     output.texcoord = input.texcoord;
-    output.normal = normalize(mul(input.normal, (float32_t3x3) gTransformationMatrix.world));
+    output.normal = normalize(mul((float32_t3x3) gTransformationMatrix.world, input.normal));
     return output;
 }
\ No newline at end of file
@@ -51,14 +51,43 @@ void Sprite::Initialize(SpriteCommon* spriteCommon, std::string textureFilePath)
 #pragma endregion 座標変換
 
 	// --- テクスチャ読み込み ---
-	TextureManager::GetInstance()->LoadTexture(textureFilePath_);
+	SetTexture(textureFilePath_);
+
+}
+
+void Sprite::SetTexture(const std::string& textureFilePath)
+{
+	textureFilePath_ = textureFilePath;
+
+	// --- テクスチャ読み込み(前のテクスチャの参照は手放す) ---
+	texture_ = TextureManager::GetInstance()->AcquireTexture(textureFilePath_);
 
 	// --- 単位行列 ---
-	textureIndex = TextureManager::GetInstance()->GetTextureIndexByFilePath(textureFilePath_);
+	textureIndex = texture_->srvIndex;
 
 	// --- 切り取り ---
+	textureLeftTop = { 0.0f,0.0f };
 	AdjustTextureSize();
+}
+
+void Sprite::Reset()
+{
+	// --- 書き込み済みのバッファを初期値で上書き ---
+	MaterialDataWriting();
+	TransformationMatrixDataWriting();
 
+	// --- 状態を初期値に(テクスチャはそのまま) ---
+	position = { 0.0f,0.0f };
+	rotation = 0.0f;
+	anchorPoint = { 0.0f,0.0f };
+	left = 0.0f - anchorPoint.x;
+	right = 1.0f - anchorPoint.x;
+	top = 0.0f - anchorPoint.y;
+	bottom = 1.0f - anchorPoint.y;
+	isFlipX_ = false;
+	isFlipY_ = false;
+	textureLeftTop = { 0.0f,0.0f };
+	AdjustTextureSize();
 }
 
 void Sprite::Update()
@@ -67,12 +96,12 @@ void Sprite::Update()
 	transform.translate = { position.x, position.y, 0.0f };
 	transform.rotate = { 0.0f, 0.0f, rotation };
 	transform.scale = { size.x, size.y, 1.0f };
-	worldMatrix = MakeAffineMatrix(transform.scale, transform.rotate, transform.translate);
+	worldMatrix = MakeAffine3x4(transform.scale, transform.rotate, transform.translate);
 	viewMatrix = MakeIdentity4x4();
 	projectionMatrix = MakeOrthographicMatrix(0.0f, 0.0f, float(WinApp::kClientWidth), float(WinApp::kClientHeight), 0.0f, 100.0f);
 
 	// --- transformationMatrixDataの更新 ---
-	transformationMatrixData->WVP = worldMatrix * viewMatrix * projectionMatrix;
+	transformationMatrixData->WVP = Multiply(worldMatrix, viewMatrix * projectionMatrix);
 	transformationMatrixData->World = worldMatrix;
 
 	// --- フリップの更新処理 ---
@@ -99,22 +128,29 @@ void Sprite::Update()
 
 void Sprite::Draw()
 {
+	CommandContext* commandContext = spriteCommon->GetDxCommon()->GetCommandContext();
+
 	// --- vertexBufferViewの生成 ---
-	spriteCommon->GetDxCommon()->GetCommandList()->IASetVertexBuffers(0, 1, &vertexBufferView);
+	commandContext->IASetVertexBuffers(0, 1, &vertexBufferView);
 	// --- indexBufferViewの生成 ---
-	spriteCommon->GetDxCommon()->GetCommandList()->IASetIndexBuffer(&indexBufferView);
+	commandContext->IASetIndexBuffer(&indexBufferView);
 
 	// --- マテリアルCBufferの場所を設定 --- 
-	spriteCommon->GetDxCommon()->GetCommandList()->SetGraphicsRootConstantBufferView(0, materialResource->GetGPUVirtualAddress());
+	commandContext->SetGraphicsRootConstantBufferView(0, materialResource->GetGPUVirtualAddress());
 
 	// --- 座標変換行列CBufferの場所を設定 ---
-	spriteCommon->GetDxCommon()->GetCommandList()->SetGraphicsRootConstantBufferView(1, transformationMatrixResource->GetGPUVirtualAddress());
+	commandContext->SetGraphicsRootConstantBufferView(1, transformationMatrixResource->GetGPUVirtualAddress());
+
+	// --- 表示サイズに合ったミップを要求(テクスチャ全体が画面上で占める大きさ) ---
+	const DirectX::TexMetadata& metadata = TextureManager::GetInstance()->GetMetaData(textureFilePath_);
+	TextureManager::GetInstance()->RequestTextureSize(textureFilePath_,
+		size.x * float(metadata.width) / textureSize.x, size.y * float(metadata.height) / textureSize.y);
 
 	// --- SRVのDescriptorTableを設定 ---
-	spriteCommon->GetDxCommon()->GetCommandList()->SetGraphicsRootDescriptorTable(2, TextureManager::GetInstance()->GetSrvHandleGPU(textureFilePath_));
+	commandContext->SetGraphicsRootDescriptorTable(2, TextureManager::GetInstance()->GetSrvHandleGPU(texture_));
 
 	// --- 描画(DrawCall/ドローコール) ---
-	spriteCommon->GetDxCommon()->GetCommandList()->DrawIndexedInstanced(vertexCount, 1, 0, 0, 0);
+	commandContext->DrawIndexedInstanced(vertexCount, 1, 0, 0, 0);
 
 }
 
@@ -153,7 +189,7 @@ void Sprite::MaterialDataWriting()
 void Sprite::TransformationMatrixDataWriting()
 {
 	transformationMatrixData->WVP = MakeIdentity4x4();
-	transformationMatrixData->World = MakeIdentity4x4();
+	transformationMatrixData->World = MakeIdentityAffine3x4();
 }
 
 void Sprite::AdjustTextureSize()
@@ -4,11 +4,13 @@
 #include <numbers>
 
 #include "SpriteCommon.h"
+#include "TextureManager.h"
 
 #include "Vector2.h"
 #include "Vector3.h"
 #include "Vector4.h"
 #include "Matrix4x4.h"
+#include "Affine3x4.h"
 #include "CalculateMath.h"
 
 class SpriteCommon;
@@ -26,6 +28,12 @@ public://メンバ関数
 	//描画処理
 	void Draw();
 
+	// 表示するテクスチャを変える(大きさはテクスチャに合わせる)
+	void SetTexture(const std::string& textureFilePath);
+
+	// 初期状態に戻す(バッファは作り直さない。プールで使い回すとき用)
+	void Reset();
+
 public:
 	// position
 	const Vector2& GetPosition() const { return position; }
@@ -72,6 +80,8 @@ private:
 private:
 	SpriteCommon* spriteCommon = nullptr;
 	std::string textureFilePath_;
+	// スプライトが破棄されるまでテクスチャの参照を持つ
+	TextureHandle texture_;
 
 	// --- 頂点データ ---
 	struct VertexData {
@@ -105,7 +115,7 @@ private:
 	// --- 座標変換 ---
 	struct TransformationMatrix {
 		Matrix4x4 WVP;
-		Matrix4x4 World;
+		Affine3x4 World;	// シェーダー側はfloat3x4
 	};
 	//バッファリソース
 	Microsoft::WRL::ComPtr<ID3D12Resource> transformationMatrixResource;
@@ -126,7 +136,7 @@ private:
 	Matrix4x4 backToFrontMatrix = MakeRotateYMatrix(std::numbers::pi_v<float>);
 	Matrix4x4 viewMatrix;
 	Matrix4x4 projectionMatrix;
-	Matrix4x4 worldMatrix;
+	Affine3x4 worldMatrix;
 
 	Transform transform{ {1.0f,1.0f,1.0f},{0.0f,0.0f,0.0f},{0.0f,0.0f,0.0f} };
 	Vector2 position = { 0.0f,0.0f };
@@ -1,5 +1,7 @@
 #include "Windows.h"
 #include "SpriteCommon.h"
+#include "PipelineCache.h"
+#include "ShaderCompiler.h"
 
 SpriteCommon* SpriteCommon::instance = nullptr;
 
@@ -28,15 +30,13 @@ void SpriteCommon::Initialize(DirectXCommon* dxCommon)
 void SpriteCommon::PreDraw()
 {
 	// セット
-	dxCommon_->GetCommandList()->SetGraphicsRootSignature(rootSignature.Get());
-	dxCommon_->GetCommandList()->SetPipelineState(graphicsPipelineState.Get());
-	dxCommon_->GetCommandList()->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+	dxCommon_->GetCommandContext()->SetGraphicsRootSignature(rootSignature.Get());
+	dxCommon_->GetCommandContext()->SetPipelineState(graphicsPipelineState.Get());
+	dxCommon_->GetCommandContext()->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 }
 
 void SpriteCommon::CreateRootSignature()
 {
-	HRESULT hr;
-
 	D3D12_ROOT_SIGNATURE_DESC descriptionRootSignature{};
 	descriptionRootSignature.Flags = D3D12_ROOT_SIGNATURE_FLAG_ALLOW_INPUT_ASSEMBLER_INPUT_LAYOUT;
 
@@ -82,28 +82,21 @@ void SpriteCommon::CreateRootSignature()
 	descriptionRootSignature.pParameters = rootParameters;             // ルートパラメータ配列へのポインタ
 	descriptionRootSignature.NumParameters = _countof(rootParameters); // 配列の長さ
 
-	//--- Blobの生成 ---
-	ID3DBlob* signatureBlob = nullptr;
-	ID3DBlob* errorBlob = nullptr;
-	hr = D3D12SerializeRootSignature(&descriptionRootSignature, D3D_ROOT_SIGNATURE_VERSION_1, &signatureBlob, &errorBlob);
-	if (FAILED(hr)) {
-		Logger::Log(reinterpret_cast<char*>(errorBlob->GetBufferPointer()));
-		assert(false);
-	}
-	hr = dxCommon_->GetDevice()->CreateRootSignature(0, signatureBlob->GetBufferPointer(), signatureBlob->GetBufferSize(), IID_PPV_ARGS(&rootSignature));
-	assert(SUCCEEDED(hr));
+	// --- 生成(同じ記述があれば共有される) ---
+	rootSignature = PipelineCache::GetInstance()->GetRootSignature(descriptionRootSignature);
 }
 
 void SpriteCommon::CreateGraphicsPipelineState()
 {
-	HRESULT hr;
+	// --- Shaderのコンパイルを登録(ルートシグネチャの生成と並行して進む) ---
+	ShaderCompiler::Result vertexShader = ShaderCompiler::GetInstance()->Compile(L"./Resources/shaders/Object3d.VS.hlsl", L"vs_6_0");
+	ShaderCompiler::Result pixelShader = ShaderCompiler::GetInstance()->Compile(L"./Resources/shaders/Object3d.PS.hlsl", L"ps_6_0");
 
 	//ルートシグネチャの作成
 	CreateRootSignature();
 
 #pragma region PSOに必要な変数の作成
-	// --- InputLayoutの設定 ---
-	D3D12_INPUT_ELEMENT_DESC inputElementDescs[3] = {};
+	// --- InputLayoutの設定(PSOを作り直すときにも参照するのでメンバに持つ) ---
 	inputElementDescs[0].SemanticName = "POSITION";
 	inputElementDescs[0].SemanticIndex = 0;
 	inputElementDescs[0].Format = DXGI_FORMAT_R32G32B32A32_FLOAT;
@@ -123,10 +116,10 @@ void SpriteCommon::CreateGraphicsPipelineState()
 	inputLayoutDesc.pInputElementDescs = inputElementDescs;
 	inputLayoutDesc.NumElements = _countof(inputElementDescs);
 
-	// --- Shaderをコンパイル ---
-	IDxcBlob* vertexShaderBlob = dxCommon_->CompileShader(L"./Resources/shaders/Object3d.VS.hlsl", L"vs_6_0");
+	// --- Shaderのコンパイル完了を待つ ---
+	vertexShaderBlob = vertexShader.get();
 	assert(vertexShaderBlob != nullptr);
-	IDxcBlob* pixelShaderBlob = dxCommon_->CompileShader(L"./Resources/shaders/Object3d.PS.hlsl", L"ps_6_0");
+	pixelShaderBlob = pixelShader.get();
 	assert(pixelShaderBlob != nullptr);
 
 	// --- BlendStateの設定 ---
@@ -152,8 +145,6 @@ void SpriteCommon::CreateGraphicsPipelineState()
 	//PSOの作成
 	graphicsPipelineStateDesc.pRootSignature = rootSignature.Get();												// RootSignature
 	graphicsPipelineStateDesc.InputLayout = inputLayoutDesc;													// inputLayout
-	graphicsPipelineStateDesc.VS = { vertexShaderBlob->GetBufferPointer(), vertexShaderBlob->GetBufferSize() }; // VertexShader
-	graphicsPipelineStateDesc.PS = { pixelShaderBlob->GetBufferPointer(), pixelShaderBlob->GetBufferSize() };   // PixelShader
 	graphicsPipelineStateDesc.BlendState = blendDesc;															// BlendDesc
 	graphicsPipelineStateDesc.RasterizerState = rasterizerDesc;													// RasterizerDesc
 	// 書き込むRTV情報
@@ -169,8 +160,47 @@ void SpriteCommon::CreateGraphicsPipelineState()
 	// どのように画面に色を打ち込むかの設定
 	graphicsPipelineStateDesc.SampleDesc.Count = 1;
 	graphicsPipelineStateDesc.SampleMask = D3D12_DEFAULT_SAMPLE_MASK;
-	// 生成
-	hr = dxCommon_->GetDevice()->CreateGraphicsPipelineState(&graphicsPipelineStateDesc, IID_PPV_ARGS(&graphicsPipelineState));
-	assert(SUCCEEDED(hr));
 
+	CreatePipelineState();
+}
+
+void SpriteCommon::CreatePipelineState()
+{
+	// --- シェーダーを設定 ---
+	graphicsPipelineStateDesc.VS = { vertexShaderBlob->GetBufferPointer(), vertexShaderBlob->GetBufferSize() }; // VertexShader
+	graphicsPipelineStateDesc.PS = { pixelShaderBlob->GetBufferPointer(), pixelShaderBlob->GetBufferSize() };   // PixelShader
+
+	// 生成(同じ記述があれば共有される)
+	graphicsPipelineState = PipelineCache::GetInstance()->GetGraphicsPipeline(graphicsPipelineStateDesc);
+}
+
+void SpriteCommon::ReloadShaders()
+{
+	// 登録し直すと新しい内容でコンパイルされる
+	reloadVertexShader_ = ShaderCompiler::GetInstance()->Compile(L"./Resources/shaders/Object3d.VS.hlsl", L"vs_6_0");
+	reloadPixelShader_ = ShaderCompiler::GetInstance()->Compile(L"./Resources/shaders/Object3d.PS.hlsl", L"ps_6_0");
+}
+
+void SpriteCommon::Update()
+{
+	// --- 再読み込みしていない・コンパイル中なら何もしない ---
+	if (!reloadVertexShader_.valid() || !reloadPixelShader_.valid()) {
+		return;
+	}
+	if (reloadVertexShader_.wait_for(std::chrono::seconds(0)) != std::future_status::ready ||
+		reloadPixelShader_.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+		return;
+	}
+	Microsoft::WRL::ComPtr<IDxcBlob> vertexShader = reloadVertexShader_.get();
+	Microsoft::WRL::ComPtr<IDxcBlob> pixelShader = reloadPixelShader_.get();
+	reloadVertexShader_ = {};
+	reloadPixelShader_ = {};
+
+	// --- コンパイルエラーなら前のシェーダーのまま ---
+	if (!vertexShader || !pixelShader) {
+		return;
+	}
+	vertexShaderBlob = vertexShader;
+	pixelShaderBlob = pixelShader;
+	CreatePipelineState();
 }
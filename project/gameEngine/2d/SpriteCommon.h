@@ -3,6 +3,7 @@
 #include <wrl.h>
 
 #include "DirectXCommon.h"
+#include "ShaderCompiler.h"
 
 //スプライト共通部
 class SpriteCommon
@@ -30,6 +31,11 @@ public://メンバ関数
 	//共通描画設定
 	void PreDraw();
 
+	// シェーダーの再読み込みを開始(コンパイルはワーカーで進む)
+	void ReloadShaders();
+	// 再コンパイルが終わっていればPSOを差し替える(GPUが前フレームを終えた後に呼ぶ)
+	void Update();
+
 public://ゲッター
 	DirectXCommon* GetDxCommon() const { return dxCommon_; }
 
@@ -45,12 +51,23 @@ private:
 	//グラフィックスパイプライン
 	Microsoft::WRL::ComPtr<ID3D12PipelineState> graphicsPipelineState;
 
+	// --- PSOの作り直しに使うもの ---
+	D3D12_INPUT_ELEMENT_DESC inputElementDescs[3] = {};
+	Microsoft::WRL::ComPtr<IDxcBlob> vertexShaderBlob;
+	Microsoft::WRL::ComPtr<IDxcBlob> pixelShaderBlob;
+
+	// --- 再読み込み中のシェーダー ---
+	ShaderCompiler::Result reloadVertexShader_;
+	ShaderCompiler::Result reloadPixelShader_;
+
 
 private:
 	//ルートシグネチャの作成
 	void CreateRootSignature();
 	//グラフィックスパイプラインの生成
 	void CreateGraphicsPipelineState();
+	//現在のシェーダーでPSOを生成
+	void CreatePipelineState();
 
 private://PSO生成のための関数
 	
@@ -16,7 +16,9 @@ Camera::Camera()
 void Camera::Update()
 {
 	// --- world座標変換 ---
-	worldMatrix = MakeAffineMatrix(transform.scale, transform.rotate, transform.translate);
+	worldMatrix = isQuaternionRotate ?
+		MakeAffineMatrix(transform.scale, rotateQuaternion, transform.translate) :
+		MakeAffineMatrix(transform.scale, transform.rotate, transform.translate);
 	viewMatrix = Inverse(worldMatrix);
 	projectionMatrix = MakePerspectiveFovMatrix(fovY, aspectRatio, nearClip, farClip);
 	viewProjectionMatrix = viewMatrix * projectionMatrix;
@@ -13,7 +13,16 @@ public:
 public:
 	// RT
 	const Vector3& GetRotate() const { return transform.rotate; }
-	void SetRotate(Vector3 rotate) { this->transform.rotate = rotate; }
+	void SetRotate(Vector3 rotate) {
+		this->transform.rotate = rotate;
+		this->isQuaternionRotate = false;
+	}
+	// 回転(クォータニオン。設定するとオイラー角の代わりに使う)
+	const Quaternion& GetRotateQuaternion() const { return rotateQuaternion; }
+	void SetRotateQuaternion(const Quaternion& rotate) {
+		this->rotateQuaternion = rotate;
+		this->isQuaternionRotate = true;
+	}
 	const Vector3& GetTranslate() const { return transform.translate; }
 	void SetTranslate(Vector3 translate) { this->transform.translate = translate; }
 
@@ -39,6 +48,8 @@ private:
 
 	// --- ビュー行列関連データ ---
 	Transform transform;
+	Quaternion rotateQuaternion;
+	bool isQuaternionRotate = false;
 	Matrix4x4 worldMatrix;
 	Matrix4x4 viewMatrix;
 
@@ -1,20 +1,44 @@
 #include "Model.h"
+#include "AssetPack.h"
+#include "Logger.h"
 #include "ModelCommon.h"
+#include "StringUtility.h"
 #include "TextureManager.h"
+#include "ThreadPool.h"
+#include "VirtualFileSystem.h"
 #include "WinApp.h"
 
-#include <fstream>
+#include <algorithm>
+#include <cassert>
+#include <charconv>
 #include <sstream>
 
 #include "../math/CalculateMath.h"
 
 void Model::Initialize(ModelCommon* modelCommon, const std::string& directorypath, const std::string& filename)
+{
+	Load(directorypath, filename);
+	CreateResources(modelCommon);
+}
+
+void Model::Load(const std::string& directorypath, const std::string& filename)
 {
 	// 引数で受け取ってメンバ変数に記録する
-	modelCommon_ = modelCommon;
+	directoryPath_ = directorypath;
+	filename_ = filename;
 
 	// --- オブジェクト読み込み ---
-	modelData_ = LoadObjFile(directorypath, filename);
+	bool isLoaded = LoadObjFile(directorypath, filename, modelData_);
+	if (!isLoaded) {
+		Logger::Log("Error: Failed to load model: " + directorypath + "/" + filename + "\n");
+	}
+	assert(isLoaded);
+}
+
+void Model::CreateResources(ModelCommon* modelCommon)
+{
+	// 引数で受け取ってメンバ変数に記録する
+	modelCommon_ = modelCommon;
 
 	// 頂点データの初期化
 	VertexResource();
@@ -22,26 +46,81 @@ void Model::Initialize(ModelCommon* modelCommon, const std::string& directorypat
 	MaterialResource();
 
 	// --- .objの参照しているテクスチャファイル読み込み ---
-	TextureManager::GetInstance()->LoadTexture(modelData_.material.textureFilePath);
+	texture_ = TextureManager::GetInstance()->AcquireTexture(modelData_.material.textureFilePath);
 	// 読み込んだテクスチャファイルの番号を取得
-	modelData_.material.textureIndex =
-		TextureManager::GetInstance()->GetTextureIndexByFilePath(modelData_.material.textureFilePath);
+	modelData_.material.textureIndex = texture_->srvIndex;
 }
 
 void Model::Draw()
 {
+	CommandContext* commandContext = modelCommon_->GetDxCommon()->GetCommandContext();
+
 	// --- vertexBufferViewの生成 ---
-	modelCommon_->GetDxCommon()->GetCommandList()->IASetVertexBuffers(0, 1, &vertexBufferView);
+	commandContext->IASetVertexBuffers(0, 1, &vertexBufferView);
 
 	// --- マテリアルCBufferの場所を設定 --- 
-	modelCommon_->GetDxCommon()->GetCommandList()->SetGraphicsRootConstantBufferView(0, materialResource->GetGPUVirtualAddress());
+	commandContext->SetGraphicsRootConstantBufferView(0, materialResource->GetGPUVirtualAddress());
 	
+	// --- 画面上の大きさが分からないので最も細かいミップを要求 ---
+	TextureManager::GetInstance()->RequestTextureMip(modelData_.material.textureFilePath, 0);
+
 	// --- SRVのDescriptorTableを設定 ---
-	modelCommon_->GetDxCommon()->GetCommandList()->SetGraphicsRootDescriptorTable(2, TextureManager::GetInstance()->GetSrvHandleGPU(modelData_.material.textureFilePath));
+	commandContext->SetGraphicsRootDescriptorTable(2, TextureManager::GetInstance()->GetSrvHandleGPU(texture_));
 
 	// --- 描画(DrawCall/ドローコール) ---
-	modelCommon_->GetDxCommon()->GetCommandList()->DrawInstanced(UINT(modelData_.vertices.size()), 1, 0, 0);
+	commandContext->DrawInstanced(UINT(modelData_.vertices.size()), 1, 0, 0);
+
+}
+
+void Model::BeginReload(ThreadPool& threadPool)
+{
+	// --- 前の解析が残っていても新しい内容で上書きする ---
+	reloadData_ = threadPool.Submit([directoryPath = directoryPath_, filename = filename_]() {
+		// 保存途中などで読めなければ空のまま返す
+		ModelData modelData;
+		if (!LoadObjFile(directoryPath, filename, modelData)) {
+			return ModelData{};
+		}
+		return modelData;
+		});
+}
+
+bool Model::ApplyReload()
+{
+	// --- 再読み込みしていない・解析中なら何もしない ---
+	if (!reloadData_.valid() || reloadData_.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+		return false;
+	}
+
+	// --- 壊れたファイルなら前のモデルのまま ---
+	ModelData modelData = reloadData_.get();
+	if (modelData.vertices.empty()) {
+		Logger::Log("Error: Failed to reload model: " + filename_ + "\n");
+		return false;
+	}
+	modelData_ = std::move(modelData);
+
+	// --- 頂点バッファを作り直す(前のバッファは前フレームで使い終わっている) ---
+	VertexResource();
+
+	// --- テクスチャが変わっていれば読み込む(前のテクスチャは参照が無くなれば解放される) ---
+	texture_ = TextureManager::GetInstance()->AcquireTexture(modelData_.material.textureFilePath);
+	modelData_.material.textureIndex = texture_->srvIndex;
+	return true;
+}
 
+bool Model::UsesFile(const std::string& normalizedPath) const
+{
+	if (AssetPack::NormalizePath(directoryPath_ + "/" + filename_) == normalizedPath) {
+		return true;
+	}
+	return !modelData_.materialFilename.empty() &&
+		AssetPack::NormalizePath(directoryPath_ + "/" + modelData_.materialFilename) == normalizedPath;
+}
+
+uint64_t Model::GetBufferSize() const
+{
+	return sizeof(VertexData) * modelData_.vertices.size() + sizeof(Material);
 }
 
 void Model::VertexResource()
@@ -72,14 +151,16 @@ void Model::MaterialResource()
 	materialData->uvTransform = MakeIdentity4x4();
 }
 
-Model::MaterialData Model::LoadMaterialTemplateFile(const std::string& directoryPath, const std::string& filename)
+bool Model::LoadMaterialTemplateFile(const std::string& directoryPath, const std::string& filename, MaterialData& materialData)
 {
-	MaterialData materialData;
 	std::string line;
-	std::ifstream file(directoryPath + "/" + filename);
-	assert(file.is_open());
+	FileData file = VirtualFileSystem::GetInstance()->Open(directoryPath + "/" + filename);
+	if (!file.IsValid()) {
+		return false;
+	}
 
-	while (std::getline(file, line)) {
+	size_t position = 0;
+	while (StringUtility::ReadLine(file.GetText(), position, line)) {
 		std::string identifier;
 		std::istringstream s(line);
 		s >> identifier;
@@ -90,21 +171,24 @@ Model::MaterialData Model::LoadMaterialTemplateFile(const std::string& directory
 			materialData.textureFilePath = directoryPath + "/" + textureFilename;
 		}
 	}
-	return materialData;
+	return true;
 }
 
-Model::ModelData Model::LoadObjFile(const std::string& directoryPath, const std::string& filename)
+bool Model::LoadObjFile(const std::string& directoryPath, const std::string& filename, ModelData& modelData)
 {
-	ModelData modelData;
+	modelData = ModelData{};
 	std::vector<Vector4> positions;
 	std::vector<Vector3> normals;
 	std::vector<Vector2> texcoords;
 	std::string line;
 
-	std::ifstream file(directoryPath + "/" + filename);
-	assert(file.is_open());
+	FileData file = VirtualFileSystem::GetInstance()->Open(directoryPath + "/" + filename);
+	if (!file.IsValid()) {
+		return false;
+	}
 
-	while (std::getline(file, line)) {
+	size_t position = 0;
+	while (StringUtility::ReadLine(file.GetText(), position, line)) {
 		std::string identifier;
 		std::istringstream s(line);
 		s >> identifier;
@@ -135,10 +219,16 @@ Model::ModelData Model::LoadObjFile(const std::string& directoryPath, const std:
 				s >> vertexDefinition;
 				std::istringstream v(vertexDefinition);
 				uint32_t elementIndices[3];
+				const size_t elementCounts[3] = { positions.size(), texcoords.size(), normals.size() };
 				for (int32_t element = 0; element < 3; ++element) {
 					std::string index;
 					std::getline(v, index, '/');
-					elementIndices[element] = std::stoi(index);
+					// 1始まりで、それまでに定義された要素を指していること
+					auto [end, ec] = std::from_chars(index.data(), index.data() + index.size(), elementIndices[element]);
+					if (ec != std::errc() || end != index.data() + index.size() ||
+						elementIndices[element] == 0 || elementIndices[element] > elementCounts[element]) {
+						return false;
+					}
 				}
 				Vector4 position = positions[elementIndices[0] - 1];
 				Vector2 texcoord = texcoords[elementIndices[1] - 1];
@@ -153,9 +243,23 @@ Model::ModelData Model::LoadObjFile(const std::string& directoryPath, const std:
 		else if (identifier == "mtllib") {
 			std::string materialFilename;
 			s >> materialFilename;
-			modelData.material = LoadMaterialTemplateFile(directoryPath, materialFilename);
+			if (!LoadMaterialTemplateFile(directoryPath, materialFilename, modelData.material)) {
+				return false;
+			}
+			modelData.materialFilename = materialFilename;
+		}
+	}
+
+	// --- 頂点を囲む箱 ---
+	if (!modelData.vertices.empty()) {
+		const Vector4& first = modelData.vertices.front().position;
+		modelData.bounds = { { first.x, first.y, first.z }, { first.x, first.y, first.z } };
+		for (const VertexData& vertex : modelData.vertices) {
+			const Vector4& p = vertex.position;
+			modelData.bounds.min = { (std::min)(modelData.bounds.min.x, p.x), (std::min)(modelData.bounds.min.y, p.y), (std::min)(modelData.bounds.min.z, p.z) };
+			modelData.bounds.max = { (std::max)(modelData.bounds.max.x, p.x), (std::max)(modelData.bounds.max.y, p.y), (std::max)(modelData.bounds.max.z, p.z) };
 		}
 	}
 
-	return modelData;
+	return true;
 }
@@ -1,26 +1,52 @@
 #pragma once
 #include <d3d12.h>
+#include <future>
 #include <string>
 #include <vector>
 #include <wrl.h>
 
+#include "TextureManager.h"
+
 #include "../math/Vector2.h"
 #include "../math/Vector3.h"
 #include "../math/Vector4.h"
 #include "../math/Matrix4x4.h"
+#include "../math/Affine3x4.h"
+#include "../math/Intersection.h"
 
 class ModelCommon;
+class ThreadPool;
 
 // 3Dモデル
 class Model
 {
 public:
-	// 初期化
+	// 初期化(Load + CreateResources)
 	void Initialize(ModelCommon* modelCommon, const std::string& directorypath, const std::string& filename);
 
+	// ファイルの解析だけを行う(GPUに触らないのでワーカースレッドから呼べる)
+	void Load(const std::string& directorypath, const std::string& filename);
+	// 解析済みのデータからバッファ・テクスチャを作る(メインスレッドで呼ぶ)
+	void CreateResources(ModelCommon* modelCommon);
+
 	// 描画処理
 	void Draw();
 
+	// 再読み込みの開始(.objの解析はワーカーで進む)
+	void BeginReload(ThreadPool& threadPool);
+	// 解析が終わっていれば頂点バッファとテクスチャを作り直す(反映したらtrue)
+	// GPUが前フレームを終えた後、そのフレームの描画コマンドを積む前に呼ぶこと
+	bool ApplyReload();
+
+	// 参照しているファイル(.obj/.mtl)か(パスはAssetPack::NormalizePathで正規化したもの)
+	bool UsesFile(const std::string& normalizedPath) const;
+
+	// GPU上のバッファの大きさ(バイト)
+	uint64_t GetBufferSize() const;
+
+	// 頂点を囲む箱(ローカル座標)
+	const AABB& GetBounds() const { return modelData_.bounds; }
+
 private:
 	// ===== 構造体 =====
 	// --- 頂点データ ---
@@ -56,7 +82,7 @@ private:
 	// --- 座標変換 ---
 	struct TransformationMatrix {
 		Matrix4x4 WVP;
-		Matrix4x4 World;
+		Affine3x4 World;
 	};
 	// --- 平行光源 ---
 	struct DirectionalLight {
@@ -74,6 +100,8 @@ private:
 	struct ModelData {
 		std::vector<VertexData> vertices;
 		MaterialData material;
+		std::string materialFilename; // mtllibで指定された.mtl
+		AABB bounds;	// 頂点を囲む箱(ローカル)
 	};
 
 private:
@@ -81,10 +109,11 @@ private:
 	void VertexResource();
 	void MaterialResource();
 
-	// .mtlファイルの読み取り
-	static MaterialData LoadMaterialTemplateFile(const std::string& directoryPath, const std::string& filename);
-	//.objファイルの読み取り
-	static ModelData LoadObjFile(const std::string& directoryPath, const std::string& filename);
+	// .mtlファイルの読み取り(開けなければfalse)
+	static bool LoadMaterialTemplateFile(const std::string& directoryPath, const std::string& filename, MaterialData& materialData);
+	//.objファイルの読み取り(開けない・インデックスが範囲外などで壊れていればfalse)
+	// 保存途中のファイルをワーカーで読むこともあるので、assertせずに失敗を返す
+	static bool LoadObjFile(const std::string& directoryPath, const std::string& filename, ModelData& modelData);
 
 private:
 	// --- ModelCommon ---
@@ -92,6 +121,11 @@ private:
 
 	// --- Objファイル ---
 	ModelData modelData_;
+	std::string directoryPath_;
+	std::string filename_;
+
+	// --- 再読み込み中のデータ ---
+	std::future<ModelData> reloadData_;
 
 	// --- バッファリソース ---
 	// VertexResource
@@ -101,6 +135,9 @@ private:
 	// VertexResourceにデータを書き込むためのポインタ
 	VertexData* vertexData = nullptr;
 
+	// --- テクスチャ(モデルが破棄されるまで参照を持つ) ---
+	TextureHandle texture_;
+
 	// --- マテリアル ---
 	// マテリアルリソース
 	Microsoft::WRL::ComPtr<ID3D12Resource> materialResource;
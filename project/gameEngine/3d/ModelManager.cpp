@@ -1,9 +1,14 @@
 #include "ModelManager.h"
+#include "AssetPack.h"
 #include "DirectXCommon.h"
+#include "Logger.h"
 #include "ModelCommon.h"
 
 ModelManager* ModelManager::instance = nullptr;
 
+// モデルファイルの置き場所
+const char* const ModelManager::kDirectory = "resources/models";
+
 ModelManager* ModelManager::GetInstance()
 {
 	if (instance == nullptr) {
@@ -13,39 +18,120 @@ ModelManager* ModelManager::GetInstance()
 }
 void ModelManager::Finalize()
 {
+	// --- 残っているモデルを報告(ハンドルが残っていればリーク) ---
+	if (models_.GetLiveCount() != 0) {
+		ReportLiveModels();
+	}
+	delete modelCommon_;
+	modelCommon_ = nullptr;
+
 	delete instance;
 	instance = nullptr;
 }
 
 void ModelManager::Initialize(DirectXCommon* dxCommon)
 {
+	dxCommon_ = dxCommon;
 	modelCommon_ = new ModelCommon();
 	modelCommon_->Initialize(dxCommon);
+
+	// 再読み込みはたまにしか起きないので1本で足りる
+	threadPool_ = std::make_unique<ThreadPool>(1);
 }
 
 void ModelManager::LoadModel(const std::string& filePath)
 {
 	// --- 読み込み済みモデルを検索 ---
-	if (models.contains(filePath)) {
-		// 読み込み済みなら早期return
+	if (models_.Find(filePath) != AssetRegistry<Model>::kInvalidId) {
+		// 読み込み済み(解放待ちを含む)なら早期return
 		return;
 	}
-	// --- モデルの生成とファイル読み込み・初期化 ---
+	// --- 解析済みならGPUリソースを作るだけ ---
+	std::unique_ptr<Model> model;
+	{
+		std::lock_guard<std::mutex> lock(preparedMutex_);
+		auto it = preparedModels_.find(filePath);
+		if (it != preparedModels_.end()) {
+			model = std::move(it->second);
+			preparedModels_.erase(it);
+		}
+	}
+	if (model) {
+		model->CreateResources(modelCommon_);
+	}
+	else {
+		// --- モデルの生成とファイル読み込み・初期化 ---
+		model = std::make_unique<Model>();
+		model->Initialize(modelCommon_, kDirectory, filePath);
+	}
+
+	// --- モデルを登録簿に格納する ---
+	models_.Add(filePath, std::move(model)); // 所有権を譲渡
+
+}
+
+void ModelManager::PrepareModel(const std::string& filePath)
+{
+	// --- 解析済みなら何もしない(読み込み済みかは登録簿に触れないので見ない) ---
+	{
+		std::lock_guard<std::mutex> lock(preparedMutex_);
+		if (preparedModels_.contains(filePath)) {
+			return;
+		}
+	}
+
+	// --- ロックの外で解析 ---
 	std::unique_ptr<Model> model = std::make_unique<Model>();
-	model->Initialize(modelCommon_, "resources/models", filePath);
+	model->Load(kDirectory, filePath);
 
-	// --- モデルをmapコンテナに格納する ---
-	models.insert(std::make_pair(filePath, std::move(model))); // 所有権を譲渡
+	std::lock_guard<std::mutex> lock(preparedMutex_);
+	preparedModels_.emplace(filePath, std::move(model));
+}
 
+ModelHandle ModelManager::AcquireModel(const std::string& filePath)
+{
+	// 解放待ちなら復活させる
+	LoadModel(filePath);
+	return ModelHandle(&models_, models_.Find(filePath));
 }
 
-Model* ModelManager::FindModel(const std::string& filePath)
+ModelHandle ModelManager::FindModel(const std::string& filePath)
 {
 	// --- 読み込み済みモデルを検索 ---
-	if (models.contains(filePath)) {
-		// 読み込みモデルを戻り値としてreturn
-		return models.at(filePath).get();
+	uint32_t id = models_.Find(filePath);
+	if (id != AssetRegistry<Model>::kInvalidId) {
+		// 読み込みモデルのハンドルを戻り値としてreturn
+		return ModelHandle(&models_, id);
 	}
 	// ファイル名一致無し
-	return nullptr;
+	return ModelHandle();
+}
+
+void ModelManager::ReportLiveModels() const
+{
+	Logger::Log(models_.BuildReport("ModelManager", [](const Model& model) { return model.GetBufferSize(); }));
+}
+
+void ModelManager::ReloadModel(const std::string& filePath)
+{
+	// --- 変更されたファイルを参照しているモデルだけ解析し直す ---
+	std::string normalizedPath = AssetPack::NormalizePath(filePath);
+	models_.ForEach([&](uint32_t, AssetRegistry<Model>::Entry& entry) {
+		if (entry.asset->UsesFile(normalizedPath)) {
+			entry.asset->BeginReload(*threadPool_);
+		}
+		});
+}
+
+void ModelManager::Update()
+{
+	// --- 参照が無くなりGPUも使い終わったモデルを解放(テクスチャの参照もここで外れる) ---
+	models_.Collect(dxCommon_->GetCompletedFenceValue());
+	// このフレームで参照が無くなったものはこのフレームのコマンドが終わってから解放
+	models_.SetRetireFenceValue(dxCommon_->GetNextFenceValue());
+
+	// --- 再読み込みの終わったモデルを差し替える ---
+	models_.ForEach([](uint32_t, AssetRegistry<Model>::Entry& entry) {
+		entry.asset->ApplyReload();
+		});
 }
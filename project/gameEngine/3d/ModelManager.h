@@ -2,12 +2,18 @@
 #include <string>
 #include <map>
 #include <memory>
+#include <mutex>
 
+#include "AssetRegistry.h"
 #include "Model.h"
+#include "ThreadPool.h"
 
 class ModelCommon;
 class DirectXCommon;
 
+// モデルのハンドル(最後のハンドルが無くなるとGPUが使い終わってから解放される)
+using ModelHandle = AssetHandle<Model>;
+
 // モデルマネージャー
 class ModelManager
 {
@@ -31,15 +37,49 @@ public:
 	// 初期化
 	void Initialize(DirectXCommon* dxCommon);
 
-	// モデルファイルの読み込み
+	// モデルファイルの読み込み(LoadModelだけで読み込んだものはハンドルを作るまで解放されない)
 	void LoadModel(const std::string& filePath);
 
-	// モデルの検索
-	Model* FindModel(const std::string& filePath);
+	// 読み込んでハンドルを取得
+	ModelHandle AcquireModel(const std::string& filePath);
+
+	// ファイルの解析だけを先に済ませる(ワーカースレッドから呼べる)
+	// 次のLoadModelではGPUリソースを作るだけになる
+	void PrepareModel(const std::string& filePath);
+
+	// モデルの検索(無ければ空のハンドル)
+	ModelHandle FindModel(const std::string& filePath);
+
+	// 読み込み済みモデルの一覧と使用メモリをログに出す
+	void ReportLiveModels() const;
+
+	// 変更された.obj/.mtlを参照しているモデルを再読み込みする
+	void ReloadModel(const std::string& filePath);
+
+	// 再読み込みの終わったモデルを差し替え、参照の無くなったモデルを解放する
+	// GPUが前フレームを終えた後、そのフレームの描画コマンドを積む前に呼ぶこと
+	void Update();
+
+public:
+	// 読み込み済みのモデル数(解放待ちを含む)
+	size_t GetModelCount() const { return models_.GetLiveCount(); }
+
+public:
+	// モデルファイルの置き場所
+	static const char* const kDirectory;
 
 private:
-	// --- モデルデータ ---
-	std::map<std::string, std::unique_ptr<Model>> models;
+	// --- モデルデータ(ファイル名→参照カウント付きの登録) ---
+	AssetRegistry<Model> models_;
+
+	DirectXCommon* dxCommon_ = nullptr;
+
+	// --- 解析済みでGPUリソースを作っていないモデル ---
+	std::map<std::string, std::unique_ptr<Model>> preparedModels_;
+	std::mutex preparedMutex_;
+
+	// --- 再読み込み用のワーカー ---
+	std::unique_ptr<ThreadPool> threadPool_;
 
 	// --- モデル共通部 ---
 	ModelCommon* modelCommon_ = nullptr;
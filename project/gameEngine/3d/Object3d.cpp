@@ -31,14 +31,19 @@ void Object3d::Initialize(Object3dCommon* object3dCommon)
 void Object3d::Update()
 {
 	// --- world座標変換 ---
-	Matrix4x4 worldMatrix = MakeAffineMatrix(transform.scale, transform.rotate, transform.translate);
+	worldMatrix = isQuaternionRotate ?
+		MakeAffine3x4(transform.scale, rotateQuaternion, transform.translate) :
+		MakeAffine3x4(transform.scale, transform.rotate, transform.translate);
+	if (parentHierarchy) {
+		worldMatrix = worldMatrix * parentHierarchy->GetWorldMatrix(parentNode);
+	}
 	Matrix4x4 worldViewProjectionMatrix;
 	if (camera) {
 		const Matrix4x4& viewProjectionMatrix = camera->GetViewProjectionMatrix();
-		worldViewProjectionMatrix = worldMatrix * viewProjectionMatrix;
+		worldViewProjectionMatrix = Multiply(worldMatrix, viewProjectionMatrix);
 	}
 	else {
-		worldViewProjectionMatrix = worldMatrix;
+		worldViewProjectionMatrix = ToMatrix4x4(worldMatrix);
 	}
 
 	// --- transformationMatrixDataの更新 ---
@@ -48,11 +53,13 @@ void Object3d::Update()
 
 void Object3d::Draw()
 {
+	CommandContext* commandContext = object3dCommon->GetDxCommon()->GetCommandContext();
+
 	// --- 座標変換行列CBufferの場所を設定 ---
-	object3dCommon->GetDxCommon()->GetCommandList()->SetGraphicsRootConstantBufferView(1, transformationMatrixResource->GetGPUVirtualAddress());
+	commandContext->SetGraphicsRootConstantBufferView(1, transformationMatrixResource->GetGPUVirtualAddress());
 
 	// --- 平行光源CBufferの場所を設定 ---
-	object3dCommon->GetDxCommon()->GetCommandList()->SetGraphicsRootConstantBufferView(3, directionalLightResource->GetGPUVirtualAddress());
+	commandContext->SetGraphicsRootConstantBufferView(3, directionalLightResource->GetGPUVirtualAddress());
 
 	// --- 描画 ---
 	if (model) {
@@ -61,6 +68,22 @@ void Object3d::Draw()
 	}
 }
 
+void Object3d::Reset()
+{
+	// --- 書き込み済みのバッファを初期値で上書き ---
+	TransformationMatrixDataWriting();
+	DirectionalLightDataWriting();
+
+	// --- Transform・モデル・カメラを初期状態に ---
+	transform = { {1.0f,1.0f,1.0f},{0.0f,0.0f,0.0f},{0.0f,0.0f,0.0f} };
+	worldMatrix = MakeIdentityAffine3x4();
+	rotateQuaternion = IdentityQuaternion();
+	isQuaternionRotate = false;
+	model.Reset();
+	camera = object3dCommon->GetDefaultCamera();
+	SetParent(nullptr, TransformHierarchy::kInvalidNode);
+}
+
 void Object3d::SetModel(const std::string& filePath)
 {
 	// モデルを検索してセット
@@ -75,8 +98,7 @@ void Object3d::TransformationMatrixResource()
 	// --- transformationMatrixDataに割り当てる ---
 	transformationMatrixResource->Map(0, nullptr, reinterpret_cast<void**>(&transformationMatrixData));
 
-	transformationMatrixData->WVP = MakeIdentity4x4();
-	transformationMatrixData->World = MakeIdentity4x4();
+	TransformationMatrixDataWriting();
 }
 void Object3d::DirectionalLightResource()
 {
@@ -86,6 +108,17 @@ void Object3d::DirectionalLightResource()
 	// --- directionalLightDataに割り当てる ---
 	directionalLightResource->Map(0, nullptr, reinterpret_cast<void**>(&directionalLightData));
 
+	DirectionalLightDataWriting();
+}
+
+void Object3d::TransformationMatrixDataWriting()
+{
+	transformationMatrixData->WVP = MakeIdentity4x4();
+	transformationMatrixData->World = MakeIdentityAffine3x4();
+}
+
+void Object3d::DirectionalLightDataWriting()
+{
 	directionalLightData->color = { 1.0f, 1.0f, 1.0f, 1.0f };
 	directionalLightData->direction = { 0.0f, -1.0f, 0.0f };
 	directionalLightData->intensity = 1.0f;
@@ -6,14 +6,18 @@
 #include <wrl.h>
 
 #include "Camera.h"
+#include "ModelManager.h"
+#include "TransformHierarchy.h"
 
 #include "Vector2.h"
 #include "Vector3.h"
 #include "Vector4.h"
 #include "Matrix4x4.h"
+#include "Affine3x4.h"
+#include "Intersection.h"
+#include "Quaternion.h"
 
 class Object3dCommon;
-class Model;
 
 // 3Dオブジェクト
 class Object3d
@@ -28,6 +32,9 @@ public:
 	// 描画処理
 	void Draw();
 
+	// 初期状態に戻す(バッファは作り直さない。プールで使い回すとき用)
+	void Reset();
+
 public:
 	// position
 	const Vector3& GetPosition() const { return transform.translate; }
@@ -35,7 +42,17 @@ public:
 
 	// rotate
 	const Vector3& GetRotate() const { return transform.rotate; }
-	void SetRotate(Vector3 rotate) { this->transform.rotate = rotate; }
+	void SetRotate(Vector3 rotate) {
+		this->transform.rotate = rotate;
+		this->isQuaternionRotate = false;
+	}
+
+	// rotate(クォータニオン。設定するとオイラー角の代わりに使う)
+	const Quaternion& GetRotateQuaternion() const { return rotateQuaternion; }
+	void SetRotateQuaternion(const Quaternion& rotate) {
+		this->rotateQuaternion = rotate;
+		this->isQuaternionRotate = true;
+	}
 
 	// scale
 	const Vector3& GetSize() const { return transform.scale; }
@@ -43,23 +60,37 @@ public:
 	
 	// model
 	void SetModel(const std::string& filePath);
+	// モデルの頂点を囲む箱(ローカル座標。モデルが無ければ原点の点)
+	AABB GetLocalBounds() const { return model ? model->GetBounds() : AABB{}; }
+
+	// ワールド行列(Updateで更新される)
+	const Affine3x4& GetWorldMatrix() const { return worldMatrix; }
 
 	// camera
 	void SetCamera(Camera* camera) { this->camera = camera; }
 
+	// 親(Transformは親のワールド行列からの相対になる。hierarchyがnullptrなら親なし)
+	// 親のワールド行列はhierarchyのUpdateで更新されるので、このオブジェクトのUpdateより先に呼ぶ
+	void SetParent(const TransformHierarchy* hierarchy, TransformHierarchy::NodeId node) {
+		this->parentHierarchy = hierarchy;
+		this->parentNode = node;
+	}
+
 private:
 	//Data書き込み
 	void TransformationMatrixResource();
 	void DirectionalLightResource();
+	void TransformationMatrixDataWriting();
+	void DirectionalLightDataWriting();
 
 private:
 	Object3dCommon* object3dCommon = nullptr;
-	Model* model = nullptr;
+	ModelHandle model;
 
 	// --- 座標変換 ---
 	struct TransformationMatrix {
 		Matrix4x4 WVP;
-		Matrix4x4 World;
+		Affine3x4 World;	// 最後の列は常に(0,0,0,1)なので3x4で送る(シェーダー側はfloat3x4)
 	};
 	// バッファリソース
 	Microsoft::WRL::ComPtr<ID3D12Resource> transformationMatrixResource;
@@ -84,7 +115,14 @@ private:
 		Vector3 translate;
 	};
 	Transform transform;
+	Affine3x4 worldMatrix = MakeIdentityAffine3x4();
+	Quaternion rotateQuaternion;
+	bool isQuaternionRotate = false;
 	Camera* camera = nullptr;
 
+	// --- 親 ---
+	const TransformHierarchy* parentHierarchy = nullptr;
+	TransformHierarchy::NodeId parentNode = TransformHierarchy::kInvalidNode;
+
 };
 
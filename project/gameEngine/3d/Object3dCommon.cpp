@@ -2,6 +2,9 @@
 #include <cassert>
 #include <d3d12.h>
 
+#include "PipelineCache.h"
+#include "ShaderCompiler.h"
+
 Object3dCommon* Object3dCommon::instance = nullptr;
 
 Object3dCommon* Object3dCommon::GetInstance()
@@ -30,17 +33,15 @@ void Object3dCommon::Initialize(DirectXCommon* dxCommon)
 void Object3dCommon::PreDraw()
 {
 	// ルートシグネチャをセット
-	dxCommon_->GetCommandList()->SetGraphicsRootSignature(rootSignature.Get());
+	dxCommon_->GetCommandContext()->SetGraphicsRootSignature(rootSignature.Get());
 	// グラフィックスパイプラインをセット
-	dxCommon_->GetCommandList()->SetPipelineState(graphicsPipelineState.Get());
+	dxCommon_->GetCommandContext()->SetPipelineState(graphicsPipelineState.Get());
 	// プリミティブトポロジーをセット
-	dxCommon_->GetCommandList()->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+	dxCommon_->GetCommandContext()->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 }
 
 void Object3dCommon::CreateRootSignature()
 {
-	HRESULT hr;
-
 	// --- DescriptorRange作成 ---
 	descriptorRange[0].BaseShaderRegister = 0;                                                   // 0から始まる
 	descriptorRange[0].NumDescriptors = 1;                                                       // 数は1つ
@@ -83,17 +84,8 @@ void Object3dCommon::CreateRootSignature()
 	descriptionRootSignature.pStaticSamplers = staticSamplers;
 	descriptionRootSignature.NumStaticSamplers = _countof(staticSamplers);
 
-	// --- シリアライズしてバイナリにする ---
-	Microsoft::WRL::ComPtr <ID3DBlob> signatureBlob;
-	Microsoft::WRL::ComPtr <ID3DBlob> errorBlob;
-	hr = D3D12SerializeRootSignature(&descriptionRootSignature, D3D_ROOT_SIGNATURE_VERSION_1, &signatureBlob, &errorBlob);
-	if (FAILED(hr)) {
-		Logger::Log(reinterpret_cast<char*>(errorBlob->GetBufferPointer()));
-		assert(false);
-	}
-	// バイナリを元に生成
-	hr = dxCommon_->GetDevice()->CreateRootSignature(0, signatureBlob->GetBufferPointer(), signatureBlob->GetBufferSize(), IID_PPV_ARGS(&rootSignature));
-	assert(SUCCEEDED(hr));
+	// --- 生成(同じ記述があれば共有される) ---
+	rootSignature = PipelineCache::GetInstance()->GetRootSignature(descriptionRootSignature);
 
 	// --- InputLayoutの設定 ---
 	inputElementDescs[0].SemanticName = "POSITION";
@@ -124,12 +116,6 @@ void Object3dCommon::CreateRootSignature()
 	// 塗りつぶすかどうか
 	rasterizerDesc.FillMode = D3D12_FILL_MODE_SOLID;
 
-	// --- Shaderをコンパイル --- 
-	vertexShaderBlob = dxCommon_->CompileShader(L"Resources/shaders/Object3d.VS.hlsl", L"vs_6_0");
-	assert(vertexShaderBlob != nullptr);
-	pixelShaderBlob = dxCommon_->CompileShader(L"Resources/shaders/Object3d.PS.hlsl", L"ps_6_0");
-	assert(pixelShaderBlob != nullptr);
-
 	// --- DepthStencilStateの設定 ---
 	// Depthの機能を有効化
 	depthStencilDesc.DepthEnable = true;
@@ -140,10 +126,54 @@ void Object3dCommon::CreateRootSignature()
 
 void Object3dCommon::CreateGraphicsPipeline()
 {
+	// --- Shaderのコンパイルを登録(ルートシグネチャの生成と並行して進む) --- 
+	ShaderCompiler::Result vertexShader = ShaderCompiler::GetInstance()->Compile(L"Resources/shaders/Object3d.VS.hlsl", L"vs_6_0");
+	ShaderCompiler::Result pixelShader = ShaderCompiler::GetInstance()->Compile(L"Resources/shaders/Object3d.PS.hlsl", L"ps_6_0");
+
 	CreateRootSignature();
 
-	HRESULT hr;
+	// --- Shaderのコンパイル完了を待つ ---
+	vertexShaderBlob = vertexShader.get();
+	assert(vertexShaderBlob != nullptr);
+	pixelShaderBlob = pixelShader.get();
+	assert(pixelShaderBlob != nullptr);
+
+	CreatePipelineState();
+}
 
+void Object3dCommon::ReloadShaders()
+{
+	// 登録し直すと新しい内容でコンパイルされる
+	reloadVertexShader_ = ShaderCompiler::GetInstance()->Compile(L"Resources/shaders/Object3d.VS.hlsl", L"vs_6_0");
+	reloadPixelShader_ = ShaderCompiler::GetInstance()->Compile(L"Resources/shaders/Object3d.PS.hlsl", L"ps_6_0");
+}
+
+void Object3dCommon::Update()
+{
+	// --- 再読み込みしていない・コンパイル中なら何もしない ---
+	if (!reloadVertexShader_.valid() || !reloadPixelShader_.valid()) {
+		return;
+	}
+	if (reloadVertexShader_.wait_for(std::chrono::seconds(0)) != std::future_status::ready ||
+		reloadPixelShader_.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+		return;
+	}
+	Microsoft::WRL::ComPtr<IDxcBlob> vertexShader = reloadVertexShader_.get();
+	Microsoft::WRL::ComPtr<IDxcBlob> pixelShader = reloadPixelShader_.get();
+	reloadVertexShader_ = {};
+	reloadPixelShader_ = {};
+
+	// --- コンパイルエラーなら前のシェーダーのまま ---
+	if (!vertexShader || !pixelShader) {
+		return;
+	}
+	vertexShaderBlob = vertexShader;
+	pixelShaderBlob = pixelShader;
+	CreatePipelineState();
+}
+
+void Object3dCommon::CreatePipelineState()
+{
 	// --- PSOを生成 ---
 	graphicsPipelineStateDesc.pRootSignature = rootSignature.Get();												// RootSignature
 	graphicsPipelineStateDesc.InputLayout = inputLayoutDesc;													// inputLayout
@@ -164,7 +194,6 @@ void Object3dCommon::CreateGraphicsPipeline()
 	graphicsPipelineStateDesc.SampleDesc.Count = 1;
 	graphicsPipelineStateDesc.SampleMask = D3D12_DEFAULT_SAMPLE_MASK;
 	
-	// 生成
-	hr = dxCommon_->GetDevice()->CreateGraphicsPipelineState(&graphicsPipelineStateDesc, IID_PPV_ARGS(&graphicsPipelineState));
-	assert(SUCCEEDED(hr));
+	// 生成(同じ記述があれば共有される)
+	graphicsPipelineState = PipelineCache::GetInstance()->GetGraphicsPipeline(graphicsPipelineStateDesc);
 }
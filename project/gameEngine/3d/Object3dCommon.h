@@ -2,6 +2,7 @@
 
 #include "Camera.h"
 #include "DirectXCommon.h"
+#include "ShaderCompiler.h"
 
 class Object3dCommon
 {
@@ -28,6 +29,11 @@ public:
 	// 共通描画設定
 	void PreDraw();
 
+	// シェーダーの再読み込みを開始(コンパイルはワーカーで進む)
+	void ReloadShaders();
+	// 再コンパイルが終わっていればPSOを差し替える(GPUが前フレームを終えた後に呼ぶ)
+	void Update();
+
 public:
 	// dxCommonの取得
 	DirectXCommon* GetDxCommon() const { return dxCommon_; }
@@ -41,6 +47,8 @@ private:
 	void CreateRootSignature();
 	// グラフィックスパイプラインステートの生成
 	void CreateGraphicsPipeline();
+	// 現在のシェーダーでPSOを生成
+	void CreatePipelineState();
 
 private:
 	DirectXCommon* dxCommon_;
@@ -67,5 +75,9 @@ private:
 	Microsoft::WRL::ComPtr <IDxcBlob> vertexShaderBlob;
 	Microsoft::WRL::ComPtr <IDxcBlob> pixelShaderBlob;
 
+	// --- 再読み込み中のシェーダー ---
+	ShaderCompiler::Result reloadVertexShader_;
+	ShaderCompiler::Result reloadPixelShader_;
+
 };
 
@@ -0,0 +1,304 @@
+#include "TransformHierarchy.h"
+#include <algorithm>
+#include <cassert>
+
+#include "CalculateMath.h"
+
+namespace
+{
+	const uint32_t kNoParent = UINT32_MAX;
+}
+
+TransformHierarchy::NodeId TransformHierarchy::CreateNode(NodeId parent, const Transform& local)
+{
+	assert(parent == kInvalidNode || IsAlive(parent));
+
+	// --- ノード番号の確保 ---
+	NodeId node;
+	if (!freeNodes_.empty()) {
+		node = freeNodes_.back();
+		freeNodes_.pop_back();
+	}
+	else {
+		node = NodeId(links_.size());
+		links_.emplace_back();
+		indexOfNode_.push_back(0);
+	}
+	links_[node] = Link{};
+	links_[node].isAlive = true;
+	LinkTo(node, parent);
+	nodeCount_++;
+
+	// --- 末尾に追加(親は必ず前にあるので並べ直すまでも計算できる) ---
+	uint32_t index = uint32_t(order_.size());
+	indexOfNode_[node] = index;
+	order_.push_back(node);
+	parentIndices_.push_back(parent == kInvalidNode ? kNoParent : indexOfNode_[parent]);
+	subtreeSizes_.push_back(1);
+	locals_.push_back(local);
+	worldMatrices_.push_back(MakeIdentityAffine3x4());
+	isDirty_.push_back(0);
+	MarkDirty(node);
+
+	isStructureDirty_ = true;
+	return node;
+}
+
+void TransformHierarchy::DestroyNode(NodeId node)
+{
+	assert(IsAlive(node));
+	Unlink(node);
+
+	// --- 子孫をまとめて破棄(並びに残った値は次のUpdateで外す) ---
+	std::vector<NodeId> stack = { node };
+	while (!stack.empty()) {
+		NodeId current = stack.back();
+		stack.pop_back();
+		for (NodeId child = links_[current].firstChild; child != kInvalidNode; child = links_[child].nextSibling) {
+			stack.push_back(child);
+		}
+		links_[current] = Link{};
+		freeNodes_.push_back(current);
+		nodeCount_--;
+	}
+	isStructureDirty_ = true;
+}
+
+void TransformHierarchy::SetParent(NodeId node, NodeId parent)
+{
+	assert(IsAlive(node) && (parent == kInvalidNode || IsAlive(parent)));
+	if (links_[node].parent == parent) {
+		return;
+	}
+#ifdef _DEBUG
+	// 自分の子孫を親にすると循環する
+	for (NodeId ancestor = parent; ancestor != kInvalidNode; ancestor = links_[ancestor].parent) {
+		assert(ancestor != node);
+	}
+#endif
+
+	Unlink(node);
+	LinkTo(node, parent);
+	parentIndices_[indexOfNode_[node]] = parent == kInvalidNode ? kNoParent : indexOfNode_[parent];
+	MarkDirty(node);
+	isStructureDirty_ = true;
+}
+
+void TransformHierarchy::SetLocal(NodeId node, const Transform& local)
+{
+	locals_[indexOfNode_[node]] = local;
+	MarkDirty(node);
+}
+
+void TransformHierarchy::SetTranslate(NodeId node, const Vector3& translate)
+{
+	locals_[indexOfNode_[node]].translate = translate;
+	MarkDirty(node);
+}
+
+void TransformHierarchy::SetRotate(NodeId node, const Vector3& rotate)
+{
+	locals_[indexOfNode_[node]].rotate = rotate;
+	MarkDirty(node);
+}
+
+void TransformHierarchy::SetScale(NodeId node, const Vector3& scale)
+{
+	locals_[indexOfNode_[node]].scale = scale;
+	MarkDirty(node);
+}
+
+void TransformHierarchy::Update(ThreadPool* threadPool)
+{
+	updatedNodeCount_ = 0;
+
+	// --- 構造が変わっていたら深さ優先の順に並べ直す ---
+	if (isStructureDirty_) {
+		Rebuild();
+	}
+	if (dirtyIndices_.empty()) {
+		return;
+	}
+
+	// --- 変更のあった部分木を集める ---
+	uint32_t threadCount = threadPool ? threadPool->GetThreadCount() + 1 : 1;
+	CollectDirtySubtrees(threadCount);
+
+	// --- 分割した部分木の根を先に計算(祖先が前に来るよう昇順) ---
+	for (uint32_t index : serialIndices_) {
+		UpdateRange(index, index + 1);
+	}
+
+	// --- 残りは部分木ごとに計算(部分木どうしは重ならないので並列にしてよい) ---
+	if (threadPool && subtreeRoots_.size() > 1) {
+		threadPool->ParallelFor(uint32_t(subtreeRoots_.size()), [this](uint32_t begin, uint32_t end) {
+			for (uint32_t i = begin; i < end; ++i) {
+				uint32_t root = subtreeRoots_[i];
+				UpdateRange(root, root + subtreeSizes_[root]);
+			}
+			});
+	}
+	else {
+		for (uint32_t root : subtreeRoots_) {
+			UpdateRange(root, root + subtreeSizes_[root]);
+		}
+	}
+
+	updatedNodeCount_ = uint32_t(serialIndices_.size());
+	for (uint32_t root : subtreeRoots_) {
+		updatedNodeCount_ += subtreeSizes_[root];
+	}
+	dirtyIndices_.clear();
+}
+
+void TransformHierarchy::Unlink(NodeId node)
+{
+	NodeId& first = FirstChildOf(links_[node].parent);
+	if (first == node) {
+		first = links_[node].nextSibling;
+	}
+	else {
+		NodeId sibling = first;
+		while (links_[sibling].nextSibling != node) {
+			sibling = links_[sibling].nextSibling;
+		}
+		links_[sibling].nextSibling = links_[node].nextSibling;
+	}
+	links_[node].parent = kInvalidNode;
+	links_[node].nextSibling = kInvalidNode;
+}
+
+void TransformHierarchy::LinkTo(NodeId node, NodeId parent)
+{
+	NodeId& first = FirstChildOf(parent);
+	links_[node].parent = parent;
+	links_[node].nextSibling = first;
+	first = node;
+}
+
+void TransformHierarchy::Rebuild()
+{
+	std::vector<NodeId> order;
+	std::vector<uint32_t> parentIndices;
+	std::vector<uint32_t> subtreeSizes;
+	std::vector<Transform> locals;
+	std::vector<Affine3x4> worldMatrices;
+	std::vector<uint8_t> isDirty;
+	order.reserve(nodeCount_);
+	parentIndices.reserve(nodeCount_);
+	subtreeSizes.reserve(nodeCount_);
+	locals.reserve(nodeCount_);
+	worldMatrices.reserve(nodeCount_);
+	isDirty.reserve(nodeCount_);
+
+	// --- 深さ優先で並べ、古い並びから値を移す ---
+	std::vector<NodeId> stack;
+	for (NodeId root = firstRoot_; root != kInvalidNode; root = links_[root].nextSibling) {
+		stack.push_back(root);
+	}
+	while (!stack.empty()) {
+		NodeId node = stack.back();
+		stack.pop_back();
+
+		uint32_t oldIndex = indexOfNode_[node];
+		NodeId parent = links_[node].parent;
+		order.push_back(node);
+		parentIndices.push_back(parent == kInvalidNode ? kNoParent : indexOfNode_[parent]);
+		subtreeSizes.push_back(1);
+		locals.push_back(locals_[oldIndex]);
+		worldMatrices.push_back(worldMatrices_[oldIndex]);
+		isDirty.push_back(isDirty_[oldIndex]);
+		// 親はもう新しい並びに入っているので、新しい番号に差し替えてよい
+		indexOfNode_[node] = uint32_t(order.size() - 1);
+
+		for (NodeId child = links_[node].firstChild; child != kInvalidNode; child = links_[child].nextSibling) {
+			stack.push_back(child);
+		}
+	}
+
+	// --- 部分木の大きさを後ろから積み上げる ---
+	for (uint32_t index = uint32_t(order.size()); index-- > 0;) {
+		if (parentIndices[index] != kNoParent) {
+			subtreeSizes[parentIndices[index]] += subtreeSizes[index];
+		}
+	}
+
+	order_ = std::move(order);
+	parentIndices_ = std::move(parentIndices);
+	subtreeSizes_ = std::move(subtreeSizes);
+	locals_ = std::move(locals);
+	worldMatrices_ = std::move(worldMatrices);
+	isDirty_ = std::move(isDirty);
+
+	// --- 変更ありの番号を振り直す ---
+	dirtyIndices_.clear();
+	for (uint32_t index = 0; index < isDirty_.size(); ++index) {
+		if (isDirty_[index]) {
+			dirtyIndices_.push_back(index);
+		}
+	}
+	isStructureDirty_ = false;
+}
+
+void TransformHierarchy::CollectDirtySubtrees(uint32_t threadCount)
+{
+	serialIndices_.clear();
+	subtreeRoots_.clear();
+
+	// --- 変更のあったノードのうち、祖先に変更が無いものを根にする(部分木は連続しているので昇順に見ればよい) ---
+	std::sort(dirtyIndices_.begin(), dirtyIndices_.end());
+	std::vector<uint32_t> candidates;
+	uint32_t coveredEnd = 0;
+	uint32_t totalNodes = 0;
+	for (uint32_t index : dirtyIndices_) {
+		if (index < coveredEnd) {
+			continue;
+		}
+		candidates.push_back(index);
+		coveredEnd = index + subtreeSizes_[index];
+		totalNodes += subtreeSizes_[index];
+	}
+
+	// --- 1スレッドなら分けない ---
+	if (threadCount <= 1) {
+		subtreeRoots_ = std::move(candidates);
+		return;
+	}
+
+	// --- 大きすぎる部分木は根だけ先に計算し、子の部分木に分ける ---
+	uint32_t limit = (std::max)(uint32_t(kMinParallelNodes), totalNodes / (threadCount * 4));
+	while (!candidates.empty()) {
+		uint32_t root = candidates.back();
+		candidates.pop_back();
+		uint32_t size = subtreeSizes_[root];
+		if (size <= limit) {
+			subtreeRoots_.push_back(root);
+			continue;
+		}
+		serialIndices_.push_back(root);
+		for (uint32_t child = root + 1; child < root + size; child += subtreeSizes_[child]) {
+			candidates.push_back(child);
+		}
+	}
+	std::sort(serialIndices_.begin(), serialIndices_.end());
+}
+
+void TransformHierarchy::UpdateRange(uint32_t begin, uint32_t end)
+{
+	for (uint32_t index = begin; index < end; ++index) {
+		const Transform& local = locals_[index];
+		Affine3x4 localMatrix = MakeAffine3x4(local.scale, local.rotate, local.translate);
+		uint32_t parentIndex = parentIndices_[index];
+		worldMatrices_[index] = parentIndex == kNoParent ? localMatrix : localMatrix * worldMatrices_[parentIndex];
+		isDirty_[index] = 0;
+	}
+}
+
+void TransformHierarchy::MarkDirty(NodeId node)
+{
+	uint32_t index = indexOfNode_[node];
+	if (!isDirty_[index]) {
+		isDirty_[index] = 1;
+		dirtyIndices_.push_back(index);
+	}
+}
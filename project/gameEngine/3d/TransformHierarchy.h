@@ -0,0 +1,118 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "Affine3x4.h"
+#include "Vector3.h"
+#include "ThreadPool.h"
+
+// 親子関係を持つTransformの集まり
+// ノードは深さ優先の順(親が子より前、部分木が連続)に平らな配列で並べ、
+// ローカルが変わった部分木だけを先頭から1回なめてワールド行列を求める
+// 生成・破棄・親の付け替えは次のUpdateでまとめて並べ直す(それまでも値の読み書きはできる)
+class TransformHierarchy
+{
+public:
+	// ノード番号(破棄されるまで変わらない)
+	using NodeId = uint32_t;
+	static const NodeId kInvalidNode = UINT32_MAX;
+
+	// 並列に計算する部分木の最小ノード数(これより小さい部分木は分割しない)
+	static const uint32_t kMinParallelNodes = 256;
+
+	// ローカルの位置・回転・拡縮
+	struct Transform {
+		Vector3 scale{ 1.0f, 1.0f, 1.0f };
+		Vector3 rotate{};
+		Vector3 translate{};
+	};
+
+public:
+	// ノードの生成(parentがkInvalidNodeならルート)
+	NodeId CreateNode(NodeId parent, const Transform& local);
+	NodeId CreateNode(NodeId parent = kInvalidNode) { return CreateNode(parent, Transform{}); }
+
+	// ノードの破棄(子孫もまとめて破棄する)
+	void DestroyNode(NodeId node);
+
+	// 親の付け替え(自分の子孫には付けられない)
+	void SetParent(NodeId node, NodeId parent);
+
+	// ワールド行列の更新(threadPoolを渡すと変更のあった部分木を並列に計算する)
+	void Update(ThreadPool* threadPool = nullptr);
+
+public:
+	// ローカル
+	const Transform& GetLocal(NodeId node) const { return locals_[indexOfNode_[node]]; }
+	void SetLocal(NodeId node, const Transform& local);
+	void SetTranslate(NodeId node, const Vector3& translate);
+	void SetRotate(NodeId node, const Vector3& rotate);
+	void SetScale(NodeId node, const Vector3& scale);
+
+	// ワールド行列(Updateで更新される)
+	const Affine3x4& GetWorldMatrix(NodeId node) const { return worldMatrices_[indexOfNode_[node]]; }
+
+	// 親
+	NodeId GetParent(NodeId node) const { return links_[node].parent; }
+	// 生存しているか
+	bool IsAlive(NodeId node) const { return node < links_.size() && links_[node].isAlive; }
+
+	// ノード数
+	uint32_t GetNodeCount() const { return nodeCount_; }
+	// 直前のUpdateで計算したノード数
+	uint32_t GetUpdatedNodeCount() const { return updatedNodeCount_; }
+
+private:
+	// 親子のつながり(ノード番号で引く)
+	struct Link {
+		NodeId parent = kInvalidNode;
+		NodeId firstChild = kInvalidNode;
+		NodeId nextSibling = kInvalidNode;
+		bool isAlive = false;
+	};
+
+	// 兄弟のリストから外す
+	void Unlink(NodeId node);
+	// 兄弟のリストの先頭に加える
+	void LinkTo(NodeId node, NodeId parent);
+	// 兄弟のリストの先頭(ルートならルートのリスト)
+	NodeId& FirstChildOf(NodeId parent) { return parent == kInvalidNode ? firstRoot_ : links_[parent].firstChild; }
+
+	// 深さ優先の順に並べ直す
+	void Rebuild();
+
+	// 変更のあったノードを根とする部分木を集め、大きいものは子の部分木に分ける
+	void CollectDirtySubtrees(uint32_t threadCount);
+
+	// [begin, end)のワールド行列を計算(beginの親は計算済みであること)
+	void UpdateRange(uint32_t begin, uint32_t end);
+
+	// 変更ありにする
+	void MarkDirty(NodeId node);
+
+private:
+	// --- ノード番号で引くデータ ---
+	std::vector<Link> links_;
+	std::vector<NodeId> freeNodes_;
+	std::vector<uint32_t> indexOfNode_;
+	NodeId firstRoot_ = kInvalidNode;
+	uint32_t nodeCount_ = 0;
+
+	// --- 深さ優先の順に並んだデータ ---
+	std::vector<NodeId> order_;
+	std::vector<uint32_t> parentIndices_;	// ルートはUINT32_MAX(並べ直すまでは親が後ろにあることもある)
+	std::vector<uint32_t> subtreeSizes_;	// 自分を含む子孫の数
+	std::vector<Transform> locals_;
+	std::vector<Affine3x4> worldMatrices_;
+	std::vector<uint8_t> isDirty_;
+
+	// 変更のあったノード(並び順の番号)
+	std::vector<uint32_t> dirtyIndices_;
+	// 並びを作り直す必要があるか
+	bool isStructureDirty_ = false;
+
+	// 今回計算するもの(作業用)
+	std::vector<uint32_t> serialIndices_;	// 分割した部分木の根(先に1つずつ計算する)
+	std::vector<uint32_t> subtreeRoots_;	// まとめて計算する部分木の根
+	uint32_t updatedNodeCount_ = 0;
+};
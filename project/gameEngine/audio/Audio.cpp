@@ -1,5 +1,9 @@
 #include "Audio.h"
 #include <cassert>
+#include <cstring>
+#include <span>
+
+#include "VirtualFileSystem.h"
 
 Audio* Audio::instance = nullptr;
 
@@ -27,19 +31,20 @@ void Audio::Initialize()
 
 SoundData Audio::LoadWav(const char* filename)
 {
-	std::ifstream file;
 	// 基本パスを指定（"Resources/audio/"）
 	std::string basePath = "Resources/audio/";
 	std::string fullPath = basePath + filename;
 
-	// .wavファイルをバイナリモードで展開
-	file.open(fullPath.c_str(), std::ios_base::binary);
+	// .wavファイルを仮想ファイルシステムから読み込む(メモリ上で直接解析する)
+	FileData file = VirtualFileSystem::GetInstance()->Open(fullPath);
 	// ファイル展開失敗時
-	assert(file.is_open());
+	assert(file.IsValid());
+	std::span<const uint8_t> bytes = file.GetSpan();
 
 	// RIFFヘッダーの読み込み
 	RiffHeader riff;
-	file.read((char*)&riff, sizeof(riff));
+	assert(bytes.size() >= sizeof(riff));
+	memcpy(&riff, bytes.data(), sizeof(riff));
 	// ファイルがRIFFかチェック
 	if (strncmp(riff.chunk.id, "RIFF", 4) != 0) {
 		assert(0);
@@ -49,53 +54,49 @@ SoundData Audio::LoadWav(const char* filename)
 		assert(0);
 	}
 
-	// チャンクのループを開始
-	ChunkHeader chunkHeader;
+	// チャンクのループを開始("fmt "と"data"以外(JUNKなど)は読み飛ばす)
 	FormatChunk format = {};
+	std::span<const uint8_t> waveData;
+	bool hasData = false;
+	size_t position = sizeof(riff);
+
+	while (position + sizeof(ChunkHeader) <= bytes.size()) {
+		ChunkHeader chunkHeader;
+		memcpy(&chunkHeader, bytes.data() + position, sizeof(chunkHeader));
+		position += sizeof(chunkHeader);
+		// チャンクがファイルからはみ出していないか
+		assert(chunkHeader.size >= 0 && size_t(chunkHeader.size) <= bytes.size() - position);
 
-	while (file.read((char*)&chunkHeader, sizeof(chunkHeader))) {
 		// チャンクIDが "fmt" か確認
 		if (strncmp(chunkHeader.id, "fmt ", 4) == 0) {
 			// Formatチャンクのサイズを確認し、データを読み込む
-			assert(chunkHeader.size <= sizeof(format.fmt));
+			assert(size_t(chunkHeader.size) <= sizeof(format.fmt));
 
 			format.chunk = chunkHeader; // チャンクヘッダーをコピー
-			file.read((char*)&format.fmt, chunkHeader.size); // fmtのデータを読み込み
-			
-			break;
+			memcpy(&format.fmt, bytes.data() + position, chunkHeader.size); // fmtのデータを読み込み
 		}
-		else {
-			// 次のチャンクに移動
-			file.seekg(chunkHeader.size, std::ios_base::cur);
+		// Dataチャンク(波形データ)
+		else if (strncmp(chunkHeader.id, "data", 4) == 0) {
+			waveData = bytes.subspan(position, chunkHeader.size);
+			hasData = true;
 		}
+
+		// 次のチャンクに移動(奇数サイズのチャンクは1バイト詰め物がある)
+		position += size_t(chunkHeader.size) + (chunkHeader.size & 1);
 	}
 
 	// "fmt"チャンクが見つからなかった場合のエラーとしてだす
 	if (strncmp(format.chunk.id, "fmt ", 4) != 0) {
 		assert(0);
 	}
-
-	// Dataチャンクの読み込み
-	ChunkHeader data;
-	file.read((char*)&data, sizeof(data));
-	// JUNKチャンクを検出した場合
-	if (strncmp(data.id, "JUNK", 4) == 0) {
-		// 読み取り位置をJUNKチャンクの終わりまで進める
-		file.seekg(data.size, std::ios_base::cur);
-		// 再読み込み
-		file.read((char*)&data, sizeof(data));
-	}
-
-	if (strncmp(data.id, "data", 4) != 0) {
+	// "data"チャンクが見つからなかった場合
+	if (!hasData) {
 		assert(0);
 	}
 
-	// Dataチャンクのデータ部（波形データの読み込み）
-	char* pBuffer = new char[data.size];
-	file.read(pBuffer, data.size);
-
-	// Wavファイルを閉じる
-	file.close();
+	// Dataチャンクのデータ部（波形データ）をコピー
+	char* pBuffer = new char[waveData.size()];
+	memcpy(pBuffer, waveData.data(), waveData.size());
 
 
 	// returnする為のデータ
@@ -103,7 +104,7 @@ SoundData Audio::LoadWav(const char* filename)
 
 	soundData.wfex = format.fmt;
 	soundData.pBuffer = reinterpret_cast<BYTE*>(pBuffer);
-	soundData.bufferSize = data.size;
+	soundData.bufferSize = static_cast<unsigned int>(waveData.size());
 
 	return soundData;
 }
@@ -0,0 +1,214 @@
+#include "AssetPack.h"
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+
+#include "BlockCompression.h"
+#include "Hash.h"
+#include "Logger.h"
+#include "Lz4.h"
+#include "ThreadPool.h"
+
+// "APAK"
+const uint32_t AssetPack::kMagic = 0x4B415041;
+// 形式のバージョン
+const uint32_t AssetPack::kVersion = 2;
+
+namespace
+{
+	// 圧縮後がこの割合を下回るときだけ圧縮して格納する
+	const double kCompressionThreshold = 0.9;
+
+	// 境界に揃える
+	uint64_t AlignUp(uint64_t value, uint64_t alignment)
+	{
+		return (value + alignment - 1) / alignment * alignment;
+	}
+}
+
+bool AssetPack::Open(const std::filesystem::path& packPath)
+{
+	Close();
+	if (!file_.Open(packPath)) {
+		return false;
+	}
+
+	// --- ヘッダの確認 ---
+	if (file_.GetSize() < sizeof(Header)) {
+		Close();
+		return false;
+	}
+	const Header* header = reinterpret_cast<const Header*>(file_.GetData());
+	if (header->magic != kMagic || header->version != kVersion ||
+		(file_.GetSize() - sizeof(Header)) / sizeof(Entry) < header->entryCount) {
+		Logger::Log("AssetPack: invalid pack " + packPath.string() + "\n");
+		Close();
+		return false;
+	}
+
+	// --- 索引はヘッダの直後 ---
+	entries_ = { reinterpret_cast<const Entry*>(file_.GetData() + sizeof(Header)), header->entryCount };
+	for (const Entry& entry : entries_) {
+		if (entry.offset > file_.GetSize() || file_.GetSize() - entry.offset < entry.storedSize) {
+			Logger::Log("AssetPack: entry out of range in " + packPath.string() + "\n");
+			Close();
+			return false;
+		}
+	}
+	return true;
+}
+
+void AssetPack::Close()
+{
+	entries_ = {};
+	file_.Close();
+}
+
+const AssetPack::Entry* AssetPack::Find(const std::filesystem::path& path) const
+{
+	// --- ハッシュ順に並んでいるので二分探索 ---
+	uint64_t hash = HashPath(path);
+	auto it = std::lower_bound(entries_.begin(), entries_.end(), hash,
+		[](const Entry& entry, uint64_t value) { return entry.pathHash < value; });
+	if (it == entries_.end() || it->pathHash != hash) {
+		return nullptr;
+	}
+	return &*it;
+}
+
+std::span<const uint8_t> AssetPack::GetStoredData(const Entry& entry) const
+{
+	return file_.GetSpan().subspan(size_t(entry.offset), size_t(entry.storedSize));
+}
+
+bool AssetPack::Decompress(const Entry& entry, std::span<uint8_t> dst, ThreadPool* threadPool) const
+{
+	if (dst.size() != entry.size) {
+		return false;
+	}
+	return Read(entry, 0, dst, threadPool);
+}
+
+bool AssetPack::Read(const Entry& entry, uint64_t offset, std::span<uint8_t> dst, ThreadPool* threadPool) const
+{
+	if (offset > entry.size || entry.size - offset < dst.size()) {
+		return false;
+	}
+	std::span<const uint8_t> stored = GetStoredData(entry);
+
+	// --- ブロック単位(範囲にかかるブロックだけを並列に展開) ---
+	if (entry.flags & kCompressedBlocks) {
+		return BlockCompression::DecompressRange(stored, offset, dst, threadPool);
+	}
+
+	// --- 全体圧縮(1ブロック以下の小さいものだけなので全体を展開してから切り出す) ---
+	if (entry.flags & kCompressedLZ4) {
+		if (offset == 0 && dst.size() == entry.size) {
+			return Lz4::Decompress(stored, dst);
+		}
+		std::vector<uint8_t> temporary(size_t(entry.size));
+		if (!Lz4::Decompress(stored, temporary)) {
+			return false;
+		}
+		std::copy_n(temporary.begin() + ptrdiff_t(offset), dst.size(), dst.begin());
+		return true;
+	}
+
+	// --- 無圧縮 ---
+	std::copy_n(stored.begin() + ptrdiff_t(offset), dst.size(), dst.begin());
+	return true;
+}
+
+std::string AssetPack::NormalizePath(const std::filesystem::path& path)
+{
+	std::string result = path.lexically_normal().generic_string();
+	std::transform(result.begin(), result.end(), result.begin(), [](unsigned char c) { return char(std::tolower(c)); });
+	return result;
+}
+
+uint64_t AssetPack::HashPath(const std::filesystem::path& path)
+{
+	return Hash::CombineString(Hash::kOffsetBasis, NormalizePath(path));
+}
+
+bool AssetPack::Build(const std::filesystem::path& rootDirectory, const std::filesystem::path& packPath,
+	bool isCompressionEnabled, Lz4::Level level)
+{
+	// --- 対象ファイルの列挙(ハッシュ順) ---
+	struct Source {
+		std::filesystem::path path;
+		uint64_t pathHash;
+	};
+	std::vector<Source> sources;
+	std::error_code ec;
+	for (const auto& item : std::filesystem::recursive_directory_iterator(rootDirectory, ec)) {
+		if (item.is_regular_file()) {
+			sources.push_back({ item.path(), HashPath(item.path()) });
+		}
+	}
+	std::sort(sources.begin(), sources.end(), [](const Source& a, const Source& b) { return a.pathHash < b.pathHash; });
+
+	// ハッシュが衝突したら区別できない
+	auto duplicate = std::adjacent_find(sources.begin(), sources.end(),
+		[](const Source& a, const Source& b) { return a.pathHash == b.pathHash; });
+	if (duplicate != sources.end()) {
+		Logger::Log("AssetPack: path hash collision " + duplicate->path.string() + "\n");
+		return false;
+	}
+
+	std::ofstream out(packPath, std::ios::binary | std::ios::trunc);
+	if (!out.is_open()) {
+		return false;
+	}
+
+	// --- ヘッダと索引の領域を確保(索引は最後に書き直す) ---
+	Header header{ kMagic, kVersion, uint32_t(sources.size()), 0 };
+	std::vector<Entry> entries(sources.size());
+	out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	out.write(reinterpret_cast<const char*>(entries.data()), std::streamsize(entries.size() * sizeof(Entry)));
+	uint64_t offset = sizeof(Header) + entries.size() * sizeof(Entry);
+
+	// --- 各エントリを境界に揃えて書き出す ---
+	ThreadPool threadPool;
+	std::vector<uint8_t> compressed;
+	for (size_t i = 0; i < sources.size(); ++i) {
+		MappedFile source;
+		if (!source.Open(sources[i].path) && std::filesystem::file_size(sources[i].path, ec) != 0) {
+			Logger::Log("AssetPack: failed to read " + sources[i].path.string() + "\n");
+			return false;
+		}
+
+		Entry& entry = entries[i];
+		entry.pathHash = sources[i].pathHash;
+		entry.size = source.GetSize();
+		std::span<const uint8_t> stored = source.GetSpan();
+
+		if (isCompressionEnabled && source.GetSize() > 0) {
+			// 大きいものはブロック単位にして並列に圧縮・展開できるようにする
+			bool isBlocks = source.GetSize() > BlockCompression::kDefaultBlockSize;
+			compressed.clear();
+			if (isBlocks) {
+				BlockCompression::Compress(source.GetSpan(), compressed, level, BlockCompression::kDefaultBlockSize, &threadPool);
+			} else {
+				Lz4::Compress(source.GetSpan(), compressed, level);
+			}
+			if (double(compressed.size()) < double(source.GetSize()) * kCompressionThreshold) {
+				stored = compressed;
+				entry.flags |= isBlocks ? kCompressedBlocks : kCompressedLZ4;
+			}
+		}
+
+		uint64_t alignedOffset = AlignUp(offset, kAlignment);
+		static const char kPadding[kAlignment] = {};
+		out.write(kPadding, std::streamsize(alignedOffset - offset));
+		out.write(reinterpret_cast<const char*>(stored.data()), std::streamsize(stored.size()));
+		entry.offset = alignedOffset;
+		entry.storedSize = stored.size();
+		offset = alignedOffset + stored.size();
+	}
+
+	// --- 索引を書き直す ---
+	out.seekp(sizeof(Header));
+	out.write(reinterpret_cast<const char*>(entries.data()), std::streamsize(entries.size() * sizeof(Entry)));
+	return out.good();
+}
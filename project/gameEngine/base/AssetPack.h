@@ -0,0 +1,90 @@
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "Lz4.h"
+#include "MappedFile.h"
+
+class ThreadPool;
+
+// アセットパック
+// 複数のアセットを1つのファイルにまとめ、丸ごとマップして参照する
+// [ヘッダ][パスのハッシュ順に並んだ索引][kAlignmentに揃えた各エントリ(LZ4圧縮可。大きいものはブロック単位)]
+class AssetPack
+{
+public:
+	// ファイル先頭の識別子
+	static const uint32_t kMagic;
+	// 形式のバージョン
+	static const uint32_t kVersion;
+	// エントリの先頭を揃える境界
+	static const uint64_t kAlignment = 64;
+
+	// エントリのフラグ
+	enum EntryFlags : uint32_t {
+		kCompressedLZ4 = 1 << 0,	// 全体をLZ4で圧縮している
+		kCompressedBlocks = 1 << 1,	// ブロックごとにLZ4で圧縮している(並列・部分展開できる)
+	};
+
+	// ヘッダ
+	struct Header {
+		uint32_t magic;
+		uint32_t version;
+		uint32_t entryCount;
+		uint32_t reserved;
+	};
+
+	// 索引の1要素
+	struct Entry {
+		uint64_t pathHash;		// 正規化したパスのハッシュ
+		uint64_t offset;		// ファイル先頭からの位置
+		uint64_t storedSize;	// 格納サイズ
+		uint64_t size;			// 元のサイズ
+		uint32_t flags;			// EntryFlags
+		uint32_t reserved;
+	};
+
+public:
+	// パックを開いてマップする(形式が違えばfalse)
+	bool Open(const std::filesystem::path& packPath);
+	// 閉じる
+	void Close();
+
+	// エントリの検索(無ければnullptr)
+	const Entry* Find(const std::filesystem::path& path) const;
+
+	// エントリの格納データ(圧縮されていれば圧縮されたまま)
+	std::span<const uint8_t> GetStoredData(const Entry& entry) const;
+
+	// エントリを展開してdstに書き込む(dstはentry.sizeであること)
+	// ブロック圧縮のエントリはthreadPoolで並列に展開する
+	bool Decompress(const Entry& entry, std::span<uint8_t> dst, ThreadPool* threadPool = nullptr) const;
+
+	// エントリの展開後のoffsetからdst.size()分を読む
+	bool Read(const Entry& entry, uint64_t offset, std::span<uint8_t> dst, ThreadPool* threadPool = nullptr) const;
+
+public:
+	// 開いているか
+	bool IsOpen() const { return file_.IsOpen(); }
+	// エントリ数
+	size_t GetEntryCount() const { return entries_.size(); }
+
+public:
+	// パスの正規化(区切りは'/'、小文字、"./"などを除く)
+	static std::string NormalizePath(const std::filesystem::path& path);
+	// 正規化したパスのハッシュ
+	static uint64_t HashPath(const std::filesystem::path& path);
+
+	// ディレクトリ以下の全ファイルをパックにまとめる(パスはrootDirectoryを含めて登録する)
+	// 圧縮して小さくなるエントリだけLZ4で格納する。1ブロックより大きいものはブロック単位で圧縮する
+	static bool Build(const std::filesystem::path& rootDirectory, const std::filesystem::path& packPath,
+		bool isCompressionEnabled, Lz4::Level level = Lz4::Level::kFast);
+
+private:
+	MappedFile file_;
+	// 索引(マップしたファイルを直接参照)
+	std::span<const Entry> entries_;
+};
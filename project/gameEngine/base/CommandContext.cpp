@@ -0,0 +1,183 @@
+#include "CommandContext.h"
+#include <cassert>
+
+void CommandContext::Initialize(ID3D12GraphicsCommandList* commandList)
+{
+	// メンバ変数に記録
+	commandList_ = commandList;
+
+	Invalidate();
+	ResetStatistics();
+}
+
+void CommandContext::Invalidate()
+{
+	rootSignature_ = nullptr;
+	pipelineState_ = nullptr;
+	primitiveTopology_ = D3D_PRIMITIVE_TOPOLOGY_UNDEFINED;
+	descriptorHeap_ = nullptr;
+	hasVertexBuffer_ = false;
+	hasIndexBuffer_ = false;
+	InvalidateRootArguments();
+}
+
+void CommandContext::EndFrame()
+{
+	Invalidate();
+
+	lastFrameStatistics_ = statistics_;
+	ResetStatistics();
+}
+
+void CommandContext::SetGraphicsRootSignature(ID3D12RootSignature* rootSignature)
+{
+	if (!Count(rootSignature_ == rootSignature)) {
+		return;
+	}
+	rootSignature_ = rootSignature;
+	// ルートシグネチャが変わるとルート引数は全て未定義になる
+	InvalidateRootArguments();
+
+	if (commandList_) {
+		commandList_->SetGraphicsRootSignature(rootSignature);
+	}
+}
+
+void CommandContext::SetPipelineState(ID3D12PipelineState* pipelineState)
+{
+	if (!Count(pipelineState_ == pipelineState)) {
+		return;
+	}
+	pipelineState_ = pipelineState;
+
+	if (commandList_) {
+		commandList_->SetPipelineState(pipelineState);
+	}
+}
+
+void CommandContext::IASetPrimitiveTopology(D3D12_PRIMITIVE_TOPOLOGY primitiveTopology)
+{
+	if (!Count(primitiveTopology_ == primitiveTopology)) {
+		return;
+	}
+	primitiveTopology_ = primitiveTopology;
+
+	if (commandList_) {
+		commandList_->IASetPrimitiveTopology(primitiveTopology);
+	}
+}
+
+void CommandContext::SetDescriptorHeaps(UINT numDescriptorHeaps, ID3D12DescriptorHeap* const* descriptorHeaps)
+{
+	// CBV_SRV_UAVヒープ1つだけの場合のみ保持する
+	bool redundant = numDescriptorHeaps == 1 && descriptorHeap_ == descriptorHeaps[0];
+	if (!Count(redundant)) {
+		return;
+	}
+	descriptorHeap_ = numDescriptorHeaps == 1 ? descriptorHeaps[0] : nullptr;
+	// ヒープが変わるとDescriptorTableは指し直しが必要
+	InvalidateRootArguments();
+
+	if (commandList_) {
+		commandList_->SetDescriptorHeaps(numDescriptorHeaps, descriptorHeaps);
+	}
+}
+
+void CommandContext::IASetVertexBuffers(UINT startSlot, UINT numViews, const D3D12_VERTEX_BUFFER_VIEW* views)
+{
+	// 0番スロット1つだけの場合のみ保持する
+	bool tracked = startSlot == 0 && numViews == 1;
+	bool redundant = tracked && hasVertexBuffer_ &&
+		vertexBufferView_.BufferLocation == views[0].BufferLocation &&
+		vertexBufferView_.SizeInBytes == views[0].SizeInBytes &&
+		vertexBufferView_.StrideInBytes == views[0].StrideInBytes;
+	if (!Count(redundant)) {
+		return;
+	}
+	hasVertexBuffer_ = tracked;
+	if (tracked) {
+		vertexBufferView_ = views[0];
+	}
+
+	if (commandList_) {
+		commandList_->IASetVertexBuffers(startSlot, numViews, views);
+	}
+}
+
+void CommandContext::IASetIndexBuffer(const D3D12_INDEX_BUFFER_VIEW* view)
+{
+	bool redundant = hasIndexBuffer_ &&
+		indexBufferView_.BufferLocation == view->BufferLocation &&
+		indexBufferView_.SizeInBytes == view->SizeInBytes &&
+		indexBufferView_.Format == view->Format;
+	if (!Count(redundant)) {
+		return;
+	}
+	hasIndexBuffer_ = true;
+	indexBufferView_ = *view;
+
+	if (commandList_) {
+		commandList_->IASetIndexBuffer(view);
+	}
+}
+
+void CommandContext::SetGraphicsRootConstantBufferView(UINT rootParameterIndex, D3D12_GPU_VIRTUAL_ADDRESS bufferLocation)
+{
+	assert(rootParameterIndex < kMaxRootParameters);
+
+	if (!Count(rootArguments_[rootParameterIndex] == bufferLocation)) {
+		return;
+	}
+	rootArguments_[rootParameterIndex] = bufferLocation;
+
+	if (commandList_) {
+		commandList_->SetGraphicsRootConstantBufferView(rootParameterIndex, bufferLocation);
+	}
+}
+
+void CommandContext::SetGraphicsRootDescriptorTable(UINT rootParameterIndex, D3D12_GPU_DESCRIPTOR_HANDLE baseDescriptor)
+{
+	assert(rootParameterIndex < kMaxRootParameters);
+
+	if (!Count(rootArguments_[rootParameterIndex] == baseDescriptor.ptr)) {
+		return;
+	}
+	rootArguments_[rootParameterIndex] = baseDescriptor.ptr;
+
+	if (commandList_) {
+		commandList_->SetGraphicsRootDescriptorTable(rootParameterIndex, baseDescriptor);
+	}
+}
+
+void CommandContext::DrawInstanced(UINT vertexCountPerInstance, UINT instanceCount, UINT startVertexLocation, UINT startInstanceLocation)
+{
+	Count(false);
+
+	if (commandList_) {
+		commandList_->DrawInstanced(vertexCountPerInstance, instanceCount, startVertexLocation, startInstanceLocation);
+	}
+}
+
+void CommandContext::DrawIndexedInstanced(UINT indexCountPerInstance, UINT instanceCount, UINT startIndexLocation, INT baseVertexLocation, UINT startInstanceLocation)
+{
+	Count(false);
+
+	if (commandList_) {
+		commandList_->DrawIndexedInstanced(indexCountPerInstance, instanceCount, startIndexLocation, baseVertexLocation, startInstanceLocation);
+	}
+}
+
+bool CommandContext::Count(bool redundant)
+{
+	if (redundant) {
+		statistics_.skipped++;
+		return false;
+	}
+	statistics_.issued++;
+	return true;
+}
+
+void CommandContext::InvalidateRootArguments()
+{
+	rootArguments_.fill(0);
+}
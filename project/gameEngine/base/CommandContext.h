@@ -0,0 +1,91 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <d3d12.h>
+
+// コマンド記録ラッパー
+// 現在バインドされている状態を保持し、同じ値の再設定を発行せずに捨てる
+// commandListがnullptrの場合は記録のみ行う(状態とカウンタだけ更新する)
+class CommandContext
+{
+public:
+	// ルートパラメータの最大数
+	static const uint32_t kMaxRootParameters = 16;
+
+	// 発行・スキップ数の統計
+	struct Statistics {
+		uint32_t issued = 0;	// 発行したコマンド数
+		uint32_t skipped = 0;	// 冗長でスキップしたコマンド数
+	};
+
+public:
+	// 初期化(nullptrなら記録のみ)
+	void Initialize(ID3D12GraphicsCommandList* commandList);
+
+	// 保持している状態を破棄する(コマンドリストのリセットや外部から直接コマンドを積んだ後に呼ぶ)
+	void Invalidate();
+
+	// フレーム終了(状態を破棄し、統計を前フレーム分として確定する)
+	void EndFrame();
+
+	// 統計のリセット
+	void ResetStatistics() { statistics_ = {}; }
+
+public:
+	// --- パイプライン ---
+	void SetGraphicsRootSignature(ID3D12RootSignature* rootSignature);
+	void SetPipelineState(ID3D12PipelineState* pipelineState);
+	void IASetPrimitiveTopology(D3D12_PRIMITIVE_TOPOLOGY primitiveTopology);
+	void SetDescriptorHeaps(UINT numDescriptorHeaps, ID3D12DescriptorHeap* const* descriptorHeaps);
+
+	// --- 入力アセンブラ ---
+	// 0番スロットのみ保持する
+	void IASetVertexBuffers(UINT startSlot, UINT numViews, const D3D12_VERTEX_BUFFER_VIEW* views);
+	void IASetIndexBuffer(const D3D12_INDEX_BUFFER_VIEW* view);
+
+	// --- ルート引数 ---
+	void SetGraphicsRootConstantBufferView(UINT rootParameterIndex, D3D12_GPU_VIRTUAL_ADDRESS bufferLocation);
+	void SetGraphicsRootDescriptorTable(UINT rootParameterIndex, D3D12_GPU_DESCRIPTOR_HANDLE baseDescriptor);
+
+	// --- 描画 ---
+	void DrawInstanced(UINT vertexCountPerInstance, UINT instanceCount, UINT startVertexLocation, UINT startInstanceLocation);
+	void DrawIndexedInstanced(UINT indexCountPerInstance, UINT instanceCount, UINT startIndexLocation, INT baseVertexLocation, UINT startInstanceLocation);
+
+public:
+	// 統計の取得
+	const Statistics& GetStatistics() const { return statistics_; }
+	const Statistics& GetLastFrameStatistics() const { return lastFrameStatistics_; }
+
+	// 現在の状態の取得
+	ID3D12RootSignature* GetRootSignature() const { return rootSignature_; }
+	ID3D12PipelineState* GetPipelineState() const { return pipelineState_; }
+
+private:
+	// 発行した場合はtrue
+	bool Count(bool redundant);
+
+	// ルート引数の状態を破棄
+	void InvalidateRootArguments();
+
+private:
+	// 記録先(nullptrなら記録のみ)
+	ID3D12GraphicsCommandList* commandList_ = nullptr;
+
+	// --- 保持している状態 ---
+	ID3D12RootSignature* rootSignature_ = nullptr;
+	ID3D12PipelineState* pipelineState_ = nullptr;
+	D3D12_PRIMITIVE_TOPOLOGY primitiveTopology_ = D3D_PRIMITIVE_TOPOLOGY_UNDEFINED;
+	ID3D12DescriptorHeap* descriptorHeap_ = nullptr;
+
+	bool hasVertexBuffer_ = false;
+	D3D12_VERTEX_BUFFER_VIEW vertexBufferView_{};
+	bool hasIndexBuffer_ = false;
+	D3D12_INDEX_BUFFER_VIEW indexBufferView_{};
+
+	// ルート引数(0は未設定扱い)
+	std::array<uint64_t, kMaxRootParameters> rootArguments_{};
+
+	// 統計
+	Statistics statistics_;
+	Statistics lastFrameStatistics_;
+};
@@ -1,6 +1,8 @@
 #include "Windows.h"
 
 #include "DirectXCommon.h"
+#include "ShaderCompiler.h"
+#include "UploadService.h"
 #include <cassert>
 #include <format>
 #include <thread>
@@ -156,6 +158,12 @@ void DirectXCommon::CommandInitialize()
 
 	Logger::Log("Complete create ID3D12GraphicsCommandList!!!\n"); // コマンドリスト生成完了のログ　
 
+	// --- コマンドコンテキスト初期化 ---
+	commandContext.Initialize(commandList.Get());
+
+	// --- アップロード用バッファのプール ---
+	stagingPool.Initialize(this);
+
 }
 
 void DirectXCommon::SwapChainCreate()
@@ -269,17 +277,8 @@ void DirectXCommon::ScissorRect()
 
 void DirectXCommon::DXCCompilerCreate()
 {
-	HRESULT hr;
-
-	// --- dxcUtils dxcCompiler を生成 ---
-	hr = DxcCreateInstance(CLSID_DxcUtils, IID_PPV_ARGS(&dxcUtils));
-	assert(SUCCEEDED(hr));
-	hr = DxcCreateInstance(CLSID_DxcCompiler, IID_PPV_ARGS(&dxcCompiler));
-	assert(SUCCEEDED(hr));
-
-	// --- デフォルトインクルードハンドラの生成 ---
-	hr = dxcUtils->CreateDefaultIncludeHandler(&includeHandler);
-	assert(SUCCEEDED(hr));
+	// --- シェーダーコンパイルサービスの初期化(スレッドごとにDXCを生成する) ---
+	ShaderCompiler::GetInstance()->Initialize();
 }
 
 void DirectXCommon::PreDraw()
@@ -340,6 +339,10 @@ void DirectXCommon::PostDraw()
 	hr = commandList->Close();
 	assert(SUCCEEDED(hr));
 
+	// --- このフレームの転送をコピーキューへ送り、描画で使うものの完了をGPU上で待つ ---
+	UploadService::GetInstance()->Submit();
+	UploadService::GetInstance()->InsertFrameWait(commandQueue.Get());
+
 	// --- GPUコマンドの実行 ---
 	ID3D12CommandList* commandLists[] = { commandList.Get() };
 	commandQueue->ExecuteCommandLists(1, commandLists);
@@ -347,9 +350,6 @@ void DirectXCommon::PostDraw()
 	// --- GPU画面の交換を通知 ---
 	swapChain->Present(1, 0);
 
-	// --- Fenceの値を更新 ---
-	fenceValue++;
-
 	// --- コマンドキューにシグナルを送る ---
 	commandQueue->Signal(fence.Get(), ++fenceValue);
 
@@ -361,6 +361,9 @@ void DirectXCommon::PostDraw()
 		CloseHandle(event);
 	}
 
+	// --- 使い終わった中間バッファをプールに戻す ---
+	stagingPool.Update(fence->GetCompletedValue());
+
 	// --- FPS固定 ---
 	UpdateFixFPS();
 
@@ -371,6 +374,9 @@ void DirectXCommon::PostDraw()
 	// --- コマンドリストのリセット ---
 	hr = commandList->Reset(commandAllocator.Get(), nullptr);
 	assert(SUCCEEDED(hr));
+
+	// --- リセットで状態が消えるので保持している状態も破棄 ---
+	commandContext.EndFrame();
 }
 
 Microsoft::WRL::ComPtr<ID3D12DescriptorHeap> DirectXCommon::CreateDescriptorHeap(Microsoft::WRL::ComPtr<ID3D12Device> device, D3D12_DESCRIPTOR_HEAP_TYPE heapType, UINT numDescriptors, bool shaderVisible)
@@ -450,59 +456,10 @@ Microsoft::WRL::ComPtr<ID3D12Resource> DirectXCommon::CreateDepthStencilTextureR
 
 IDxcBlob* DirectXCommon::CompileShader(const std::wstring& filePath, const wchar_t* profile)
 {
-	// これからシェーダーをコンパイルする旨をログにだす
-	Logger::Log(StringUtility::ConvertString(std::format(L"Begin CompileShader, path:{}, profile{}\n", filePath, profile)));
-	// hlslファイルを読む
-	IDxcBlobEncoding* shaderSource = nullptr;
-	HRESULT hr = dxcUtils->LoadFile(filePath.c_str(), nullptr, &shaderSource);
-	assert(SUCCEEDED(hr));
-	// 読み込んだファイル内容を設定
-	DxcBuffer shaderSourceBuffer;
-	shaderSourceBuffer.Ptr = shaderSource->GetBufferPointer();
-	shaderSourceBuffer.Size = shaderSource->GetBufferSize();
-	shaderSourceBuffer.Encoding = DXC_CP_UTF8; // UTF8の文字コードであることを通知
-
-	LPCWSTR arguments[] = {
-		filePath.c_str(),	// コンパイル対象のhlslファイル名
-		L"-E",
-		L"main",			// エントリーポイントの指定
-		L"-T",
-		profile,			// ShaderProfileの設定
-		L"-Zi",
-		L"-Qembed_debug",	// デバッグ用の情報を埋め込む
-		L"-Od",				// 最適化を外す
-		L"-Zpr",			// メモリレイアウトは行優先
-	};
-	// Shaderをコンパイルする
-	IDxcResult* shaderResult = nullptr;
-	hr = dxcCompiler->Compile(
-		&shaderSourceBuffer,        // 読み込んだファイル
-		arguments,                  // コンパイルオプション
-		_countof(arguments),        // コンパイルオプションの数
-		includeHandler,             // includeが含まれた諸々
-		IID_PPV_ARGS(&shaderResult) // コンパイル結果
-	);
-	assert(SUCCEEDED(hr));
-
-	// 警告・エラーがでていたらログに出してとめる
-	IDxcBlobUtf8* shaderError = nullptr;
-	shaderResult->GetOutput(DXC_OUT_ERRORS, IID_PPV_ARGS(&shaderError), nullptr);
-	if (shaderError != nullptr && shaderError->GetStringLength() != 0) {
-		Logger::Log(shaderError->GetStringPointer());
-		assert(false);
-	}
-
-	// コンパイル結果から実行用のバイナリ部分を取得
-	IDxcBlob* shaderBlob = nullptr;
-	hr = shaderResult->GetOutput(DXC_OUT_OBJECT, IID_PPV_ARGS(&shaderBlob), nullptr);
-	assert(SUCCEEDED(hr));
-	// 成功したログを出す
-	Logger::Log(StringUtility::ConvertString(std::format(L"Compile Succeeded, path:{}, profile{}\n", filePath, profile)));
-	// リソースを解放
-	shaderSource->Release();
-	shaderResult->Release();
+	// コンパイルサービスに登録して結果を待つ
+	Microsoft::WRL::ComPtr<IDxcBlob> shaderBlob = ShaderCompiler::GetInstance()->Compile(filePath, profile).get();
 	// 実行用のバイナリを返却
-	return shaderBlob;
+	return shaderBlob.Detach();
 }
 
 Microsoft::WRL::ComPtr<ID3D12Resource> DirectXCommon::CreateBufferResource(size_t sizeInBytes)
@@ -526,18 +483,20 @@ Microsoft::WRL::ComPtr<ID3D12Resource> DirectXCommon::CreateBufferResource(size_
 	Microsoft::WRL::ComPtr<ID3D12Resource> resource = nullptr;
 	HRESULT hr = device_->CreateCommittedResource(&uploadHeapProperties, D3D12_HEAP_FLAG_NONE, &resourceDesc, D3D12_RESOURCE_STATE_GENERIC_READ, nullptr, IID_PPV_ARGS(&resource));
 	assert(SUCCEEDED(hr));
+	resourceCreationCount_++;
 
 	return resource;
 }
 
-Microsoft::WRL::ComPtr<ID3D12Resource> DirectXCommon::CreateTextureResources(const DirectX::TexMetadata& metadata)
+Microsoft::WRL::ComPtr<ID3D12Resource> DirectXCommon::CreateTextureResources(const DirectX::TexMetadata& metadata, D3D12_RESOURCE_STATES initialState)
 {
 	// metadataを基にResourcesの設定
 	D3D12_RESOURCE_DESC resourceDesc{};
 	resourceDesc.Width = UINT(metadata.width);                             // Textureの幅
 	resourceDesc.Height = UINT(metadata.height);                           // Textureの高さ
 	resourceDesc.MipLevels = UINT16(metadata.mipLevels);                   // mipmapの数
-	resourceDesc.DepthOrArraySize = UINT16(metadata.arraySize);            // 奥行き or 配列Textureの配列数
+	resourceDesc.DepthOrArraySize = UINT16(metadata.dimension == DirectX::TEX_DIMENSION_TEXTURE3D
+		? metadata.depth : metadata.arraySize);                            // 奥行き or 配列Textureの配列数
 	resourceDesc.Format = metadata.format;                                 // TextureのFormat
 	resourceDesc.SampleDesc.Count = 1;                                     // サンプリングカウント(1固定)
 	resourceDesc.Dimension = D3D12_RESOURCE_DIMENSION(metadata.dimension); // Textureの次元数
@@ -554,21 +513,27 @@ Microsoft::WRL::ComPtr<ID3D12Resource> DirectXCommon::CreateTextureResources(con
 		&heapProperties,                   // Heapの設定
 		D3D12_HEAP_FLAG_NONE,              // Heapの特殊な設定
 		&resourceDesc,                     // Resource設定
-		D3D12_RESOURCE_STATE_COPY_DEST,    // 初回のResourceState
+		initialState,                      // 初回のResourceState
 		nullptr,                           // Clear最適値
 		IID_PPV_ARGS(&resource)            // 作成するResourceポインタへのポインタ
 	);
 	assert(SUCCEEDED(hr));
+	resourceCreationCount_++;
 
 	return resource;
 }
 
-Microsoft::WRL::ComPtr<ID3D12Resource> DirectXCommon::UploadTextureData(Microsoft::WRL::ComPtr<ID3D12Resource> texture, const DirectX::ScratchImage& mipImages)
+void DirectXCommon::UploadTextureData(Microsoft::WRL::ComPtr<ID3D12Resource> texture, const DirectX::ScratchImage& mipImages)
 {
 	std::vector<D3D12_SUBRESOURCE_DATA>subresources;
 	DirectX::PrepareUpload(device_.Get(), mipImages.GetImages(), mipImages.GetImageCount(), mipImages.GetMetadata(), subresources);
+	UploadTextureData(texture, subresources);
+}
+
+void DirectXCommon::UploadTextureData(Microsoft::WRL::ComPtr<ID3D12Resource> texture, const std::vector<D3D12_SUBRESOURCE_DATA>& subresources)
+{
 	uint64_t intermediateSize = GetRequiredIntermediateSize(texture.Get(), 0, UINT(subresources.size()));
-	Microsoft::WRL::ComPtr<ID3D12Resource> intermediateResource = CreateBufferResource(intermediateSize);
+	Microsoft::WRL::ComPtr<ID3D12Resource> intermediateResource = stagingPool.Acquire(intermediateSize);
 	UpdateSubresources(commandList.Get(), texture.Get(), intermediateResource.Get(), 0, 0, UINT(subresources.size()), subresources.data());
 	// Textureへの転送後は利用できるよう、D3D12_RESOURCE_STATE_COPY_DESTからD3D12_RESOURCE_STATE_GENERIC_READへのResourceStateを変更する
 	D3D12_RESOURCE_BARRIER barrier{};
@@ -579,7 +544,9 @@ Microsoft::WRL::ComPtr<ID3D12Resource> DirectXCommon::UploadTextureData(Microsof
 	barrier.Transition.StateBefore = D3D12_RESOURCE_STATE_COPY_DEST;
 	barrier.Transition.StateAfter = D3D12_RESOURCE_STATE_GENERIC_READ;
 	commandList->ResourceBarrier(1, &barrier);
-	return intermediateResource;
+
+	// --- このフレームのコマンドが終わったら中間バッファを再利用する ---
+	stagingPool.Release(intermediateResource, GetNextFenceValue());
 }
 
 DirectX::ScratchImage DirectXCommon::LoadTexture(const std::string& filePath)
@@ -1,11 +1,15 @@
 #pragma once
 #include <array>
+#include <atomic>
 #include <chrono>
+#include <vector>
 #include <d3d12.h>
 #include <dxgi1_6.h>
 #include <wrl.h>
 #include <dxcapi.h>
 
+#include "CommandContext.h"
+#include "StagingPool.h"
 #include "WinApp.h"
 
 #include "Logger.h"
@@ -54,7 +58,7 @@ public:
 	// DepthStencilTextureResourceの生成
 	Microsoft::WRL::ComPtr<ID3D12Resource> CreateDepthStencilTextureResource(Microsoft::WRL::ComPtr<ID3D12Device> device, int32_t width, int32_t height);
 
-	// シェーダーのコンパイル
+	// シェーダーのコンパイル(完了まで待つ)
 	IDxcBlob* CompileShader(const std::wstring& filePath, const wchar_t* profile);
 
 	// リソース生成関数
@@ -63,10 +67,13 @@ public:
 	// バッファリソースの生成
 	Microsoft::WRL::ComPtr<ID3D12Resource> CreateBufferResource(size_t sizeInBytes);
 	// テクスチャリソースの生成
-	Microsoft::WRL::ComPtr<ID3D12Resource> CreateTextureResources(const DirectX::TexMetadata& metadata);
+	// コピーキューで転送する場合はinitialStateをCOMMONにする
+	Microsoft::WRL::ComPtr<ID3D12Resource> CreateTextureResources(const DirectX::TexMetadata& metadata, D3D12_RESOURCE_STATES initialState = D3D12_RESOURCE_STATE_COPY_DEST);
 	// テクスチャデータの転送
-	[[nodiscard]]
-	Microsoft::WRL::ComPtr<ID3D12Resource> UploadTextureData(Microsoft::WRL::ComPtr<ID3D12Resource> texture, const DirectX::ScratchImage& mipImages);
+	// 今フレームのコマンドリストに積まれ、中間バッファはGPUが使い終わるとステージングプールに戻る
+	void UploadTextureData(Microsoft::WRL::ComPtr<ID3D12Resource> texture, const DirectX::ScratchImage& mipImages);
+	// サブリソースを直接指定して転送(マップしたファイルなどから)
+	void UploadTextureData(Microsoft::WRL::ComPtr<ID3D12Resource> texture, const std::vector<D3D12_SUBRESOURCE_DATA>& subresources);
 
 	// テクスチャファイルの読み込み
 	static DirectX::ScratchImage LoadTexture(const std::string& filePath);
@@ -75,6 +82,18 @@ public:
 	Microsoft::WRL::ComPtr<ID3D12Device> GetDevice()const { return device_; }
 	// commandListを取得
 	Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList>GetCommandList()const { return commandList; }
+	// 冗長な状態設定を省くコマンドコンテキストを取得
+	CommandContext* GetCommandContext() { return &commandContext; }
+	// アップロード用バッファのプールを取得
+	StagingPool* GetStagingPool() { return &stagingPool; }
+
+	// 今記録しているコマンドリストの完了時にシグナルされるフェンス値
+	uint64_t GetNextFenceValue() const { return fenceValue + 1; }
+	// GPUが完了したフェンス値
+	uint64_t GetCompletedFenceValue() const { return fence->GetCompletedValue(); }
+
+	// これまでに生成したバッファ・テクスチャ数(プールで使い回している間は増えないことの確認用)
+	uint64_t GetResourceCreationCount() const { return resourceCreationCount_; }
 
 	// swapChainDescを取得
 	DXGI_SWAP_CHAIN_DESC1 GetSwapChainDesc() { return swapChainDesc; }
@@ -106,6 +125,10 @@ private:
 	Microsoft::WRL::ComPtr<ID3D12CommandAllocator> commandAllocator = nullptr;
 	Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList> commandList = nullptr;
 	Microsoft::WRL::ComPtr<ID3D12CommandQueue> commandQueue = nullptr;
+	// 状態フィルタ付きのコマンド記録
+	CommandContext commandContext;
+	// アップロード用バッファのプール
+	StagingPool stagingPool;
 
 	// スワップチェーン
 	Microsoft::WRL::ComPtr<IDXGISwapChain4> swapChain;
@@ -131,20 +154,18 @@ private:
 
 	// Fence
 	Microsoft::WRL::ComPtr<ID3D12Fence> fence;
-	UINT fenceValue = 0;
+	uint64_t fenceValue = 0;
 	HANDLE fenceEvent;
 
+	// CreateBufferResource・CreateTextureResourcesで作ったリソース数(ワーカーからも呼ばれる)
+	std::atomic<uint64_t> resourceCreationCount_ = 0;
+
 	// ビューポート
 	D3D12_VIEWPORT viewport{};
 
 	// シザー矩形
 	D3D12_RECT scissorRect{};
 
-	// dxcCompiler
-	IDxcUtils* dxcUtils;
-	IDxcCompiler3* dxcCompiler;
-	IDxcIncludeHandler* includeHandler;
-
 	// リソースバリア
 	D3D12_RESOURCE_BARRIER barrier{};
 
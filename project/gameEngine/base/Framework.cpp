@@ -1,8 +1,62 @@
 #include "Framework.h"
 #include <imgui.h>
+#include <shellapi.h>
 
-void Framework::Run()
+#include "AssetPack.h"
+#include "LevelFile.h"
+#include "Logger.h"
+
+Framework::LaunchOptions Framework::ParseCommandLine()
+{
+	LaunchOptions options;
+
+	// 既定のパックは実行ファイルの隣(作業ディレクトリのResourcesとは別に置く)
+	wchar_t modulePath[MAX_PATH] = {};
+	GetModuleFileNameW(nullptr, modulePath, MAX_PATH);
+	options.packPath = std::filesystem::path(modulePath).parent_path() / "Resources.pak";
+
+	// --- オプションの解析 ---
+	int argc = 0;
+	LPWSTR* argv = CommandLineToArgvW(GetCommandLineW(), &argc);
+	for (int i = 1; argv && i < argc; ++i) {
+		std::wstring argument = argv[i];
+		if (argument != L"-buildpack" && argument != L"-usepack") {
+			continue;
+		}
+		(argument == L"-buildpack" ? options.isBuildPack : options.isPackRequired) = true;
+		// 続けてパスがあればそれを使う
+		if (i + 1 < argc && argv[i + 1][0] != L'-') {
+			options.packPath = argv[++i];
+		}
+	}
+	LocalFree(argv);
+	return options;
+}
+
+bool Framework::BuildAssetPack(const std::filesystem::path& packPath)
 {
+	// --- レベルは実行時にテキストから変換しないので、先にバイナリにしておく ---
+	std::error_code ec;
+	for (const auto& item : std::filesystem::directory_iterator("Resources/levels", ec)) {
+		if (item.path().extension() == ".txt" &&
+			!LevelFile::Convert(item.path(), std::filesystem::path(item.path()).replace_extension(".level"))) {
+			return false;
+		}
+	}
+
+	// --- Resources以下をまとめる ---
+	if (!AssetPack::Build("Resources", packPath, true)) {
+		Logger::Log("Framework: failed to build " + packPath.string() + "\n");
+		return false;
+	}
+	Logger::Log("Framework: built " + packPath.string() + "\n");
+	return true;
+}
+
+void Framework::Run(const LaunchOptions& options)
+{
+	launchOptions_ = options;
+
 	Initialize();
 
 	while (true) {
@@ -38,10 +92,23 @@ void Framework::Initialize()
 	winApp = new WinApp();
 	winApp->Initialize();
 
+	// 仮想ファイルシステム(アセットパックが無ければResources以下のファイルを直接読む)
+	VirtualFileSystem::GetInstance()->Initialize(launchOptions_.packPath, launchOptions_.isPackRequired);
+
 	// DirectX
 	dxCommon = new DirectXCommon();
 	dxCommon->Initialize(winApp);
 
+	// シェーダーの先行コンパイル(以降の初期化と並行してワーカーで進む)
+	ShaderCompiler::GetInstance()->Compile(L"Resources/shaders/Object3d.VS.hlsl", L"vs_6_0");
+	ShaderCompiler::GetInstance()->Compile(L"Resources/shaders/Object3d.PS.hlsl", L"ps_6_0");
+
+	// パイプラインキャッシュ
+	PipelineCache::GetInstance()->Initialize(dxCommon, "pipelineCache/pipeline.bin");
+
+	// コピーキューでのアップロード
+	UploadService::GetInstance()->Initialize(dxCommon);
+
 	// キーボード入力
 	input = Input::GetInstance();
 	input->Initialize(winApp);
@@ -77,10 +144,23 @@ void Framework::Initialize()
 	modelManager = ModelManager::GetInstance();
 	modelManager->Initialize(dxCommon);
 
+	// ホットリロード(アセットパックが無いときだけResources以下を監視)
+	HotReloader::GetInstance()->Initialize("Resources");
+
 }
 
 void Framework::Update()
 {
+	// 保存されたアセットの再読み込みを開始し、準備のできたものを差し替える
+	// (前フレームのGPU処理は終わっているので、ここでリソースを入れ替えてよい)
+	HotReloader::GetInstance()->Update();
+	object3dCommon->Update();
+	spriteCommon->Update();
+	modelManager->Update();
+
+	// テクスチャストリーミングの更新(前フレームの描画で要求されたミップを読み込む)
+	textureManager->Update();
+
 	// シーンマネージャの更新
 	sceneManager_->Update();
 
@@ -90,6 +170,9 @@ void Framework::Update()
 
 void Framework::Finalize()
 {
+	// 監視スレッドを先に止める
+	HotReloader::GetInstance()->Finalize();
+
 	winApp->Finalize();
 	delete winApp;
 	winApp = nullptr;
@@ -103,9 +186,14 @@ void Framework::Finalize()
 
 	audio->Finalize();
 	spriteCommon->Finalize();
+	// モデルはテクスチャの参照を持つので先に解放
+	modelManager->Finalize();
 	textureManager->Finalize();
 	object3dCommon->Finalize();
-	modelManager->Finalize();
+	ShaderCompiler::GetInstance()->Finalize();
+	PipelineCache::GetInstance()->Finalize();
+	UploadService::GetInstance()->Finalize();
+	VirtualFileSystem::GetInstance()->Finalize();
 
 	imGuiManager->Finalize();
 	delete imGuiManager;
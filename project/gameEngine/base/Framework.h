@@ -1,31 +1,52 @@
 #pragma once
 #include <Windows.h>
+#include <filesystem>
 #include <Audio.h>
 #include <Camera.h>
 #include <CameraManager.h>
 #include <D3DResourceLeakChecker.h>
 #include <DirectXCommon.h>
+#include <HotReloader.h>
 #include <ImGuiManager.h>
 #include <Input.h>
 #include <Model.h>
 #include <ModelCommon.h>
 #include <ModelManager.h>
 #include <Object3dCommon.h>
+#include <PipelineCache.h>
 #include <SceneFactory.h>
 #include <SceneManager.h>
+#include <ShaderCompiler.h>
 #include <SpriteCommon.h>
 #include <SrvManager.h>
 #include <TextureManager.h>
+#include <UploadService.h>
+#include <VirtualFileSystem.h>
 #include <WinApp.h>
 
 // フレームワーク
 class Framework
 {
+public:
+	// 起動オプション
+	struct LaunchOptions {
+		std::filesystem::path packPath;	// アセットパック(既定は実行ファイルと同じフォルダのResources.pak)
+		bool isPackRequired = false;	// -usepack [パス] : パックだけから読み込む(無ければ起動しない)
+		bool isBuildPack = false;		// -buildpack [パス] : パックを作って終了する
+	};
+
+	// コマンドラインの解析
+	static LaunchOptions ParseCommandLine();
+
+	// Resources以下をアセットパックにまとめる(レベルのテキストは先にバイナリにする)
+	// ウィンドウ・デバイスは使わないので、リリースビルドのビルド後イベントから呼べる
+	static bool BuildAssetPack(const std::filesystem::path& packPath);
+
 public:
 	virtual ~Framework() = default;
 
 	// 実行
-	void Run();
+	void Run(const LaunchOptions& options);
 
 
 	// 初期化
@@ -44,6 +65,9 @@ public:
 	virtual bool IsEndRequest() { return winApp->ProcessMessage(); }
 
 protected:
+	// 起動オプション
+	LaunchOptions launchOptions_;
+
 	// 汎用性の高いシステム
 	WinApp* winApp = nullptr;					// WindowsAPI
 	DirectXCommon* dxCommon = nullptr;			// DirectX
@@ -0,0 +1,92 @@
+#include "HotReloader.h"
+#include <algorithm>
+#include <cctype>
+#include <string>
+
+#include "Logger.h"
+#include "ModelManager.h"
+#include "Object3dCommon.h"
+#include "ShaderCompiler.h"
+#include "SpriteCommon.h"
+#include "TextureManager.h"
+#include "VirtualFileSystem.h"
+
+HotReloader* HotReloader::instance = nullptr;
+
+HotReloader* HotReloader::GetInstance()
+{
+	if (instance == nullptr) {
+		instance = new HotReloader;
+	}
+	return instance;
+}
+
+void HotReloader::Finalize()
+{
+	// 監視スレッドを止めてから破棄
+	fileWatcher_.Stop();
+
+	delete instance;
+	instance = nullptr;
+}
+
+void HotReloader::Initialize(const std::filesystem::path& directory)
+{
+	// --- パックの中身は書き換わらないので監視しない ---
+	if (VirtualFileSystem::GetInstance()->IsPackMounted()) {
+		return;
+	}
+
+	if (!fileWatcher_.Start(directory)) {
+		Logger::Log("HotReloader: failed to watch " + directory.string() + "\n");
+	}
+}
+
+void HotReloader::Update()
+{
+	if (!fileWatcher_.IsWatching()) {
+		return;
+	}
+
+	// --- 変更の落ち着いたファイルを振り分ける ---
+	bool isShaderChanged = false;
+	for (const std::filesystem::path& filePath : fileWatcher_.PollChanges()) {
+		std::string extension = filePath.extension().string();
+		std::transform(extension.begin(), extension.end(), extension.begin(),
+			[](unsigned char c) { return char(std::tolower(c)); });
+
+		if (extension == ".hlsl" || extension == ".hlsli") {
+			// 同じフレームで複数保存されても再コンパイルは1回にまとめる
+			ShaderCompiler::GetInstance()->Invalidate(filePath);
+			isShaderChanged = true;
+		}
+		else if (!Dispatch(filePath, extension)) {
+			continue;
+		}
+		reloadCount_++;
+		Logger::Log("HotReloader: " + filePath.generic_string() + "\n");
+	}
+
+	// --- シェーダーを使っているパイプラインを作り直す ---
+	if (isShaderChanged) {
+		Object3dCommon::GetInstance()->ReloadShaders();
+		SpriteCommon::GetInstance()->ReloadShaders();
+	}
+}
+
+bool HotReloader::Dispatch(const std::filesystem::path& filePath, const std::string& extension)
+{
+	// --- テクスチャ ---
+	if (extension == ".png" || extension == ".jpg" || extension == ".jpeg" || extension == ".bmp" ||
+		extension == ".tga" || extension == ".hdr" || extension == ".dds") {
+		TextureManager::GetInstance()->ReloadTexture(filePath.generic_string());
+		return true;
+	}
+
+	// --- モデル ---
+	if (extension == ".obj" || extension == ".mtl") {
+		ModelManager::GetInstance()->ReloadModel(filePath.generic_string());
+		return true;
+	}
+	return false;
+}
@@ -0,0 +1,50 @@
+#pragma once
+#include <filesystem>
+#include <string>
+
+#include "FileWatcher.h"
+
+// ホットリロード
+// 監視ディレクトリ以下で保存されたアセットを種類ごとのマネージャーに渡して再読み込みさせる
+// アセットパックから読んでいるとき(配布版)は監視しない
+class HotReloader
+{
+#pragma region シングルトンインスタンス
+private:
+	static HotReloader* instance;
+
+	HotReloader() = default;
+	~HotReloader() = default;
+	HotReloader(HotReloader&) = delete;
+	HotReloader& operator=(HotReloader&) = delete;
+
+public:
+	// シングルトンインスタンスの取得
+	static HotReloader* GetInstance();
+	// 終了
+	void Finalize();
+#pragma endregion シングルトンインスタンス
+
+public:
+	// 初期化(監視を開始する)
+	void Initialize(const std::filesystem::path& directory);
+
+	// 変更されたアセットの再読み込みを開始する
+	// 差し替えは各マネージャーのUpdateで、GPUが前フレームを終えた後に行われる
+	void Update();
+
+public:
+	// 監視中か
+	bool IsEnabled() const { return fileWatcher_.IsWatching(); }
+
+	// 再読み込みを開始したファイル数
+	uint32_t GetReloadCount() const { return reloadCount_; }
+
+private:
+	// シェーダー以外の変更を振り分ける(extensionは小文字。再読み込み対象ならtrue)
+	bool Dispatch(const std::filesystem::path& filePath, const std::string& extension);
+
+private:
+	FileWatcher fileWatcher_;
+	uint32_t reloadCount_ = 0;
+};
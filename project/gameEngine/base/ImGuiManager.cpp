@@ -71,4 +71,6 @@ void ImGuiManager::Draw()
 	commandList->SetDescriptorHeaps(_countof(ppHeaps), ppHeaps);
 	// 描画コマンドを発行
 	ImGui_ImplDX12_RenderDrawData(ImGui::GetDrawData(), commandList);
+	// コマンドリストへ直接積んだので保持している状態を破棄
+	dxCommon_->GetCommandContext()->Invalidate();
 }
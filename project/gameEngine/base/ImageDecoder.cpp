@@ -0,0 +1,150 @@
+#include "ImageDecoder.h"
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "PngDecoder.h"
+#include "VirtualFileSystem.h"
+
+namespace
+{
+	// 拡張子を小文字で取得
+	std::string ToLowerExtension(const std::filesystem::path& extension)
+	{
+		std::string result = extension.string();
+		std::transform(result.begin(), result.end(), result.begin(), [](unsigned char c) { return char(std::tolower(c)); });
+		return result;
+	}
+
+	// DDSのヘッダサイズ(マジック+DDS_HEADER、DX10拡張ヘッダ付き)
+	const size_t kDDSHeaderSize = 4 + 124;
+	const size_t kDDSHeaderSizeDX10 = kDDSHeaderSize + 20;
+	// DDS_PIXELFORMATのflagsの位置とFourCCのフラグ
+	const size_t kDDSPixelFormatFlagsOffset = 4 + 76;
+	const uint32_t kDDSFourCC = 0x00000004;
+
+	// DDSはヘッダだけ読んで、ピクセルは仮想ファイルシステムからScratchImageに直接読み込む
+	// 変換の要る古い形式などはS_FALSEを返す(呼び出し側で丸ごと読み込む)
+	HRESULT DecodeDDSDirect(const std::filesystem::path& filePath, DirectX::ScratchImage& image)
+	{
+		const VirtualFileSystem* fileSystem = VirtualFileSystem::GetInstance();
+		uint64_t fileSize = 0;
+		if (!fileSystem->GetFileSize(filePath, fileSize) || fileSize < kDDSHeaderSize) {
+			return S_FALSE;
+		}
+
+		// --- ヘッダ ---
+		std::vector<uint8_t> header(size_t(std::min<uint64_t>(fileSize, kDDSHeaderSizeDX10)));
+		if (!fileSystem->Read(filePath, 0, header)) {
+			return S_FALSE;
+		}
+		uint32_t pixelFormatFlags;
+		std::memcpy(&pixelFormatFlags, header.data() + kDDSPixelFormatFlagsOffset, sizeof(pixelFormatFlags));
+		if (!(pixelFormatFlags & kDDSFourCC)) {
+			// ビットマスク指定の形式は読み込み時に変換されることがある
+			return S_FALSE;
+		}
+		DirectX::TexMetadata metadata{};
+		if (FAILED(DirectX::GetMetadataFromDDSMemory(header.data(), header.size(), DirectX::DDS_FLAGS_NONE, metadata))) {
+			return S_FALSE;
+		}
+
+		// --- ヘッダの直後にScratchImageと同じ並びでピクセルが続いている場合だけ直接読む ---
+		HRESULT hr = image.Initialize(metadata);
+		if (FAILED(hr)) {
+			return hr;
+		}
+		uint64_t headerSize = fileSize - std::min<uint64_t>(fileSize, image.GetPixelsSize());
+		if ((headerSize != kDDSHeaderSize && headerSize != kDDSHeaderSizeDX10) ||
+			!fileSystem->Read(filePath, headerSize, { image.GetPixels(), image.GetPixelsSize() })) {
+			image.Release();
+			return S_FALSE;
+		}
+		return S_OK;
+	}
+
+	// スレッドごとのCOMの初期化(スレッドの終了時に解除する)
+	struct ComInitializer {
+		HRESULT hr = CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+		~ComInitializer() {
+			// 既に別のモードで初期化済みのスレッドでは解除しない
+			if (SUCCEEDED(hr)) {
+				CoUninitialize();
+			}
+		}
+	};
+
+	// WICでデコード(呼び出したスレッドで最初の1回だけCOMを初期化する)
+	HRESULT DecodeWIC(std::span<const uint8_t> data, bool isSRGB, DirectX::ScratchImage& image)
+	{
+		static thread_local ComInitializer comInitializer;
+		DirectX::WIC_FLAGS flags = isSRGB ? DirectX::WIC_FLAGS_FORCE_SRGB : DirectX::WIC_FLAGS_IGNORE_SRGB;
+		HRESULT hr = DirectX::LoadFromWICMemory(data.data(), data.size(), flags, nullptr, image);
+		if (FAILED(hr)) {
+			return hr;
+		}
+
+		// --- 16bitなど_SRGB形式の無い整数形式は8bitのsRGBにする(リニアとして扱われないように) ---
+		DXGI_FORMAT format = image.GetMetadata().format;
+		if (isSRGB && DirectX::MakeSRGB(format) == format && !DirectX::IsSRGB(format) &&
+			DirectX::FormatDataType(format) == DirectX::FORMAT_TYPE_UNORM) {
+			DirectX::ScratchImage converted{};
+			// 入出力ともsRGBとして扱い、値は変えずに丸めるだけにする
+			hr = DirectX::Convert(image.GetImages(), image.GetImageCount(), image.GetMetadata(),
+				DXGI_FORMAT_R8G8B8A8_UNORM_SRGB, DirectX::TEX_FILTER_SRGB, DirectX::TEX_THRESHOLD_DEFAULT, converted);
+			if (FAILED(hr)) {
+				return hr;
+			}
+			image = std::move(converted);
+		}
+		return S_OK;
+	}
+}
+
+HRESULT ImageDecoder::DecodeFile(const std::filesystem::path& filePath, bool isSRGB, DirectX::ScratchImage& image)
+{
+	// --- DDSは展開先に直接読み込む ---
+	if (ToLowerExtension(filePath.extension()) == ".dds") {
+		HRESULT hr = DecodeDDSDirect(filePath, image);
+		if (hr != S_FALSE) {
+			return hr;
+		}
+	}
+
+	FileData file = VirtualFileSystem::GetInstance()->Open(filePath);
+	if (!file.IsValid()) {
+		return HRESULT_FROM_WIN32(ERROR_FILE_NOT_FOUND);
+	}
+	return DecodeMemory(file.GetSpan(), filePath.extension(), isSRGB, image);
+}
+
+HRESULT ImageDecoder::DecodeMemory(std::span<const uint8_t> data, const std::filesystem::path& extension, bool isSRGB, DirectX::ScratchImage& image)
+{
+	// --- PNG(インターレースなど未対応のものはWICへ) ---
+	if (PngDecoder::IsPng(data)) {
+		HRESULT hr = PngDecoder::Decode(data, isSRGB, image);
+		if (hr != E_NOTIMPL) {
+			return hr;
+		}
+		return DecodeWIC(data, isSRGB, image);
+	}
+
+	// --- TGA・HDR(シグネチャが無いので拡張子で判定) ---
+	std::string ext = ToLowerExtension(extension);
+	if (ext == ".dds") {
+		return DirectX::LoadFromDDSMemory(data.data(), data.size(), DirectX::DDS_FLAGS_NONE, nullptr, image);
+	}
+	if (ext == ".tga") {
+		DirectX::TGA_FLAGS flags = isSRGB ? DirectX::TGA_FLAGS_FORCE_SRGB : DirectX::TGA_FLAGS_FORCE_LINEAR;
+		return DirectX::LoadFromTGAMemory(data.data(), data.size(), flags, nullptr, image);
+	}
+	if (ext == ".hdr") {
+		// 浮動小数点のリニア値なのでsRGBは関係ない
+		return DirectX::LoadFromHDRMemory(data.data(), data.size(), nullptr, image);
+	}
+
+	// --- その他はWIC ---
+	return DecodeWIC(data, isSRGB, image);
+}
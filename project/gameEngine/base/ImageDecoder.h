@@ -0,0 +1,19 @@
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <span>
+
+#include "../../externals/DirectXTex/DirectXTex.h"
+
+// 画像のデコード
+// PNGは自前のデコーダー、DDS・TGA・HDRはDirectXTexのローダーで展開し、それ以外だけWICに任せる
+// DDSはピクセルをパックからScratchImageへ直接展開する
+// WICを通らない形式は複数スレッドから同時に呼んでもロックを取り合わない
+namespace ImageDecoder
+{
+	// ファイルをデコード(isSRGBならsRGB、falseならリニアとして扱う。仮想ファイルシステムから読む)
+	HRESULT DecodeFile(const std::filesystem::path& filePath, bool isSRGB, DirectX::ScratchImage& image);
+
+	// メモリ上の画像をデコード(形式はシグネチャと拡張子で判定)
+	HRESULT DecodeMemory(std::span<const uint8_t> data, const std::filesystem::path& extension, bool isSRGB, DirectX::ScratchImage& image);
+};
@@ -0,0 +1,173 @@
+#include "PipelineCache.h"
+#include <cassert>
+#include <format>
+#include <fstream>
+
+#include "DirectXCommon.h"
+#include "Hash.h"
+#include "Logger.h"
+
+PipelineCache* PipelineCache::instance = nullptr;
+
+PipelineCache* PipelineCache::GetInstance()
+{
+	if (instance == nullptr) {
+		instance = new PipelineCache;
+	}
+	return instance;
+}
+
+void PipelineCache::Finalize()
+{
+	// --- 新しいPSOがあればライブラリを保存 ---
+	if (library_ && isLibraryDirty_) {
+		std::vector<uint8_t> buffer(library_->GetSerializedSize());
+		HRESULT hr = library_->Serialize(buffer.data(), buffer.size());
+		if (SUCCEEDED(hr)) {
+			std::error_code ec;
+			std::filesystem::create_directories(libraryPath_.parent_path(), ec);
+			std::ofstream file(libraryPath_, std::ios::binary | std::ios::trunc);
+			file.write(reinterpret_cast<const char*>(buffer.data()), std::streamsize(buffer.size()));
+		}
+	}
+
+	delete instance;
+	instance = nullptr;
+}
+
+void PipelineCache::Initialize(DirectXCommon* dxCommon, const std::filesystem::path& libraryPath)
+{
+	// メンバ変数に記録
+	dxCommon_ = dxCommon;
+	libraryPath_ = libraryPath;
+
+	// パイプラインライブラリの読み込み
+	LoadPipelineLibrary();
+}
+
+Microsoft::WRL::ComPtr<ID3D12RootSignature> PipelineCache::GetRootSignature(const D3D12_ROOT_SIGNATURE_DESC& desc)
+{
+	std::vector<uint8_t> description = SerializeRootSignature(desc);
+	uint64_t hash = Hash::Compute(description.data(), description.size());
+
+	std::lock_guard<std::mutex> lock(mutex_);
+
+	// --- 同じ記述があれば再利用 ---
+	if (ID3D12RootSignature* found = Find(rootSignatures_, hash, description)) {
+		statistics_.rootSignatureReused++;
+		return found;
+	}
+
+	// --- シリアライズしてバイナリにする ---
+	Microsoft::WRL::ComPtr<ID3DBlob> signatureBlob;
+	Microsoft::WRL::ComPtr<ID3DBlob> errorBlob;
+	HRESULT hr = D3D12SerializeRootSignature(&desc, D3D_ROOT_SIGNATURE_VERSION_1, &signatureBlob, &errorBlob);
+	if (FAILED(hr)) {
+		Logger::Log(reinterpret_cast<char*>(errorBlob->GetBufferPointer()));
+		assert(false);
+	}
+	// バイナリを元に生成
+	Microsoft::WRL::ComPtr<ID3D12RootSignature> rootSignature;
+	hr = dxCommon_->GetDevice()->CreateRootSignature(0, signatureBlob->GetBufferPointer(), signatureBlob->GetBufferSize(), IID_PPV_ARGS(&rootSignature));
+	assert(SUCCEEDED(hr));
+
+	rootSignatureDescriptions_.emplace(rootSignature.Get(), description);
+	rootSignatures_.emplace(hash, Entry<ID3D12RootSignature>{ std::move(description), rootSignature });
+	statistics_.rootSignatureCreated++;
+	return rootSignature;
+}
+
+Microsoft::WRL::ComPtr<ID3D12PipelineState> PipelineCache::GetGraphicsPipeline(const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc)
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+
+	// キャッシュ外のルートシグネチャは使えない
+	auto rootIt = rootSignatureDescriptions_.find(desc.pRootSignature);
+	assert(rootIt != rootSignatureDescriptions_.end());
+	std::vector<uint8_t> description = SerializeGraphicsPipeline(desc, rootIt->second);
+	uint64_t hash = Hash::Compute(description.data(), description.size());
+
+	// --- 同じ記述があれば再利用 ---
+	if (ID3D12PipelineState* found = Find(pipelines_, hash, description)) {
+		statistics_.pipelineReused++;
+		return found;
+	}
+
+	Microsoft::WRL::ComPtr<ID3D12PipelineState> pipelineState;
+	std::wstring name = std::format(L"{:016x}", hash);
+	HRESULT hr;
+
+	// --- ライブラリにあれば読み込む ---
+	if (library_) {
+		hr = library_->LoadGraphicsPipeline(name.c_str(), &desc, IID_PPV_ARGS(&pipelineState));
+		if (SUCCEEDED(hr)) {
+			statistics_.pipelineLoaded++;
+		}
+	}
+
+	// --- 無ければ生成してライブラリに追加 ---
+	if (!pipelineState) {
+		hr = dxCommon_->GetDevice()->CreateGraphicsPipelineState(&desc, IID_PPV_ARGS(&pipelineState));
+		assert(SUCCEEDED(hr));
+		statistics_.pipelineCreated++;
+
+		if (library_ && SUCCEEDED(library_->StorePipeline(name.c_str(), pipelineState.Get()))) {
+			isLibraryDirty_ = true;
+		}
+	}
+
+	pipelines_.emplace(hash, Entry<ID3D12PipelineState>{ std::move(description), pipelineState });
+	return pipelineState;
+}
+
+template<typename T>
+T* PipelineCache::Find(const std::unordered_multimap<uint64_t, Entry<T>>& entries, uint64_t hash, const std::vector<uint8_t>& description)
+{
+	// ハッシュが同じでも記述が違えば別物
+	auto [begin, end] = entries.equal_range(hash);
+	for (auto it = begin; it != end; ++it) {
+		if (it->second.description == description) {
+			return it->second.object.Get();
+		}
+	}
+	return nullptr;
+}
+
+void PipelineCache::LoadPipelineLibrary()
+{
+	// パイプラインライブラリはID3D12Device1から
+	Microsoft::WRL::ComPtr<ID3D12Device1> device1;
+	if (FAILED(dxCommon_->GetDevice().As(&device1))) {
+		Logger::Log("PipelineCache: ID3D12Device1 not supported, pipeline library disabled\n");
+		return;
+	}
+
+	// --- 保存済みのライブラリを読む ---
+	std::ifstream file(libraryPath_, std::ios::binary | std::ios::ate);
+	// 大きさが取れない・読めなければライブラリ無しとして作り直す
+	if (file.is_open()) {
+		std::streamsize size = file.tellg();
+		if (size > 0) {
+			libraryData_.resize(static_cast<size_t>(size));
+			file.seekg(0, std::ios::beg);
+			if (!file.read(reinterpret_cast<char*>(libraryData_.data()), size)) {
+				libraryData_.clear();
+			}
+		}
+	}
+
+	HRESULT hr = E_FAIL;
+	if (!libraryData_.empty()) {
+		hr = device1->CreatePipelineLibrary(libraryData_.data(), libraryData_.size(), IID_PPV_ARGS(&library_));
+	}
+
+	// --- ドライバ更新などで使えなければ空で作り直す ---
+	if (FAILED(hr)) {
+		libraryData_.clear();
+		hr = device1->CreatePipelineLibrary(nullptr, 0, IID_PPV_ARGS(&library_));
+		if (FAILED(hr)) {
+			library_.Reset();
+			Logger::Log("PipelineCache: failed to create pipeline library\n");
+		}
+	}
+}
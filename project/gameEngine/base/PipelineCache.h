@@ -0,0 +1,98 @@
+#pragma once
+#include <cstdint>
+#include <d3d12.h>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include <wrl.h>
+
+class DirectXCommon;
+
+// パイプラインキャッシュ
+// ルートシグネチャ・PSOを記述内容で重複排除し、PSOはパイプラインライブラリとしてディスクに保存する
+// 記述はバイト列にして保持し、ハッシュが一致したときは中身も比較する
+class PipelineCache
+{
+#pragma region シングルトンインスタンス
+private:
+	static PipelineCache* instance;
+
+	PipelineCache() = default;
+	~PipelineCache() = default;
+	PipelineCache(PipelineCache&) = delete;
+	PipelineCache& operator = (PipelineCache&) = delete;
+
+public:
+	// シングルトンインスタンスの取得
+	static PipelineCache* GetInstance();
+	// 終了(変更があればパイプラインライブラリを保存)
+	void Finalize();
+#pragma endregion シングルトンインスタンス
+
+public:
+	// 初期化
+	void Initialize(DirectXCommon* dxCommon, const std::filesystem::path& libraryPath);
+
+	// ルートシグネチャの取得(同じ記述なら同じオブジェクトを返す)
+	Microsoft::WRL::ComPtr<ID3D12RootSignature> GetRootSignature(const D3D12_ROOT_SIGNATURE_DESC& desc);
+
+	// グラフィックスパイプラインの取得(同じ記述なら同じオブジェクトを返す)
+	// pRootSignatureはこのキャッシュから取得したものであること
+	Microsoft::WRL::ComPtr<ID3D12PipelineState> GetGraphicsPipeline(const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc);
+
+public:
+	// --- 記述のバイト列化(デバイス不要。PipelineCacheDescription.cpp) ---
+	// ルートシグネチャ記述
+	static std::vector<uint8_t> SerializeRootSignature(const D3D12_ROOT_SIGNATURE_DESC& desc);
+	// PSO記述(ルートシグネチャはポインタではなくその記述を含める)
+	static std::vector<uint8_t> SerializeGraphicsPipeline(const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc, const std::vector<uint8_t>& rootSignatureDescription);
+
+public:
+	// 統計
+	struct Statistics {
+		uint32_t rootSignatureCreated = 0;	// 生成したルートシグネチャ数
+		uint32_t rootSignatureReused = 0;	// 重複排除したルートシグネチャ数
+		uint32_t pipelineCreated = 0;		// 生成したPSO数
+		uint32_t pipelineLoaded = 0;		// ライブラリから読み込んだPSO数
+		uint32_t pipelineReused = 0;		// 重複排除したPSO数
+	};
+	const Statistics& GetStatistics() const { return statistics_; }
+
+private:
+	// パイプラインライブラリの読み込み(失敗したら空で作り直す)
+	void LoadPipelineLibrary();
+
+	// 生成済みのオブジェクト(ハッシュの衝突に備えて記述も持つ)
+	template<typename T>
+	struct Entry {
+		std::vector<uint8_t> description;
+		Microsoft::WRL::ComPtr<T> object;
+	};
+
+	// 記述が一致するものを探す(無ければnullptr)
+	template<typename T>
+	static T* Find(const std::unordered_multimap<uint64_t, Entry<T>>& entries, uint64_t hash, const std::vector<uint8_t>& description);
+
+private:
+	DirectXCommon* dxCommon_ = nullptr;
+
+	// --- 重複排除用(キーは記述のハッシュ) ---
+	std::unordered_multimap<uint64_t, Entry<ID3D12RootSignature>> rootSignatures_;
+	std::unordered_multimap<uint64_t, Entry<ID3D12PipelineState>> pipelines_;
+	// ルートシグネチャ→記述
+	std::map<ID3D12RootSignature*, std::vector<uint8_t>> rootSignatureDescriptions_;
+
+	// --- パイプラインライブラリ ---
+	std::filesystem::path libraryPath_;
+	// ライブラリが参照するので破棄まで保持する
+	std::vector<uint8_t> libraryData_;
+	Microsoft::WRL::ComPtr<ID3D12PipelineLibrary> library_;
+	// 保存が必要か
+	bool isLibraryDirty_ = false;
+
+	std::mutex mutex_;
+
+	Statistics statistics_;
+};
@@ -0,0 +1,131 @@
+#include "PipelineCache.h"
+#include <string>
+
+// PipelineCacheの記述のバイト列化(デバイスに触らないのでテストからも使う)
+
+namespace
+{
+	// 記述をバイト列に書き出す
+	struct DescriptionWriter {
+		std::vector<uint8_t> bytes;
+
+		// 値をそのまま書く(パディングを含まない型に限る)
+		template<typename T>
+		void Write(const T& value) { Write(&value, sizeof(T)); }
+		void Write(const void* data, size_t size) {
+			const uint8_t* begin = static_cast<const uint8_t*>(data);
+			bytes.insert(bytes.end(), begin, begin + size);
+		}
+		// 文字列を書く(長さも含める)
+		void WriteString(const std::string& str) {
+			Write(str.size());
+			Write(str.data(), str.size());
+		}
+	};
+}
+
+std::vector<uint8_t> PipelineCache::SerializeRootSignature(const D3D12_ROOT_SIGNATURE_DESC& desc)
+{
+	DescriptionWriter writer;
+	writer.Write(desc.Flags);
+
+	// --- ルートパラメータ ---
+	writer.Write(desc.NumParameters);
+	for (UINT i = 0; i < desc.NumParameters; ++i) {
+		const D3D12_ROOT_PARAMETER& parameter = desc.pParameters[i];
+		writer.Write(parameter.ParameterType);
+		writer.Write(parameter.ShaderVisibility);
+
+		switch (parameter.ParameterType) {
+		case D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE:
+			writer.Write(parameter.DescriptorTable.NumDescriptorRanges);
+			for (UINT j = 0; j < parameter.DescriptorTable.NumDescriptorRanges; ++j) {
+				// D3D12_DESCRIPTOR_RANGEはパディングを含まない
+				writer.Write(parameter.DescriptorTable.pDescriptorRanges[j]);
+			}
+			break;
+		case D3D12_ROOT_PARAMETER_TYPE_32BIT_CONSTANTS:
+			writer.Write(parameter.Constants);
+			break;
+		default:
+			writer.Write(parameter.Descriptor);
+			break;
+		}
+	}
+
+	// --- 静的サンプラー(パディングを含まない) ---
+	writer.Write(desc.NumStaticSamplers);
+	for (UINT i = 0; i < desc.NumStaticSamplers; ++i) {
+		writer.Write(desc.pStaticSamplers[i]);
+	}
+	return std::move(writer.bytes);
+}
+
+std::vector<uint8_t> PipelineCache::SerializeGraphicsPipeline(const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc, const std::vector<uint8_t>& rootSignatureDescription)
+{
+	DescriptionWriter writer;
+	writer.Write(rootSignatureDescription.size());
+	writer.Write(rootSignatureDescription.data(), rootSignatureDescription.size());
+
+	// --- シェーダー(中身で比較) ---
+	for (const D3D12_SHADER_BYTECODE* shader : { &desc.VS, &desc.PS, &desc.DS, &desc.HS, &desc.GS }) {
+		writer.Write(shader->BytecodeLength);
+		writer.Write(shader->pShaderBytecode, shader->BytecodeLength);
+	}
+	writer.Write(desc.StreamOutput.NumEntries);
+
+	// --- BlendState(UINT8を含むので要素ごと) ---
+	writer.Write(desc.BlendState.AlphaToCoverageEnable);
+	writer.Write(desc.BlendState.IndependentBlendEnable);
+	for (const D3D12_RENDER_TARGET_BLEND_DESC& blend : desc.BlendState.RenderTarget) {
+		writer.Write(blend.BlendEnable);
+		writer.Write(blend.LogicOpEnable);
+		writer.Write(blend.SrcBlend);
+		writer.Write(blend.DestBlend);
+		writer.Write(blend.BlendOp);
+		writer.Write(blend.SrcBlendAlpha);
+		writer.Write(blend.DestBlendAlpha);
+		writer.Write(blend.BlendOpAlpha);
+		writer.Write(blend.LogicOp);
+		writer.Write(blend.RenderTargetWriteMask);
+	}
+	writer.Write(desc.SampleMask);
+
+	// --- RasterizerState(パディングを含まない) ---
+	writer.Write(desc.RasterizerState);
+
+	// --- DepthStencilState(UINT8を含むので要素ごと) ---
+	const D3D12_DEPTH_STENCIL_DESC& depthStencil = desc.DepthStencilState;
+	writer.Write(depthStencil.DepthEnable);
+	writer.Write(depthStencil.DepthWriteMask);
+	writer.Write(depthStencil.DepthFunc);
+	writer.Write(depthStencil.StencilEnable);
+	writer.Write(depthStencil.StencilReadMask);
+	writer.Write(depthStencil.StencilWriteMask);
+	writer.Write(depthStencil.FrontFace);
+	writer.Write(depthStencil.BackFace);
+
+	// --- InputLayout(セマンティクス名は文字列で比較) ---
+	writer.Write(desc.InputLayout.NumElements);
+	for (UINT i = 0; i < desc.InputLayout.NumElements; ++i) {
+		const D3D12_INPUT_ELEMENT_DESC& element = desc.InputLayout.pInputElementDescs[i];
+		writer.WriteString(std::string(element.SemanticName));
+		writer.Write(element.SemanticIndex);
+		writer.Write(element.Format);
+		writer.Write(element.InputSlot);
+		writer.Write(element.AlignedByteOffset);
+		writer.Write(element.InputSlotClass);
+		writer.Write(element.InstanceDataStepRate);
+	}
+
+	// --- 出力関連 ---
+	writer.Write(desc.IBStripCutValue);
+	writer.Write(desc.PrimitiveTopologyType);
+	writer.Write(desc.NumRenderTargets);
+	writer.Write(desc.RTVFormats);
+	writer.Write(desc.DSVFormat);
+	writer.Write(desc.SampleDesc);
+	writer.Write(desc.NodeMask);
+	writer.Write(desc.Flags);
+	return std::move(writer.bytes);
+}
@@ -0,0 +1,298 @@
+#include "PngDecoder.h"
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include "Inflate.h"
+#include "PngFilter.h"
+
+namespace
+{
+	// PNGのシグネチャ
+	const uint8_t kSignature[8] = { 0x89, 'P', 'N', 'G', 0x0D, 0x0A, 0x1A, 0x0A };
+
+	// 幅・高さの上限(D3D12のTexture2Dの最大サイズ)
+	const uint32_t kMaxDimension = 16384;
+	// Deflateの最大圧縮率(1バイトから展開される最大バイト数。これ以上は先に確保しない)
+	const size_t kMaxDeflateRatio = 1032;
+
+	// カラータイプ
+	enum ColorType : uint8_t {
+		kGray = 0,
+		kRGB = 2,
+		kPalette = 3,
+		kGrayAlpha = 4,
+		kRGBA = 6,
+	};
+
+	// IHDRの内容
+	struct Header {
+		uint32_t width = 0;
+		uint32_t height = 0;
+		uint8_t bitDepth = 0;
+		uint8_t colorType = 0;
+		uint8_t interlace = 0;
+	};
+
+	// 透過情報(tRNS)
+	struct Transparency {
+		bool hasKey = false;
+		uint16_t key[3] = {};		// グレー・RGBの透過色
+	};
+
+	// ビッグエンディアンの読み込み
+	uint32_t ReadU32(const uint8_t* p)
+	{
+		return (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) | (uint32_t(p[2]) << 8) | uint32_t(p[3]);
+	}
+	uint16_t ReadU16(const uint8_t* p)
+	{
+		return uint16_t((p[0] << 8) | p[1]);
+	}
+
+	// カラータイプごとのチャンネル数(不正なら0)
+	uint32_t GetChannelCount(uint8_t colorType)
+	{
+		switch (colorType) {
+		case kGray: return 1;
+		case kRGB: return 3;
+		case kPalette: return 1;
+		case kGrayAlpha: return 2;
+		case kRGBA: return 4;
+		default: return 0;
+		}
+	}
+
+	// カラータイプとビット深度の組み合わせが正しいか
+	bool IsValidDepth(uint8_t colorType, uint8_t bitDepth)
+	{
+		switch (colorType) {
+		case kGray: return bitDepth == 1 || bitDepth == 2 || bitDepth == 4 || bitDepth == 8 || bitDepth == 16;
+		case kPalette: return bitDepth == 1 || bitDepth == 2 || bitDepth == 4 || bitDepth == 8;
+		default: return bitDepth == 8 || bitDepth == 16;
+		}
+	}
+
+#pragma region RGBAへの展開
+
+	// 8bit以下の行をRGBA8に展開
+	void ExpandRow8(const Header& header, const uint8_t* row, const uint8_t(*palette)[4], const Transparency& transparency, uint8_t* dst)
+	{
+		const uint32_t width = header.width;
+		switch (header.colorType) {
+		case kRGBA:
+			std::memcpy(dst, row, size_t(width) * 4);
+			break;
+		case kRGB:
+			for (uint32_t x = 0; x < width; ++x, row += 3, dst += 4) {
+				dst[0] = row[0];
+				dst[1] = row[1];
+				dst[2] = row[2];
+				bool isKey = transparency.hasKey && row[0] == transparency.key[0] && row[1] == transparency.key[1] && row[2] == transparency.key[2];
+				dst[3] = isKey ? 0 : 255;
+			}
+			break;
+		case kGrayAlpha:
+			for (uint32_t x = 0; x < width; ++x, row += 2, dst += 4) {
+				dst[0] = dst[1] = dst[2] = row[0];
+				dst[3] = row[1];
+			}
+			break;
+		case kGray:
+		case kPalette: {
+			// 1バイトに複数ピクセルが詰まっている場合がある
+			const uint32_t depth = header.bitDepth;
+			const uint32_t mask = (1u << depth) - 1;
+			const uint8_t scale = uint8_t(255 / mask);
+			for (uint32_t x = 0; x < width; ++x, dst += 4) {
+				uint32_t bit = x * depth;
+				uint32_t value = (row[bit / 8] >> (8 - depth - bit % 8)) & mask;
+				if (header.colorType == kPalette) {
+					std::memcpy(dst, palette[value], 4);
+				} else {
+					dst[0] = dst[1] = dst[2] = uint8_t(value * scale);
+					dst[3] = (transparency.hasKey && value == transparency.key[0]) ? 0 : 255;
+				}
+			}
+			break;
+		}
+		default:
+			break;
+		}
+	}
+
+	// 16bitの行をRGBA16に展開
+	void ExpandRow16(const Header& header, const uint8_t* row, const Transparency& transparency, uint16_t* dst)
+	{
+		const uint32_t channels = GetChannelCount(header.colorType);
+		for (uint32_t x = 0; x < header.width; ++x, row += channels * 2, dst += 4) {
+			uint16_t sample[4];
+			for (uint32_t i = 0; i < channels; ++i) {
+				sample[i] = ReadU16(row + i * 2);
+			}
+			switch (header.colorType) {
+			case kRGBA:
+				std::memcpy(dst, sample, sizeof(sample));
+				break;
+			case kRGB: {
+				bool isKey = transparency.hasKey && sample[0] == transparency.key[0] && sample[1] == transparency.key[1] && sample[2] == transparency.key[2];
+				dst[0] = sample[0];
+				dst[1] = sample[1];
+				dst[2] = sample[2];
+				dst[3] = isKey ? 0 : 0xFFFF;
+				break;
+			}
+			case kGrayAlpha:
+				dst[0] = dst[1] = dst[2] = sample[0];
+				dst[3] = sample[1];
+				break;
+			default:
+				dst[0] = dst[1] = dst[2] = sample[0];
+				dst[3] = (transparency.hasKey && sample[0] == transparency.key[0]) ? 0 : 0xFFFF;
+				break;
+			}
+		}
+	}
+
+#pragma endregion RGBAへの展開
+}
+
+bool PngDecoder::IsPng(std::span<const uint8_t> data)
+{
+	return data.size() >= sizeof(kSignature) && std::memcmp(data.data(), kSignature, sizeof(kSignature)) == 0;
+}
+
+HRESULT PngDecoder::Decode(std::span<const uint8_t> data, bool isSRGB, DirectX::ScratchImage& image)
+{
+	const HRESULT kInvalidData = HRESULT_FROM_WIN32(ERROR_INVALID_DATA);
+	if (!IsPng(data)) {
+		return kInvalidData;
+	}
+
+	// --- チャンクの走査(IDATは連結する) ---
+	Header header{};
+	Transparency transparency{};
+	uint8_t palette[256][4] = {};
+	for (auto& entry : palette) {
+		entry[3] = 255;
+	}
+	std::vector<uint8_t> compressed;
+	bool hasHeader = false;
+
+	size_t offset = sizeof(kSignature);
+	while (true) {
+		if (data.size() - offset < 12) {
+			return kInvalidData;
+		}
+		uint32_t length = ReadU32(data.data() + offset);
+		const uint8_t* type = data.data() + offset + 4;
+		const uint8_t* body = data.data() + offset + 8;
+		if (data.size() - offset - 12 < length) {
+			return kInvalidData;
+		}
+		offset += size_t(length) + 12;
+
+		if (std::memcmp(type, "IHDR", 4) == 0) {
+			if (length < 13) {
+				return kInvalidData;
+			}
+			header.width = ReadU32(body);
+			header.height = ReadU32(body + 4);
+			header.bitDepth = body[8];
+			header.colorType = body[9];
+			header.interlace = body[12];
+			// 圧縮方式・フィルタ方式は0のみ
+			if (body[10] != 0 || body[11] != 0) {
+				return kInvalidData;
+			}
+			hasHeader = true;
+		} else if (std::memcmp(type, "PLTE", 4) == 0) {
+			for (uint32_t i = 0; i < std::min<uint32_t>(length / 3, 256); ++i) {
+				std::memcpy(palette[i], body + i * 3, 3);
+			}
+		} else if (std::memcmp(type, "tRNS", 4) == 0) {
+			if (header.colorType == kPalette) {
+				for (uint32_t i = 0; i < std::min<uint32_t>(length, 256); ++i) {
+					palette[i][3] = body[i];
+				}
+			} else if (header.colorType == kGray && length >= 2) {
+				transparency.hasKey = true;
+				transparency.key[0] = ReadU16(body);
+			} else if (header.colorType == kRGB && length >= 6) {
+				transparency.hasKey = true;
+				for (uint32_t i = 0; i < 3; ++i) {
+					transparency.key[i] = ReadU16(body + i * 2);
+				}
+			}
+		} else if (std::memcmp(type, "IDAT", 4) == 0) {
+			compressed.insert(compressed.end(), body, body + length);
+		} else if (std::memcmp(type, "IEND", 4) == 0) {
+			break;
+		}
+	}
+
+	// --- ヘッダの検証 ---
+	// 壊れた・悪意のあるIHDRで巨大な確保をしないように大きさを制限する
+	if (!hasHeader || header.width == 0 || header.height == 0 || !IsValidDepth(header.colorType, header.bitDepth)) {
+		return kInvalidData;
+	}
+	if (header.width > kMaxDimension || header.height > kMaxDimension) {
+		return kInvalidData;
+	}
+	if (header.interlace != 0) {
+		// Adam7はWICに任せる
+		return E_NOTIMPL;
+	}
+
+	// --- 展開 ---
+	const uint32_t channels = GetChannelCount(header.colorType);
+	const size_t bpp = std::max<size_t>(1, channels * header.bitDepth / 8);
+	const size_t stride = (size_t(header.width) * channels * header.bitDepth + 7) / 8;
+	// IHDRから分かる大きさを超えて展開しない(確保も実際のデータで展開できる分まで)
+	const size_t rawSize = (stride + 1) * header.height;
+	std::vector<uint8_t> raw;
+	raw.reserve(std::min(rawSize, compressed.size() * kMaxDeflateRatio));
+	if (!Inflate::DecompressZlib(compressed, raw, rawSize) || raw.size() < rawSize) {
+		return kInvalidData;
+	}
+
+	// --- 出力先(sRGBの16bitはリニアとして扱われてガンマが二重にかかるので8bitにする) ---
+	const bool isOutput16 = header.bitDepth == 16 && !isSRGB;
+	DXGI_FORMAT format;
+	if (isOutput16) {
+		format = DXGI_FORMAT_R16G16B16A16_UNORM;
+	} else {
+		format = isSRGB ? DXGI_FORMAT_R8G8B8A8_UNORM_SRGB : DXGI_FORMAT_R8G8B8A8_UNORM;
+	}
+	HRESULT hr = image.Initialize2D(format, header.width, header.height, 1, 1);
+	if (FAILED(hr)) {
+		return hr;
+	}
+	const DirectX::Image* dstImage = image.GetImage(0, 0, 0);
+
+	// --- 1行ずつフィルタを解除してRGBAにする ---
+	std::vector<uint8_t> zeroRow(stride, 0);
+	const uint8_t* prior = zeroRow.data();
+	// 16bitを8bitに丸めるときの展開先
+	std::vector<uint16_t> row16(header.bitDepth == 16 && !isOutput16 ? size_t(header.width) * 4 : 0);
+	for (uint32_t y = 0; y < header.height; ++y) {
+		uint8_t* row = raw.data() + (stride + 1) * y;
+		if (!PngFilter::UnfilterRow(row[0], row + 1, prior, stride, bpp)) {
+			image.Release();
+			return kInvalidData;
+		}
+		uint8_t* dst = dstImage->pixels + dstImage->rowPitch * y;
+		if (isOutput16) {
+			ExpandRow16(header, row + 1, transparency, reinterpret_cast<uint16_t*>(dst));
+		} else if (header.bitDepth == 16) {
+			ExpandRow16(header, row + 1, transparency, row16.data());
+			for (size_t i = 0; i < row16.size(); ++i) {
+				dst[i] = uint8_t((uint32_t(row16[i]) * 255 + 32767) / 65535);
+			}
+		} else {
+			ExpandRow8(header, row + 1, palette, transparency, dst);
+		}
+		prior = row + 1;
+	}
+	return S_OK;
+}
@@ -0,0 +1,18 @@
+#pragma once
+#include <cstdint>
+#include <span>
+
+#include "../../externals/DirectXTex/DirectXTex.h"
+
+// PNGデコーダー
+// WICを使わずにメモリ上のPNGを展開し、RGBAのScratchImageに直接書き込む(スレッドセーフ)
+namespace PngDecoder
+{
+	// PNGのシグネチャか
+	bool IsPng(std::span<const uint8_t> data);
+
+	// デコード(8bit以下はR8G8B8A8、16bitはR16G16B16A16に展開する)
+	// isSRGBならR8G8B8A8_SRGBにする(16bitの_SRGB形式は無いので、16bitも8bitに丸める)
+	// インターレースには対応しない(E_NOTIMPL)
+	HRESULT Decode(std::span<const uint8_t> data, bool isSRGB, DirectX::ScratchImage& image);
+};
@@ -0,0 +1,202 @@
+#include "PngFilter.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(_M_X64) || defined(__SSE2__)
+#include <emmintrin.h>
+#define PNG_FILTER_SSE2
+#endif
+
+namespace
+{
+	// Paeth予測
+	uint8_t Paeth(int32_t a, int32_t b, int32_t c)
+	{
+		int32_t pa = std::abs(b - c);
+		int32_t pb = std::abs(a - c);
+		int32_t pc = std::abs(a + b - 2 * c);
+		if (pa <= pb && pa <= pc) {
+			return uint8_t(a);
+		}
+		return uint8_t(pb <= pc ? b : c);
+	}
+
+	// スカラー版(start番目以降)
+	void UnfilterScalar(uint8_t filter, uint8_t* row, const uint8_t* prior, size_t stride, size_t bpp, size_t start)
+	{
+		switch (filter) {
+		case 1:
+			for (size_t i = std::max(start, bpp); i < stride; ++i) {
+				row[i] = uint8_t(row[i] + row[i - bpp]);
+			}
+			break;
+		case 2:
+			for (size_t i = start; i < stride; ++i) {
+				row[i] = uint8_t(row[i] + prior[i]);
+			}
+			break;
+		case 3:
+			for (size_t i = start; i < stride; ++i) {
+				uint32_t left = (i >= bpp) ? row[i - bpp] : 0;
+				row[i] = uint8_t(row[i] + ((left + prior[i]) >> 1));
+			}
+			break;
+		case 4:
+			for (size_t i = start; i < stride; ++i) {
+				int32_t left = (i >= bpp) ? row[i - bpp] : 0;
+				int32_t upperLeft = (i >= bpp) ? prior[i - bpp] : 0;
+				row[i] = uint8_t(row[i] + Paeth(left, prior[i], upperLeft));
+			}
+			break;
+		default:
+			break;
+		}
+	}
+
+#ifdef PNG_FILTER_SSE2
+	// 1ピクセル(3or4バイト)の読み書き
+	__m128i LoadPixel(const uint8_t* p, size_t bpp)
+	{
+		uint32_t value = 0;
+		std::memcpy(&value, p, bpp);
+		return _mm_cvtsi32_si128(int32_t(value));
+	}
+	void StorePixel(uint8_t* p, __m128i pixel, size_t bpp)
+	{
+		uint32_t value = uint32_t(_mm_cvtsi128_si32(pixel));
+		std::memcpy(p, &value, bpp);
+	}
+
+	// maskが立っている要素はa、それ以外はb
+	__m128i Select(__m128i mask, __m128i a, __m128i b)
+	{
+		return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+	}
+
+	// 16bit要素の絶対値
+	__m128i Abs16(__m128i x)
+	{
+		return _mm_max_epi16(x, _mm_sub_epi16(_mm_setzero_si128(), x));
+	}
+
+	// Up: 前の行を16バイトずつ足す
+	void UnfilterUp(uint8_t* row, const uint8_t* prior, size_t stride)
+	{
+		size_t i = 0;
+		for (; i + 16 <= stride; i += 16) {
+			__m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + i));
+			__m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(prior + i));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(row + i), _mm_add_epi8(x, b));
+		}
+		UnfilterScalar(2, row, prior, stride, 1, i);
+	}
+
+	// Sub(4バイト/ピクセル): 16バイト内の4ピクセルを累積和にする
+	void UnfilterSub4(uint8_t* row, size_t stride)
+	{
+		__m128i last = _mm_setzero_si128();
+		size_t i = 0;
+		for (; i + 16 <= stride; i += 16) {
+			__m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + i));
+			x = _mm_add_epi8(x, _mm_slli_si128(x, 4));
+			x = _mm_add_epi8(x, _mm_slli_si128(x, 8));
+			x = _mm_add_epi8(x, last);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(row + i), x);
+			// 最後のピクセルを次の4ピクセルに足す
+			last = _mm_shuffle_epi32(x, _MM_SHUFFLE(3, 3, 3, 3));
+		}
+		UnfilterScalar(1, row, nullptr, stride, 4, i);
+	}
+
+	// Average(3or4バイト/ピクセル): ピクセル単位で左と上の平均を足す
+	void UnfilterAverage(uint8_t* row, const uint8_t* prior, size_t stride, size_t bpp)
+	{
+		const __m128i one = _mm_set1_epi8(1);
+		__m128i a = _mm_setzero_si128();
+		for (size_t i = 0; i < stride; i += bpp) {
+			__m128i b = LoadPixel(prior + i, bpp);
+			__m128i x = LoadPixel(row + i, bpp);
+			// avg_epu8は切り上げなので、奇数になる要素は1引いて切り捨てにする
+			__m128i average = _mm_sub_epi8(_mm_avg_epu8(a, b), _mm_and_si128(_mm_xor_si128(a, b), one));
+			a = _mm_add_epi8(x, average);
+			StorePixel(row + i, a, bpp);
+		}
+	}
+
+	// Paeth(3or4バイト/ピクセル): 16bitに広げて3つの候補から選ぶ
+	void UnfilterPaeth(uint8_t* row, const uint8_t* prior, size_t stride, size_t bpp)
+	{
+		const __m128i zero = _mm_setzero_si128();
+		__m128i a = zero;
+		__m128i c = zero;
+		for (size_t i = 0; i < stride; i += bpp) {
+			__m128i b = _mm_unpacklo_epi8(LoadPixel(prior + i, bpp), zero);
+			__m128i x = LoadPixel(row + i, bpp);
+
+			// p = a + b - c に対して |p-a|, |p-b|, |p-c|
+			__m128i pa = _mm_sub_epi16(b, c);
+			__m128i pb = _mm_sub_epi16(a, c);
+			__m128i pc = Abs16(_mm_add_epi16(pa, pb));
+			pa = Abs16(pa);
+			pb = Abs16(pb);
+
+			// 同値ならa→b→cの順に優先
+			__m128i smallest = _mm_min_epi16(pc, _mm_min_epi16(pa, pb));
+			__m128i nearest = Select(_mm_cmpeq_epi16(pb, smallest), b, c);
+			nearest = Select(_mm_cmpeq_epi16(pa, smallest), a, nearest);
+
+			x = _mm_add_epi8(x, _mm_packus_epi16(nearest, nearest));
+			StorePixel(row + i, x, bpp);
+
+			c = b;
+			a = _mm_unpacklo_epi8(x, zero);
+		}
+	}
+#endif
+}
+
+bool PngFilter::UnfilterRow(uint8_t filter, uint8_t* row, const uint8_t* prior, size_t stride, size_t bpp)
+{
+	if (filter > 4) {
+		return false;
+	}
+#ifdef PNG_FILTER_SSE2
+	switch (filter) {
+	case 1:
+		if (bpp == 4) {
+			UnfilterSub4(row, stride);
+			return true;
+		}
+		break;
+	case 2:
+		UnfilterUp(row, prior, stride);
+		return true;
+	case 3:
+		if (bpp == 3 || bpp == 4) {
+			UnfilterAverage(row, prior, stride, bpp);
+			return true;
+		}
+		break;
+	case 4:
+		if (bpp == 3 || bpp == 4) {
+			UnfilterPaeth(row, prior, stride, bpp);
+			return true;
+		}
+		break;
+	default:
+		break;
+	}
+#endif
+	UnfilterScalar(filter, row, prior, stride, bpp, 0);
+	return true;
+}
+
+bool PngFilter::UnfilterRowScalar(uint8_t filter, uint8_t* row, const uint8_t* prior, size_t stride, size_t bpp)
+{
+	if (filter > 4) {
+		return false;
+	}
+	UnfilterScalar(filter, row, prior, stride, bpp, 0);
+	return true;
+}
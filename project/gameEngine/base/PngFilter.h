@@ -0,0 +1,14 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// PNGのフィルタ解除
+// SSE2があればSub(4バイト/ピクセル)・Up・Average・Paeth(3・4バイト/ピクセル)をSIMDで解除する
+namespace PngFilter
+{
+	// 1行分のフィルタを解除(priorは解除済みの前の行。最初の行は0で埋めたもの。filterが不正ならfalse)
+	bool UnfilterRow(uint8_t filter, uint8_t* row, const uint8_t* prior, size_t stride, size_t bpp);
+
+	// スカラー版(SIMD版と結果を比べる用)
+	bool UnfilterRowScalar(uint8_t filter, uint8_t* row, const uint8_t* prior, size_t stride, size_t bpp);
+};
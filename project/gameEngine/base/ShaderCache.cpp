@@ -0,0 +1,132 @@
+#include "ShaderCache.h"
+#include <cassert>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+#include "Hash.h"
+#include "Logger.h"
+
+// キャッシュ形式のバージョン
+const uint32_t ShaderCache::kVersion = 1;
+
+void ShaderCache::Initialize(const std::filesystem::path& cacheDirectory, uint64_t compilerVersion)
+{
+	// メンバ変数に記録
+	cacheDirectory_ = cacheDirectory;
+	compilerVersion_ = compilerVersion;
+
+	// キャッシュディレクトリを作成
+	std::error_code ec;
+	std::filesystem::create_directories(cacheDirectory_, ec);
+}
+
+uint64_t ShaderCache::ComputeKey(const std::filesystem::path& filePath, const std::vector<std::wstring>& arguments) const
+{
+	uint64_t hash = Hash::CombineValue(Hash::kOffsetBasis, kVersion);
+	hash = Hash::CombineValue(hash, compilerVersion_);
+
+	// --- ソースとインクルードの内容 ---
+	std::set<std::filesystem::path> visited;
+	hash = HashSourceRecursive(hash, filePath, visited);
+
+	// --- コンパイル引数(エントリーポイント・プロファイルを含む) ---
+	hash = Hash::CombineValue(hash, arguments.size());
+	for (const std::wstring& argument : arguments) {
+		hash = Hash::CombineString(hash, argument);
+	}
+	return hash;
+}
+
+Microsoft::WRL::ComPtr<IDxcBlob> ShaderCache::Load(IDxcUtils* dxcUtils, uint64_t key) const
+{
+	// --- ファイルを開く ---
+	std::ifstream file(GetCachePath(key), std::ios::binary | std::ios::ate);
+	if (!file.is_open()) {
+		missCount_++;
+		return nullptr;
+	}
+
+	// --- 一度の読み込みで全体を取得 ---
+	std::streamsize size = file.tellg();
+	if (size <= 0) {
+		missCount_++;
+		return nullptr;
+	}
+	file.seekg(0, std::ios::beg);
+	std::vector<char> buffer(static_cast<size_t>(size));
+	if (!file.read(buffer.data(), size)) {
+		missCount_++;
+		return nullptr;
+	}
+
+	// --- Blobとして返す ---
+	Microsoft::WRL::ComPtr<IDxcBlobEncoding> blob;
+	HRESULT hr = dxcUtils->CreateBlob(buffer.data(), UINT32(buffer.size()), DXC_CP_ACP, &blob);
+	assert(SUCCEEDED(hr));
+
+	hitCount_++;
+	return blob;
+}
+
+void ShaderCache::Store(uint64_t key, IDxcBlob* blob) const
+{
+	// 書き込み途中のファイルを読まないように一時ファイルから置き換える
+	std::filesystem::path path = GetCachePath(key);
+	std::filesystem::path tempPath = path;
+	tempPath += ".tmp";
+
+	std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+	if (!file.is_open()) {
+		Logger::Log("ShaderCache: failed to open " + tempPath.string() + "\n");
+		return;
+	}
+	file.write(static_cast<const char*>(blob->GetBufferPointer()), std::streamsize(blob->GetBufferSize()));
+	file.close();
+
+	std::error_code ec;
+	std::filesystem::rename(tempPath, path, ec);
+	if (ec) {
+		std::filesystem::remove(tempPath, ec);
+	}
+}
+
+std::filesystem::path ShaderCache::GetCachePath(uint64_t key) const
+{
+	char filename[32];
+	std::snprintf(filename, sizeof(filename), "%016llx.dxil", static_cast<unsigned long long>(key));
+	return cacheDirectory_ / filename;
+}
+
+uint64_t ShaderCache::HashSourceRecursive(uint64_t hash, const std::filesystem::path& filePath, std::set<std::filesystem::path>& visited)
+{
+	// 同じファイルは一度だけ
+	std::filesystem::path normalPath = filePath.lexically_normal();
+	if (!visited.insert(normalPath).second) {
+		return hash;
+	}
+
+	// --- ファイル内容を混ぜる ---
+	std::ifstream file(normalPath, std::ios::binary);
+	std::string source((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+	hash = Hash::CombineString(hash, normalPath.generic_string());
+	hash = Hash::CombineString(hash, source);
+
+	// --- #include "..." を辿る ---
+	std::istringstream stream(source);
+	std::string line;
+	while (std::getline(stream, line)) {
+		size_t pos = line.find_first_not_of(" \t");
+		if (pos == std::string::npos || line.compare(pos, 8, "#include") != 0) {
+			continue;
+		}
+		size_t begin = line.find('"', pos);
+		size_t end = line.find('"', begin + 1);
+		if (begin == std::string::npos || end == std::string::npos) {
+			continue;
+		}
+		std::filesystem::path includePath = normalPath.parent_path() / line.substr(begin + 1, end - begin - 1);
+		hash = HashSourceRecursive(hash, includePath, visited);
+	}
+	return hash;
+}
@@ -0,0 +1,53 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <set>
+#include <string>
+#include <vector>
+#include <wrl.h>
+#include <dxcapi.h>
+
+// シェーダーバイトコードのディスクキャッシュ
+// ソース・インクルード・コンパイル引数の内容からキーを作り、DXILをファイルに保存する
+class ShaderCache
+{
+public:
+	// キャッシュ形式のバージョン(変えると全て無効になる)
+	static const uint32_t kVersion;
+
+public:
+	// 初期化(compilerVersionはDXCのバージョン。変わると全て無効になる)
+	void Initialize(const std::filesystem::path& cacheDirectory, uint64_t compilerVersion);
+
+	// キャッシュキーの計算(ソースと、そこからインクルードされる全ファイル・引数・コンパイラのバージョンを含む)
+	uint64_t ComputeKey(const std::filesystem::path& filePath, const std::vector<std::wstring>& arguments) const;
+
+	// キャッシュから読み込む(無ければnullptr)
+	Microsoft::WRL::ComPtr<IDxcBlob> Load(IDxcUtils* dxcUtils, uint64_t key) const;
+
+	// キャッシュに保存
+	void Store(uint64_t key, IDxcBlob* blob) const;
+
+public:
+	// キャッシュファイルのパスを取得
+	std::filesystem::path GetCachePath(uint64_t key) const;
+
+	// ヒット・ミス数の取得
+	uint32_t GetHitCount() const { return hitCount_; }
+	uint32_t GetMissCount() const { return missCount_; }
+
+private:
+	// ファイルとインクルード先を再帰的にハッシュへ混ぜる
+	static uint64_t HashSourceRecursive(uint64_t hash, const std::filesystem::path& filePath, std::set<std::filesystem::path>& visited);
+
+private:
+	// キャッシュディレクトリ
+	std::filesystem::path cacheDirectory_;
+	// コンパイラのバージョン
+	uint64_t compilerVersion_ = 0;
+
+	// 統計
+	mutable std::atomic<uint32_t> hitCount_ = 0;
+	mutable std::atomic<uint32_t> missCount_ = 0;
+};
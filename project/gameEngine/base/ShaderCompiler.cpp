@@ -0,0 +1,212 @@
+#include "ShaderCompiler.h"
+#include <cassert>
+#include <filesystem>
+#include <format>
+#include <vector>
+
+#include "Hash.h"
+#include "Logger.h"
+#include "StringUtility.h"
+
+ShaderCompiler* ShaderCompiler::instance = nullptr;
+
+namespace
+{
+	// スレッドごとのDXC
+	struct DxcInstances {
+		Microsoft::WRL::ComPtr<IDxcUtils> dxcUtils;
+		Microsoft::WRL::ComPtr<IDxcCompiler3> dxcCompiler;
+		Microsoft::WRL::ComPtr<IDxcIncludeHandler> includeHandler;
+	};
+	thread_local DxcInstances dxcInstances;
+
+	// 呼び出したスレッドのDXCを取得(初回に生成)
+	DxcInstances& GetDxcInstances()
+	{
+		if (!dxcInstances.dxcCompiler) {
+			HRESULT hr;
+
+			// --- dxcUtils dxcCompiler を生成 ---
+			hr = DxcCreateInstance(CLSID_DxcUtils, IID_PPV_ARGS(&dxcInstances.dxcUtils));
+			assert(SUCCEEDED(hr));
+			hr = DxcCreateInstance(CLSID_DxcCompiler, IID_PPV_ARGS(&dxcInstances.dxcCompiler));
+			assert(SUCCEEDED(hr));
+
+			// --- デフォルトインクルードハンドラの生成 ---
+			hr = dxcInstances.dxcUtils->CreateDefaultIncludeHandler(&dxcInstances.includeHandler);
+			assert(SUCCEEDED(hr));
+		}
+		return dxcInstances;
+	}
+
+	// DXCのバージョン(メジャー・マイナーとコミット)
+	uint64_t GetCompilerVersion()
+	{
+		uint64_t version = 0;
+		Microsoft::WRL::ComPtr<IDxcVersionInfo> versionInfo;
+		if (SUCCEEDED(GetDxcInstances().dxcCompiler.As(&versionInfo))) {
+			uint32_t major = 0, minor = 0;
+			versionInfo->GetVersion(&major, &minor);
+			version = Hash::CombineValue(Hash::CombineValue(Hash::kOffsetBasis, major), minor);
+		}
+		// 同じバージョン番号の別ビルドも区別する
+		Microsoft::WRL::ComPtr<IDxcVersionInfo2> versionInfo2;
+		if (SUCCEEDED(GetDxcInstances().dxcCompiler.As(&versionInfo2))) {
+			uint32_t commitCount = 0;
+			char* commitHash = nullptr;
+			if (SUCCEEDED(versionInfo2->GetCommitInfo(&commitCount, &commitHash))) {
+				version = Hash::CombineValue(version, commitCount);
+				if (commitHash) {
+					version = Hash::CombineString(version, std::string(commitHash));
+					CoTaskMemFree(commitHash);
+				}
+			}
+		}
+		return version;
+	}
+}
+
+ShaderCompiler* ShaderCompiler::GetInstance()
+{
+	if (instance == nullptr) {
+		instance = new ShaderCompiler;
+	}
+	return instance;
+}
+
+void ShaderCompiler::Finalize()
+{
+	// 実行中のコンパイルを待ってから破棄
+	WaitAll();
+
+	delete instance;
+	instance = nullptr;
+}
+
+void ShaderCompiler::Initialize(uint32_t threadCount)
+{
+	// --- ワーカーの生成 ---
+	threadPool_ = std::make_unique<ThreadPool>(threadCount);
+
+	// --- シェーダーキャッシュの初期化 ---
+	shaderCache_.Initialize("shaderCache", GetCompilerVersion());
+}
+
+ShaderCompiler::Result ShaderCompiler::Compile(const std::wstring& filePath, const wchar_t* profile)
+{
+	assert(threadPool_);
+
+	// "./"などの違いで二重にコンパイルしないようにパスを正規化
+	std::wstring normalPath = std::filesystem::path(filePath).lexically_normal().wstring();
+	std::wstring profileName = profile;
+	std::wstring key = normalPath + L"|" + profileName;
+
+	std::lock_guard<std::mutex> lock(mutex_);
+
+	// --- 登録済みならその結果を返す ---
+	auto it = results_.find(key);
+	if (it != results_.end()) {
+		return it->second;
+	}
+
+	// --- ワーカーに投入 ---
+	Result result = threadPool_->Submit([this, normalPath, profileName]() {
+		return CompileOnThisThread(normalPath, profileName);
+		}).share();
+	results_.emplace(key, result);
+	return result;
+}
+
+void ShaderCompiler::WaitAll()
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	for (auto& [key, result] : results_) {
+		result.wait();
+	}
+}
+
+void ShaderCompiler::Invalidate(const std::filesystem::path& filePath)
+{
+	std::wstring normalPath = filePath.lexically_normal().wstring();
+	bool isInclude = filePath.extension() == L".hlsli";
+
+	std::lock_guard<std::mutex> lock(mutex_);
+	for (auto it = results_.begin(); it != results_.end();) {
+		// キーは"パス|プロファイル"(Windowsのパスなので大文字小文字は区別しない)
+		std::wstring path = it->first.substr(0, it->first.find(L'|'));
+		if (isInclude || _wcsicmp(path.c_str(), normalPath.c_str()) == 0) {
+			it = results_.erase(it);
+		} else {
+			++it;
+		}
+	}
+}
+
+Microsoft::WRL::ComPtr<IDxcBlob> ShaderCompiler::CompileOnThisThread(const std::wstring& filePath, const std::wstring& profile)
+{
+	DxcInstances& dxc = GetDxcInstances();
+
+	LPCWSTR arguments[] = {
+		filePath.c_str(),	// コンパイル対象のhlslファイル名
+		L"-E",
+		L"main",			// エントリーポイントの指定
+		L"-T",
+		profile.c_str(),	// ShaderProfileの設定
+		L"-Zi",
+		L"-Qembed_debug",	// デバッグ用の情報を埋め込む
+		L"-Od",				// 最適化を外す
+		L"-Zpr",			// メモリレイアウトは行優先
+	};
+
+	// --- キャッシュを検索 ---
+	uint64_t cacheKey = shaderCache_.ComputeKey(filePath, std::vector<std::wstring>(std::begin(arguments), std::end(arguments)));
+	Microsoft::WRL::ComPtr<IDxcBlob> cachedBlob = shaderCache_.Load(dxc.dxcUtils.Get(), cacheKey);
+	if (cachedBlob) {
+		// ヒットしたらコンパイラを使わずに返す
+		Logger::Log(StringUtility::ConvertString(std::format(L"Load Shader Cache, path:{}, profile{}\n", filePath, profile)));
+		return cachedBlob;
+	}
+
+	// これからシェーダーをコンパイルする旨をログにだす
+	Logger::Log(StringUtility::ConvertString(std::format(L"Begin CompileShader, path:{}, profile{}\n", filePath, profile)));
+	// hlslファイルを読む
+	Microsoft::WRL::ComPtr<IDxcBlobEncoding> shaderSource;
+	HRESULT hr = dxc.dxcUtils->LoadFile(filePath.c_str(), nullptr, &shaderSource);
+	assert(SUCCEEDED(hr));
+	// 読み込んだファイル内容を設定
+	DxcBuffer shaderSourceBuffer;
+	shaderSourceBuffer.Ptr = shaderSource->GetBufferPointer();
+	shaderSourceBuffer.Size = shaderSource->GetBufferSize();
+	shaderSourceBuffer.Encoding = DXC_CP_UTF8; // UTF8の文字コードであることを通知
+
+	// Shaderをコンパイルする
+	Microsoft::WRL::ComPtr<IDxcResult> shaderResult;
+	hr = dxc.dxcCompiler->Compile(
+		&shaderSourceBuffer,         // 読み込んだファイル
+		arguments,                   // コンパイルオプション
+		_countof(arguments),         // コンパイルオプションの数
+		dxc.includeHandler.Get(),    // includeが含まれた諸々
+		IID_PPV_ARGS(&shaderResult)  // コンパイル結果
+	);
+	assert(SUCCEEDED(hr));
+
+	// 警告・エラーがでていたらログに出してとめる
+	Microsoft::WRL::ComPtr<IDxcBlobUtf8> shaderError;
+	shaderResult->GetOutput(DXC_OUT_ERRORS, IID_PPV_ARGS(&shaderError), nullptr);
+	// 呼び出し側で止める(ホットリロードでは前のシェーダーを使い続ける)
+	if (shaderError != nullptr && shaderError->GetStringLength() != 0) {
+		Logger::Log(shaderError->GetStringPointer());
+		return nullptr;
+	}
+
+	// コンパイル結果から実行用のバイナリ部分を取得
+	Microsoft::WRL::ComPtr<IDxcBlob> shaderBlob;
+	hr = shaderResult->GetOutput(DXC_OUT_OBJECT, IID_PPV_ARGS(&shaderBlob), nullptr);
+	assert(SUCCEEDED(hr));
+	// 成功したログを出す
+	Logger::Log(StringUtility::ConvertString(std::format(L"Compile Succeeded, path:{}, profile{}\n", filePath, profile)));
+	// 次回起動用にキャッシュへ保存
+	shaderCache_.Store(cacheKey, shaderBlob.Get());
+	// 実行用のバイナリを返却
+	return shaderBlob;
+}
@@ -0,0 +1,70 @@
+#pragma once
+#include <filesystem>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <wrl.h>
+#include <dxcapi.h>
+
+#include "ShaderCache.h"
+#include "ThreadPool.h"
+
+// シェーダーコンパイルサービス
+// 登録されたシェーダーをスレッドプールで並列にコンパイルする(DXCはスレッドごとに1つ)
+class ShaderCompiler
+{
+#pragma region シングルトンインスタンス
+private:
+	static ShaderCompiler* instance;
+
+	ShaderCompiler() = default;
+	~ShaderCompiler() = default;
+	ShaderCompiler(ShaderCompiler&) = delete;
+	ShaderCompiler& operator = (ShaderCompiler&) = delete;
+
+public:
+	// シングルトンインスタンスの取得
+	static ShaderCompiler* GetInstance();
+	// 終了
+	void Finalize();
+#pragma endregion シングルトンインスタンス
+
+public:
+	// コンパイル結果
+	using Result = std::shared_future<Microsoft::WRL::ComPtr<IDxcBlob>>;
+
+public:
+	// 初期化(0ならハードウェアスレッド数)
+	void Initialize(uint32_t threadCount = 0);
+
+	// コンパイルの登録(同じシェーダー・プロファイルは1度だけコンパイルされる)
+	Result Compile(const std::wstring& filePath, const wchar_t* profile);
+
+	// 登録済みのコンパイルが全て終わるまで待つ
+	void WaitAll();
+
+	// 登録済みの結果を破棄して、次のCompileでコンパイルし直させる(ホットリロード用)
+	// インクルードファイル(.hlsli)なら全て破棄する
+	void Invalidate(const std::filesystem::path& filePath);
+
+public:
+	// シェーダーキャッシュの取得
+	const ShaderCache& GetShaderCache() const { return shaderCache_; }
+
+private:
+	// 呼び出したスレッドのDXCでコンパイル(エラーならログを出してnullptr)
+	Microsoft::WRL::ComPtr<IDxcBlob> CompileOnThisThread(const std::wstring& filePath, const std::wstring& profile);
+
+private:
+	// ワーカー
+	std::unique_ptr<ThreadPool> threadPool_;
+
+	// シェーダーキャッシュ
+	ShaderCache shaderCache_;
+
+	// 登録済みのコンパイル(パス+プロファイル)
+	std::map<std::wstring, Result> results_;
+	std::mutex mutex_;
+};
@@ -1,5 +1,6 @@
 #include "Windows.h"
 #include "SrvManager.h"
+#include <algorithm>
 
 const uint32_t SrvManager::kMaxSRVCount = 512;
 
@@ -16,6 +17,13 @@ void SrvManager::Initialize(DirectXCommon* dxCommon)
 
 uint32_t SrvManager::Allocate()
 {
+	// 解放された番号があれば再利用
+	if (!freeIndices.empty()) {
+		uint32_t index = freeIndices.back();
+		freeIndices.pop_back();
+		return index;
+	}
+
 	// 上限に達していないかチェックしてassert
 	assert(kMaxSRVCount > useIndex);
 
@@ -29,7 +37,7 @@ uint32_t SrvManager::Allocate()
 
 bool SrvManager::IsAllocate()
 {
-		if (kMaxSRVCount > useIndex) {
+		if (kMaxSRVCount > useIndex || !freeIndices.empty()) {
 			return true;
 		}
 		else {
@@ -37,6 +45,13 @@ bool SrvManager::IsAllocate()
 		}
 }
 
+void SrvManager::Free(uint32_t srvIndex)
+{
+	assert(srvIndex < useIndex);
+	assert(std::find(freeIndices.begin(), freeIndices.end(), srvIndex) == freeIndices.end());
+	freeIndices.push_back(srvIndex);
+}
+
 void SrvManager::CreateSRVforTexture2D(uint32_t srvIndex, ID3D12Resource* pResource, DXGI_FORMAT Format, UINT MipLevels)
 {
 	D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc{};
@@ -51,6 +66,49 @@ void SrvManager::CreateSRVforTexture2D(uint32_t srvIndex, ID3D12Resource* pResou
 
 }
 
+void SrvManager::CreateSRVforTexture(uint32_t srvIndex, ID3D12Resource* pResource, bool isCubeMap)
+{
+	D3D12_RESOURCE_DESC resourceDesc = pResource->GetDesc();
+	D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc{};
+
+	// 各項目を埋める
+	srvDesc.Format = resourceDesc.Format;
+	srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+	UINT mipLevels = resourceDesc.MipLevels;
+	UINT arraySize = resourceDesc.DepthOrArraySize;
+
+	// --- 次元ごとの設定 ---
+	if (resourceDesc.Dimension == D3D12_RESOURCE_DIMENSION_TEXTURE3D) {
+		srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE3D;
+		srvDesc.Texture3D.MipLevels = mipLevels;
+	}
+	else if (resourceDesc.Dimension == D3D12_RESOURCE_DIMENSION_TEXTURE1D) {
+		srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE1DARRAY;
+		srvDesc.Texture1DArray.MipLevels = mipLevels;
+		srvDesc.Texture1DArray.ArraySize = arraySize;
+	}
+	else if (isCubeMap && arraySize == 6) {
+		srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURECUBE;
+		srvDesc.TextureCube.MipLevels = mipLevels;
+	}
+	else if (isCubeMap) {
+		srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURECUBEARRAY;
+		srvDesc.TextureCubeArray.MipLevels = mipLevels;
+		srvDesc.TextureCubeArray.NumCubes = arraySize / 6;
+	}
+	else if (arraySize > 1) {
+		srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2DARRAY;
+		srvDesc.Texture2DArray.MipLevels = mipLevels;
+		srvDesc.Texture2DArray.ArraySize = arraySize;
+	}
+	else {
+		srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
+		srvDesc.Texture2D.MipLevels = mipLevels;
+	}
+
+	dxCommon_->GetDevice()->CreateShaderResourceView(pResource, &srvDesc, GetCPUDescriptorHandle(srvIndex));
+}
+
 void SrvManager::CreateSRVforStructuredBuffer(uint32_t srvIndex, ID3D12Resource* pResource, UINT numElements, UINT structureByteStride)
 {
 	D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc{};
@@ -66,7 +124,7 @@ void SrvManager::PreDraw()
 {
 	// 描画用DescriptorHeapの設定
 	ID3D12DescriptorHeap* descriptorHeaps[] = { descriptorHeap.Get() };
-	dxCommon_->GetCommandList()->SetDescriptorHeaps(1, descriptorHeaps);
+	dxCommon_->GetCommandContext()->SetDescriptorHeaps(1, descriptorHeaps);
 }
 
 D3D12_CPU_DESCRIPTOR_HANDLE SrvManager::GetCPUDescriptorHandle(uint32_t index)
@@ -85,5 +143,5 @@ D3D12_GPU_DESCRIPTOR_HANDLE SrvManager::GetGPUDescriptorHandle(uint32_t index)
 
 void SrvManager::SetGraphicsRootDescriptorTable(UINT RootParameterIndex, uint32_t srvIndex)
 {
-	dxCommon_->GetCommandList()->SetGraphicsRootDescriptorTable(RootParameterIndex, GetGPUDescriptorHandle(srvIndex));
+	dxCommon_->GetCommandContext()->SetGraphicsRootDescriptorTable(RootParameterIndex, GetGPUDescriptorHandle(srvIndex));
 }
@@ -1,5 +1,6 @@
 #pragma once
 #include <DirectXCommon.h>
+#include <vector>
 
 // SRV管理
 class SrvManager
@@ -11,10 +12,14 @@ public:
 	// 確保関数
 	uint32_t Allocate();
 	bool IsAllocate();
+	// 解放関数(GPUが使い終わってから呼ぶこと。番号は次のAllocateで再利用される)
+	void Free(uint32_t srvIndex);
 
 	// SRV生成関数
 	// テクスチャ 用
 	void CreateSRVforTexture2D(uint32_t srvIndex, ID3D12Resource* pResource, DXGI_FORMAT Format, UINT MipLevels);
+	// 配列・キューブ・3Dテクスチャ 用(リソースの次元に合わせる。全ミップを使う)
+	void CreateSRVforTexture(uint32_t srvIndex, ID3D12Resource* pResource, bool isCubeMap);
 	// Structured Buffer 用
 	void CreateSRVforStructuredBuffer(uint32_t srvIndex, ID3D12Resource* pResource, UINT numElements, UINT structureByteStride);
 
@@ -29,6 +34,9 @@ public:
 	// SRVの設定
 	void SetGraphicsRootDescriptorTable(UINT RootParameterIndex, uint32_t srvIndex);
 
+	// 使用中のSRV数
+	uint32_t GetAllocatedCount() const { return useIndex - uint32_t(freeIndices.size()); }
+
 public:
 	// 最大SRV数(最大テクスチャ数)
 	static const uint32_t kMaxSRVCount;
@@ -45,6 +53,8 @@ private:
 	// --- 確保関数 ---
 	// 次に使用するSRVインデックス
 	uint32_t useIndex = 0;
+	// 解放されて再利用できるSRVインデックス
+	std::vector<uint32_t> freeIndices;
 
 };
 
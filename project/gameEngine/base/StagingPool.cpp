@@ -0,0 +1,44 @@
+#include "StagingPool.h"
+#include <cassert>
+
+#include "DirectXCommon.h"
+
+void StagingPool::Initialize(DirectXCommon* dxCommon)
+{
+	// メンバ変数に記録
+	dxCommon_ = dxCommon;
+}
+
+Microsoft::WRL::ComPtr<ID3D12Resource> StagingPool::Acquire(uint64_t size)
+{
+	uint64_t alignedSize = (size + kAlignment - 1) / kAlignment * kAlignment;
+
+	// --- 入る中で最も小さい空きを使う(大きすぎるものは小さな転送に使わない) ---
+	Microsoft::WRL::ComPtr<ID3D12Resource> buffer;
+	if (free_.Take(alignedSize, buffer)) {
+		reusedCount_++;
+		return buffer;
+	}
+
+	// --- 無ければ確保単位に切り上げて生成 ---
+	createdCount_++;
+	return dxCommon_->CreateBufferResource(size_t(alignedSize));
+}
+
+void StagingPool::Release(Microsoft::WRL::ComPtr<ID3D12Resource> buffer, uint64_t fenceValue)
+{
+	assert(buffer);
+	pending_.Push(fenceValue, std::move(buffer));
+}
+
+void StagingPool::Update(uint64_t completedFenceValue)
+{
+	// --- GPUが使い終わったものを空きに戻す ---
+	pending_.Retire(completedFenceValue, [this](Microsoft::WRL::ComPtr<ID3D12Resource> buffer) {
+		uint64_t size = buffer->GetDesc().Width;
+		free_.Add(size, std::move(buffer));
+		});
+
+	// --- 上限を超えた分は大きいものから破棄 ---
+	free_.Trim(maxFreeBytes_);
+}
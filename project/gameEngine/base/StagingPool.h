@@ -0,0 +1,55 @@
+#pragma once
+#include <cstdint>
+#include <d3d12.h>
+#include <wrl.h>
+
+#include "FenceRetireQueue.h"
+#include "SizedFreeList.h"
+
+class DirectXCommon;
+
+// アップロード用バッファのプール
+// コピーに使ったバッファはフェンス値で管理し、GPUが使い終わったら次のアップロードで再利用する
+class StagingPool
+{
+public:
+	// 初期化
+	void Initialize(DirectXCommon* dxCommon);
+
+	// size以上のアップロードバッファを取得(空きが無ければ生成)
+	Microsoft::WRL::ComPtr<ID3D12Resource> Acquire(uint64_t size);
+
+	// fenceValueのコマンドが終わったら再利用できるように返却
+	void Release(Microsoft::WRL::ComPtr<ID3D12Resource> buffer, uint64_t fenceValue);
+
+	// 終わったものを空きに戻し、上限を超えた空きを破棄する
+	void Update(uint64_t completedFenceValue);
+
+public:
+	// 空きとして保持するバイト数の上限
+	void SetMaxFreeBytes(uint64_t maxFreeBytes) { maxFreeBytes_ = maxFreeBytes; }
+
+	// 統計
+	uint64_t GetFreeBytes() const { return free_.GetFreeBytes(); }
+	size_t GetPendingCount() const { return pending_.GetPendingCount(); }
+	uint32_t GetCreatedCount() const { return createdCount_; }
+	uint32_t GetReusedCount() const { return reusedCount_; }
+
+private:
+	// バッファの確保単位(リソースの配置単位に合わせる)
+	static const uint64_t kAlignment = D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT;
+	// 再利用する空きの大きさの上限(要求の何倍まで)
+	static const uint64_t kMaxOversize = 4;
+
+private:
+	DirectXCommon* dxCommon_ = nullptr;
+
+	// GPUが使い終わるのを待っているバッファ
+	FenceRetireQueue<Microsoft::WRL::ComPtr<ID3D12Resource>> pending_;
+	// 空きバッファ(入る中で最も小さいものを再利用)
+	SizedFreeList<Microsoft::WRL::ComPtr<ID3D12Resource>> free_{ kMaxOversize };
+	uint64_t maxFreeBytes_ = 64ull * 1024 * 1024;
+
+	uint32_t createdCount_ = 0;
+	uint32_t reusedCount_ = 0;
+};
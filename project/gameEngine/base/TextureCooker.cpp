@@ -0,0 +1,237 @@
+#include "TextureCooker.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <format>
+
+#include "Hash.h"
+#include "ImageDecoder.h"
+#include "Logger.h"
+#include "MappedFile.h"
+#include "VirtualFileSystem.h"
+
+// キャッシュ形式のバージョン
+const uint32_t TextureCooker::kVersion = 5;
+
+namespace
+{
+	// ログ用の形式名
+	const char* GetFormatName(DXGI_FORMAT format)
+	{
+		switch (format) {
+		case DXGI_FORMAT_BC1_UNORM_SRGB: return "BC1";
+		case DXGI_FORMAT_BC3_UNORM_SRGB: return "BC3";
+		case DXGI_FORMAT_BC7_UNORM_SRGB: return "BC7";
+		default: return "RGBA8";
+		}
+	}
+}
+
+void TextureCooker::Initialize(const std::filesystem::path& cacheDirectory)
+{
+	// メンバ変数に記録
+	cacheDirectory_ = cacheDirectory;
+
+	// キャッシュディレクトリを作成
+	std::error_code ec;
+	std::filesystem::create_directories(cacheDirectory_, ec);
+}
+
+bool TextureCooker::ComputeKey(const std::filesystem::path& sourcePath, uint64_t& key) const
+{
+	// --- 元画像のサイズ・更新日時(中身を読むと読み込みのたびに全体をハッシュすることになる) ---
+	uint64_t stamp = 0;
+	if (!VirtualFileSystem::GetInstance()->GetFileStamp(sourcePath, stamp)) {
+		return false;
+	}
+	uint64_t hash = Hash::CombineValue(Hash::kOffsetBasis, kVersion);
+	hash = Hash::CombineString(hash, AssetPack::NormalizePath(sourcePath));
+	hash = Hash::CombineValue(hash, stamp);
+
+	// --- 圧縮設定 ---
+	hash = Hash::CombineValue(hash, isCompressionEnabled_);
+	hash = Hash::CombineValue(hash, isHighQuality_);
+	key = hash;
+	return true;
+}
+
+bool TextureCooker::Map(uint64_t key, MappedFile& file, DirectX::TexMetadata& metadata) const
+{
+	// --- ファイルをマップ ---
+	if (!file.Open(GetCachePath(key))) {
+		missCount_++;
+		return false;
+	}
+
+	// --- ヘッダだけを読む ---
+	HRESULT hr = DirectX::GetMetadataFromDDSMemory(file.GetData(), file.GetSize(), DirectX::DDS_FLAGS_NONE, metadata);
+	if (FAILED(hr)) {
+		file.Close();
+		missCount_++;
+		return false;
+	}
+
+	hitCount_++;
+	return true;
+}
+
+bool TextureCooker::Cook(const std::filesystem::path& sourcePath, uint64_t key, DirectX::ScratchImage& image, bool isParallel) const
+{
+	// --- 元画像のデコード ---
+	DirectX::ScratchImage sourceImage{};
+	HRESULT hr = ImageDecoder::DecodeFile(sourcePath, true, sourceImage);
+	if (FAILED(hr)) {
+		Logger::Log("TextureCooker: failed to decode " + sourcePath.string() + "\n");
+		return false;
+	}
+
+	// --- 圧縮済み・ミップ付きのDDSはそのままキャッシュにする ---
+	const DirectX::TexMetadata& metadata = sourceImage.GetMetadata();
+	if (DirectX::IsCompressed(metadata.format) || metadata.mipLevels > 1) {
+		image = std::move(sourceImage);
+		return Store(key, image);
+	}
+
+	// --- ミップマップの生成(1x1はそのまま) ---
+	DirectX::ScratchImage mipImages{};
+	if (metadata.width > 1 || metadata.height > 1) {
+		DirectX::TEX_FILTER_FLAGS filter = DirectX::IsSRGB(metadata.format) ? DirectX::TEX_FILTER_SRGB : DirectX::TEX_FILTER_DEFAULT;
+		hr = DirectX::GenerateMipMaps(sourceImage.GetImages(), sourceImage.GetImageCount(), metadata, filter, 0, mipImages);
+		if (FAILED(hr)) {
+			return false;
+		}
+	} else {
+		mipImages = std::move(sourceImage);
+	}
+
+	// --- ブロック圧縮(HDRなど浮動小数点の画像はそのまま) ---
+	bool isFloat = DirectX::FormatDataType(mipImages.GetMetadata().format) == DirectX::FORMAT_TYPE_FLOAT;
+	if (isCompressionEnabled_ && !isFloat && IsCompressible(mipImages.GetMetadata())) {
+		DXGI_FORMAT format = SelectFormat(!mipImages.IsAlphaAllOpaque(), isHighQuality_);
+
+		auto start = std::chrono::steady_clock::now();
+		DirectX::TEX_COMPRESS_FLAGS compressFlags = isParallel ? DirectX::TEX_COMPRESS_PARALLEL : DirectX::TEX_COMPRESS_DEFAULT;
+		hr = DirectX::Compress(mipImages.GetImages(), mipImages.GetImageCount(), mipImages.GetMetadata(), format,
+			compressFlags, DirectX::TEX_THRESHOLD_DEFAULT, image);
+		if (FAILED(hr)) {
+			Logger::Log("TextureCooker: failed to compress " + sourcePath.string() + "\n");
+			return false;
+		}
+		double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+		// --- 品質の記録(最上位ミップのPSNR) ---
+		DirectX::CMSE_FLAGS mseFlags = format == DXGI_FORMAT_BC1_UNORM_SRGB ? DirectX::CMSE_IGNORE_ALPHA : DirectX::CMSE_DEFAULT;
+		float psnr = ComputePSNR(*mipImages.GetImage(0, 0, 0), *image.GetImage(0, 0, 0), mseFlags);
+		double megaPixels = double(metadata.width) * double(metadata.height) / 1000000.0;
+		Logger::Log(std::format("TextureCooker: {} -> {}, PSNR {:.2f}dB, {:.2f}MP/s\n",
+			sourcePath.string(), GetFormatName(format), psnr, megaPixels / std::max(seconds, 1e-6)));
+	} else {
+		image = std::move(mipImages);
+	}
+
+	return Store(key, image);
+}
+
+bool TextureCooker::Store(uint64_t key, const DirectX::ScratchImage& image) const
+{
+	// --- DDSとして保存(書き込み途中のファイルを読まないように一時ファイルから置き換える) ---
+	std::filesystem::path path = GetCachePath(key);
+	std::filesystem::path tempPath = path;
+	tempPath += ".tmp";
+	HRESULT hr = DirectX::SaveToDDSFile(image.GetImages(), image.GetImageCount(), image.GetMetadata(), DirectX::DDS_FLAGS_NONE, tempPath.c_str());
+	if (FAILED(hr)) {
+		// 保存できなくても今回の読み込みには使える
+		Logger::Log("TextureCooker: failed to write " + tempPath.string() + "\n");
+		return true;
+	}
+
+	std::error_code ec;
+	std::filesystem::rename(tempPath, path, ec);
+	if (ec) {
+		std::filesystem::remove(tempPath, ec);
+	}
+	return true;
+}
+
+DXGI_FORMAT TextureCooker::SelectFormat(bool hasAlpha, bool isHighQuality)
+{
+	// 不透明なら4bpp
+	if (!hasAlpha) {
+		return DXGI_FORMAT_BC1_UNORM_SRGB;
+	}
+	// アルファ付きは8bpp
+	return isHighQuality ? DXGI_FORMAT_BC7_UNORM_SRGB : DXGI_FORMAT_BC3_UNORM_SRGB;
+}
+
+bool TextureCooker::IsCompressible(const DirectX::TexMetadata& metadata)
+{
+	return (metadata.width % 4) == 0 && (metadata.height % 4) == 0;
+}
+
+bool TextureCooker::IsStreamable(const DirectX::TexMetadata& metadata)
+{
+	return metadata.dimension == DirectX::TEX_DIMENSION_TEXTURE2D && metadata.arraySize == 1 && metadata.depth == 1;
+}
+
+bool TextureCooker::GetMipSubresources(const MappedFile& file, const DirectX::TexMetadata& metadata, uint32_t firstMip, std::vector<D3D12_SUBRESOURCE_DATA>& subresources)
+{
+	// 配列・キューブ・3Dテクスチャは扱わない
+	if (!IsStreamable(metadata)) {
+		return false;
+	}
+
+	// --- ミップごとのサイズ ---
+	std::vector<D3D12_SUBRESOURCE_DATA> mips(metadata.mipLevels);
+	size_t pixelBytes = 0;
+	for (size_t mip = 0; mip < metadata.mipLevels; ++mip) {
+		size_t rowPitch = 0;
+		size_t slicePitch = 0;
+		HRESULT hr = DirectX::ComputePitch(metadata.format,
+			std::max<size_t>(metadata.width >> mip, 1), std::max<size_t>(metadata.height >> mip, 1), rowPitch, slicePitch);
+		if (FAILED(hr)) {
+			return false;
+		}
+		mips[mip].RowPitch = LONG_PTR(rowPitch);
+		mips[mip].SlicePitch = LONG_PTR(slicePitch);
+		pixelBytes += slicePitch;
+	}
+	if (pixelBytes > file.GetSize()) {
+		return false;
+	}
+
+	// --- ヘッダの後ろにミップが大きい順に並んでいる ---
+	const uint8_t* pixels = file.GetData() + (file.GetSize() - pixelBytes);
+	for (D3D12_SUBRESOURCE_DATA& mip : mips) {
+		mip.pData = pixels;
+		pixels += mip.SlicePitch;
+	}
+
+	subresources.assign(mips.begin() + firstMip, mips.end());
+	return true;
+}
+
+float TextureCooker::ComputePSNR(const DirectX::Image& original, const DirectX::Image& compressed, DirectX::CMSE_FLAGS flags)
+{
+	float mse = 0.0f;
+	HRESULT hr = DirectX::ComputeMSE(original, compressed, mse, nullptr, flags);
+	if (FAILED(hr)) {
+		return 0.0f;
+	}
+	// 完全一致
+	if (mse <= 0.0f) {
+		return INFINITY;
+	}
+	// 値域は0~1なのでピーク値は1
+	return 10.0f * std::log10(1.0f / mse);
+}
+
+bool TextureCooker::IsCooked(uint64_t key) const
+{
+	std::error_code ec;
+	return std::filesystem::exists(GetCachePath(key), ec);
+}
+
+std::filesystem::path TextureCooker::GetCachePath(uint64_t key) const
+{
+	return cacheDirectory_ / std::format("{:016x}.dds", key);
+}
@@ -0,0 +1,88 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <d3d12.h>
+#include <filesystem>
+#include <vector>
+
+#include "MappedFile.h"
+
+#include "../../externals/DirectXTex/DirectXTex.h"
+
+// テクスチャのクック
+// 元画像をデコードしてミップマップ生成・ブロック圧縮まで行ったものをDDSとして保存し、次回からはそれを読み込む
+class TextureCooker
+{
+public:
+	// キャッシュ形式のバージョン(クック設定を変えたら上げる)
+	static const uint32_t kVersion;
+
+public:
+	// 初期化
+	void Initialize(const std::filesystem::path& cacheDirectory);
+
+	// キャッシュキーの計算(元画像のパス・サイズ・更新日時・圧縮設定から)
+	// 元画像は読まないのでメインスレッドから呼んでよい。元画像が無ければfalse
+	bool ComputeKey(const std::filesystem::path& sourcePath, uint64_t& key) const;
+
+	// クック済みのDDSがあるか(統計には数えない)
+	bool IsCooked(uint64_t key) const;
+
+	// クック済みのDDSをマップする(無ければfalse)
+	// ピクセルはコピーせず、マップしたまま参照する
+	bool Map(uint64_t key, MappedFile& file, DirectX::TexMetadata& metadata) const;
+
+	// 元画像をデコード・ミップマップ生成・圧縮してDDSに保存する
+	// 別々のテクスチャなら複数スレッドから同時に呼べる
+	// isParallelなら圧縮を全コアで行う(コアごとのワーカーから呼ぶときはfalseにして、スレッドを増やしすぎない)
+	bool Cook(const std::filesystem::path& sourcePath, uint64_t key, DirectX::ScratchImage& image, bool isParallel) const;
+
+public:
+	// アルファの有無から圧縮形式を選ぶ
+	// 不透明→BC1 / アルファ付き→BC7(高品質) or BC3
+	static DXGI_FORMAT SelectFormat(bool hasAlpha, bool isHighQuality);
+
+	// ブロック圧縮できるサイズか(最上位ミップが4の倍数)
+	static bool IsCompressible(const DirectX::TexMetadata& metadata);
+
+	// ミップ単位でストリーミングできるか(配列でない2Dテクスチャのみ)
+	static bool IsStreamable(const DirectX::TexMetadata& metadata);
+
+	// マップしたDDSのfirstMip以降のサブリソースを取得(ストリーミングできるテクスチャのみ)
+	static bool GetMipSubresources(const MappedFile& file, const DirectX::TexMetadata& metadata, uint32_t firstMip, std::vector<D3D12_SUBRESOURCE_DATA>& subresources);
+
+	// 圧縮前後のPSNR(dB)
+	static float ComputePSNR(const DirectX::Image& original, const DirectX::Image& compressed, DirectX::CMSE_FLAGS flags);
+
+public:
+	// 圧縮設定(falseならアルファ付きはBC3で速くクックする)
+	void SetHighQuality(bool isHighQuality) { isHighQuality_ = isHighQuality; }
+	bool IsHighQuality() const { return isHighQuality_; }
+
+	// 圧縮を行うか(falseなら非圧縮RGBA8のまま)
+	void SetCompressionEnabled(bool isEnabled) { isCompressionEnabled_ = isEnabled; }
+	bool IsCompressionEnabled() const { return isCompressionEnabled_; }
+
+	// キャッシュファイルのパスを取得
+	std::filesystem::path GetCachePath(uint64_t key) const;
+
+	// ヒット・ミス数の取得
+	uint32_t GetHitCount() const { return hitCount_; }
+	uint32_t GetMissCount() const { return missCount_; }
+
+private:
+	// キャッシュに保存(書けなくても今回の読み込みには使えるのでtrue)
+	bool Store(uint64_t key, const DirectX::ScratchImage& image) const;
+
+private:
+	// キャッシュディレクトリ
+	std::filesystem::path cacheDirectory_;
+
+	// 圧縮設定
+	bool isCompressionEnabled_ = true;
+	bool isHighQuality_ = true;
+
+	// 統計
+	mutable std::atomic<uint32_t> hitCount_ = 0;
+	mutable std::atomic<uint32_t> missCount_ = 0;
+};
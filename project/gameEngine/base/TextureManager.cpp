@@ -1,4 +1,10 @@
 #include "TextureManager.h"
+#include <algorithm>
+#include <format>
+#include <future>
+
+#include "AssetPack.h"
+#include "UploadService.h"
 
 TextureManager* TextureManager::instance = nullptr;
 
@@ -15,6 +21,11 @@ TextureManager* TextureManager::GetInstance()
 }
 void TextureManager::Finalize()
 {
+	// --- 残っているテクスチャを報告(ハンドルが残っていればリーク) ---
+	if (textures_.GetLiveCount() != 0) {
+		ReportLiveTextures();
+	}
+
 	delete instance;
 	instance = nullptr;
 }
@@ -25,60 +36,442 @@ void TextureManager::Initialize(DirectXCommon* dxCommon, SrvManager* srvManager)
 	this->dxCommon = dxCommon;
 	this->srvManager = srvManager;
 
-	// SRVの数と同数
-	textureDatas.rehash(kSRVIndexTop < SrvManager::kMaxSRVCount);
+	// テクスチャキャッシュの初期化
+	textureCooker_.Initialize("textureCache");
+	reloadCooker_.Initialize("textureCache");
+	reloadCooker_.SetCompressionEnabled(false);
+
+	// --- クック用のワーカーの生成 ---
+	threadPool_ = std::make_unique<ThreadPool>();
+}
+
+void TextureManager::LoadTextures(const std::vector<std::string>& filePaths)
+{
+	// --- 未読み込みのものだけワーカーでデコード・クック ---
+	std::vector<std::string> unloadedPaths;
+	for (const std::string& filePath : filePaths) {
+		if (textures_.Find(filePath) == AssetRegistry<TextureData>::kInvalidId) {
+			unloadedPaths.push_back(filePath);
+		}
+	}
+	PrepareTextures(unloadedPaths);
+
+	// --- SRVの確保と転送はメインスレッドで(クック済みなのでマップするだけ) ---
+	for (const std::string& filePath : filePaths) {
+		LoadTexture(filePath);
+	}
+}
+
+void TextureManager::PrepareTextures(const std::vector<std::string>& filePaths)
+{
+	// --- 未クックのテクスチャをワーカーでデコード・クック ---
+	std::vector<std::future<bool>> cookResults;
+	for (const std::string& filePath : filePaths) {
+		std::wstring filepathW = ConvertString(filePath);
+		uint64_t cookKey = 0;
+		if (!textureCooker_.ComputeKey(filepathW, cookKey)) {
+			Logger::Log("Error: Texture not found: " + filePath + "\n");
+			continue;
+		}
+		if (textureCooker_.IsCooked(cookKey)) {
+			continue;
+		}
+		// 別のスレッドがクック中のものはその完了を待つ
+		cookResults.push_back(threadPool_->Submit([this, filepathW, cookKey]() {
+			DirectX::ScratchImage image{};
+			return CookOnce(textureCooker_, filepathW, cookKey, image, false);
+			}));
+	}
+	for (std::future<bool>& result : cookResults) {
+		result.wait();
+	}
+}
+
+bool TextureManager::CookOnce(TextureCooker& cooker, const std::wstring& filePath, uint64_t cookKey, DirectX::ScratchImage& image, bool isParallel)
+{
+	// --- 同じキーがクック中なら終わるまで待つ ---
+	std::promise<bool> promise;
+	{
+		std::unique_lock<std::mutex> lock(cookMutex_);
+		auto it = cooks_.find(cookKey);
+		if (it != cooks_.end()) {
+			std::shared_future<bool> cook = it->second;
+			lock.unlock();
+			return cook.get();
+		}
+		cooks_.emplace(cookKey, promise.get_future().share());
+	}
+
+	// --- クックして、待っているスレッドに結果を渡す ---
+	bool isCooked = cooker.Cook(filePath, cookKey, image, isParallel);
+	{
+		std::lock_guard<std::mutex> lock(cookMutex_);
+		cooks_.erase(cookKey);
+	}
+	promise.set_value(isCooked);
+	return isCooked;
 }
 
 void TextureManager::LoadTexture(const std::string& filePath)
 {
 	// --- 読み込み済みテクスチャを検索 ---
-	if (textureDatas.contains(filePath)) {
-		// 読み込み済みなら早期return
+	if (textures_.Find(filePath) != AssetRegistry<TextureData>::kInvalidId) {
+		// 読み込み済み(解放待ちを含む)なら早期return
+		return;
+	}
+
+	// --- 元画像を確認 ---
+	std::wstring filepathW = ConvertString(filePath);
+	uint64_t cookKey = 0;
+	if (!textureCooker_.ComputeKey(filepathW, cookKey)) {
+		Logger::Log("Error: Texture not found: " + filePath + "\n");
+		assert(false);
 		return;
 	}
 
 	// テクスチャ枚数上限チェック
 	assert(srvManager->IsAllocate());
 
-	// --- ファイル読み込み ---
-	DirectX::ScratchImage image{};
-	std::wstring filepathW = ConvertString(filePath);
-	HRESULT hr = DirectX::LoadFromWICFile(filepathW.c_str(), DirectX::WIC_FLAGS_FORCE_SRGB, nullptr, image);
-	assert(SUCCEEDED(hr));
-	DirectX::ScratchImage mipImages{};
-	hr = DirectX::GenerateMipMaps(image.GetImages(), image.GetImageCount(), image.GetMetadata(), DirectX::TEX_FILTER_SRGB, 0, mipImages);
-	assert(SUCCEEDED(hr));
-
 	// --- テクスチャデータを追加 ---
 	// 追加したテクスチャデータの参照を取得
-	TextureData& textureData = textureDatas[filePath];
-
-	// --- テクスチャデータ書き込み ---
-	textureData.metadata = image.GetMetadata();
-	textureData.resource = dxCommon->CreateTextureResources(textureData.metadata);
-	// テクスチャデータをGPUにアップロード
-	textureData.intermediateResource = dxCommon->UploadTextureData(textureData.resource.Get(), image);
+	TextureData& textureData = *textures_.Get(textures_.Add(filePath, std::make_unique<TextureData>()));
+	textureData.filepath = filePath;
 
 	// --- デスクリプタハンドルの計算 ---
 	textureData.srvIndex = srvManager->Allocate();
 	textureData.srvHandleCPU = srvManager->GetCPUDescriptorHandle(textureData.srvIndex);
 	textureData.srvHandleGPU = srvManager->GetGPUDescriptorHandle(textureData.srvIndex);
 
-	// --- SRVの生成 ---
+	// --- クック済みのDDSをマップする(無ければ元画像からクックする。ワーカーがクック中なら待つ) ---
+	if (!textureCooker_.Map(cookKey, textureData.cookedFile, textureData.metadata)) {
+		DirectX::ScratchImage mipImages{};
+		bool isCooked = CookOnce(textureCooker_, filepathW, cookKey, mipImages, true);
+		assert(isCooked);
+
+		// キャッシュに書けなかった場合はストリーミングせずに全ミップを転送
+		if (!textureCooker_.Map(cookKey, textureData.cookedFile, textureData.metadata)) {
+			// 別のスレッドがクックしていたなら画像が手元に無いので自分でクックし直す
+			if (mipImages.GetImageCount() == 0) {
+				isCooked = CookOnce(textureCooker_, filepathW, cookKey, mipImages, true);
+				assert(isCooked && mipImages.GetImageCount() != 0);
+			}
+			UploadWholeTexture(textureData, mipImages);
+			return;
+		}
+	}
+
+	// --- 配列・キューブ・3Dはストリーミングせずに全体を転送 ---
+	if (!TextureCooker::IsStreamable(textureData.metadata)) {
+		DirectX::ScratchImage image{};
+		bool isLoaded = LoadCookedImage(textureData.cookedFile, image);
+		assert(isLoaded);
+		UploadWholeTexture(textureData, image);
+		return;
+	}
+
+	// --- ストリーミングに登録 ---
+	RegisterStreaming(textureData);
+}
+
+TextureManager::Handle TextureManager::AcquireTexture(const std::string& filePath)
+{
+	// 解放待ちなら復活させる
+	LoadTexture(filePath);
+	return Handle(&textures_, textures_.Find(filePath));
+}
+
+void TextureManager::RegisterStreaming(TextureData& textureData)
+{
+	// --- ミップごとのバイト数 ---
+	std::vector<uint64_t> mipSizes(textureData.metadata.mipLevels);
+	for (size_t mip = 0; mip < mipSizes.size(); ++mip) {
+		size_t rowPitch = 0;
+		size_t slicePitch = 0;
+		DirectX::ComputePitch(textureData.metadata.format,
+			std::max<size_t>(textureData.metadata.width >> mip, 1), std::max<size_t>(textureData.metadata.height >> mip, 1), rowPitch, slicePitch);
+		mipSizes[mip] = slicePitch;
+	}
+	uint32_t tailMip = ComputeTailMip(textureData.metadata);
+	textureData.streamId = textureStreamer_.Register(mipSizes, tailMip);
+	if (streamedTextures_.size() <= textureData.streamId) {
+		streamedTextures_.resize(textureData.streamId + 1, nullptr);
+	}
+	streamedTextures_[textureData.streamId] = &textureData;
+
+	// --- 粗いミップだけを転送 ---
+	UpdateResidency(textureData, tailMip);
+}
+
+void TextureManager::ReloadTexture(const std::string& filePath)
+{
+	// --- 同じファイルを指す読み込み済みテクスチャを探す(区切り文字・大文字小文字の違いは無視) ---
+	std::string normalizedPath = AssetPack::NormalizePath(filePath);
+	textures_.ForEach([&](uint32_t, AssetRegistry<TextureData>::Entry& entry) {
+		const std::string& key = entry.name;
+		if (AssetPack::NormalizePath(key) != normalizedPath) {
+			return;
+		}
+
+		// --- ワーカーでクック(メインスレッドは止めない) ---
+		std::wstring filepathW = ConvertString(key);
+		uint64_t cookKey = 0;
+		if (!reloadCooker_.ComputeKey(filepathW, cookKey)) {
+			// 保存途中などで消えていれば次の変更を待つ
+			Logger::Log("Error: Texture not found: " + key + "\n");
+			return;
+		}
+		std::future<bool> result = threadPool_->Submit([this, filepathW, cookKey]() {
+			if (reloadCooker_.IsCooked(cookKey)) {
+				return true;
+			}
+			DirectX::ScratchImage image{};
+			return CookOnce(reloadCooker_, filepathW, cookKey, image, false);
+			});
+		reloads_.push_back({ key, cookKey, std::move(result) });
+		});
+}
+
+void TextureManager::ApplyReload(const Reload& reload)
+{
+	// クック中に解放されていれば何もしない
+	TextureData* texture = textures_.Get(reload.filePath);
+	if (!texture) {
+		return;
+	}
+	TextureData& textureData = *texture;
+
+	// --- 新しいDDSをマップ(書けなかったら前のまま) ---
+	MappedFile cookedFile;
+	DirectX::TexMetadata metadata{};
+	if (!reloadCooker_.Map(reload.cookKey, cookedFile, metadata)) {
+		Logger::Log("Error: Failed to reload texture: " + reload.filePath + "\n");
+		return;
+	}
+
+	// --- 配列・キューブ・3Dは全体を読み込んでおく(前のリソースを外す前に失敗を確かめる) ---
+	bool isStreamable = TextureCooker::IsStreamable(metadata);
+	DirectX::ScratchImage image{};
+	if (!isStreamable && !LoadCookedImage(cookedFile, image)) {
+		Logger::Log("Error: Failed to reload texture: " + reload.filePath + "\n");
+		return;
+	}
+
+	// --- 前のストリーミング登録を外す ---
+	if (textureData.streamId != TextureStreamer::kInvalidId) {
+		textureStreamer_.Unregister(textureData.streamId);
+		streamedTextures_[textureData.streamId] = nullptr;
+		textureData.streamId = TextureStreamer::kInvalidId;
+	}
+	// 前のDDSからの転送は中間バッファへコピー済みなので閉じてよい
+	textureData.cookedFile = std::move(cookedFile);
+	textureData.metadata = metadata;
+
+	// --- ストリーミングしないものは全体を転送し直す ---
+	if (!isStreamable) {
+		UploadWholeTexture(textureData, image);
+		return;
+	}
+
+	// --- 登録し直して粗いミップを転送(描画中のリソースは転送が終わるまで使う) ---
+	RegisterStreaming(textureData);
+}
+
+void TextureManager::UploadWholeTexture(TextureData& textureData, const DirectX::ScratchImage& image)
+{
+	// --- ストリーミング用のファイル・転送中のリソースは使わない ---
+	textureData.cookedFile.Close();
+	if (textureData.pendingResource) {
+		UploadService::GetInstance()->ReleaseAfter(textureData.pendingToken, std::move(textureData.pendingResource));
+	}
+	textureData.pendingResource.Reset();
+	textureData.pendingToken = 0;
+
+	// --- 全サブリソースを転送(前フレームの描画は終わっているので前のリソースはそのまま差し替える) ---
+	textureData.metadata = image.GetMetadata();
+	textureData.resource = dxCommon->CreateTextureResources(textureData.metadata);
+	dxCommon->UploadTextureData(textureData.resource.Get(), image);
+	textureData.uploadToken = 0;
+	textureData.residentMip = 0;
+
+	// --- SRVの生成(次元はリソースに合わせる) ---
+	srvManager->CreateSRVforTexture(textureData.srvIndex, textureData.resource.Get(), textureData.metadata.IsCubemap());
+	D3D12_RESOURCE_DESC desc = textureData.resource->GetDesc();
+	textureData.residentBytes = dxCommon->GetDevice()->GetResourceAllocationInfo(0, 1, &desc).SizeInBytes;
+}
+
+bool TextureManager::LoadCookedImage(const MappedFile& cookedFile, DirectX::ScratchImage& image)
+{
+	HRESULT hr = DirectX::LoadFromDDSMemory(cookedFile.GetData(), cookedFile.GetSize(), DirectX::DDS_FLAGS_NONE, nullptr, image);
+	return SUCCEEDED(hr);
+}
+
+void TextureManager::Update()
+{
+	// --- 参照が無くなりGPUも使い終わったテクスチャを解放 ---
+	textures_.Collect(dxCommon->GetCompletedFenceValue(), [this](uint32_t, TextureData& textureData) {
+		DestroyTexture(textureData);
+		});
+	// このフレームで参照が無くなったものはこのフレームのコマンドが終わってから解放
+	textures_.SetRetireFenceValue(dxCommon->GetNextFenceValue());
+
+	// --- クックの終わった再読み込みを反映 ---
+	for (auto it = reloads_.begin(); it != reloads_.end();) {
+		if (it->result.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+			++it;
+			continue;
+		}
+		if (it->result.get()) {
+			ApplyReload(*it);
+		}
+		else {
+			Logger::Log("Error: Failed to cook texture: " + it->filePath + "\n");
+		}
+		it = reloads_.erase(it);
+	}
+
+	// --- 転送の終わったテクスチャを差し替える(描画中のものは前フレームで使い終わっている) ---
+	for (TextureData* textureData : streamedTextures_) {
+		if (textureData && textureData->pendingResource && UploadService::GetInstance()->IsComplete(textureData->pendingToken)) {
+			SwapPendingResource(*textureData);
+		}
+	}
+
+	// --- 常駐ミップの変わったテクスチャを作り直す ---
+	for (const TextureStreamer::Change& change : textureStreamer_.Update()) {
+		UpdateResidency(*streamedTextures_[change.id], change.residentMip);
+	}
+}
+
+void TextureManager::RequestTextureSize(const std::string& filePath, float screenWidth, float screenHeight)
+{
+	TextureData* textureData = textures_.Get(filePath);
+	if (!textureData || textureData->streamId == TextureStreamer::kInvalidId) {
+		return;
+	}
+	const DirectX::TexMetadata& metadata = textureData->metadata;
+	uint32_t mip = TextureStreamer::ComputeMipForSize(
+		uint32_t(metadata.width), uint32_t(metadata.height), screenWidth, screenHeight, uint32_t(metadata.mipLevels));
+	textureStreamer_.RequestMip(textureData->streamId, mip);
+}
+
+void TextureManager::RequestTextureMip(const std::string& filePath, uint32_t mip)
+{
+	TextureData* textureData = textures_.Get(filePath);
+	if (!textureData || textureData->streamId == TextureStreamer::kInvalidId) {
+		return;
+	}
+	textureStreamer_.RequestMip(textureData->streamId, mip);
+}
+
+void TextureManager::UpdateResidency(TextureData& textureData, uint32_t residentMip)
+{
+	// --- 常駐させるミップのサブリソース(マップしたファイルを直接参照) ---
+	std::vector<D3D12_SUBRESOURCE_DATA> subresources;
+	bool isValid = TextureCooker::GetMipSubresources(textureData.cookedFile, textureData.metadata, residentMip, subresources);
+	assert(isValid);
+
+	// --- residentMipを最上位とするリソースを作る(コピーキューで転送するのでCOMMON状態) ---
+	DirectX::TexMetadata residentMetadata = textureData.metadata;
+	residentMetadata.width = std::max<size_t>(textureData.metadata.width >> residentMip, 1);
+	residentMetadata.height = std::max<size_t>(textureData.metadata.height >> residentMip, 1);
+	residentMetadata.mipLevels = textureData.metadata.mipLevels - residentMip;
+	Microsoft::WRL::ComPtr<ID3D12Resource> resource = dxCommon->CreateTextureResources(residentMetadata, D3D12_RESOURCE_STATE_COMMON);
+	// テクスチャデータをGPUにアップロード
+	UploadService::Token token = UploadService::GetInstance()->UploadTexture(resource, subresources);
+
+	// 転送中の前の要求は不要になったので、転送が終わってから破棄
+	if (textureData.pendingResource) {
+		UploadService::GetInstance()->ReleaseAfter(textureData.pendingToken, std::move(textureData.pendingResource));
+	}
+	textureData.pendingResource = resource;
+	textureData.pendingToken = token;
+	textureData.pendingMip = residentMip;
+
+	// まだ何も無ければすぐに差し替える(初めて描くフレームだけGPUが転送の完了を待つ)
+	if (!textureData.resource) {
+		SwapPendingResource(textureData);
+	}
+}
+
+void TextureManager::SwapPendingResource(TextureData& textureData)
+{
+	// --- 転送したリソースに差し替える ---
+	textureData.resource = std::move(textureData.pendingResource);
+	textureData.pendingResource.Reset();
+	textureData.uploadToken = textureData.pendingToken;
+	textureData.residentMip = textureData.pendingMip;
+
+	// --- SRVを同じ番号に作り直す ---
+	D3D12_RESOURCE_DESC desc = textureData.resource->GetDesc();
 	srvManager->CreateSRVforTexture2D(
 		textureData.srvIndex,                // SRVインデックス
 		textureData.resource.Get(),          // リソース
-		textureData.metadata.format,         // フォーマット
-		UINT(textureData.metadata.mipLevels) // ミップレベル
+		desc.Format,                         // フォーマット
+		UINT(desc.MipLevels)                 // ミップレベル
 	);
+	textureData.residentBytes = dxCommon->GetDevice()->GetResourceAllocationInfo(0, 1, &desc).SizeInBytes;
+}
+
+void TextureManager::DestroyTexture(TextureData& textureData)
+{
+	// --- ストリーミングから外す ---
+	if (textureData.streamId != TextureStreamer::kInvalidId) {
+		textureStreamer_.Unregister(textureData.streamId);
+		streamedTextures_[textureData.streamId] = nullptr;
+		textureData.streamId = TextureStreamer::kInvalidId;
+	}
+
+	// --- コピーキューが書き込み中かもしれないリソースは転送が終わってから破棄 ---
+	if (textureData.pendingResource) {
+		UploadService::GetInstance()->ReleaseAfter(textureData.pendingToken, std::move(textureData.pendingResource));
+	}
+	if (textureData.resource) {
+		UploadService::GetInstance()->ReleaseAfter(textureData.uploadToken, std::move(textureData.resource));
+	}
+
+	// --- SRVの番号を返す(描画での使用はフェンスで終わっている) ---
+	srvManager->Free(textureData.srvIndex);
+}
+
+void TextureManager::ReportLiveTextures() const
+{
+	Logger::Log(textures_.BuildReport("TextureManager", [](const TextureData& textureData) { return textureData.residentBytes; }));
+	Logger::Log(std::format("TextureManager: {} SRVs in use\n", srvManager->GetAllocatedCount()));
+}
+
+uint32_t TextureManager::ComputeTailMip(const DirectX::TexMetadata& metadata)
+{
+	// --- kTailSize以下になる最初のミップ ---
+	uint32_t tailMip = 0;
+	while (tailMip + 1 < metadata.mipLevels &&
+		std::max(metadata.width >> tailMip, metadata.height >> tailMip) > kTailSize) {
+		tailMip++;
+	}
+
+	// --- 圧縮形式は最上位ミップが4の倍数でないとリソースを作れない ---
+	if (DirectX::IsCompressed(metadata.format)) {
+		auto isBlockAligned = [&metadata](uint32_t mip) {
+			return ((metadata.width >> mip) % 4) == 0 && ((metadata.height >> mip) % 4) == 0;
+			};
+		while (tailMip > 0) {
+			bool isAllAligned = true;
+			for (uint32_t mip = 0; mip <= tailMip; ++mip) {
+				isAllAligned = isAllAligned && isBlockAligned(mip);
+			}
+			if (isAllAligned) {
+				break;
+			}
+			tailMip--;
+		}
+	}
+	return tailMip;
 }
 
 uint32_t TextureManager::GetTextureIndexByFilePath(const std::string& filePath)
 {
-	// unordered_mapを使って直接インデックスを取得
-	auto it = textureDatas.find(filePath);
-	if (it != textureDatas.end()) {
-		return it->second.srvIndex;
+	// 登録簿から直接インデックスを取得
+	if (TextureData* textureData = textures_.Get(filePath)) {
+		return textureData->srvIndex;
 	}
 	// なかったらエラーメッセージ
 	Logger::Log("Error: Texture not found for filePath: " + filePath);
@@ -89,32 +482,45 @@ uint32_t TextureManager::GetTextureIndexByFilePath(const std::string& filePath)
 D3D12_GPU_DESCRIPTOR_HANDLE TextureManager::GetSrvHandleGPU(const std::string& filePath)
 {
 	// テクスチャが存在するか確認
-	auto it = textureDatas.find(filePath);
-	if (it == textureDatas.end()) {
+	TextureData* texture = textures_.Get(filePath);
+	if (!texture) {
 		// なかったらエラーメッセージ
 		Logger::Log("Error: Texture not found for filePath: " + filePath);
 		throw std::runtime_error("Texture not found for filePath: " + filePath);
 	}
 
 	// テクスチャデータの参照を取得
-	TextureData& textureData = it->second;
+	TextureData& textureData = *texture;
+
+	// 描画に使うので、転送中ならこのフレームでGPUに完了を待たせる
+	UploadService::GetInstance()->RequireForFrame(textureData.uploadToken);
 
 	// GPUハンドルを返却
 	return textureData.srvHandleGPU;
 }
 
+D3D12_GPU_DESCRIPTOR_HANDLE TextureManager::GetSrvHandleGPU(const Handle& texture)
+{
+	assert(texture);
+	TextureData& textureData = *texture;
+
+	// 描画に使うので、転送中ならこのフレームでGPUに完了を待たせる
+	UploadService::GetInstance()->RequireForFrame(textureData.uploadToken);
+	return textureData.srvHandleGPU;
+}
+
 const DirectX::TexMetadata& TextureManager::GetMetaData(const std::string& filePath)
 {
 	// テクスチャが存在するか確認
-	auto it = textureDatas.find(filePath);
-	if (it == textureDatas.end()) {
+	TextureData* texture = textures_.Get(filePath);
+	if (!texture) {
 		// なかったらエラーメッセージ
 		Logger::Log("Error: Texture not found for filePath: " + filePath);
 		throw std::runtime_error("Texture not found for filePath: " + filePath);
 	}
 
 	// テクスチャデータの参照を取得
-	TextureData& textureData = it->second;
+	TextureData& textureData = *texture;
 
 	// メタデータを返却
 	return textureData.metadata;
@@ -1,11 +1,20 @@
 #pragma once
 #include <d3d12.h>
+#include <future>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
+#include <vector>
 #include <wrl.h>
 
+#include "AssetRegistry.h"
 #include "DirectXCommon.h"
 #include "SrvManager.h"
+#include "MappedFile.h"
+#include "TextureCooker.h"
+#include "TextureStreamer.h"
+#include "ThreadPool.h"
 
 #include "../../externals/DirectXTex/DirectXTex.h"
 
@@ -29,18 +38,77 @@ public:
 	void Finalize();
 #pragma endregion シングルトンインスタンス
 
+public:
+	// テクスチャ1枚分のデータ
+	struct TextureData {
+		std::string filepath;								// 画像ファイルパス
+		DirectX::TexMetadata metadata;						// 画像の幅・高さ
+		Microsoft::WRL::ComPtr<ID3D12Resource> resource;	// テクスチャリソース
+		uint32_t srvIndex;
+		D3D12_CPU_DESCRIPTOR_HANDLE srvHandleCPU;
+		D3D12_GPU_DESCRIPTOR_HANDLE srvHandleGPU;
+
+		// --- ストリーミング ---
+		MappedFile cookedFile;									// クック済みDDS(ミップの読み込み元)
+		uint32_t streamId = TextureStreamer::kInvalidId;		// ストリーミングしないならkInvalidId
+		uint32_t residentMip = 0;								// 常駐している最も細かいミップ
+
+		// --- 転送 ---
+		uint64_t uploadToken = 0;								// 描画しているリソースの転送完了トークン
+		Microsoft::WRL::ComPtr<ID3D12Resource> pendingResource;	// 転送中の差し替え先
+		uint64_t pendingToken = 0;
+		uint32_t pendingMip = 0;
+
+		// --- 統計 ---
+		uint64_t residentBytes = 0;								// VRAM上の大きさ
+	};
+
+	// 参照カウント付きハンドル(最後のハンドルが無くなるとGPUが使い終わってから解放される)
+	using Handle = AssetHandle<TextureData>;
+
 public:
 	// 初期化
 	void Initialize(DirectXCommon* dxCommon, SrvManager* srvManager);
 
-	// テクスチャファイルの読み込み
+	// テクスチャファイルの読み込み(最初は粗いミップだけが常駐する)
 	void LoadTexture(const std::string& filePath);
 
+	// 複数のテクスチャをまとめて読み込み(未クックのものはワーカーで並列にデコード・クックする)
+	void LoadTextures(const std::vector<std::string>& filePaths);
+
+	// デコード・クックだけを先に済ませる(GPUに触らないのでワーカースレッドから呼べる)
+	// 次のLoadTextureではマップして転送するだけになる
+	void PrepareTextures(const std::vector<std::string>& filePaths);
+
+	// 読み込んでハンドルを取得(LoadTextureだけで読み込んだものはハンドルを作るまで解放されない)
+	Handle AcquireTexture(const std::string& filePath);
+
+	// 読み込み済みテクスチャの一覧と使用メモリをログに出す
+	void ReportLiveTextures() const;
+
+	// ストリーミングの更新(前フレームの要求に応じてミップを読み込み・破棄する)
+	// GPUが前フレームを終えた後、そのフレームの描画コマンドを積む前に呼ぶこと
+	void Update();
+
+	// 元画像の変更を反映する(ワーカーでクックし、転送が終わったらUpdateで差し替える)
+	// SRVの番号は変わらないので、取得済みのハンドルはそのまま使える
+	void ReloadTexture(const std::string& filePath);
+
+	// 画面上に表示する大きさ(ピクセル)を要求
+	void RequestTextureSize(const std::string& filePath, float screenWidth, float screenHeight);
+	// 必要なミップを直接要求
+	void RequestTextureMip(const std::string& filePath, uint32_t mip);
+
+	// ストリーミングのVRAM予算(バイト)
+	void SetStreamingBudget(uint64_t budget) { textureStreamer_.SetBudget(budget); }
+	// ストリーミングで常駐しているバイト数
+	uint64_t GetStreamingResidentBytes() const { return textureStreamer_.GetResidentBytes(); }
+
 	std::wstring ConvertString(const std::string& str);
 	std::string ConvertString(const std::wstring& str);
 
 public:
-	// メタデータの取得
+	// メタデータの取得(常駐状態によらず元の大きさ)
 	const DirectX::TexMetadata& GetMetaData(const std::string& filePath);
 
 	// SRVインデックスの開始番号取得
@@ -48,27 +116,73 @@ public:
 
 	// テクスチャ番号からGPUハンドルを取得
 	D3D12_GPU_DESCRIPTOR_HANDLE GetSrvHandleGPU(const std::string& filePath);
+	// ハンドルからGPUハンドルを取得(名前の検索をしない)
+	D3D12_GPU_DESCRIPTOR_HANDLE GetSrvHandleGPU(const Handle& texture);
+
+	// 読み込み済みのテクスチャ数(解放待ちを含む)
+	size_t GetTextureCount() const { return textures_.GetLiveCount(); }
 
 private:
 	DirectXCommon* dxCommon;
 	SrvManager* srvManager;
 
-	// テクスチャ1枚分のデータ
-	struct TextureData {
-		std::string filepath;								// 画像ファイルパス
-		DirectX::TexMetadata metadata;						// 画像の幅・高さ
-		Microsoft::WRL::ComPtr<ID3D12Resource> resource;	// テクスチャリソース
-		Microsoft::WRL::ComPtr<ID3D12Resource> intermediateResource;
-		uint32_t srvIndex;
-		D3D12_CPU_DESCRIPTOR_HANDLE srvHandleCPU;
-		D3D12_GPU_DESCRIPTOR_HANDLE srvHandleGPU;
+	// クック済みテクスチャ(DDS)のキャッシュ
+	TextureCooker textureCooker_;
+	// 再読み込み用のキャッシュ(速さを優先して圧縮しない)
+	TextureCooker reloadCooker_;
+	// クック用のワーカー
+	std::unique_ptr<ThreadPool> threadPool_;
+	// クック中のキャッシュキーと完了(同じ.tmpに複数のスレッドが書かないように待ち合わせる)
+	std::unordered_map<uint64_t, std::shared_future<bool>> cooks_;
+	std::mutex cookMutex_;
+
+	// 再読み込み中のテクスチャ
+	struct Reload {
+		std::string filePath;		// 登録名
+		uint64_t cookKey;
+		std::future<bool> result;	// クックの完了
 	};
+	std::vector<Reload> reloads_;
+
+
+	// クックする(同じキーを別のスレッドがクック中ならその完了を待ち、imageは空のまま結果を返す)
+	bool CookOnce(TextureCooker& cooker, const std::wstring& filePath, uint64_t cookKey, DirectX::ScratchImage& image, bool isParallel);
+
+	// ストリーミングに登録して粗いミップを転送する
+	void RegisterStreaming(TextureData& textureData);
+	// クックし直したDDSに切り替える(差し替えは転送が終わってから)
+	void ApplyReload(const Reload& reload);
+
+	// 全サブリソースを転送する(ストリーミングしないテクスチャ用)
+	void UploadWholeTexture(TextureData& textureData, const DirectX::ScratchImage& image);
+	// クック済みのDDSを丸ごと読み込む
+	static bool LoadCookedImage(const MappedFile& cookedFile, DirectX::ScratchImage& image);
+
+	// 常駐させるミップを変えたリソースを作り、コピーキューで転送する
+	void UpdateResidency(TextureData& textureData, uint32_t residentMip);
+	// 転送したリソースに差し替える(SRVは同じ番号に作り直す)
+	void SwapPendingResource(TextureData& textureData);
+	// 参照の無くなったテクスチャのSRV・ストリーミング登録を返す
+	void DestroyTexture(TextureData& textureData);
+
+	// 常に常駐させるミップを計算
+	static uint32_t ComputeTailMip(const DirectX::TexMetadata& metadata);
+
+	// テクスチャデータ(ファイルパス→参照カウント付きの登録)
+	AssetRegistry<TextureData> textures_;
+
+	// ストリーミングの常駐ポリシー
+	TextureStreamer textureStreamer_;
+	// ストリーミングID→テクスチャデータ
+	std::vector<TextureData*> streamedTextures_;
 
-	// テクスチャデータ
-	std::unordered_map < std::string,TextureData> textureDatas;
+	// 常に常駐させるミップの大きさ(これ以下のミップは最初から読み込む)
+	static const uint32_t kTailSize = 64;
 
 	// SRVインデックスの開始番号
 	static uint32_t kSRVIndexTop;
 
 };
 
+// テクスチャのハンドル
+using TextureHandle = TextureManager::Handle;
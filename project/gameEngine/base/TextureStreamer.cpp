@@ -0,0 +1,194 @@
+#include "TextureStreamer.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <map>
+
+uint32_t TextureStreamer::Register(const std::vector<uint64_t>& mipSizes, uint32_t tailMip)
+{
+	assert(!mipSizes.empty());
+	assert(tailMip < mipSizes.size());
+
+	// --- 空いているIDを再利用 ---
+	uint32_t id;
+	if (!freeIds_.empty()) {
+		id = freeIds_.back();
+		freeIds_.pop_back();
+	} else {
+		id = uint32_t(entries_.size());
+		entries_.emplace_back();
+	}
+
+	// --- 最初は粗いミップだけを常駐 ---
+	Entry& entry = entries_[id];
+	entry.mipSizes = mipSizes;
+	entry.tailMip = tailMip;
+	entry.residentMip = tailMip;
+	entry.requestedMip = tailMip;
+	entry.lastUsedFrame = 0;
+	entry.isActive = true;
+
+	residentBytes_ += ComputeBytes(entry, entry.residentMip);
+	return id;
+}
+
+void TextureStreamer::Unregister(uint32_t id)
+{
+	Entry& entry = entries_[id];
+	assert(entry.isActive);
+
+	residentBytes_ -= ComputeBytes(entry, entry.residentMip);
+	entry = Entry{};
+	freeIds_.push_back(id);
+}
+
+void TextureStreamer::RequestMip(uint32_t id, uint32_t mip)
+{
+	Entry& entry = entries_[id];
+	assert(entry.isActive);
+
+	mip = std::min(mip, entry.tailMip);
+
+	// 今フレーム最初の要求ならそのまま、2回目以降は細かい方
+	if (!IsUsedThisFrame(entry)) {
+		entry.requestedMip = mip;
+		entry.lastUsedFrame = frame_;
+	} else {
+		entry.requestedMip = std::min(entry.requestedMip, mip);
+	}
+}
+
+std::vector<TextureStreamer::Change> TextureStreamer::Update()
+{
+	// 変更のあったテクスチャ(ID順にまとめる)
+	std::map<uint32_t, uint32_t> changes;
+
+	// --- 読み込みが必要なテクスチャを集める ---
+	std::vector<uint32_t> demands;
+	for (uint32_t id = 0; id < entries_.size(); ++id) {
+		const Entry& entry = entries_[id];
+		if (entry.isActive && IsUsedThisFrame(entry) && entry.requestedMip < entry.residentMip) {
+			demands.push_back(id);
+		}
+	}
+	// 足りないミップが多いものから
+	std::sort(demands.begin(), demands.end(), [this](uint32_t a, uint32_t b) {
+		const Entry& entryA = entries_[a];
+		const Entry& entryB = entries_[b];
+		return (entryA.residentMip - entryA.requestedMip) > (entryB.residentMip - entryB.requestedMip);
+		});
+
+	// --- 予算内で読み込む ---
+	for (uint32_t id : demands) {
+		Entry& entry = entries_[id];
+
+		// 捨てられる分を全て捨てても入らないなら粗いミップで妥協する
+		uint64_t available = budget_ + ComputeEvictableBytes();
+		uint32_t targetMip = entry.requestedMip;
+		while (targetMip < entry.residentMip &&
+			residentBytes_ + ComputeBytes(entry, targetMip) - ComputeBytes(entry, entry.residentMip) > available) {
+			targetMip++;
+		}
+		if (targetMip >= entry.residentMip) {
+			continue;
+		}
+		uint64_t need = ComputeBytes(entry, targetMip) - ComputeBytes(entry, entry.residentMip);
+
+		// 予算を超える分は使われていないものから1段階ずつ捨てる
+		while (residentBytes_ + need > budget_) {
+			uint32_t victimId = FindVictim();
+			assert(victimId != kInvalidId);
+			Entry& victim = entries_[victimId];
+			residentBytes_ -= victim.mipSizes[victim.residentMip];
+			victim.residentMip++;
+			changes[victimId] = victim.residentMip;
+		}
+
+		residentBytes_ += need;
+		entry.residentMip = targetMip;
+		changes[id] = entry.residentMip;
+	}
+
+	// --- 予算を超えたままなら使われていないものを捨てる(予算を下げた場合など) ---
+	while (residentBytes_ > budget_) {
+		uint32_t victimId = FindVictim();
+		if (victimId == kInvalidId) {
+			break;
+		}
+		Entry& victim = entries_[victimId];
+		residentBytes_ -= victim.mipSizes[victim.residentMip];
+		victim.residentMip++;
+		changes[victimId] = victim.residentMip;
+	}
+
+	frame_++;
+
+	std::vector<Change> result;
+	result.reserve(changes.size());
+	for (const auto& [id, residentMip] : changes) {
+		result.push_back({ id, residentMip });
+	}
+	return result;
+}
+
+uint32_t TextureStreamer::ComputeMipForSize(uint32_t textureWidth, uint32_t textureHeight, float screenWidth, float screenHeight, uint32_t mipCount)
+{
+	// 画面1ピクセルあたりのテクセル数(大きい方の軸)
+	float ratioX = float(textureWidth) / std::max(std::abs(screenWidth), 1.0f);
+	float ratioY = float(textureHeight) / std::max(std::abs(screenHeight), 1.0f);
+	float ratio = std::max(ratioX, ratioY);
+	if (ratio <= 1.0f) {
+		return 0;
+	}
+
+	// 1ピクセルに1テクセル以上になる最も粗いミップ
+	uint32_t mip = uint32_t(std::floor(std::log2(ratio)));
+	return std::min(mip, mipCount - 1);
+}
+
+uint64_t TextureStreamer::ComputeBytes(const Entry& entry, uint32_t mip)
+{
+	uint64_t bytes = 0;
+	for (uint32_t i = mip; i < entry.mipSizes.size(); ++i) {
+		bytes += entry.mipSizes[i];
+	}
+	return bytes;
+}
+
+uint64_t TextureStreamer::ComputeEvictableBytes() const
+{
+	uint64_t bytes = 0;
+	for (const Entry& entry : entries_) {
+		if (!entry.isActive) {
+			continue;
+		}
+		uint32_t floorMip = IsUsedThisFrame(entry) ? entry.requestedMip : entry.tailMip;
+		if (entry.residentMip < floorMip) {
+			bytes += ComputeBytes(entry, entry.residentMip) - ComputeBytes(entry, floorMip);
+		}
+	}
+	return bytes;
+}
+
+uint32_t TextureStreamer::FindVictim() const
+{
+	// 最も長く使われていないものを選ぶ
+	// 今フレーム使われているものは要求より細かい分だけ、それ以外はtailMipまで捨てられる
+	uint32_t victimId = kInvalidId;
+	uint64_t oldestFrame = UINT64_MAX;
+	for (uint32_t id = 0; id < entries_.size(); ++id) {
+		const Entry& entry = entries_[id];
+		if (!entry.isActive) {
+			continue;
+		}
+		uint32_t floorMip = IsUsedThisFrame(entry) ? entry.requestedMip : entry.tailMip;
+		if (entry.residentMip >= floorMip) {
+			continue;
+		}
+		if (entry.lastUsedFrame < oldestFrame) {
+			oldestFrame = entry.lastUsedFrame;
+			victimId = id;
+		}
+	}
+	return victimId;
+}
@@ -0,0 +1,84 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+// テクスチャストリーミングの常駐ポリシー
+// テクスチャごとのミップ常駐状態とVRAM予算を管理し、どのミップまで読み込む(捨てる)かを決める
+// デバイスには触らないので、実際のリソース再生成は結果を受け取った側で行う
+class TextureStreamer
+{
+public:
+	// 無効なID
+	static const uint32_t kInvalidId = UINT32_MAX;
+
+	// 常駐ミップの変更
+	struct Change {
+		uint32_t id;			// テクスチャID
+		uint32_t residentMip;	// 新しく常駐させる最も細かいミップ
+	};
+
+public:
+	// VRAM予算(バイト)
+	void SetBudget(uint64_t budget) { budget_ = budget; }
+	uint64_t GetBudget() const { return budget_; }
+
+	// テクスチャの登録
+	// mipSizes:ミップごとのバイト数 / tailMip:常に常駐させる最も細かいミップ(これ以降は捨てない)
+	// 最初はtailMip以降だけが常駐している
+	uint32_t Register(const std::vector<uint64_t>& mipSizes, uint32_t tailMip);
+
+	// テクスチャの登録解除
+	void Unregister(uint32_t id);
+
+	// 今フレームに必要なミップを要求(複数回呼ばれたら最も細かいものを採用)
+	void RequestMip(uint32_t id, uint32_t mip);
+
+	// 常駐状態の更新(要求に応じて読み込み、予算を超える分は使われていないものから捨てる)
+	// 変更のあったテクスチャを返す
+	std::vector<Change> Update();
+
+public:
+	// 画面上の大きさ(ピクセル)から必要なミップを計算
+	static uint32_t ComputeMipForSize(uint32_t textureWidth, uint32_t textureHeight, float screenWidth, float screenHeight, uint32_t mipCount);
+
+public:
+	// 常駐しているミップ
+	uint32_t GetResidentMip(uint32_t id) const { return entries_[id].residentMip; }
+	// 常駐しているバイト数
+	uint64_t GetResidentBytes() const { return residentBytes_; }
+	// 現在のフレーム
+	uint64_t GetFrame() const { return frame_; }
+
+private:
+	// テクスチャ1枚分の状態
+	struct Entry {
+		std::vector<uint64_t> mipSizes;
+		uint32_t tailMip = 0;			// 常に常駐させるミップ
+		uint32_t residentMip = 0;		// 常駐している最も細かいミップ
+		uint32_t requestedMip = 0;		// 今フレームの要求
+		uint64_t lastUsedFrame = 0;		// 最後に要求されたフレーム
+		bool isActive = false;
+	};
+
+	// mip以降を常駐させたときのバイト数
+	static uint64_t ComputeBytes(const Entry& entry, uint32_t mip);
+
+	// 今捨てられるバイト数の合計
+	uint64_t ComputeEvictableBytes() const;
+
+	// 1段階捨てるテクスチャを選ぶ(無ければkInvalidId)
+	uint32_t FindVictim() const;
+
+	// 今フレーム要求されたか
+	bool IsUsedThisFrame(const Entry& entry) const { return entry.lastUsedFrame == frame_; }
+
+private:
+	std::vector<Entry> entries_;
+	std::vector<uint32_t> freeIds_;
+
+	uint64_t budget_ = 256ull * 1024 * 1024;
+	uint64_t residentBytes_ = 0;
+
+	// 0は「未使用」を表すので1から
+	uint64_t frame_ = 1;
+};
@@ -0,0 +1,49 @@
+#pragma once
+#include <cstdint>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+// アップロードジョブのバッチ化
+// どのスレッドからでもジョブを積め、描画スレッドがまとめて取り出して1回で送信する(デバイスには触らない)
+// トークンはジョブが入るバッチの番号で、コピーキューがそのバッチの後にシグナルするフェンス値と同じ
+template<typename Job>
+class UploadBatcher
+{
+public:
+	using Token = uint64_t;
+
+public:
+	// ジョブを積み、完了を待つためのトークンを返す
+	Token Enqueue(Job job) {
+		std::lock_guard<std::mutex> lock(mutex_);
+		jobs_.push_back(std::move(job));
+		return submittedToken_ + 1;
+	}
+
+	// 積まれたジョブをバッチとして取り出す(空ならfalse)
+	bool TakeBatch(std::vector<Job>& jobs, Token& token) {
+		std::lock_guard<std::mutex> lock(mutex_);
+		if (jobs_.empty()) {
+			return false;
+		}
+		jobs.swap(jobs_);
+		jobs_.clear();
+		token = ++submittedToken_;
+		return true;
+	}
+
+	// 送信済みの最後のトークン
+	Token GetSubmittedToken() const {
+		std::lock_guard<std::mutex> lock(mutex_);
+		return submittedToken_;
+	}
+
+	// 送信済みか
+	bool IsSubmitted(Token token) const { return token <= GetSubmittedToken(); }
+
+private:
+	std::vector<Job> jobs_;
+	Token submittedToken_ = 0;
+	mutable std::mutex mutex_;
+};
@@ -0,0 +1,196 @@
+#include "UploadService.h"
+#include <algorithm>
+#include <cassert>
+
+#include "DirectXCommon.h"
+#include "../../externals/DirectXTex/d3dx12.h"
+
+UploadService* UploadService::instance = nullptr;
+
+UploadService* UploadService::GetInstance()
+{
+	if (instance == nullptr) {
+		instance = new UploadService;
+	}
+	return instance;
+}
+
+void UploadService::Finalize()
+{
+	// --- 残っている転送を送り、全て終わるまで待つ ---
+	if (fence_) {
+		Submit();
+		UploadBatcher<Job>::Token lastToken = batcher_.GetSubmittedToken();
+		if (fence_->GetCompletedValue() < lastToken) {
+			HANDLE event = CreateEvent(nullptr, false, false, nullptr);
+			fence_->SetEventOnCompletion(lastToken, event);
+			WaitForSingleObject(event, INFINITE);
+			CloseHandle(event);
+		}
+	}
+
+	delete instance;
+	instance = nullptr;
+}
+
+void UploadService::Initialize(DirectXCommon* dxCommon)
+{
+	// メンバ変数に記録
+	dxCommon_ = dxCommon;
+
+	ID3D12Device* device = dxCommon_->GetDevice().Get();
+	HRESULT hr;
+
+	// --- コピーキューの生成 ---
+	D3D12_COMMAND_QUEUE_DESC queueDesc{};
+	queueDesc.Type = D3D12_COMMAND_LIST_TYPE_COPY;
+	hr = device->CreateCommandQueue(&queueDesc, IID_PPV_ARGS(&copyQueue_));
+	assert(SUCCEEDED(hr));
+
+	// --- コマンドアロケータ・コマンドリストの生成 ---
+	for (Microsoft::WRL::ComPtr<ID3D12CommandAllocator>& allocator : allocators_) {
+		hr = device->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_COPY, IID_PPV_ARGS(&allocator));
+		assert(SUCCEEDED(hr));
+	}
+	hr = device->CreateCommandList(0, D3D12_COMMAND_LIST_TYPE_COPY, allocators_[0].Get(), nullptr, IID_PPV_ARGS(&commandList_));
+	assert(SUCCEEDED(hr));
+	// 記録はSubmitで始めるので閉じておく
+	hr = commandList_->Close();
+	assert(SUCCEEDED(hr));
+
+	// --- フェンスの生成(値はバッチの番号) ---
+	hr = device->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&fence_));
+	assert(SUCCEEDED(hr));
+
+	// --- 中間バッファのプール ---
+	stagingPool_.Initialize(dxCommon_);
+}
+
+UploadService::Token UploadService::UploadTexture(Microsoft::WRL::ComPtr<ID3D12Resource> texture, const std::vector<D3D12_SUBRESOURCE_DATA>& subresources)
+{
+	// --- コピー先の配置を計算 ---
+	D3D12_RESOURCE_DESC desc = texture->GetDesc();
+	UINT subresourceCount = UINT(subresources.size());
+	Job job;
+	job.texture = texture;
+	job.layouts.resize(subresourceCount);
+	std::vector<UINT> rowCounts(subresourceCount);
+	std::vector<UINT64> rowSizes(subresourceCount);
+	UINT64 totalSize = 0;
+	dxCommon_->GetDevice()->GetCopyableFootprints(&desc, 0, subresourceCount, 0, job.layouts.data(), rowCounts.data(), rowSizes.data(), &totalSize);
+
+	// --- 中間バッファを取得 ---
+	{
+		std::lock_guard<std::mutex> lock(stagingMutex_);
+		job.staging = stagingPool_.Acquire(totalSize);
+	}
+
+	// --- 呼び出したスレッドで中間バッファへコピー ---
+	uint8_t* mapped = nullptr;
+	HRESULT hr = job.staging->Map(0, nullptr, reinterpret_cast<void**>(&mapped));
+	assert(SUCCEEDED(hr));
+	for (UINT i = 0; i < subresourceCount; ++i) {
+		const D3D12_PLACED_SUBRESOURCE_FOOTPRINT& layout = job.layouts[i];
+		D3D12_MEMCPY_DEST dest{};
+		dest.pData = mapped + layout.Offset;
+		dest.RowPitch = layout.Footprint.RowPitch;
+		dest.SlicePitch = SIZE_T(layout.Footprint.RowPitch) * rowCounts[i];
+		MemcpySubresource(&dest, &subresources[i], SIZE_T(rowSizes[i]), rowCounts[i], layout.Footprint.Depth);
+	}
+	job.staging->Unmap(0, nullptr);
+
+	// --- コピーコマンドは次のSubmitでまとめて積む ---
+	return batcher_.Enqueue(std::move(job));
+}
+
+void UploadService::Submit()
+{
+	std::vector<Job> jobs;
+	Token token = 0;
+	if (!batcher_.TakeBatch(jobs, token)) {
+		return;
+	}
+
+	// --- 使うアロケータのコマンドが終わっているか確認(通常は待たない) ---
+	uint32_t allocatorIndex = uint32_t(token % kAllocatorCount);
+	if (fence_->GetCompletedValue() < allocatorFenceValues_[allocatorIndex]) {
+		HANDLE event = CreateEvent(nullptr, false, false, nullptr);
+		fence_->SetEventOnCompletion(allocatorFenceValues_[allocatorIndex], event);
+		WaitForSingleObject(event, INFINITE);
+		CloseHandle(event);
+	}
+	HRESULT hr = allocators_[allocatorIndex]->Reset();
+	assert(SUCCEEDED(hr));
+	hr = commandList_->Reset(allocators_[allocatorIndex].Get(), nullptr);
+	assert(SUCCEEDED(hr));
+
+	// --- コピーコマンドを積む ---
+	// コピーキューの後はCOMMONに戻り、描画キューで読むときに暗黙にSRV状態へ昇格する
+	for (const Job& job : jobs) {
+		for (UINT i = 0; i < UINT(job.layouts.size()); ++i) {
+			D3D12_TEXTURE_COPY_LOCATION dst{};
+			dst.pResource = job.texture.Get();
+			dst.Type = D3D12_TEXTURE_COPY_TYPE_SUBRESOURCE_INDEX;
+			dst.SubresourceIndex = i;
+			D3D12_TEXTURE_COPY_LOCATION src{};
+			src.pResource = job.staging.Get();
+			src.Type = D3D12_TEXTURE_COPY_TYPE_PLACED_FOOTPRINT;
+			src.PlacedFootprint = job.layouts[i];
+			commandList_->CopyTextureRegion(&dst, 0, 0, 0, &src, nullptr);
+		}
+	}
+	hr = commandList_->Close();
+	assert(SUCCEEDED(hr));
+
+	// --- 送信してバッチの番号でシグナル ---
+	ID3D12CommandList* commandLists[] = { commandList_.Get() };
+	copyQueue_->ExecuteCommandLists(1, commandLists);
+	copyQueue_->Signal(fence_.Get(), token);
+	allocatorFenceValues_[allocatorIndex] = token;
+
+	// --- 中間バッファはこのバッチが終わったら再利用、転送先もそれまで保持 ---
+	std::lock_guard<std::mutex> lock(stagingMutex_);
+	for (Job& job : jobs) {
+		stagingPool_.Release(std::move(job.staging), token);
+		ReleaseAfter(token, std::move(job.texture));
+	}
+}
+
+void UploadService::RequireForFrame(Token token)
+{
+	frameWaitToken_ = std::max(frameWaitToken_, token);
+}
+
+void UploadService::InsertFrameWait(ID3D12CommandQueue* queue)
+{
+	// 未送信のものがあれば先に送る
+	if (!batcher_.IsSubmitted(frameWaitToken_)) {
+		Submit();
+	}
+
+	// --- 完了していなければGPU上で待つ(CPUは止めない) ---
+	if (frameWaitToken_ != 0 && !IsComplete(frameWaitToken_)) {
+		queue->Wait(fence_.Get(), frameWaitToken_);
+	}
+	frameWaitToken_ = 0;
+
+	// --- 終わった転送の中間バッファ・保持していたリソースを回収 ---
+	uint64_t completedValue = fence_->GetCompletedValue();
+	{
+		std::lock_guard<std::mutex> lock(stagingMutex_);
+		stagingPool_.Update(completedValue);
+	}
+	deferredReleases_.Retire(completedValue, [](Microsoft::WRL::ComPtr<ID3D12Resource>) {});
+}
+
+bool UploadService::IsComplete(Token token) const
+{
+	return token == 0 || fence_->GetCompletedValue() >= token;
+}
+
+void UploadService::ReleaseAfter(Token token, Microsoft::WRL::ComPtr<ID3D12Resource> resource)
+{
+	// キューはフェンス値の昇順なので、前に積んだものより早くは解放しない
+	lastDeferredToken_ = std::max(lastDeferredToken_, token);
+	deferredReleases_.Push(lastDeferredToken_, std::move(resource));
+}
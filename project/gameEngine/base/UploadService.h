@@ -0,0 +1,97 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <d3d12.h>
+#include <mutex>
+#include <vector>
+#include <wrl.h>
+
+#include "FenceRetireQueue.h"
+#include "StagingPool.h"
+#include "UploadBatcher.h"
+
+class DirectXCommon;
+
+// 専用のコピーキューでアップロードするサービス
+// どのスレッドからでも転送を登録でき、描画スレッドがフレームごとにまとめてコピーキューへ送る
+// 描画側はトークンを使って、そのアセットを初めて描くフレームだけGPU上で完了を待つ
+class UploadService
+{
+#pragma region シングルトンインスタンス
+private:
+	static UploadService* instance;
+
+	UploadService() = default;
+	~UploadService() = default;
+	UploadService(UploadService&) = delete;
+	UploadService& operator = (UploadService&) = delete;
+
+public:
+	// シングルトンインスタンスの取得
+	static UploadService* GetInstance();
+	// 終了(コピーの完了を待つ)
+	void Finalize();
+#pragma endregion シングルトンインスタンス
+
+public:
+	// 完了待ち用のトークン(0は「待つ必要なし」)
+	using Token = uint64_t;
+
+public:
+	// 初期化
+	void Initialize(DirectXCommon* dxCommon);
+
+	// テクスチャの転送を登録(どのスレッドからでもよい)
+	// データは呼び出し中に中間バッファへコピーされる。textureはCOMMON状態で生成しておくこと
+	Token UploadTexture(Microsoft::WRL::ComPtr<ID3D12Resource> texture, const std::vector<D3D12_SUBRESOURCE_DATA>& subresources);
+
+	// 登録された転送をまとめてコピーキューへ送る(描画スレッド)
+	void Submit();
+
+	// このフレームの描画で使うので、描画前に完了を待つ
+	void RequireForFrame(Token token);
+	// 描画キューにこのフレームで必要な完了待ちを積む(毎フレーム、ExecuteCommandListsの直前に呼ぶ)
+	// 終わった転送の中間バッファもここで回収する
+	void InsertFrameWait(ID3D12CommandQueue* queue);
+
+	// GPU上で完了しているか
+	bool IsComplete(Token token) const;
+
+	// tokenの転送が終わるまでリソースを保持する(描画スレッド)
+	void ReleaseAfter(Token token, Microsoft::WRL::ComPtr<ID3D12Resource> resource);
+
+private:
+	// 1回分の転送
+	struct Job {
+		Microsoft::WRL::ComPtr<ID3D12Resource> texture;
+		Microsoft::WRL::ComPtr<ID3D12Resource> staging;
+		std::vector<D3D12_PLACED_SUBRESOURCE_FOOTPRINT> layouts;
+	};
+
+	// 同時に使うコマンドアロケータの数
+	static const uint32_t kAllocatorCount = 3;
+
+private:
+	DirectXCommon* dxCommon_ = nullptr;
+
+	// --- コピーキュー ---
+	Microsoft::WRL::ComPtr<ID3D12CommandQueue> copyQueue_;
+	std::array<Microsoft::WRL::ComPtr<ID3D12CommandAllocator>, kAllocatorCount> allocators_;
+	std::array<uint64_t, kAllocatorCount> allocatorFenceValues_{};
+	Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList> commandList_;
+	Microsoft::WRL::ComPtr<ID3D12Fence> fence_;
+
+	// --- ジョブ ---
+	UploadBatcher<Job> batcher_;
+
+	// --- 中間バッファ(コピーキューのフェンス値で再利用) ---
+	StagingPool stagingPool_;
+	std::mutex stagingMutex_;
+
+	// 転送が終わるまで保持するリソース
+	FenceRetireQueue<Microsoft::WRL::ComPtr<ID3D12Resource>> deferredReleases_;
+	Token lastDeferredToken_ = 0;
+
+	// このフレームで待つ必要のある最大のトークン
+	Token frameWaitToken_ = 0;
+};
@@ -0,0 +1,137 @@
+#include "VirtualFileSystem.h"
+#include <algorithm>
+#include <cassert>
+#include <string>
+
+#include "Hash.h"
+#include "Logger.h"
+
+VirtualFileSystem* VirtualFileSystem::instance = nullptr;
+
+VirtualFileSystem* VirtualFileSystem::GetInstance()
+{
+	if (instance == nullptr) {
+		instance = new VirtualFileSystem;
+	}
+	return instance;
+}
+
+void VirtualFileSystem::Finalize()
+{
+	delete instance;
+	instance = nullptr;
+}
+
+void VirtualFileSystem::Initialize(const std::filesystem::path& packPath, bool isPackRequired)
+{
+	// --- ブロック展開用のワーカーの生成 ---
+	threadPool_ = std::make_unique<ThreadPool>();
+
+	// --- パックをマップ ---
+	if (pack_.Open(packPath)) {
+		std::error_code ec;
+		packWriteTime_ = std::filesystem::last_write_time(packPath, ec).time_since_epoch().count();
+		Logger::Log("VirtualFileSystem: mounted " + packPath.string() + " (" + std::to_string(pack_.GetEntryCount()) + " entries)\n");
+	} else if (isPackRequired) {
+		Logger::Log("VirtualFileSystem: required pack " + packPath.string() + " not found\n");
+		assert(false);
+	} else {
+		Logger::Log("VirtualFileSystem: no pack, reading loose files\n");
+	}
+	isLooseFileEnabled_ = !isPackRequired;
+}
+
+FileData VirtualFileSystem::Open(const std::filesystem::path& path) const
+{
+	FileData fileData;
+
+	// --- パックから ---
+	if (const AssetPack::Entry* entry = pack_.Find(path)) {
+		if (entry->flags & (AssetPack::kCompressedLZ4 | AssetPack::kCompressedBlocks)) {
+			// 圧縮されているものだけ展開先を確保する
+			fileData.buffer_.resize(size_t(entry->size));
+			fileData.isValid_ = pack_.Decompress(*entry, fileData.buffer_, threadPool_.get());
+			fileData.data_ = fileData.buffer_;
+		} else {
+			fileData.data_ = pack_.GetStoredData(*entry);
+			fileData.isValid_ = true;
+		}
+		packReadCount_++;
+		return fileData;
+	}
+
+	// --- ばらのファイルから ---
+	if (isLooseFileEnabled_ && fileData.mappedFile_.Open(path)) {
+		fileData.data_ = fileData.mappedFile_.GetSpan();
+		fileData.isValid_ = true;
+		looseReadCount_++;
+	}
+	return fileData;
+}
+
+bool VirtualFileSystem::Exists(const std::filesystem::path& path) const
+{
+	if (pack_.Find(path)) {
+		return true;
+	}
+	std::error_code ec;
+	return isLooseFileEnabled_ && std::filesystem::is_regular_file(path, ec);
+}
+
+bool VirtualFileSystem::GetFileSize(const std::filesystem::path& path, uint64_t& size) const
+{
+	if (const AssetPack::Entry* entry = pack_.Find(path)) {
+		size = entry->size;
+		return true;
+	}
+	if (!isLooseFileEnabled_) {
+		return false;
+	}
+	std::error_code ec;
+	size = std::filesystem::file_size(path, ec);
+	return !ec;
+}
+
+bool VirtualFileSystem::GetFileStamp(const std::filesystem::path& path, uint64_t& stamp) const
+{
+	// --- パックから(マウント中は変わらないので、索引とパックの更新日時で十分) ---
+	if (const AssetPack::Entry* entry = pack_.Find(path)) {
+		stamp = Hash::CombineValue(Hash::kOffsetBasis, *entry);
+		stamp = Hash::CombineValue(stamp, packWriteTime_);
+		return true;
+	}
+
+	// --- ばらのファイルから ---
+	if (!isLooseFileEnabled_) {
+		return false;
+	}
+	std::error_code ec;
+	uint64_t size = std::filesystem::file_size(path, ec);
+	if (ec) {
+		return false;
+	}
+	int64_t writeTime = std::filesystem::last_write_time(path, ec).time_since_epoch().count();
+	if (ec) {
+		return false;
+	}
+	stamp = Hash::CombineValue(Hash::CombineValue(Hash::kOffsetBasis, size), writeTime);
+	return true;
+}
+
+bool VirtualFileSystem::Read(const std::filesystem::path& path, uint64_t offset, std::span<uint8_t> dst) const
+{
+	// --- パックから(展開先に直接) ---
+	if (const AssetPack::Entry* entry = pack_.Find(path)) {
+		packReadCount_++;
+		return pack_.Read(*entry, offset, dst, threadPool_.get());
+	}
+
+	// --- ばらのファイルから ---
+	MappedFile file;
+	if (!isLooseFileEnabled_ || !file.Open(path) || offset > file.GetSize() || file.GetSize() - offset < dst.size()) {
+		return false;
+	}
+	std::copy_n(file.GetData() + offset, dst.size(), dst.begin());
+	looseReadCount_++;
+	return true;
+}
@@ -0,0 +1,111 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "AssetPack.h"
+#include "MappedFile.h"
+#include "ThreadPool.h"
+
+// 読み込んだファイルの内容
+// パック内の非圧縮エントリ・ばらのファイルはマップしたメモリをそのまま参照する
+class FileData
+{
+public:
+	FileData() = default;
+	FileData(const FileData&) = delete;
+	FileData& operator=(const FileData&) = delete;
+	FileData(FileData&&) noexcept = default;
+	FileData& operator=(FileData&&) noexcept = default;
+
+public:
+	// 読み込めたか
+	bool IsValid() const { return isValid_; }
+	// 内容
+	std::span<const uint8_t> GetSpan() const { return data_; }
+	// 内容(テキストとして)
+	std::string_view GetText() const { return { reinterpret_cast<const char*>(data_.data()), data_.size() }; }
+	// サイズ
+	size_t GetSize() const { return data_.size(); }
+
+private:
+	friend class VirtualFileSystem;
+
+	// ばらのファイル
+	MappedFile mappedFile_;
+	// 圧縮エントリを展開したもの
+	std::vector<uint8_t> buffer_;
+	// 参照している内容
+	std::span<const uint8_t> data_;
+	bool isValid_ = false;
+};
+
+// 仮想ファイルシステム
+// アセットパックがあればそこから、無ければ(開発中は)ばらのファイルから読み込む
+class VirtualFileSystem
+{
+#pragma region シングルトンインスタンス
+private:
+	static VirtualFileSystem* instance;
+
+	VirtualFileSystem() = default;
+	~VirtualFileSystem() = default;
+	VirtualFileSystem(VirtualFileSystem&) = delete;
+	VirtualFileSystem& operator=(VirtualFileSystem&) = delete;
+
+public:
+	// シングルトンインスタンスの取得
+	static VirtualFileSystem* GetInstance();
+	// 終了
+	void Finalize();
+#pragma endregion シングルトンインスタンス
+
+public:
+	// 初期化(パックが無ければばらのファイルだけを使う)
+	// isPackRequiredならパックだけから読み込む(パックが無ければ止める。パック漏れを見つける用)
+	void Initialize(const std::filesystem::path& packPath, bool isPackRequired = false);
+
+	// ファイルを開く(パス区切り・大文字小文字は区別しない)
+	// 複数スレッドから同時に呼べる
+	FileData Open(const std::filesystem::path& path) const;
+
+	// ファイルがあるか
+	bool Exists(const std::filesystem::path& path) const;
+
+	// ファイルサイズ(展開後。無ければfalse)
+	bool GetFileSize(const std::filesystem::path& path, uint64_t& size) const;
+
+	// 内容が変わると変わる値(中身は読まず、サイズと更新日時から作る。無ければfalse)
+	bool GetFileStamp(const std::filesystem::path& path, uint64_t& stamp) const;
+
+	// offsetからdst.size()分を呼び出し側のバッファに直接読み込む
+	// ブロック圧縮のエントリは範囲にかかるブロックだけをワーカーで並列に展開する
+	bool Read(const std::filesystem::path& path, uint64_t offset, std::span<uint8_t> dst) const;
+
+public:
+	// パックを使っているか
+	bool IsPackMounted() const { return pack_.IsOpen(); }
+	// ばらのファイルも読むか
+	bool IsLooseFileEnabled() const { return isLooseFileEnabled_; }
+
+	// 統計
+	uint32_t GetPackReadCount() const { return packReadCount_; }
+	uint32_t GetLooseReadCount() const { return looseReadCount_; }
+
+private:
+	AssetPack pack_;
+	// パックの更新日時(パック内のファイルの更新日時の代わり)
+	int64_t packWriteTime_ = 0;
+	// パックに無いファイルをばらのファイルから読むか
+	bool isLooseFileEnabled_ = true;
+	// ブロック展開用のワーカー
+	std::unique_ptr<ThreadPool> threadPool_;
+
+	// 統計
+	mutable std::atomic<uint32_t> packReadCount_ = 0;
+	mutable std::atomic<uint32_t> looseReadCount_ = 0;
+};
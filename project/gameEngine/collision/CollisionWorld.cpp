@@ -0,0 +1,324 @@
+#include "CollisionWorld.h"
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <emmintrin.h>
+
+#include "Object3d.h"
+
+namespace
+{
+	// 軸の成分
+	float GetAxis(const Vector3& v, uint32_t axis) { return axis == 0 ? v.x : axis == 1 ? v.y : v.z; }
+
+	// 今の軸の広がりがこの割合を超えて負けたら軸を替える(毎フレーム行き来しないように)
+	const float kAxisSwitchRatio = 1.2f;
+	// 挿入ソートで1つあたりこれ以上動かしたら、大きく動いたとみなしてまとめてソートする
+	const uint64_t kMaxInsertionShifts = 32;
+}
+
+CollisionWorld::ColliderId CollisionWorld::AddCollider(Object3d* object, uint32_t layer, uint32_t collideMask)
+{
+	assert(object);
+	Collider collider;
+	collider.object = object;
+	collider.layer = layer;
+	collider.collideMask = collideMask;
+	collider.useModelBounds = true;
+	return Allocate(collider);
+}
+
+CollisionWorld::ColliderId CollisionWorld::AddCollider(Object3d* object, const AABB& localBounds, uint32_t layer, uint32_t collideMask)
+{
+	assert(object);
+	Collider collider;
+	collider.object = object;
+	collider.localBounds = localBounds;
+	collider.layer = layer;
+	collider.collideMask = collideMask;
+	return Allocate(collider);
+}
+
+CollisionWorld::ColliderId CollisionWorld::AddCollider(const AABB& bounds, uint32_t layer, uint32_t collideMask)
+{
+	Collider collider;
+	collider.bounds = bounds;
+	collider.layer = layer;
+	collider.collideMask = collideMask;
+	return Allocate(collider);
+}
+
+CollisionWorld::ColliderId CollisionWorld::Allocate(const Collider& collider)
+{
+	ColliderId id;
+	if (!freeColliders_.empty()) {
+		id = freeColliders_.back();
+		freeColliders_.pop_back();
+		colliders_[id] = collider;
+	}
+	else {
+		id = ColliderId(colliders_.size());
+		colliders_.push_back(collider);
+	}
+	colliders_[id].isAlive = true;
+
+	// 並びの末尾に加え、次のUpdateで正しい位置に移す
+	order_.push_back(id);
+	++addedCount_;
+	if (collider.object) {
+		isObjectListDirty_ = true;
+	}
+	return id;
+}
+
+void CollisionWorld::RemoveCollider(ColliderId collider)
+{
+	assert(IsAlive(collider));
+	Collider& target = colliders_[collider];
+	if (target.object) {
+		isObjectListDirty_ = true;
+	}
+	target.object = nullptr;
+	target.isAlive = false;
+	removedColliders_.push_back(collider);
+}
+
+void CollisionWorld::SetLayer(ColliderId collider, uint32_t layer, uint32_t collideMask)
+{
+	assert(IsAlive(collider));
+	colliders_[collider].layer = layer;
+	colliders_[collider].collideMask = collideMask;
+}
+
+void CollisionWorld::SetBounds(ColliderId collider, const AABB& bounds)
+{
+	assert(IsAlive(collider) && !colliders_[collider].object);
+	colliders_[collider].bounds = bounds;
+}
+
+void CollisionWorld::Clear()
+{
+	colliders_.clear();
+	freeColliders_.clear();
+	removedColliders_.clear();
+	releasingColliders_.clear();
+	objectColliders_.clear();
+	isObjectListDirty_ = false;
+	addedCount_ = 0;
+	order_.clear();
+	pairs_.clear();
+	previousPairs_.clear();
+	events_.clear();
+}
+
+void CollisionWorld::Update(ThreadPool* threadPool)
+{
+	// --- 削除された番号を整理 ---
+	// 前回削除されたものはイベントにもう出ないので再利用できる
+	freeColliders_.insert(freeColliders_.end(), releasingColliders_.begin(), releasingColliders_.end());
+	releasingColliders_.swap(removedColliders_);
+	removedColliders_.clear();
+	if (!releasingColliders_.empty()) {
+		std::erase_if(order_, [this](ColliderId id) { return !colliders_[id].isAlive; });
+	}
+	if (isObjectListDirty_) {
+		objectColliders_.clear();
+		for (ColliderId id : order_) {
+			if (colliders_[id].object) {
+				objectColliders_.push_back(id);
+			}
+		}
+		isObjectListDirty_ = false;
+	}
+
+	bool isParallel = threadPool && order_.size() >= kMinParallelColliders;
+
+	// --- Object3dの箱を更新 ---
+	if (isParallel) {
+		threadPool->ParallelFor(uint32_t(objectColliders_.size()), [this](uint32_t begin, uint32_t end) { UpdateBounds(begin, end); });
+	}
+	else {
+		UpdateBounds(0, uint32_t(objectColliders_.size()));
+	}
+
+	// --- 並べ直す ---
+	SortAlongAxis();
+
+	// --- 重なっている組を集める ---
+	pairs_.swap(previousPairs_);
+	pairs_.clear();
+	uint32_t count = uint32_t(order_.size());
+	if (isParallel) {
+		// 後ろほど調べる相手が少ないので、範囲を細かく分けて偏りを減らす
+		uint32_t rangeCount = threadPool->GetThreadCount() * 4;
+		rangePairs_.resize(rangeCount);
+		threadPool->ParallelFor(rangeCount, [this, count, rangeCount](uint32_t begin, uint32_t end) {
+			for (uint32_t range = begin; range < end; ++range) {
+				rangePairs_[range].clear();
+				Sweep(uint32_t(uint64_t(count) * range / rangeCount), uint32_t(uint64_t(count) * (range + 1) / rangeCount), rangePairs_[range]);
+			}
+		});
+		for (const std::vector<uint64_t>& pairs : rangePairs_) {
+			pairs_.insert(pairs_.end(), pairs.begin(), pairs.end());
+		}
+	}
+	else {
+		Sweep(0, count, pairs_);
+	}
+	std::sort(pairs_.begin(), pairs_.end());
+
+	// --- イベント ---
+	BuildEvents();
+}
+
+void CollisionWorld::UpdateBounds(uint32_t begin, uint32_t end)
+{
+	for (uint32_t index = begin; index < end; ++index) {
+		Collider& collider = colliders_[objectColliders_[index]];
+		const AABB& localBounds = collider.useModelBounds ? collider.object->GetLocalBounds() : collider.localBounds;
+		collider.bounds = Transform(localBounds, collider.object->GetWorldMatrix());
+	}
+}
+
+void CollisionWorld::SortAlongAxis()
+{
+	uint32_t count = uint32_t(order_.size());
+
+	// --- 中心の分散が一番大きい軸を選ぶ(重なりが減り、掃く範囲が短くなる) ---
+	Vector3 sum{};
+	Vector3 squaredSum{};
+	for (ColliderId id : order_) {
+		const AABB& bounds = colliders_[id].bounds;
+		Vector3 center = bounds.min + bounds.max;
+		sum += center;
+		squaredSum += center * center;
+	}
+	float invCount = count ? 1.0f / float(count) : 0.0f;
+	Vector3 mean = sum * invCount;
+	Vector3 variance = squaredSum * invCount - mean * mean;
+	uint32_t bestAxis = variance.x >= variance.y ? (variance.x >= variance.z ? 0 : 2) : (variance.y >= variance.z ? 1 : 2);
+	bool isAxisChanged = false;
+	if (bestAxis != axis_ && GetAxis(variance, bestAxis) > GetAxis(variance, axis_) * kAxisSwitchRatio) {
+		axis_ = bestAxis;
+		isAxisChanged = true;
+	}
+
+	// --- 並べ直す ---
+	bool isSorted = false;
+	if (!isAxisChanged && addedCount_ <= count / 8) {
+		// 前フレームの並びはほぼ揃っているので挿入ソートで直す
+		std::vector<float>& keys = sortedMin_[0];
+		keys.resize(count);
+		uint64_t shiftCount = 0;
+		uint32_t i = 0;
+		for (; i < count && shiftCount <= count * kMaxInsertionShifts; ++i) {
+			ColliderId id = order_[i];
+			float key = GetAxis(colliders_[id].bounds.min, axis_);
+			uint32_t j = i;
+			for (; j > 0 && keys[j - 1] > key; --j) {
+				keys[j] = keys[j - 1];
+				order_[j] = order_[j - 1];
+			}
+			keys[j] = key;
+			order_[j] = id;
+			shiftCount += i - j;
+		}
+		isSorted = i == count;
+	}
+	if (!isSorted) {
+		// 前の並びが使えないときはまとめてソート
+		std::sort(order_.begin(), order_.end(), [this](ColliderId a, ColliderId b) {
+			return GetAxis(colliders_[a].bounds.min, axis_) < GetAxis(colliders_[b].bounds.min, axis_);
+		});
+	}
+	addedCount_ = 0;
+
+	// --- 掃くときに使うものを並び順に詰める ---
+	uint32_t axes[3] = { axis_, (axis_ + 1) % 3, (axis_ + 2) % 3 };
+	for (uint32_t k = 0; k < 3; ++k) {
+		sortedMin_[k].resize(count);
+		sortedMax_[k].resize(count);
+	}
+	sortedLayers_.resize(count);
+	sortedMasks_.resize(count);
+	for (uint32_t i = 0; i < count; ++i) {
+		const Collider& collider = colliders_[order_[i]];
+		for (uint32_t k = 0; k < 3; ++k) {
+			sortedMin_[k][i] = GetAxis(collider.bounds.min, axes[k]);
+			sortedMax_[k][i] = GetAxis(collider.bounds.max, axes[k]);
+		}
+		sortedLayers_[i] = collider.layer;
+		sortedMasks_[i] = collider.collideMask;
+	}
+}
+
+void CollisionWorld::Sweep(uint32_t begin, uint32_t end, std::vector<uint64_t>& pairs) const
+{
+	uint32_t count = uint32_t(order_.size());
+	const float* min0 = sortedMin_[0].data();
+	const float* max0 = sortedMax_[0].data();
+	const float* min1 = sortedMin_[1].data();
+	const float* max1 = sortedMax_[1].data();
+	const float* min2 = sortedMin_[2].data();
+	const float* max2 = sortedMax_[2].data();
+
+	// 残りの軸でも重なっていて、レイヤーが合えば組にする
+	auto addPair = [&](uint32_t i, uint32_t j) {
+		if ((sortedLayers_[i] & sortedMasks_[j]) && (sortedLayers_[j] & sortedMasks_[i])) {
+			pairs.push_back(MakePairKey(order_[i], order_[j]));
+		}
+	};
+
+	for (uint32_t i = begin; i < end; ++i) {
+		// 掃く軸の上でiの範囲に始まるものだけが重なりうる(並んでいるので、範囲を出たら終わり)
+		__m128 max = _mm_set1_ps(max0[i]);
+		__m128 iMin1 = _mm_set1_ps(min1[i]);
+		__m128 iMax1 = _mm_set1_ps(max1[i]);
+		__m128 iMin2 = _mm_set1_ps(min2[i]);
+		__m128 iMax2 = _mm_set1_ps(max2[i]);
+		uint32_t j = i + 1;
+		for (; j + 4 <= count; j += 4) {
+			__m128 inRange = _mm_cmple_ps(_mm_loadu_ps(min0 + j), max);
+			int rangeMask = _mm_movemask_ps(inRange);
+			__m128 overlap = _mm_and_ps(inRange, _mm_and_ps(
+				_mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(min1 + j), iMax1), _mm_cmpge_ps(_mm_loadu_ps(max1 + j), iMin1)),
+				_mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(min2 + j), iMax2), _mm_cmpge_ps(_mm_loadu_ps(max2 + j), iMin2))));
+			for (uint32_t bits = uint32_t(_mm_movemask_ps(overlap)); bits; bits &= bits - 1) {
+				addPair(i, j + std::countr_zero(bits));
+			}
+			if (rangeMask != 0xF) {
+				break;
+			}
+		}
+		if (j + 4 > count) {
+			for (; j < count && min0[j] <= max0[i]; ++j) {
+				if (min1[j] <= max1[i] && max1[j] >= min1[i] && min2[j] <= max2[i] && max2[j] >= min2[i]) {
+					addPair(i, j);
+				}
+			}
+		}
+	}
+}
+
+void CollisionWorld::BuildEvents()
+{
+	// どちらもソート済みなので、並べて比べるだけで済む
+	events_.clear();
+	auto push = [this](EventType type, uint64_t key) {
+		events_.push_back({ type, ColliderId(key >> 32), ColliderId(key & UINT32_MAX) });
+	};
+	size_t current = 0;
+	size_t previous = 0;
+	while (current < pairs_.size() || previous < previousPairs_.size()) {
+		if (previous == previousPairs_.size() || (current < pairs_.size() && pairs_[current] < previousPairs_[previous])) {
+			push(EventType::Enter, pairs_[current++]);
+		}
+		else if (current == pairs_.size() || previousPairs_[previous] < pairs_[current]) {
+			push(EventType::Exit, previousPairs_[previous++]);
+		}
+		else {
+			push(EventType::Stay, pairs_[current++]);
+			++previous;
+		}
+	}
+}
@@ -0,0 +1,134 @@
+#pragma once
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "Intersection.h"
+#include "ThreadPool.h"
+
+class Object3d;
+
+// 当たり判定の管理(ブロードフェーズ)
+// 登録したコライダーのワールドAABBを毎フレーム求め、Sweep and Pruneで重なっている組を見つける
+// 並びは前フレームのものを挿入ソートで直すので、少しずつ動く物が多いときはほぼO(n)で済む
+// 組ごとに前フレームと比べて、重なり始め・重なり中・離れたのイベントを出す
+class CollisionWorld
+{
+public:
+	// コライダー番号(削除後、次の次のUpdateまでは再利用されない)
+	using ColliderId = uint32_t;
+	static const ColliderId kInvalidCollider = UINT32_MAX;
+
+	// 全てのレイヤー
+	static const uint32_t kAllLayers = UINT32_MAX;
+
+	// 並列に掃く最小のコライダー数(これより少なければ1スレッドで行う)
+	static const uint32_t kMinParallelColliders = 4096;
+
+	// イベントの種類
+	enum class EventType {
+		Enter,	// 重なり始めた
+		Stay,	// 重なっている
+		Exit,	// 離れた(どちらかが削除されたときも出る)
+	};
+
+	// イベント(collider1 < collider2)
+	struct Event {
+		EventType type;
+		ColliderId collider1;
+		ColliderId collider2;
+	};
+
+public:
+	// --- コライダーの登録 ---
+	// 互いのlayerが相手のcollideMaskに含まれる組だけを判定する
+	// Object3dのモデルの箱を使う(ワールド行列はObject3dのUpdateで更新されたもの)
+	ColliderId AddCollider(Object3d* object, uint32_t layer = 1, uint32_t collideMask = kAllLayers);
+	// Object3dに任意の箱(ローカル座標)を付ける
+	ColliderId AddCollider(Object3d* object, const AABB& localBounds, uint32_t layer, uint32_t collideMask);
+	// Object3dを持たない箱(ワールド座標。SetBoundsで動かす)
+	ColliderId AddCollider(const AABB& bounds, uint32_t layer, uint32_t collideMask);
+
+	// 削除(重なっていた組は次のUpdateでExitになる)
+	void RemoveCollider(ColliderId collider);
+
+	// レイヤーの変更
+	void SetLayer(ColliderId collider, uint32_t layer, uint32_t collideMask);
+	// 箱の変更(Object3dを持たないもの)
+	void SetBounds(ColliderId collider, const AABB& bounds);
+
+	// 全て削除(イベントも出さずに消す)
+	void Clear();
+
+	// 判定(threadPoolを渡すと箱の更新と掃き出しを並列に行う)
+	void Update(ThreadPool* threadPool = nullptr);
+
+public:
+	// 直前のUpdateで出たイベント
+	std::span<const Event> GetEvents() const { return events_; }
+
+	// コライダーのObject3d(持たない・削除済みならnullptr。GetObjectはwindows.hのマクロと被るのでこの名前)
+	Object3d* GetObject3d(ColliderId collider) const { return colliders_[collider].object; }
+	// ワールド座標の箱(直前のUpdateのもの)
+	const AABB& GetBounds(ColliderId collider) const { return colliders_[collider].bounds; }
+	// 有効か
+	bool IsAlive(ColliderId collider) const { return collider < colliders_.size() && colliders_[collider].isAlive; }
+
+	// コライダー数
+	uint32_t GetColliderCount() const { return uint32_t(order_.size()); }
+	// 重なっている組の数
+	uint32_t GetPairCount() const { return uint32_t(pairs_.size()); }
+
+private:
+	// コライダー
+	struct Collider {
+		Object3d* object = nullptr;
+		AABB localBounds{};
+		AABB bounds{};
+		uint32_t layer = 0;
+		uint32_t collideMask = 0;
+		bool useModelBounds = false;
+		bool isAlive = false;
+	};
+
+	// 番号を割り当てる
+	ColliderId Allocate(const Collider& collider);
+
+	// Object3dを持つものの箱を更新
+	void UpdateBounds(uint32_t begin, uint32_t end);
+	// 掃く軸を選んで並べ直す
+	void SortAlongAxis();
+	// 並び順の[begin, end)から始まる組を集める
+	void Sweep(uint32_t begin, uint32_t end, std::vector<uint64_t>& pairs) const;
+	// 前フレームの組と比べてイベントを作る
+	void BuildEvents();
+
+	// 組のキー(小さい番号を上位に置く)
+	static uint64_t MakePairKey(ColliderId a, ColliderId b) {
+		return a < b ? (uint64_t(a) << 32 | b) : (uint64_t(b) << 32 | a);
+	}
+
+private:
+	// --- 番号で引くデータ ---
+	std::vector<Collider> colliders_;
+	std::vector<ColliderId> freeColliders_;
+	std::vector<ColliderId> removedColliders_;		// 前回のUpdateの後に削除されたもの
+	std::vector<ColliderId> releasingColliders_;	// 次のUpdateで再利用できるようになるもの
+	std::vector<ColliderId> objectColliders_;	// Object3dを持つもの
+	bool isObjectListDirty_ = false;
+
+	// --- 掃く軸の順に並んだデータ ---
+	uint32_t axis_ = 0;
+	uint32_t addedCount_ = 0;	// 前回から追加された数(多ければ並べ直す)
+	std::vector<ColliderId> order_;
+	std::vector<float> sortedMin_[3];	// [0]が掃く軸、[1][2]が残りの軸(SIMDで4つずつ比べる)
+	std::vector<float> sortedMax_[3];
+	std::vector<uint32_t> sortedLayers_;
+	std::vector<uint32_t> sortedMasks_;
+
+	// --- 組とイベント ---
+	std::vector<uint64_t> pairs_;
+	std::vector<uint64_t> previousPairs_;
+	std::vector<std::vector<uint64_t>> rangePairs_;	// 並列に集めるときの範囲ごとの組
+	std::vector<Event> events_;
+};
@@ -0,0 +1,102 @@
+#include "Archetype.h"
+#include <algorithm>
+#include <cassert>
+
+namespace
+{
+	size_t AlignUp(size_t value, size_t alignment)
+	{
+		return (value + alignment - 1) & ~(alignment - 1);
+	}
+}
+
+Archetype::Archetype(ComponentMask mask, std::vector<const ComponentTypeInfo*> types)
+	: mask_(mask), types_(std::move(types))
+{
+	// --- 型番号順に並べる(同じ組み合わせなら同じレイアウトになる) ---
+	std::sort(types_.begin(), types_.end(), [](const ComponentTypeInfo* a, const ComponentTypeInfo* b) { return a->id < b->id; });
+	columnOfType_.fill(-1);
+	for (uint32_t column = 0; column < types_.size(); ++column) {
+		assert(types_[column]->alignment <= kChunkAlignment);
+		columnOfType_[types_[column]->id] = int8_t(column);
+	}
+
+	// --- 1チャンクに入る行数を求める ---
+	size_t rowSize = sizeof(Entity);
+	for (const ComponentTypeInfo* type : types_) {
+		rowSize += type->size;
+	}
+	columnOffsets_.resize(types_.size());
+	for (rowsPerChunk_ = uint32_t(kChunkSize / rowSize); rowsPerChunk_ > 1; --rowsPerChunk_) {
+		// 列ごとのアラインメントの詰め物を足してチャンクに収まるか
+		size_t offset = sizeof(Entity) * rowsPerChunk_;
+		for (uint32_t column = 0; column < types_.size(); ++column) {
+			offset = AlignUp(offset, types_[column]->alignment);
+			columnOffsets_[column] = offset;
+			offset += types_[column]->size * rowsPerChunk_;
+		}
+		if (offset <= kChunkSize) {
+			break;
+		}
+	}
+	assert(rowsPerChunk_ > 1);
+}
+
+Archetype::~Archetype()
+{
+	Clear();
+}
+
+uint32_t Archetype::PushBack(Entity entity)
+{
+	// --- 最後のチャンクが満杯なら追加 ---
+	if (entityCount_ == chunks_.size() * rowsPerChunk_) {
+		chunks_.emplace_back(static_cast<std::byte*>(::operator new[](kChunkSize, std::align_val_t(kChunkAlignment))));
+	}
+
+	uint32_t row = entityCount_++;
+	GetEntities(row / rowsPerChunk_)[row % rowsPerChunk_] = entity;
+	return row;
+}
+
+Entity Archetype::RemoveSwapBack(uint32_t row)
+{
+	assert(row < entityCount_);
+	uint32_t last = entityCount_ - 1;
+
+	// --- 消す行を破棄し、末尾の行を移す ---
+	DestroyRow(row);
+	Entity moved{};
+	if (row != last) {
+		for (uint32_t column = 0; column < types_.size(); ++column) {
+			void* source = GetComponent(column, last);
+			types_[column]->moveConstruct(GetComponent(column, row), source);
+			types_[column]->destroy(source);
+		}
+		moved = GetEntity(last);
+		GetEntities(row / rowsPerChunk_)[row % rowsPerChunk_] = moved;
+	}
+	entityCount_--;
+
+	// --- 空になったチャンクを返す(増減を繰り返す場合に備えて1つは残す) ---
+	if (chunks_.size() > 1 && entityCount_ <= (chunks_.size() - 2) * rowsPerChunk_) {
+		chunks_.pop_back();
+	}
+	return moved;
+}
+
+void Archetype::Clear()
+{
+	for (uint32_t row = 0; row < entityCount_; ++row) {
+		DestroyRow(row);
+	}
+	entityCount_ = 0;
+	chunks_.clear();
+}
+
+void Archetype::DestroyRow(uint32_t row)
+{
+	for (uint32_t column = 0; column < types_.size(); ++column) {
+		types_[column]->destroy(GetComponent(column, row));
+	}
+}
@@ -0,0 +1,101 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "Entity.h"
+
+// アーキタイプ(同じコンポーネントの組み合わせを持つエンティティの集まり)
+// 固定サイズのチャンクに、コンポーネントごとの配列として詰めて並べる
+// 削除は末尾の行で穴を埋めるので、最後のチャンク以外は常に満杯になる
+class Archetype
+{
+public:
+	// チャンクのバイト数(L1/L2に収まる程度)
+	static const size_t kChunkSize = 16 * 1024;
+	// チャンク先頭のアラインメント(キャッシュライン)
+	static const size_t kChunkAlignment = 64;
+
+public:
+	Archetype(ComponentMask mask, std::vector<const ComponentTypeInfo*> types);
+	~Archetype();
+	Archetype(const Archetype&) = delete;
+	Archetype& operator=(const Archetype&) = delete;
+
+public:
+	// 末尾に行を追加して行番号を返す(コンポーネントは未構築。呼び出し側が全て構築する)
+	uint32_t PushBack(Entity entity);
+
+	// 行を削除して末尾の行で埋める(コンポーネントは破棄される)
+	// 移動してきたエンティティを返す(末尾を消した場合は無効なEntity)
+	Entity RemoveSwapBack(uint32_t row);
+
+	// 全ての行を破棄
+	void Clear();
+
+public:
+	// 列番号(持っていなければ-1)
+	int32_t GetColumn(uint32_t typeId) const { return columnOfType_[typeId]; }
+	// 列の型情報
+	const ComponentTypeInfo& GetColumnType(uint32_t column) const { return *types_[column]; }
+	uint32_t GetColumnCount() const { return uint32_t(types_.size()); }
+
+	// 行のコンポーネント
+	void* GetComponent(uint32_t column, uint32_t row) const {
+		return chunks_[row / rowsPerChunk_].get() + columnOffsets_[column] + types_[column]->size * (row % rowsPerChunk_);
+	}
+	// 行のエンティティ
+	Entity GetEntity(uint32_t row) const { return GetEntities(row / rowsPerChunk_)[row % rowsPerChunk_]; }
+
+	// チャンク内の列の先頭(チャンク内ではcount個が連続して並ぶ)
+	template<typename T>
+	T* GetArray(uint32_t chunkIndex, uint32_t column) const {
+		return reinterpret_cast<T*>(chunks_[chunkIndex].get() + columnOffsets_[column]);
+	}
+	// チャンク内のエンティティの先頭
+	Entity* GetEntities(uint32_t chunkIndex) const { return reinterpret_cast<Entity*>(chunks_[chunkIndex].get()); }
+	// チャンク内の行数(末尾に空のチャンクが残っている場合は0)
+	uint32_t GetChunkEntityCount(uint32_t chunkIndex) const {
+		uint32_t begin = chunkIndex * rowsPerChunk_;
+		return entityCount_ <= begin ? 0 : (std::min)(entityCount_ - begin, rowsPerChunk_);
+	}
+
+public:
+	ComponentMask GetMask() const { return mask_; }
+	uint32_t GetEntityCount() const { return entityCount_; }
+	uint32_t GetChunkCount() const { return uint32_t(chunks_.size()); }
+	uint32_t GetRowsPerChunk() const { return rowsPerChunk_; }
+
+	// コンポーネントを1つ足した・外した先のアーキタイプ(Worldが記録する)
+	std::unordered_map<uint32_t, Archetype*>& GetAddEdges() { return addEdges_; }
+	std::unordered_map<uint32_t, Archetype*>& GetRemoveEdges() { return removeEdges_; }
+
+private:
+	// チャンク用のメモリ(キャッシュラインに揃える)
+	struct ChunkDeleter {
+		void operator()(std::byte* chunk) const { ::operator delete[](chunk, std::align_val_t(kChunkAlignment)); }
+	};
+	using ChunkPtr = std::unique_ptr<std::byte[], ChunkDeleter>;
+
+	// 行の全ての列を破棄
+	void DestroyRow(uint32_t row);
+
+private:
+	ComponentMask mask_ = 0;
+	std::vector<const ComponentTypeInfo*> types_;
+	std::array<int8_t, ComponentType::kMaxCount> columnOfType_;
+
+	// チャンク内のレイアウト([Entity × rows][列0 × rows][列1 × rows]...)
+	std::vector<size_t> columnOffsets_;
+	uint32_t rowsPerChunk_ = 0;
+
+	std::vector<ChunkPtr> chunks_;
+	uint32_t entityCount_ = 0;
+
+	std::unordered_map<uint32_t, Archetype*> addEdges_;
+	std::unordered_map<uint32_t, Archetype*> removeEdges_;
+};
@@ -0,0 +1,24 @@
+#pragma once
+#include "Vector3.h"
+
+class Object3d;
+class Sprite;
+
+// --- 描画と橋渡しする標準コンポーネント ---
+
+// 位置・回転・拡縮
+struct TransformComponent {
+	Vector3 scale{ 1.0f, 1.0f, 1.0f };
+	Vector3 rotate{};
+	Vector3 translate{};
+};
+
+// 3Dモデルの描画(モデルと定数バッファはObject3dが持つ。ObjectPoolやシーンのメモリ領域から割り当てる)
+struct RenderableComponent {
+	Object3d* object = nullptr;
+};
+
+// スプライトの描画(Transformのtranslateのxyを位置、rotateのzを回転として使う)
+struct SpriteComponent {
+	Sprite* sprite = nullptr;
+};
@@ -0,0 +1,64 @@
+#pragma once
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <new>
+#include <utility>
+
+// エンティティ(スロット番号と世代の組。破棄されたスロットが再利用されても古いEntityは無効になる)
+struct Entity {
+	uint32_t index = UINT32_MAX;
+	uint32_t generation = 0;
+
+	bool IsValid() const { return index != UINT32_MAX; }
+	bool operator==(const Entity& other) const { return index == other.index && generation == other.generation; }
+};
+
+// コンポーネントの組み合わせ(1ビットが1種類)
+using ComponentMask = uint64_t;
+
+// コンポーネントの型情報(アーキタイプが型を知らずに移動・破棄するため)
+struct ComponentTypeInfo {
+	uint32_t id;
+	size_t size;
+	size_t alignment;
+	void (*moveConstruct)(void* destination, void* source);
+	void (*destroy)(void* component);
+};
+
+namespace ComponentType
+{
+	// 扱えるコンポーネントの種類数(ComponentMaskのビット数)
+	static const uint32_t kMaxCount = 64;
+
+	// 新しい型番号を振る
+	inline uint32_t NextId()
+	{
+		static std::atomic<uint32_t> counter = 0;
+		uint32_t id = counter++;
+		assert(id < kMaxCount);
+		return id;
+	}
+
+	// 型ごとの情報(初回呼び出しで番号が決まる)
+	template<typename T>
+	const ComponentTypeInfo& GetInfo()
+	{
+		static const ComponentTypeInfo info{
+			NextId(),
+			sizeof(T),
+			alignof(T),
+			[](void* destination, void* source) { new (destination) T(std::move(*static_cast<T*>(source))); },
+			[](void* component) { static_cast<T*>(component)->~T(); },
+		};
+		return info;
+	}
+
+	// 型番号
+	template<typename T>
+	uint32_t GetId() { return GetInfo<T>().id; }
+
+	// 型の組み合わせのマスク
+	template<typename... Ts>
+	ComponentMask GetMask() { return (ComponentMask(0) | ... | (ComponentMask(1) << GetId<Ts>())); }
+}
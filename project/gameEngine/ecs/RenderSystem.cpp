@@ -0,0 +1,49 @@
+#include "RenderSystem.h"
+#include "Object3d.h"
+#include "Sprite.h"
+
+namespace
+{
+	void UpdateObject(const TransformComponent& transform, RenderableComponent& renderable)
+	{
+		renderable.object->SetSize(transform.scale);
+		renderable.object->SetRotate(transform.rotate);
+		renderable.object->SetPosition(transform.translate);
+		renderable.object->Update();
+	}
+
+	void UpdateSprite(const TransformComponent& transform, SpriteComponent& sprite)
+	{
+		sprite.sprite->SetPosition({ transform.translate.x, transform.translate.y });
+		sprite.sprite->SetRotate(transform.rotate.z);
+		sprite.sprite->Update();
+	}
+}
+
+void RenderSystem::Update(World& world, ThreadPool* threadPool)
+{
+	// 各エンティティは自分のObject3d・Spriteにしか書き込まないので並列にしてよい
+	if (threadPool) {
+		world.ParallelForEach<TransformComponent, RenderableComponent>(*threadPool, UpdateObject);
+		world.ParallelForEach<TransformComponent, SpriteComponent>(*threadPool, UpdateSprite);
+	}
+	else {
+		world.ForEach<TransformComponent, RenderableComponent>(UpdateObject);
+		world.ForEach<TransformComponent, SpriteComponent>(UpdateSprite);
+	}
+}
+
+void RenderSystem::DrawObjects(World& world)
+{
+	// コマンドリストへの記録は1スレッドで行う
+	world.ForEach<RenderableComponent>([](RenderableComponent& renderable) {
+		renderable.object->Draw();
+		});
+}
+
+void RenderSystem::DrawSprites(World& world)
+{
+	world.ForEach<SpriteComponent>([](SpriteComponent& sprite) {
+		sprite.sprite->Draw();
+		});
+}
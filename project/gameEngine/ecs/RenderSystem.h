@@ -0,0 +1,19 @@
+#pragma once
+#include "Components.h"
+#include "ThreadPool.h"
+#include "World.h"
+
+// ECSのコンポーネントを既存の描画(Object3d・Sprite)に反映するシステム
+class RenderSystem
+{
+public:
+	// TransformをObject3d・Spriteに書き込んで定数バッファを更新する
+	// threadPoolを渡すとチャンクごとに並列に処理する(カメラの更新は先に済ませておく)
+	static void Update(World& world, ThreadPool* threadPool = nullptr);
+
+	// 3Dオブジェクトの描画(Object3dCommon::CommonDrawingの後に呼ぶ)
+	static void DrawObjects(World& world);
+
+	// スプライトの描画(SpriteCommon::CommonDrawingの後に呼ぶ)
+	static void DrawSprites(World& world);
+};
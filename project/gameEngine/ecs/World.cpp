@@ -0,0 +1,143 @@
+#include "World.h"
+#include <bit>
+
+World::~World()
+{
+	Clear();
+}
+
+void World::DestroyEntity(Entity entity)
+{
+	assert(iterationDepth_ == 0);
+	if (!IsAlive(entity)) {
+		return;
+	}
+
+	// --- 行を削除してスロットを返す(世代を進めて古いEntityを無効にする) ---
+	EntityRecord& record = records_[entity.index];
+	RemoveRow(record.archetype, record.row);
+	record.archetype = nullptr;
+	record.generation++;
+	freeIndices_.push_back(entity.index);
+	entityCount_--;
+}
+
+void World::Clear()
+{
+	assert(iterationDepth_ == 0);
+
+	// --- コンポーネントを破棄(アーキタイプは次に使うため残す) ---
+	for (Archetype* archetype : archetypes_) {
+		archetype->Clear();
+	}
+
+	// --- 生存していたスロットを全て返す ---
+	for (uint32_t index = 0; index < records_.size(); ++index) {
+		if (records_[index].archetype) {
+			records_[index].archetype = nullptr;
+			records_[index].generation++;
+			freeIndices_.push_back(index);
+		}
+	}
+	entityCount_ = 0;
+}
+
+Archetype* World::GetOrCreateArchetype(ComponentMask mask, std::vector<const ComponentTypeInfo*> types)
+{
+	auto it = archetypeOfMask_.find(mask);
+	if (it != archetypeOfMask_.end()) {
+		return it->second.get();
+	}
+
+	// 同じ型を2つ持つ組み合わせは作れない
+	assert(size_t(std::popcount(mask)) == types.size());
+	auto archetype = std::make_unique<Archetype>(mask, std::move(types));
+	Archetype* result = archetype.get();
+	archetypeOfMask_.emplace(mask, std::move(archetype));
+	archetypes_.push_back(result);
+	return result;
+}
+
+Archetype* World::GetAddArchetype(Archetype* archetype, const ComponentTypeInfo& type)
+{
+	// --- 一度辿った組み合わせは記録から引く ---
+	auto& edges = archetype->GetAddEdges();
+	auto it = edges.find(type.id);
+	if (it != edges.end()) {
+		return it->second;
+	}
+
+	std::vector<const ComponentTypeInfo*> types;
+	for (uint32_t column = 0; column < archetype->GetColumnCount(); ++column) {
+		types.push_back(&archetype->GetColumnType(column));
+	}
+	types.push_back(&type);
+	Archetype* result = GetOrCreateArchetype(archetype->GetMask() | (ComponentMask(1) << type.id), std::move(types));
+	edges.emplace(type.id, result);
+	return result;
+}
+
+Archetype* World::GetRemoveArchetype(Archetype* archetype, const ComponentTypeInfo& type)
+{
+	auto& edges = archetype->GetRemoveEdges();
+	auto it = edges.find(type.id);
+	if (it != edges.end()) {
+		return it->second;
+	}
+
+	std::vector<const ComponentTypeInfo*> types;
+	for (uint32_t column = 0; column < archetype->GetColumnCount(); ++column) {
+		if (archetype->GetColumnType(column).id != type.id) {
+			types.push_back(&archetype->GetColumnType(column));
+		}
+	}
+	Archetype* result = GetOrCreateArchetype(archetype->GetMask() & ~(ComponentMask(1) << type.id), std::move(types));
+	edges.emplace(type.id, result);
+	return result;
+}
+
+Entity World::AllocateEntity()
+{
+	Entity entity;
+	if (!freeIndices_.empty()) {
+		entity.index = freeIndices_.back();
+		freeIndices_.pop_back();
+	}
+	else {
+		entity.index = uint32_t(records_.size());
+		records_.emplace_back();
+	}
+	entity.generation = records_[entity.index].generation;
+	entityCount_++;
+	return entity;
+}
+
+uint32_t World::MoveEntity(Entity entity, Archetype* destination)
+{
+	EntityRecord& record = records_[entity.index];
+	Archetype* source = record.archetype;
+
+	// --- 移動先に行を追加して共通の列をムーブ ---
+	uint32_t row = destination->PushBack(entity);
+	for (uint32_t column = 0; column < destination->GetColumnCount(); ++column) {
+		const ComponentTypeInfo& type = destination->GetColumnType(column);
+		int32_t sourceColumn = source->GetColumn(type.id);
+		if (sourceColumn >= 0) {
+			type.moveConstruct(destination->GetComponent(column, row), source->GetComponent(sourceColumn, record.row));
+		}
+	}
+
+	// --- 元の行を削除(ムーブ済みの抜け殻と外したコンポーネントはここで破棄される) ---
+	RemoveRow(source, record.row);
+	record.archetype = destination;
+	record.row = row;
+	return row;
+}
+
+void World::RemoveRow(Archetype* archetype, uint32_t row)
+{
+	Entity moved = archetype->RemoveSwapBack(row);
+	if (moved.IsValid()) {
+		records_[moved.index].row = row;
+	}
+}
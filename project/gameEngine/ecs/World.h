@@ -0,0 +1,249 @@
+#pragma once
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "Archetype.h"
+#include "Entity.h"
+#include "ThreadPool.h"
+
+// エンティティとコンポーネントの管理
+// コンポーネントの組み合わせごとのアーキタイプに詰めて持ち、クエリはチャンク単位で連続したメモリを回す
+// 巡回中にエンティティの生成・破棄・コンポーネントの追加・削除はできない
+class World
+{
+public:
+	World() = default;
+	~World();
+	World(const World&) = delete;
+	World& operator=(const World&) = delete;
+
+public:
+	// エンティティの生成
+	template<typename... Ts>
+	Entity CreateEntity(Ts&&... components);
+
+	// エンティティの破棄
+	void DestroyEntity(Entity entity);
+
+	// 生存しているか
+	bool IsAlive(Entity entity) const {
+		return entity.index < records_.size() && records_[entity.index].generation == entity.generation && records_[entity.index].archetype;
+	}
+
+	// 全てのエンティティを破棄
+	void Clear();
+
+public:
+	// コンポーネントの追加(既に持っていれば上書き)
+	template<typename T>
+	T& AddComponent(Entity entity, T component);
+
+	// コンポーネントの削除
+	template<typename T>
+	void RemoveComponent(Entity entity);
+
+	// コンポーネントの取得(持っていなければnullptr)
+	template<typename T>
+	T* GetComponent(Entity entity) const;
+
+	// コンポーネントを持っているか
+	template<typename T>
+	bool HasComponent(Entity entity) const { return GetComponent<T>(entity) != nullptr; }
+
+public:
+	// Tsを全て持つエンティティを巡回(func(Ts&...) または func(Entity, Ts&...))
+	template<typename... Ts, typename F>
+	void ForEach(F&& func);
+
+	// チャンクごとに巡回(func(count, Entity*, Ts*...)。配列をまとめて処理したいとき用)
+	template<typename... Ts, typename F>
+	void ForEachChunk(F&& func);
+
+	// チャンクをワーカーに分けて巡回(funcは別々のエンティティに対して並列に呼ばれる)
+	template<typename... Ts, typename F>
+	void ParallelForEach(ThreadPool& threadPool, F&& func);
+
+public:
+	// 生存しているエンティティ数
+	uint32_t GetEntityCount() const { return entityCount_; }
+	// アーキタイプ数
+	uint32_t GetArchetypeCount() const { return uint32_t(archetypes_.size()); }
+
+private:
+	// エンティティの所在
+	struct EntityRecord {
+		Archetype* archetype = nullptr;
+		uint32_t row = 0;
+		uint32_t generation = 0;
+	};
+
+	// 組み合わせのアーキタイプを取得(無ければ作る)
+	Archetype* GetOrCreateArchetype(ComponentMask mask, std::vector<const ComponentTypeInfo*> types);
+	// 1種類足した・外した先のアーキタイプ
+	Archetype* GetAddArchetype(Archetype* archetype, const ComponentTypeInfo& type);
+	Archetype* GetRemoveArchetype(Archetype* archetype, const ComponentTypeInfo& type);
+
+	// スロットの確保
+	Entity AllocateEntity();
+	// 別のアーキタイプへ移す(共通の列はムーブ、増えた列は未構築のまま。新しい行番号を返す)
+	uint32_t MoveEntity(Entity entity, Archetype* destination);
+	// 行を削除し、埋めるために移動したエンティティの所在を直す
+	void RemoveRow(Archetype* archetype, uint32_t row);
+
+	// Tsを全て持つチャンクを巡回(func(archetype, chunkIndex))
+	template<typename... Ts, typename F>
+	void ForEachMatchingChunk(F&& func);
+
+	// Tsの配列を並べて呼ぶ
+	template<typename... Ts, typename F>
+	static void InvokeChunk(Archetype& archetype, uint32_t chunkIndex, F& func);
+
+private:
+	std::vector<EntityRecord> records_;
+	std::vector<uint32_t> freeIndices_;
+	uint32_t entityCount_ = 0;
+
+	std::unordered_map<ComponentMask, std::unique_ptr<Archetype>> archetypeOfMask_;
+	std::vector<Archetype*> archetypes_;
+
+	// 並列巡回で分配するチャンク(毎回確保しないように使い回す)
+	std::vector<std::pair<Archetype*, uint32_t>> parallelChunks_;
+
+	// 巡回中の深さ(構造を変える操作を禁止する)
+	uint32_t iterationDepth_ = 0;
+};
+
+template<typename... Ts>
+Entity World::CreateEntity(Ts&&... components)
+{
+	assert(iterationDepth_ == 0);
+	Entity entity = AllocateEntity();
+
+	// --- 組み合わせのアーキタイプに行を追加してコンポーネントを構築 ---
+	Archetype* archetype = GetOrCreateArchetype(
+		ComponentType::GetMask<std::decay_t<Ts>...>(), { &ComponentType::GetInfo<std::decay_t<Ts>>()... });
+	uint32_t row = archetype->PushBack(entity);
+	(new (archetype->GetComponent(archetype->GetColumn(ComponentType::GetId<std::decay_t<Ts>>()), row))
+		std::decay_t<Ts>(std::forward<Ts>(components)), ...);
+
+	records_[entity.index].archetype = archetype;
+	records_[entity.index].row = row;
+	return entity;
+}
+
+template<typename T>
+T& World::AddComponent(Entity entity, T component)
+{
+	assert(iterationDepth_ == 0);
+	assert(IsAlive(entity));
+
+	// --- 既に持っていれば上書き ---
+	if (T* existing = GetComponent<T>(entity)) {
+		*existing = std::move(component);
+		return *existing;
+	}
+
+	// --- 1つ多いアーキタイプへ移して構築 ---
+	const ComponentTypeInfo& type = ComponentType::GetInfo<T>();
+	Archetype* destination = GetAddArchetype(records_[entity.index].archetype, type);
+	uint32_t row = MoveEntity(entity, destination);
+	return *new (destination->GetComponent(destination->GetColumn(type.id), row)) T(std::move(component));
+}
+
+template<typename T>
+void World::RemoveComponent(Entity entity)
+{
+	assert(iterationDepth_ == 0);
+	assert(IsAlive(entity));
+	if (!HasComponent<T>(entity)) {
+		return;
+	}
+
+	// --- 1つ少ないアーキタイプへ移す(外したコンポーネントは元の行と一緒に破棄される) ---
+	Archetype* destination = GetRemoveArchetype(records_[entity.index].archetype, ComponentType::GetInfo<T>());
+	MoveEntity(entity, destination);
+}
+
+template<typename T>
+T* World::GetComponent(Entity entity) const
+{
+	if (!IsAlive(entity)) {
+		return nullptr;
+	}
+	const EntityRecord& record = records_[entity.index];
+	int32_t column = record.archetype->GetColumn(ComponentType::GetId<T>());
+	return column >= 0 ? static_cast<T*>(record.archetype->GetComponent(column, record.row)) : nullptr;
+}
+
+template<typename... Ts, typename F>
+void World::ForEach(F&& func)
+{
+	ForEachMatchingChunk<Ts...>([&func](Archetype& archetype, uint32_t chunkIndex) {
+		InvokeChunk<Ts...>(archetype, chunkIndex, func);
+		});
+}
+
+template<typename... Ts, typename F>
+void World::ForEachChunk(F&& func)
+{
+	ForEachMatchingChunk<Ts...>([&func](Archetype& archetype, uint32_t chunkIndex) {
+		func(archetype.GetChunkEntityCount(chunkIndex), archetype.GetEntities(chunkIndex),
+			archetype.GetArray<Ts>(chunkIndex, archetype.GetColumn(ComponentType::GetId<Ts>()))...);
+		});
+}
+
+template<typename... Ts, typename F>
+void World::ParallelForEach(ThreadPool& threadPool, F&& func)
+{
+	// --- 対象のチャンクを集める ---
+	parallelChunks_.clear();
+	ForEachMatchingChunk<Ts...>([this](Archetype& archetype, uint32_t chunkIndex) {
+		parallelChunks_.emplace_back(&archetype, chunkIndex);
+		});
+
+	// --- チャンク単位で分配(同じチャンクを2つのワーカーが触ることはない) ---
+	iterationDepth_++;
+	threadPool.ParallelFor(uint32_t(parallelChunks_.size()), [this, &func](uint32_t begin, uint32_t end) {
+		for (uint32_t i = begin; i < end; ++i) {
+			InvokeChunk<Ts...>(*parallelChunks_[i].first, parallelChunks_[i].second, func);
+		}
+		});
+	iterationDepth_--;
+}
+
+template<typename... Ts, typename F>
+void World::ForEachMatchingChunk(F&& func)
+{
+	ComponentMask mask = ComponentType::GetMask<Ts...>();
+	iterationDepth_++;
+	for (Archetype* archetype : archetypes_) {
+		if ((archetype->GetMask() & mask) != mask || archetype->GetEntityCount() == 0) {
+			continue;
+		}
+		for (uint32_t chunkIndex = 0; chunkIndex < archetype->GetChunkCount(); ++chunkIndex) {
+			func(*archetype, chunkIndex);
+		}
+	}
+	iterationDepth_--;
+}
+
+template<typename... Ts, typename F>
+void World::InvokeChunk(Archetype& archetype, uint32_t chunkIndex, F& func)
+{
+	uint32_t count = archetype.GetChunkEntityCount(chunkIndex);
+	[[maybe_unused]] Entity* entities = archetype.GetEntities(chunkIndex);
+	std::tuple<Ts*...> arrays{ archetype.GetArray<Ts>(chunkIndex, archetype.GetColumn(ComponentType::GetId<Ts>()))... };
+	for (uint32_t i = 0; i < count; ++i) {
+		if constexpr (std::is_invocable_v<F&, Entity, Ts&...>) {
+			func(entities[i], std::get<Ts*>(arrays)[i]...);
+		} else {
+			func(std::get<Ts*>(arrays)[i]...);
+		}
+	}
+}
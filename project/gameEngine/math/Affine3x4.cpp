@@ -0,0 +1,117 @@
+#include "Affine3x4.h"
+#include <cmath>
+#include <xmmintrin.h>
+
+namespace
+{
+	// Matrix4x4の並び(行ベクトル)の3行と平行移動から作る
+	Affine3x4 FromRows(const Vector3& row0, const Vector3& row1, const Vector3& row2, const Vector3& translate)
+	{
+		Affine3x4 result = {
+			row0.x, row1.x, row2.x, translate.x,
+			row0.y, row1.y, row2.y, translate.y,
+			row0.z, row1.z, row2.z, translate.z,
+		};
+		return result;
+	}
+}
+
+// 合成
+Affine3x4 Affine3x4::operator*(const Affine3x4& obj) const {
+	// 「thisの後にobj」なので列ベクトルの形では obj * this
+	// 結果のi行 = obj[i][0]*this[0] + obj[i][1]*this[1] + obj[i][2]*this[2] + (0,0,0,obj[i][3])
+	__m128 row0 = _mm_loadu_ps(m[0]);
+	__m128 row1 = _mm_loadu_ps(m[1]);
+	__m128 row2 = _mm_loadu_ps(m[2]);
+
+	Affine3x4 result;
+	for (int i = 0; i < 3; ++i) {
+		__m128 r = _mm_mul_ps(_mm_set1_ps(obj.m[i][0]), row0);
+		r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(obj.m[i][1]), row1));
+		r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(obj.m[i][2]), row2));
+		r = _mm_add_ps(r, _mm_setr_ps(0.0f, 0.0f, 0.0f, obj.m[i][3]));
+		_mm_storeu_ps(result.m[i], r);
+	}
+	return result;
+}
+
+// *=
+Affine3x4& Affine3x4::operator*=(const Affine3x4& obj) {
+	*this = *this * obj;
+	return *this;
+}
+
+// アフィン変換行列
+Affine3x4 MakeAffine3x4(const Vector3& scale, const Vector3& rotate, const Vector3& translate) {
+	// MakeAffineMatrixと同じ Rx * Ry * Rz を展開したもの
+	float cx = std::cos(rotate.x), sx = std::sin(rotate.x);
+	float cy = std::cos(rotate.y), sy = std::sin(rotate.y);
+	float cz = std::cos(rotate.z), sz = std::sin(rotate.z);
+
+	return FromRows(
+		Vector3(cy * cz, cy * sz, -sy) * scale.x,
+		Vector3(sx * sy * cz - cx * sz, sx * sy * sz + cx * cz, sx * cy) * scale.y,
+		Vector3(cx * sy * cz + sx * sz, cx * sy * sz - sx * cz, cx * cy) * scale.z,
+		translate);
+}
+
+// アフィン変換行列(クォータニオン)
+Affine3x4 MakeAffine3x4(const Vector3& scale, const Quaternion& rotate, const Vector3& translate) {
+	float xx = rotate.x * rotate.x, yy = rotate.y * rotate.y, zz = rotate.z * rotate.z;
+	float xy = rotate.x * rotate.y, xz = rotate.x * rotate.z, yz = rotate.y * rotate.z;
+	float wx = rotate.w * rotate.x, wy = rotate.w * rotate.y, wz = rotate.w * rotate.z;
+
+	return FromRows(
+		Vector3(1.0f - 2.0f * (yy + zz), 2.0f * (xy + wz), 2.0f * (xz - wy)) * scale.x,
+		Vector3(2.0f * (xy - wz), 1.0f - 2.0f * (xx + zz), 2.0f * (yz + wx)) * scale.y,
+		Vector3(2.0f * (xz + wy), 2.0f * (yz - wx), 1.0f - 2.0f * (xx + yy)) * scale.z,
+		translate);
+}
+
+// 逆行列
+Affine3x4 Inverse(const Affine3x4& affine) {
+	// 3x3部分Lの逆を余因子で求め、平行移動は -L^-1 * t
+	const float(&a)[3][4] = affine.m;
+	float c00 = a[1][1] * a[2][2] - a[1][2] * a[2][1];
+	float c01 = a[1][2] * a[2][0] - a[1][0] * a[2][2];
+	float c02 = a[1][0] * a[2][1] - a[1][1] * a[2][0];
+	float invDet = 1.0f / (a[0][0] * c00 + a[0][1] * c01 + a[0][2] * c02);
+
+	Affine3x4 result;
+	float(&r)[3][4] = result.m;
+	r[0][0] = c00 * invDet;
+	r[1][0] = c01 * invDet;
+	r[2][0] = c02 * invDet;
+	r[0][1] = (a[0][2] * a[2][1] - a[0][1] * a[2][2]) * invDet;
+	r[1][1] = (a[0][0] * a[2][2] - a[0][2] * a[2][0]) * invDet;
+	r[2][1] = (a[0][1] * a[2][0] - a[0][0] * a[2][1]) * invDet;
+	r[0][2] = (a[0][1] * a[1][2] - a[0][2] * a[1][1]) * invDet;
+	r[1][2] = (a[0][2] * a[1][0] - a[0][0] * a[1][2]) * invDet;
+	r[2][2] = (a[0][0] * a[1][1] - a[0][1] * a[1][0]) * invDet;
+	for (int i = 0; i < 3; ++i) {
+		r[i][3] = -(r[i][0] * a[0][3] + r[i][1] * a[1][3] + r[i][2] * a[2][3]);
+	}
+	return result;
+}
+
+// アフィン変換の後にmatrixを掛ける
+Matrix4x4 Multiply(const Affine3x4& affine, const Matrix4x4& matrix) {
+	// Matrix4x4に直したときの最後の列が(0,0,0,1)なので、
+	// 結果のi行(i<3) = Σk a[k][i]*matrix[k]、3行 = Σk a[k][3]*matrix[k] + matrix[3]
+	const float(&a)[3][4] = affine.m;
+	__m128 row0 = _mm_loadu_ps(matrix.m[0]);
+	__m128 row1 = _mm_loadu_ps(matrix.m[1]);
+	__m128 row2 = _mm_loadu_ps(matrix.m[2]);
+
+	Matrix4x4 result;
+	for (int i = 0; i < 4; ++i) {
+		__m128 r = _mm_mul_ps(_mm_set1_ps(a[0][i]), row0);
+		r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(a[1][i]), row1));
+		r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(a[2][i]), row2));
+		if (i == 3) {
+			r = _mm_add_ps(r, _mm_loadu_ps(matrix.m[3]));
+		}
+		_mm_storeu_ps(result.m[i], r);
+	}
+	return result;
+}
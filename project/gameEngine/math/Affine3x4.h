@@ -0,0 +1,77 @@
+#pragma once
+#include "Matrix4x4.h"
+#include "Quaternion.h"
+#include "Vector3.h"
+
+/// <summary>
+/// アフィン変換行列(最後の列が常に(0,0,0,1)のMatrix4x4を3行4列に詰めたもの)
+/// Matrix4x4の転置を3行分だけ持つので、m[i]は「出力のi成分 = dot(m[i].xyz, v) + m[i][3]」
+/// シェーダーの行優先のfloat3x4とそのまま同じ並びになる
+/// 合成の向きはMatrix4x4と同じで、a * b は「aの後にb」
+/// </summary>
+class Affine3x4 {
+public:
+	float m[3][4];
+
+	// 合成(SIMD)
+	Affine3x4 operator*(const Affine3x4& obj) const;
+	// *=
+	Affine3x4& operator*=(const Affine3x4& obj);
+};
+
+// 単位行列
+[[nodiscard]] constexpr Affine3x4 MakeIdentityAffine3x4() noexcept {
+	return {
+		1.0f, 0.0f, 0.0f, 0.0f,
+		0.0f, 1.0f, 0.0f, 0.0f,
+		0.0f, 0.0f, 1.0f, 0.0f,
+	};
+}
+// アフィン変換行列(MakeAffineMatrixと同じ変換)
+Affine3x4 MakeAffine3x4(const Vector3& scale, const Vector3& rotate, const Vector3& translate);
+// アフィン変換行列(回転はクォータニオン。正規化済みであること)
+Affine3x4 MakeAffine3x4(const Vector3& scale, const Quaternion& rotate, const Vector3& translate);
+
+// Matrix4x4との変換(Matrix4x4の最後の列は捨てる)
+[[nodiscard]] constexpr Matrix4x4 ToMatrix4x4(const Affine3x4& affine) noexcept {
+	const float(&a)[3][4] = affine.m;
+	return {
+		a[0][0], a[1][0], a[2][0], 0.0f,
+		a[0][1], a[1][1], a[2][1], 0.0f,
+		a[0][2], a[1][2], a[2][2], 0.0f,
+		a[0][3], a[1][3], a[2][3], 1.0f,
+	};
+}
+[[nodiscard]] constexpr Affine3x4 ToAffine3x4(const Matrix4x4& matrix) noexcept {
+	const float(&m)[4][4] = matrix.m;
+	return {
+		m[0][0], m[1][0], m[2][0], m[3][0],
+		m[0][1], m[1][1], m[2][1], m[3][1],
+		m[0][2], m[1][2], m[2][2], m[3][2],
+	};
+}
+
+// 逆行列(Matrix4x4のInverseより速い)
+Affine3x4 Inverse(const Affine3x4& affine);
+
+// アフィン変換の後にmatrixを掛ける(ワールド行列×ビュープロジェクション行列用。SIMD)
+Matrix4x4 Multiply(const Affine3x4& affine, const Matrix4x4& matrix);
+
+// 座標変換
+[[nodiscard]] constexpr Vector3 Transform(const Vector3& vector, const Affine3x4& affine) noexcept {
+	const float(&a)[3][4] = affine.m;
+	return {
+		a[0][0] * vector.x + a[0][1] * vector.y + a[0][2] * vector.z + a[0][3],
+		a[1][0] * vector.x + a[1][1] * vector.y + a[1][2] * vector.z + a[1][3],
+		a[2][0] * vector.x + a[2][1] * vector.y + a[2][2] * vector.z + a[2][3],
+	};
+}
+// ベクトル変換(平行移動なし)
+[[nodiscard]] constexpr Vector3 TransformNormal(const Vector3& vector, const Affine3x4& affine) noexcept {
+	const float(&a)[3][4] = affine.m;
+	return {
+		a[0][0] * vector.x + a[0][1] * vector.y + a[0][2] * vector.z,
+		a[1][0] * vector.x + a[1][1] * vector.y + a[1][2] * vector.z,
+		a[2][0] * vector.x + a[2][1] * vector.y + a[2][2] * vector.z,
+	};
+}
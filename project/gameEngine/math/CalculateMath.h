@@ -1,50 +1,127 @@
 #pragma once
 #include "Matrix4x4.h"
+#include "Quaternion.h"
 #include "Vector3.h"
 #include "assert.h"
 #include <cmath>
 
+// 四則演算だけで書けるものはconstexprでここに定義する(インライン展開・コンパイル時計算できる)
+// 三角関数・平方根を使うもの(C++20ではconstexprにできない)と大きいものはCalculateMath.cpp
+
 // 内積
-float Dot(const Vector3& v1, const Vector3& v2);
+[[nodiscard]] constexpr float Dot(const Vector3& v1, const Vector3& v2) noexcept { return v1.x * v2.x + v1.y * v2.y + v1.z * v2.z; }
 // 長さ
-float Length(const Vector3& v);
+[[nodiscard]] float Length(const Vector3& v) noexcept;
 // 正規化 v/||v||
-Vector3 Normalize(const Vector3& v);
+[[nodiscard]] Vector3 Normalize(const Vector3& v) noexcept;
 // クロス積
-Vector3 Cross(const Vector3& v1, const Vector3& v2);
+[[nodiscard]] constexpr Vector3 Cross(const Vector3& v1, const Vector3& v2) noexcept {
+	return { v1.y * v2.z - v1.z * v2.y, v1.z * v2.x - v1.x * v2.z, v1.x * v2.y - v1.y * v2.x };
+}
 // ベクトル変換
-Vector3 TransformNormal(const Vector3& v, const Matrix4x4& m);
+[[nodiscard]] constexpr Vector3 TransformNormal(const Vector3& v, const Matrix4x4& m) noexcept {
+	return {
+		v.x * m.m[0][0] + v.y * m.m[1][0] + v.z * m.m[2][0],
+		v.x * m.m[0][1] + v.y * m.m[1][1] + v.z * m.m[2][1],
+		v.x * m.m[0][2] + v.y * m.m[1][2] + v.z * m.m[2][2],
+	};
+}
 
 // -----行列-----
 // 行列の積
-Matrix4x4 Multiply(const Matrix4x4& m1, const Matrix4x4& m2);
+[[nodiscard]] constexpr Matrix4x4 Multiply(const Matrix4x4& m1, const Matrix4x4& m2) noexcept { return m1 * m2; }
 
 // 平行移動行列
-Matrix4x4 MakeTranslateMatrix(const Vector3& translate);
+[[nodiscard]] constexpr Matrix4x4 MakeTranslateMatrix(const Vector3& translate) noexcept {
+	return {
+		1.0f, 0.0f, 0.0f, 0.0f,
+		0.0f, 1.0f, 0.0f, 0.0f,
+		0.0f, 0.0f, 1.0f, 0.0f,
+		translate.x, translate.y, translate.z, 1.0f,
+	};
+}
 // 拡大縮小行列
-Matrix4x4 MakeScaleMatrix(const Vector3& scale);
+[[nodiscard]] constexpr Matrix4x4 MakeScaleMatrix(const Vector3& scale) noexcept {
+	return {
+		scale.x, 0.0f, 0.0f, 0.0f,
+		0.0f, scale.y, 0.0f, 0.0f,
+		0.0f, 0.0f, scale.z, 0.0f,
+		0.0f, 0.0f, 0.0f, 1.0f,
+	};
+}
 // 回転行列
-Matrix4x4 MakeRotateXMatrix(float radian);
-Matrix4x4 MakeRotateYMatrix(float radian);
-Matrix4x4 MakeRotateZMatrix(float radian);
+[[nodiscard]] Matrix4x4 MakeRotateXMatrix(float radian) noexcept;
+[[nodiscard]] Matrix4x4 MakeRotateYMatrix(float radian) noexcept;
+[[nodiscard]] Matrix4x4 MakeRotateZMatrix(float radian) noexcept;
 // アフィン変換行列
-Matrix4x4 MakeAffineMatrix(const Vector3& scale, const Vector3& rotate, const Vector3& translate);
+[[nodiscard]] Matrix4x4 MakeAffineMatrix(const Vector3& scale, const Vector3& rotate, const Vector3& translate) noexcept;
+// アフィン変換行列(回転はクォータニオン。正規化済みであること)
+[[nodiscard]] Matrix4x4 MakeAffineMatrix(const Vector3& scale, const Quaternion& rotate, const Vector3& translate) noexcept;
 
 // 逆行列
-Matrix4x4 Inverse(const Matrix4x4& m);
+[[nodiscard]] Matrix4x4 Inverse(const Matrix4x4& m) noexcept;
 // 転置行列
-Matrix4x4 Transpose(const Matrix4x4& m);
+[[nodiscard]] constexpr Matrix4x4 Transpose(const Matrix4x4& m) noexcept {
+	Matrix4x4 result{};
+	for (int row = 0; row < 4; row++) {
+		for (int column = 0; column < 4; column++) {
+			result.m[row][column] = m.m[column][row];
+		}
+	}
+	return result;
+}
 // 単位行列の作成
-Matrix4x4 MakeIdentity4x4();
+[[nodiscard]] constexpr Matrix4x4 MakeIdentity4x4() noexcept {
+	return {
+		1.0f, 0.0f, 0.0f, 0.0f,
+		0.0f, 1.0f, 0.0f, 0.0f,
+		0.0f, 0.0f, 1.0f, 0.0f,
+		0.0f, 0.0f, 0.0f, 1.0f,
+	};
+}
 
 // vec * mat
-Vector3 Multiply(const Vector3& vec, const Matrix4x4& mat);
+[[nodiscard]] constexpr Vector3 Multiply(const Vector3& vec, const Matrix4x4& mat) noexcept {
+	Vector3 result;
+	result.x = mat.m[0][0] * vec.x + mat.m[0][1] * vec.y + mat.m[0][2] * vec.z + mat.m[0][3] * 1.0f;
+	result.y = mat.m[1][0] * vec.x + mat.m[1][1] * vec.y + mat.m[1][2] * vec.z + mat.m[1][3] * 1.0f;
+	result.z = mat.m[2][0] * vec.x + mat.m[2][1] * vec.y + mat.m[2][2] * vec.z + mat.m[2][3] * 1.0f;
+	// 念のため、w成分も計算して確認
+	float w = mat.m[3][0] * vec.x + mat.m[3][1] * vec.y + mat.m[3][2] * vec.z + mat.m[3][3] * 1.0f;
+	if (w != 1.0f) {
+		result.x /= w;
+		result.y /= w;
+		result.z /= w;
+	}
+	return result;
+}
 
 // -----座標系-----
 // 透視投影行列
-Matrix4x4 MakePerspectiveFovMatrix(float fovY, float aspectRatio, float nearClip, float farClip);
-Matrix4x4 MakeOrthographicMatrix(float left, float top, float right, float bottom, float nearClip, float farClip);
+[[nodiscard]] Matrix4x4 MakePerspectiveFovMatrix(float fovY, float aspectRatio, float nearClip, float farClip) noexcept;
+[[nodiscard]] constexpr Matrix4x4 MakeOrthographicMatrix(float left, float top, float right, float bottom, float nearClip, float farClip) noexcept {
+	return {
+		2.0f / (right - left), 0.0f, 0.0f, 0.0f,
+		0.0f, 2.0f / (top - bottom), 0.0f, 0.0f,
+		0.0f, 0.0f, 1.0f / (farClip - nearClip), 0.0f,
+		(left + right) / (left - right), (top + bottom) / (bottom - top), nearClip / (nearClip - farClip), 1.0f,
+	};
+}
 // ビューポート変換行列
-Matrix4x4 MakeViewportMatrix(float left, float top, float width, float height, float minDepth, float maxDepth);
+[[nodiscard]] constexpr Matrix4x4 MakeViewportMatrix(float left, float top, float width, float height, float minDepth, float maxDepth) noexcept {
+	return {
+		width / 2, 0.0f, 0.0f, 0.0f,
+		0.0f, -height / 2, 0.0f, 0.0f,
+		0.0f, 0.0f, maxDepth - minDepth, 0.0f,
+		left + (width / 2), top + (height / 2), minDepth, 1.0f,
+	};
+}
 // 座標変換
-Vector3 Transform(const Vector3& vector, const Matrix4x4& matrix);
+[[nodiscard]] constexpr Vector3 Transform(const Vector3& vector, const Matrix4x4& matrix) noexcept {
+	float w = vector.x * matrix.m[0][3] + vector.y * matrix.m[1][3] + vector.z * matrix.m[2][3] + 1.0f * matrix.m[3][3];
+	return {
+		(vector.x * matrix.m[0][0] + vector.y * matrix.m[1][0] + vector.z * matrix.m[2][0] + 1.0f * matrix.m[3][0]) / w,
+		(vector.x * matrix.m[0][1] + vector.y * matrix.m[1][1] + vector.z * matrix.m[2][1] + 1.0f * matrix.m[3][1]) / w,
+		(vector.x * matrix.m[0][2] + vector.y * matrix.m[1][2] + vector.z * matrix.m[2][2] + 1.0f * matrix.m[3][2]) / w,
+	};
+}
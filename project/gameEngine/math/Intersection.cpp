@@ -0,0 +1,247 @@
+#include "Intersection.h"
+#include <cmath>
+#include <emmintrin.h>
+
+#include "CalculateMath.h"
+
+// SIMD版と同じ結果になるよう、1つずつ判定するものも同じ順番で計算する
+// (min/maxはNaNの扱いを_mm_min_ps/_mm_max_psに合わせる)
+
+namespace
+{
+	// 三角形と平行とみなす行列式の大きさ
+	const float kParallelEpsilon = 1.0e-7f;
+
+	float Min(float a, float b) { return a < b ? a : b; }
+	float Max(float a, float b) { return a > b ? a : b; }
+
+	// 4つ分のベクトル
+	struct Vector3M {
+		__m128 x;
+		__m128 y;
+		__m128 z;
+	};
+	Vector3M Load(const Vector3X4& v) { return { _mm_load_ps(v.x), _mm_load_ps(v.y), _mm_load_ps(v.z) }; }
+	Vector3M Splat(const Vector3& v) { return { _mm_set1_ps(v.x), _mm_set1_ps(v.y), _mm_set1_ps(v.z) }; }
+	Vector3M Sub(const Vector3M& a, const Vector3M& b) { return { _mm_sub_ps(a.x, b.x), _mm_sub_ps(a.y, b.y), _mm_sub_ps(a.z, b.z) }; }
+	__m128 Dot(const Vector3M& a, const Vector3M& b) {
+		return _mm_add_ps(_mm_add_ps(_mm_mul_ps(a.x, b.x), _mm_mul_ps(a.y, b.y)), _mm_mul_ps(a.z, b.z));
+	}
+	Vector3M Cross(const Vector3M& a, const Vector3M& b) {
+		return {
+			_mm_sub_ps(_mm_mul_ps(a.y, b.z), _mm_mul_ps(a.z, b.y)),
+			_mm_sub_ps(_mm_mul_ps(a.z, b.x), _mm_mul_ps(a.x, b.z)),
+			_mm_sub_ps(_mm_mul_ps(a.x, b.y), _mm_mul_ps(a.y, b.x)),
+		};
+	}
+
+	// 平面を正規化して作る
+	Plane MakePlane(float a, float b, float c, float d) {
+		float length = std::sqrt(a * a + b * b + c * c);
+		return { Vector3(a / length, b / length, c / length), d / length };
+	}
+}
+
+Frustum MakeFrustum(const Matrix4x4& viewProjection)
+{
+	// 行ベクトルなので、クリップ座標の各成分は行列の列との内積
+	// 内側は -w <= x <= w, -w <= y <= w, 0 <= z <= w
+	const float(&m)[4][4] = viewProjection.m;
+	auto column = [&](int j, int k, float sign) {
+		return MakePlane(m[0][j] + sign * m[0][k], m[1][j] + sign * m[1][k], m[2][j] + sign * m[2][k], m[3][j] + sign * m[3][k]);
+	};
+	Frustum frustum;
+	frustum.planes[0] = column(3, 0, 1.0f);		// 左
+	frustum.planes[1] = column(3, 0, -1.0f);	// 右
+	frustum.planes[2] = column(3, 1, 1.0f);		// 下
+	frustum.planes[3] = column(3, 1, -1.0f);	// 上
+	frustum.planes[4] = column(2, 2, 0.0f);		// 手前
+	frustum.planes[5] = column(3, 2, -1.0f);	// 奥
+	return frustum;
+}
+
+AABB Transform(const AABB& aabb, const Affine3x4& affine)
+{
+	// 中心はそのまま変換し、半分の大きさは行列の各成分の絶対値で広げる
+	Vector3 center = (aabb.min + aabb.max) * 0.5f;
+	Vector3 extent = (aabb.max - aabb.min) * 0.5f;
+	Vector3 newCenter = Transform(center, affine);
+	const float(&a)[3][4] = affine.m;
+	Vector3 newExtent(
+		std::fabs(a[0][0]) * extent.x + std::fabs(a[0][1]) * extent.y + std::fabs(a[0][2]) * extent.z,
+		std::fabs(a[1][0]) * extent.x + std::fabs(a[1][1]) * extent.y + std::fabs(a[1][2]) * extent.z,
+		std::fabs(a[2][0]) * extent.x + std::fabs(a[2][1]) * extent.y + std::fabs(a[2][2]) * extent.z);
+	return { newCenter - newExtent, newCenter + newExtent };
+}
+
+// -----1つずつ判定-----
+bool IsCollision(const Ray& ray, const Triangle& triangle, float& distance)
+{
+	Vector3 edge1 = triangle.v1 - triangle.v0;
+	Vector3 edge2 = triangle.v2 - triangle.v0;
+	Vector3 p = Cross(ray.direction, edge2);
+	float det = Dot(edge1, p);
+	if (std::fabs(det) < kParallelEpsilon) {
+		return false;
+	}
+	float invDet = 1.0f / det;
+
+	// --- 重心座標(u, v)が三角形の中か ---
+	Vector3 s = ray.origin - triangle.v0;
+	float u = Dot(s, p) * invDet;
+	if (u < 0.0f || u > 1.0f) {
+		return false;
+	}
+	Vector3 q = Cross(s, edge1);
+	float v = Dot(ray.direction, q) * invDet;
+	if (v < 0.0f || u + v > 1.0f) {
+		return false;
+	}
+
+	// --- 始点より前か ---
+	float t = Dot(edge2, q) * invDet;
+	if (t < 0.0f) {
+		return false;
+	}
+	distance = t;
+	return true;
+}
+
+bool IsCollision(const Ray& ray, const AABB& aabb, float& distance)
+{
+	// 軸ごとに入る距離と出る距離を求め、入るのが一番遅いものと出るのが一番早いものを比べる
+	Vector3 invDirection(1.0f / ray.direction.x, 1.0f / ray.direction.y, 1.0f / ray.direction.z);
+	float tx1 = (aabb.min.x - ray.origin.x) * invDirection.x;
+	float tx2 = (aabb.max.x - ray.origin.x) * invDirection.x;
+	float ty1 = (aabb.min.y - ray.origin.y) * invDirection.y;
+	float ty2 = (aabb.max.y - ray.origin.y) * invDirection.y;
+	float tz1 = (aabb.min.z - ray.origin.z) * invDirection.z;
+	float tz2 = (aabb.max.z - ray.origin.z) * invDirection.z;
+	float tNear = Max(Max(Max(Min(tx1, tx2), Min(ty1, ty2)), Min(tz1, tz2)), 0.0f);
+	float tFar = Min(Min(Max(tx1, tx2), Max(ty1, ty2)), Max(tz1, tz2));
+	if (!(tNear <= tFar)) {
+		return false;
+	}
+	distance = tNear;
+	return true;
+}
+
+bool IsCollision(const AABB& aabb1, const AABB& aabb2)
+{
+	return aabb1.min.x <= aabb2.max.x && aabb2.min.x <= aabb1.max.x &&
+		aabb1.min.y <= aabb2.max.y && aabb2.min.y <= aabb1.max.y &&
+		aabb1.min.z <= aabb2.max.z && aabb2.min.z <= aabb1.max.z;
+}
+
+bool IsCollision(const Sphere& sphere1, const Sphere& sphere2)
+{
+	Vector3 d = sphere2.center - sphere1.center;
+	float radius = sphere1.radius + sphere2.radius;
+	return Dot(d, d) <= radius * radius;
+}
+
+bool IsCollision(const Sphere& sphere, const Frustum& frustum)
+{
+	for (const Plane& plane : frustum.planes) {
+		if (Dot(plane.normal, sphere.center) + plane.distance < -sphere.radius) {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool IsCollision(const AABB& aabb, const Frustum& frustum)
+{
+	for (const Plane& plane : frustum.planes) {
+		// 法線の方向に一番遠い頂点が裏にあれば全部裏
+		Vector3 farthest(
+			plane.normal.x >= 0.0f ? aabb.max.x : aabb.min.x,
+			plane.normal.y >= 0.0f ? aabb.max.y : aabb.min.y,
+			plane.normal.z >= 0.0f ? aabb.max.z : aabb.min.z);
+		if (Dot(plane.normal, farthest) + plane.distance < 0.0f) {
+			return false;
+		}
+	}
+	return true;
+}
+
+// -----4つまとめて判定-----
+uint32_t IsCollision(const Ray& ray, const TriangleX4& triangles, float distances[4])
+{
+	Vector3M v0 = Load(triangles.v0);
+	Vector3M edge1 = Sub(Load(triangles.v1), v0);
+	Vector3M edge2 = Sub(Load(triangles.v2), v0);
+	Vector3M direction = Splat(ray.direction);
+	Vector3M p = Cross(direction, edge2);
+	__m128 det = Dot(edge1, p);
+	const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+	__m128 hit = _mm_cmpge_ps(_mm_and_ps(det, absMask), _mm_set1_ps(kParallelEpsilon));
+	__m128 invDet = _mm_div_ps(_mm_set1_ps(1.0f), det);
+
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 one = _mm_set1_ps(1.0f);
+	Vector3M s = Sub(Splat(ray.origin), v0);
+	__m128 u = _mm_mul_ps(Dot(s, p), invDet);
+	hit = _mm_and_ps(hit, _mm_and_ps(_mm_cmpge_ps(u, zero), _mm_cmple_ps(u, one)));
+	Vector3M q = Cross(s, edge1);
+	__m128 v = _mm_mul_ps(Dot(direction, q), invDet);
+	hit = _mm_and_ps(hit, _mm_and_ps(_mm_cmpge_ps(v, zero), _mm_cmple_ps(_mm_add_ps(u, v), one)));
+	__m128 t = _mm_mul_ps(Dot(edge2, q), invDet);
+	hit = _mm_and_ps(hit, _mm_cmpge_ps(t, zero));
+
+	_mm_storeu_ps(distances, t);
+	return uint32_t(_mm_movemask_ps(hit));
+}
+
+uint32_t IsCollision(const Ray& ray, const AABBX4& aabbs, float distances[4])
+{
+	Vector3M origin = Splat(ray.origin);
+	Vector3M invDirection = Splat(Vector3(1.0f / ray.direction.x, 1.0f / ray.direction.y, 1.0f / ray.direction.z));
+	Vector3M t1 = Sub(Load(aabbs.min), origin);
+	Vector3M t2 = Sub(Load(aabbs.max), origin);
+	__m128 tx1 = _mm_mul_ps(t1.x, invDirection.x), tx2 = _mm_mul_ps(t2.x, invDirection.x);
+	__m128 ty1 = _mm_mul_ps(t1.y, invDirection.y), ty2 = _mm_mul_ps(t2.y, invDirection.y);
+	__m128 tz1 = _mm_mul_ps(t1.z, invDirection.z), tz2 = _mm_mul_ps(t2.z, invDirection.z);
+	__m128 tNear = _mm_max_ps(_mm_max_ps(_mm_max_ps(_mm_min_ps(tx1, tx2), _mm_min_ps(ty1, ty2)), _mm_min_ps(tz1, tz2)), _mm_setzero_ps());
+	__m128 tFar = _mm_min_ps(_mm_min_ps(_mm_max_ps(tx1, tx2), _mm_max_ps(ty1, ty2)), _mm_max_ps(tz1, tz2));
+
+	_mm_storeu_ps(distances, tNear);
+	return uint32_t(_mm_movemask_ps(_mm_cmple_ps(tNear, tFar)));
+}
+
+uint32_t IsCollision(const Sphere& sphere, const SphereX4& spheres)
+{
+	Vector3M d = Sub(Load(spheres.center), Splat(sphere.center));
+	__m128 radius = _mm_add_ps(_mm_set1_ps(sphere.radius), _mm_load_ps(spheres.radius));
+	return uint32_t(_mm_movemask_ps(_mm_cmple_ps(Dot(d, d), _mm_mul_ps(radius, radius))));
+}
+
+uint32_t IsCollision(const SphereX4& spheres, const Frustum& frustum)
+{
+	Vector3M center = Load(spheres.center);
+	__m128 negativeRadius = _mm_sub_ps(_mm_setzero_ps(), _mm_load_ps(spheres.radius));
+	__m128 outside = _mm_setzero_ps();
+	for (const Plane& plane : frustum.planes) {
+		__m128 d = _mm_add_ps(Dot(Splat(plane.normal), center), _mm_set1_ps(plane.distance));
+		outside = _mm_or_ps(outside, _mm_cmplt_ps(d, negativeRadius));
+	}
+	return uint32_t(_mm_movemask_ps(outside)) ^ 0xF;
+}
+
+uint32_t IsCollision(const AABBX4& aabbs, const Frustum& frustum)
+{
+	Vector3M min = Load(aabbs.min);
+	Vector3M max = Load(aabbs.max);
+	__m128 outside = _mm_setzero_ps();
+	for (const Plane& plane : frustum.planes) {
+		// 平面は4つとも同じなので、どちらの頂点を使うかは分岐で選べる
+		Vector3M farthest = {
+			plane.normal.x >= 0.0f ? max.x : min.x,
+			plane.normal.y >= 0.0f ? max.y : min.y,
+			plane.normal.z >= 0.0f ? max.z : min.z,
+		};
+		__m128 d = _mm_add_ps(Dot(Splat(plane.normal), farthest), _mm_set1_ps(plane.distance));
+		outside = _mm_or_ps(outside, _mm_cmplt_ps(d, _mm_setzero_ps()));
+	}
+	return uint32_t(_mm_movemask_ps(outside)) ^ 0xF;
+}
@@ -0,0 +1,121 @@
+#pragma once
+#include <cstdint>
+
+#include "Affine3x4.h"
+#include "Matrix4x4.h"
+#include "Vector3.h"
+
+// -----形状-----
+// 半直線(directionは正規化しなくてよい。距離はdirectionの長さを1とした値になる)
+struct Ray {
+	Vector3 origin;
+	Vector3 direction;
+};
+
+// 軸に平行な箱
+struct AABB {
+	Vector3 min;
+	Vector3 max;
+};
+
+// 球
+struct Sphere {
+	Vector3 center;
+	float radius;
+};
+
+// 三角形
+struct Triangle {
+	Vector3 v0;
+	Vector3 v1;
+	Vector3 v2;
+};
+
+// 平面(Dot(normal, p) + distance >= 0 の側が表)
+struct Plane {
+	Vector3 normal;
+	float distance;
+};
+
+// 視錐台(6枚の平面。内側が表)
+struct Frustum {
+	Plane planes[6];
+};
+
+// -----4つまとめた形状(SoA)-----
+// 使わない要素があるときは、結果のビットを (1 << 個数) - 1 でマスクする
+struct alignas(16) Vector3X4 {
+	float x[4];
+	float y[4];
+	float z[4];
+
+	void Set(uint32_t index, const Vector3& v) {
+		x[index] = v.x;
+		y[index] = v.y;
+		z[index] = v.z;
+	}
+};
+
+struct alignas(16) AABBX4 {
+	Vector3X4 min;
+	Vector3X4 max;
+
+	void Set(uint32_t index, const AABB& aabb) {
+		min.Set(index, aabb.min);
+		max.Set(index, aabb.max);
+	}
+};
+
+struct alignas(16) SphereX4 {
+	Vector3X4 center;
+	float radius[4];
+
+	void Set(uint32_t index, const Sphere& sphere) {
+		center.Set(index, sphere.center);
+		radius[index] = sphere.radius;
+	}
+};
+
+struct alignas(16) TriangleX4 {
+	Vector3X4 v0;
+	Vector3X4 v1;
+	Vector3X4 v2;
+
+	void Set(uint32_t index, const Triangle& triangle) {
+		v0.Set(index, triangle.v0);
+		v1.Set(index, triangle.v1);
+		v2.Set(index, triangle.v2);
+	}
+};
+
+// ビュープロジェクション行列から視錐台を作る(平面は正規化する)
+Frustum MakeFrustum(const Matrix4x4& viewProjection);
+// 変換後のAABBを囲むAABB(回転していると元より大きくなる)
+AABB Transform(const AABB& aabb, const Affine3x4& affine);
+
+// -----1つずつ判定-----
+// 半直線と三角形(Möller–Trumbore。両面。当たればdistanceに距離)
+bool IsCollision(const Ray& ray, const Triangle& triangle, float& distance);
+// 半直線とAABB(スラブ法。始点が中にあれば距離は0)
+bool IsCollision(const Ray& ray, const AABB& aabb, float& distance);
+// AABBとAABB(接していても重なりとみなす)
+bool IsCollision(const AABB& aabb1, const AABB& aabb2);
+// 球と球
+bool IsCollision(const Sphere& sphere1, const Sphere& sphere2);
+// 球と視錐台(一部でも内側にあればtrue)
+bool IsCollision(const Sphere& sphere, const Frustum& frustum);
+// AABBと視錐台(一部でも内側にあればtrue。角の近くでは外でもtrueになることがある)
+bool IsCollision(const AABB& aabb, const Frustum& frustum);
+
+// -----4つまとめて判定(SIMD)-----
+// 結果はi番目が当たっていればビットiが立つ。1つずつ判定するものと同じ結果になる
+// 半直線と三角形4つ(当たったものはdistances[i]に距離)
+uint32_t IsCollision(const Ray& ray, const TriangleX4& triangles, float distances[4]);
+// 半直線とAABB4つ
+uint32_t IsCollision(const Ray& ray, const AABBX4& aabbs, float distances[4]);
+// 球と球4つ
+uint32_t IsCollision(const Sphere& sphere, const SphereX4& spheres);
+// 球4つと視錐台
+uint32_t IsCollision(const SphereX4& spheres, const Frustum& frustum);
+// AABB4つと視錐台
+uint32_t IsCollision(const AABBX4& aabbs, const Frustum& frustum);
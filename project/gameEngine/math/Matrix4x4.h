@@ -1,34 +1,75 @@
 #pragma once
 #include <cstring>
 
+// 演算はすべてヘッダーに書いたconstexprなので、呼び出し側でインライン展開される
 class Matrix4x4 {
 public:
 	float m[4][4];
 
 	// 加算
-	Matrix4x4 operator+(const Matrix4x4& mat) const;
+	[[nodiscard]] constexpr Matrix4x4 operator+(const Matrix4x4& mat) const noexcept {
+		Matrix4x4 result{};
+		for (int i = 0; i < 4; ++i) {
+			for (int j = 0; j < 4; ++j) {
+				result.m[i][j] = m[i][j] + mat.m[i][j];
+			}
+		}
+		return result;
+	}
 
 	// 減算
-	Matrix4x4 operator-(const Matrix4x4& mat) const;
+	[[nodiscard]] constexpr Matrix4x4 operator-(const Matrix4x4& mat) const noexcept {
+		Matrix4x4 result{};
+		for (int i = 0; i < 4; ++i) {
+			for (int j = 0; j < 4; ++j) {
+				result.m[i][j] = m[i][j] - mat.m[i][j];
+			}
+		}
+		return result;
+	}
 
 	// 乗算
-	Matrix4x4 operator*(const Matrix4x4& mat) const;
+	[[nodiscard]] constexpr Matrix4x4 operator*(const Matrix4x4& mat) const noexcept {
+		Matrix4x4 result{};
+		for (int i = 0; i < 4; ++i) {
+			for (int j = 0; j < 4; ++j) {
+				result.m[i][j] = m[i][0] * mat.m[0][j] + m[i][1] * mat.m[1][j] + m[i][2] * mat.m[2][j] + m[i][3] * mat.m[3][j];
+			}
+		}
+		return result;
+	}
 
 	// 乗算(スカラー倍)
-	Matrix4x4 operator*(const float& scalar) const;
+	[[nodiscard]] constexpr Matrix4x4 operator*(const float& scalar) const noexcept {
+		Matrix4x4 result{};
+		for (int i = 0; i < 4; ++i) {
+			for (int j = 0; j < 4; ++j) {
+				result.m[i][j] = m[i][j] * scalar;
+			}
+		}
+		return result;
+	}
 
 	// 除算
-	Matrix4x4 operator/(const float& scalar) const;
+	[[nodiscard]] constexpr Matrix4x4 operator/(const float& scalar) const noexcept {
+		Matrix4x4 result{};
+		for (int i = 0; i < 4; ++i) {
+			for (int j = 0; j < 4; ++j) {
+				result.m[i][j] = m[i][j] / scalar;
+			}
+		}
+		return result;
+	}
 
 	// +=
-	Matrix4x4& operator+=(const Matrix4x4& mat);
+	constexpr Matrix4x4& operator+=(const Matrix4x4& mat) noexcept { return *this = *this + mat; }
 
 	// -=
-	Matrix4x4& operator-=(const Matrix4x4& mat);
+	constexpr Matrix4x4& operator-=(const Matrix4x4& mat) noexcept { return *this = *this - mat; }
 
 	// *=
-	Matrix4x4& operator*=(const Matrix4x4& mat);
+	constexpr Matrix4x4& operator*=(const Matrix4x4& mat) noexcept { return *this = *this * mat; }
 
 	// /=
-	Matrix4x4& operator/=(const float& scalar);
-};
\ No newline at end of file
+	constexpr Matrix4x4& operator/=(const float& scalar) noexcept { return *this = *this / scalar; }
+};
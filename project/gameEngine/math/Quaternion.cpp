@@ -0,0 +1,178 @@
+#include "Quaternion.h"
+#include <cmath>
+#include <xmmintrin.h>
+
+namespace
+{
+	// x,y,z,wの順にそのまま読み書きする
+	__m128 Load(const Quaternion& q) { return _mm_loadu_ps(&q.x); }
+	Quaternion Store(__m128 v)
+	{
+		Quaternion result;
+		_mm_storeu_ps(&result.x, v);
+		return result;
+	}
+}
+
+// 積
+Quaternion Quaternion::operator*(const Quaternion& obj) const {
+	// 各成分を b の並べ替え×符号 の和で求める
+	//   x = aw*bx + ax*bw + ay*bz - az*by
+	//   y = aw*by - ax*bz + ay*bw + az*bx
+	//   z = aw*bz + ax*by - ay*bx + az*bw
+	//   w = aw*bw - ax*bx - ay*by - az*bz
+	__m128 a = Load(*this);
+	__m128 b = Load(obj);
+	__m128 ax = _mm_shuffle_ps(a, a, _MM_SHUFFLE(0, 0, 0, 0));
+	__m128 ay = _mm_shuffle_ps(a, a, _MM_SHUFFLE(1, 1, 1, 1));
+	__m128 az = _mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 2, 2, 2));
+	__m128 aw = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 3, 3, 3));
+
+	// _MM_SHUFFLEは(w,z,y,x)の順に書く
+	__m128 bwzyx = _mm_shuffle_ps(b, b, _MM_SHUFFLE(0, 1, 2, 3));
+	__m128 bzwxy = _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 0, 3, 2));
+	__m128 byxwz = _mm_shuffle_ps(b, b, _MM_SHUFFLE(2, 3, 0, 1));
+	const __m128 signX = _mm_setr_ps(1.0f, -1.0f, 1.0f, -1.0f);
+	const __m128 signY = _mm_setr_ps(1.0f, 1.0f, -1.0f, -1.0f);
+	const __m128 signZ = _mm_setr_ps(-1.0f, 1.0f, 1.0f, -1.0f);
+
+	__m128 result = _mm_mul_ps(aw, b);
+	result = _mm_add_ps(result, _mm_mul_ps(_mm_mul_ps(ax, bwzyx), signX));
+	result = _mm_add_ps(result, _mm_mul_ps(_mm_mul_ps(ay, bzwxy), signY));
+	result = _mm_add_ps(result, _mm_mul_ps(_mm_mul_ps(az, byxwz), signZ));
+	return Store(result);
+}
+
+// 加算
+Quaternion Quaternion::operator+(const Quaternion& obj) const { return Quaternion(x + obj.x, y + obj.y, z + obj.z, w + obj.w); }
+
+// スカラー倍
+Quaternion Quaternion::operator*(float scalar) const { return Quaternion(x * scalar, y * scalar, z * scalar, w * scalar); }
+
+// 符号反転
+Quaternion Quaternion::operator-() const { return Quaternion(-x, -y, -z, -w); }
+
+// *=
+Quaternion& Quaternion::operator*=(const Quaternion& obj) {
+	*this = *this * obj;
+	return *this;
+}
+
+// ノルム
+float Norm(const Quaternion& q) { return std::sqrt(Dot(q, q)); }
+
+// 正規化
+Quaternion Normalize(const Quaternion& q) {
+	__m128 v = Load(q);
+	__m128 squared = _mm_mul_ps(v, v);
+	// 4成分の和を全レーンに広げる
+	__m128 sum = _mm_add_ps(squared, _mm_shuffle_ps(squared, squared, _MM_SHUFFLE(2, 3, 0, 1)));
+	sum = _mm_add_ps(sum, _mm_shuffle_ps(sum, sum, _MM_SHUFFLE(1, 0, 3, 2)));
+	if (_mm_cvtss_f32(sum) == 0.0f) {
+		return q;
+	}
+	return Store(_mm_div_ps(v, _mm_sqrt_ps(sum)));
+}
+
+// 逆
+Quaternion Inverse(const Quaternion& q) {
+	float normSquared = Dot(q, q);
+	return Conjugate(q) * (1.0f / normSquared);
+}
+
+// 任意軸回転
+Quaternion MakeRotateAxisAngleQuaternion(const Vector3& axis, float angle) {
+	float s = std::sin(angle * 0.5f);
+	return Quaternion(axis.x * s, axis.y * s, axis.z * s, std::cos(angle * 0.5f));
+}
+
+// オイラー角から
+Quaternion MakeRotateQuaternion(const Vector3& rotate) {
+	// qz * qy * qx を展開したもの
+	float cx = std::cos(rotate.x * 0.5f), sx = std::sin(rotate.x * 0.5f);
+	float cy = std::cos(rotate.y * 0.5f), sy = std::sin(rotate.y * 0.5f);
+	float cz = std::cos(rotate.z * 0.5f), sz = std::sin(rotate.z * 0.5f);
+	return Quaternion(
+		sx * cy * cz - cx * sy * sz,
+		cx * sy * cz + sx * cy * sz,
+		cx * cy * sz - sx * sy * cz,
+		cx * cy * cz + sx * sy * sz);
+}
+
+// 回転行列から
+Quaternion MakeRotateQuaternion(const Matrix4x4& matrix) {
+	const float(&m)[4][4] = matrix.m;
+	float trace = m[0][0] + m[1][1] + m[2][2];
+
+	// 桁落ちしないよう、一番大きい成分から求める
+	Quaternion result;
+	if (trace > 0.0f) {
+		float s = std::sqrt(trace + 1.0f) * 2.0f; // 4w
+		result = Quaternion((m[1][2] - m[2][1]) / s, (m[2][0] - m[0][2]) / s, (m[0][1] - m[1][0]) / s, 0.25f * s);
+	}
+	else if (m[0][0] > m[1][1] && m[0][0] > m[2][2]) {
+		float s = std::sqrt(1.0f + m[0][0] - m[1][1] - m[2][2]) * 2.0f; // 4x
+		result = Quaternion(0.25f * s, (m[0][1] + m[1][0]) / s, (m[2][0] + m[0][2]) / s, (m[1][2] - m[2][1]) / s);
+	}
+	else if (m[1][1] > m[2][2]) {
+		float s = std::sqrt(1.0f + m[1][1] - m[0][0] - m[2][2]) * 2.0f; // 4y
+		result = Quaternion((m[0][1] + m[1][0]) / s, 0.25f * s, (m[1][2] + m[2][1]) / s, (m[2][0] - m[0][2]) / s);
+	}
+	else {
+		float s = std::sqrt(1.0f + m[2][2] - m[0][0] - m[1][1]) * 2.0f; // 4z
+		result = Quaternion((m[2][0] + m[0][2]) / s, (m[1][2] + m[2][1]) / s, 0.25f * s, (m[0][1] - m[1][0]) / s);
+	}
+	return Normalize(result);
+}
+
+// 回転行列に変換
+Matrix4x4 MakeRotateMatrix(const Quaternion& q) {
+	float xx = q.x * q.x, yy = q.y * q.y, zz = q.z * q.z;
+	float xy = q.x * q.y, xz = q.x * q.z, yz = q.y * q.z;
+	float wx = q.w * q.x, wy = q.w * q.y, wz = q.w * q.z;
+
+	Matrix4x4 result = {
+		1.0f - 2.0f * (yy + zz), 2.0f * (xy + wz), 2.0f * (xz - wy), 0.0f,
+		2.0f * (xy - wz), 1.0f - 2.0f * (xx + zz), 2.0f * (yz + wx), 0.0f,
+		2.0f * (xz + wy), 2.0f * (yz - wx), 1.0f - 2.0f * (xx + yy), 0.0f,
+		0.0f, 0.0f, 0.0f, 1.0f,
+	};
+	return result;
+}
+
+// ベクトルを回転
+Vector3 RotateVector(const Vector3& vector, const Quaternion& q) {
+	// v' = v + 2w(u×v) + 2u×(u×v) (uはqのベクトル部)
+	Vector3 u(q.x, q.y, q.z);
+	Vector3 t(2.0f * (u.y * vector.z - u.z * vector.y), 2.0f * (u.z * vector.x - u.x * vector.z), 2.0f * (u.x * vector.y - u.y * vector.x));
+	Vector3 uxt(u.y * t.z - u.z * t.y, u.z * t.x - u.x * t.z, u.x * t.y - u.y * t.x);
+	return Vector3(vector.x + q.w * t.x + uxt.x, vector.y + q.w * t.y + uxt.y, vector.z + q.w * t.z + uxt.z);
+}
+
+// 球面線形補間
+Quaternion Slerp(const Quaternion& q0, const Quaternion& q1, float t) {
+	// --- 近い方を回るように向きを揃える ---
+	float dot = Dot(q0, q1);
+	Quaternion end = q1;
+	if (dot < 0.0f) {
+		end = -q1;
+		dot = -dot;
+	}
+
+	// --- ほぼ同じ向きなら線形補間(sinθが0に近く割れない) ---
+	if (dot > 0.9995f) {
+		return Nlerp(q0, end, t);
+	}
+
+	float theta = std::acos(dot);
+	float sinTheta = std::sin(theta);
+	float scale0 = std::sin((1.0f - t) * theta) / sinTheta;
+	float scale1 = std::sin(t * theta) / sinTheta;
+	return q0 * scale0 + end * scale1;
+}
+
+// 線形補間して正規化
+Quaternion Nlerp(const Quaternion& q0, const Quaternion& q1, float t) {
+	Quaternion end = Dot(q0, q1) < 0.0f ? -q1 : q1;
+	return Normalize(q0 * (1.0f - t) + end * t);
+}
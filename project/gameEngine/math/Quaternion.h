@@ -0,0 +1,59 @@
+#pragma once
+#include "Matrix4x4.h"
+#include "Vector3.h"
+
+/// <summary>
+/// クォータニオン(回転)
+/// 回転の合成は q1 * q2 で「q2の後にq1」(行列の Mq2 * Mq1 と同じ)
+/// </summary>
+class Quaternion {
+public:
+	float x;
+	float y;
+	float z;
+	float w;
+
+	// 既定は回転なし
+	constexpr Quaternion() noexcept : x(0.0f), y(0.0f), z(0.0f), w(1.0f) {}
+	constexpr Quaternion(float x_, float y_, float z_, float w_) noexcept : x(x_), y(y_), z(z_), w(w_) {}
+
+	// 積(SIMD)
+	Quaternion operator*(const Quaternion& obj) const;
+	// 加算
+	Quaternion operator+(const Quaternion& obj) const;
+	// スカラー倍
+	Quaternion operator*(float scalar) const;
+	// 符号反転(同じ回転を表す)
+	Quaternion operator-() const;
+	// *=
+	Quaternion& operator*=(const Quaternion& obj);
+};
+
+// 単位クォータニオン
+[[nodiscard]] constexpr Quaternion IdentityQuaternion() noexcept { return Quaternion(0.0f, 0.0f, 0.0f, 1.0f); }
+// 共役
+[[nodiscard]] constexpr Quaternion Conjugate(const Quaternion& q) noexcept { return Quaternion(-q.x, -q.y, -q.z, q.w); }
+// 内積
+[[nodiscard]] constexpr float Dot(const Quaternion& q1, const Quaternion& q2) noexcept { return q1.x * q2.x + q1.y * q2.y + q1.z * q2.z + q1.w * q2.w; }
+// ノルム
+float Norm(const Quaternion& q);
+// 正規化(SIMD)
+Quaternion Normalize(const Quaternion& q);
+// 逆
+Quaternion Inverse(const Quaternion& q);
+
+// 任意軸回転(axisは正規化済み)
+Quaternion MakeRotateAxisAngleQuaternion(const Vector3& axis, float angle);
+// オイラー角から(MakeAffineMatrixと同じくX→Y→Zの順に回す)
+Quaternion MakeRotateQuaternion(const Vector3& rotate);
+// 回転行列から(スケールを含まないこと)
+Quaternion MakeRotateQuaternion(const Matrix4x4& matrix);
+// 回転行列に変換
+Matrix4x4 MakeRotateMatrix(const Quaternion& q);
+// ベクトルを回転
+Vector3 RotateVector(const Vector3& vector, const Quaternion& q);
+
+// 球面線形補間(近い方を回る)
+Quaternion Slerp(const Quaternion& q0, const Quaternion& q1, float t);
+// 線形補間して正規化(Slerpより速い。角速度は一定でない)
+Quaternion Nlerp(const Quaternion& q0, const Quaternion& q1, float t);
@@ -14,65 +14,65 @@ struct Vector2 final {
 	float y;
 
 	// コンストラクタ
-	Vector2(float _x = 0.0f, float _y = 0.0f) : x(_x), y(_y) {}
+	constexpr Vector2(float _x = 0.0f, float _y = 0.0f) noexcept : x(_x), y(_y) {}
 
 	// 符号反転
-	Vector2 operator-() const { return Vector2(-x, -y); }
+	[[nodiscard]] constexpr Vector2 operator-() const noexcept { return Vector2(-x, -y); }
 
 	// 加算
-	Vector2 operator+(const Vector2& obj) const { return Vector2(x + obj.x, y + obj.y); }
+	[[nodiscard]] constexpr Vector2 operator+(const Vector2& obj) const noexcept { return Vector2(x + obj.x, y + obj.y); }
 	// 減算
-	Vector2 operator-(const Vector2& obj) const { return Vector2(x - obj.x, y - obj.y); }
+	[[nodiscard]] constexpr Vector2 operator-(const Vector2& obj) const noexcept { return Vector2(x - obj.x, y - obj.y); }
 	// 乗算
-	Vector2 operator*(const Vector2& obj) const { return Vector2(x * obj.x, y * obj.y); }
+	[[nodiscard]] constexpr Vector2 operator*(const Vector2& obj) const noexcept { return Vector2(x * obj.x, y * obj.y); }
 	// 乗算(スカラー倍)(float型)
-	Vector2 operator*(const float& scalar) const { return Vector2(x * scalar, y * scalar); }
+	[[nodiscard]] constexpr Vector2 operator*(const float& scalar) const noexcept { return Vector2(x * scalar, y * scalar); }
 	// 乗算(スカラー倍)(int型)
-	Vector2 operator*(const int& scalar) const { return Vector2(x * scalar, y * scalar); }
+	[[nodiscard]] constexpr Vector2 operator*(const int& scalar) const noexcept { return Vector2(x * scalar, y * scalar); }
 	// 除算
-	Vector2 operator/(const Vector2& obj) const { return Vector2(x / obj.x, y / obj.y); }
+	[[nodiscard]] constexpr Vector2 operator/(const Vector2& obj) const noexcept { return Vector2(x / obj.x, y / obj.y); }
 	// 除算(スカラー)(float型)
-	Vector2 operator/(const float& scalar) const { return Vector2(x / scalar, y / scalar); }
+	[[nodiscard]] constexpr Vector2 operator/(const float& scalar) const noexcept { return Vector2(x / scalar, y / scalar); }
 	// 除算(スカラー)(int型)
-	Vector2 operator/(const int& scalar) const { return Vector2(x / scalar, y / scalar); }
+	[[nodiscard]] constexpr Vector2 operator/(const int& scalar) const noexcept { return Vector2(x / scalar, y / scalar); }
 
 	// スカラー引き算
-	Vector2 operator-(const float& scalar) const { return Vector2(x - scalar, y - scalar); }
+	[[nodiscard]] constexpr Vector2 operator-(const float& scalar) const noexcept { return Vector2(x - scalar, y - scalar); }
 	// スカラー引き算 (int型)
-	Vector2 operator-(const int& scalar) const { return Vector2(x - scalar, y - scalar); }
+	[[nodiscard]] constexpr Vector2 operator-(const int& scalar) const noexcept { return Vector2(x - scalar, y - scalar); }
 
 	// フレンド関数: スカラー * ベクトル
-	friend Vector2 operator*(const float& scalar, const Vector2& vec) { return vec * scalar; }
+	[[nodiscard]] friend constexpr Vector2 operator*(const float& scalar, const Vector2& vec) noexcept { return vec * scalar; }
 	// フレンド関数: スカラー / ベクトル
-	friend Vector2 operator/(const float& scalar, const Vector2& vec) { return Vector2(scalar / vec.x, scalar / vec.y); }
+	[[nodiscard]] friend constexpr Vector2 operator/(const float& scalar, const Vector2& vec) noexcept { return Vector2(scalar / vec.x, scalar / vec.y); }
 	// フレンド関数: スカラー * ベクトル (int型)
-	friend Vector2 operator*(const int& scalar, const Vector2& vec) { return vec * scalar; }
+	[[nodiscard]] friend constexpr Vector2 operator*(const int& scalar, const Vector2& vec) noexcept { return vec * scalar; }
 	// フレンド関数: スカラー / ベクトル (int型)
-	friend Vector2 operator/(const int& scalar, const Vector2& vec) { return Vector2(scalar / vec.x, scalar / vec.y); }
+	[[nodiscard]] friend constexpr Vector2 operator/(const int& scalar, const Vector2& vec) noexcept { return Vector2(scalar / vec.x, scalar / vec.y); }
 
 	// Vector2 の == 演算子
-	bool operator==(const Vector2& other) const { return x == other.x && y == other.y; }
+	[[nodiscard]] constexpr bool operator==(const Vector2& other) const noexcept { return x == other.x && y == other.y; }
 
 	// +=
-	Vector2& operator+=(const Vector2& other) {
+	constexpr Vector2& operator+=(const Vector2& other) noexcept {
 		x += other.x;
 		y += other.y;
 		return *this;
 	}
 	// -=
-	Vector2& operator-=(const Vector2& other) {
+	constexpr Vector2& operator-=(const Vector2& other) noexcept {
 		x -= other.x;
 		y -= other.y;
 		return *this;
 	}
 	// *=
-	Vector2& operator*=(const Vector2& other) {
+	constexpr Vector2& operator*=(const Vector2& other) noexcept {
 		x *= other.x;
 		y *= other.y;
 		return *this;
 	}
 	// /=
-	Vector2& operator/=(const Vector2& other) {
+	constexpr Vector2& operator/=(const Vector2& other) noexcept {
 		x /= other.x;
 		y /= other.y;
 		return *this;
@@ -80,35 +80,35 @@ struct Vector2 final {
 
 	// スカラーに対する演算
 	// += スカラー
-	Vector2& operator+=(const float& s) {
+	constexpr Vector2& operator+=(const float& s) noexcept {
 		x += s;
 		y += s;
 		return *this;
 	}
 	// -= スカラー
-	Vector2& operator-=(const float& s) {
+	constexpr Vector2& operator-=(const float& s) noexcept {
 		x -= s;
 		y -= s;
 		return *this;
 	}
 	// *= スカラー
-	Vector2& operator*=(const float& s) {
+	constexpr Vector2& operator*=(const float& s) noexcept {
 		x *= s;
 		y *= s;
 		return *this;
 	}
 	// /= スカラー
-	Vector2& operator/=(const float& s) {
+	constexpr Vector2& operator/=(const float& s) noexcept {
 		x /= s;
 		y /= s;
 		return *this;
 	}
 
 	// ベクトルの長さを計算
-	float Length() const { return std::sqrt(x * x + y * y); }
+	[[nodiscard]] float Length() const noexcept { return std::sqrt(x * x + y * y); }
 
 	// ベクトルを正規化（単位ベクトルにする）
-	Vector2 Normalize() const {
+	[[nodiscard]] Vector2 Normalize() const noexcept {
 		float len = Length();
 		// 長さが0の場合は正規化できないので、ゼロベクトルを返す
 		if (len == 0.0f) {
@@ -123,50 +123,50 @@ struct Vector2Int final {
 	int y;
 
 	// 符号反転
-	Vector2Int operator-() const { return Vector2Int(-x, -y); }
+	[[nodiscard]] constexpr Vector2Int operator-() const noexcept { return Vector2Int(-x, -y); }
 
 	// 加算
-	Vector2Int operator+(const Vector2Int& obj) const { return Vector2Int(x + obj.x, y + obj.y); };
+	[[nodiscard]] constexpr Vector2Int operator+(const Vector2Int& obj) const noexcept { return Vector2Int(x + obj.x, y + obj.y); };
 	// 減算
-	Vector2Int operator-(const Vector2Int& obj) const { return Vector2Int(x - obj.x, y - obj.y); };
+	[[nodiscard]] constexpr Vector2Int operator-(const Vector2Int& obj) const noexcept { return Vector2Int(x - obj.x, y - obj.y); };
 	// 乗算
-	Vector2Int operator*(const Vector2Int& obj) const { return Vector2Int(x * obj.x, y * obj.y); };
+	[[nodiscard]] constexpr Vector2Int operator*(const Vector2Int& obj) const noexcept { return Vector2Int(x * obj.x, y * obj.y); };
 	// 乗算(スカラー倍)(int型)
-	Vector2Int operator*(const int& scalar) const { return Vector2Int(x * scalar, y * scalar); };
+	[[nodiscard]] constexpr Vector2Int operator*(const int& scalar) const noexcept { return Vector2Int(x * scalar, y * scalar); };
 	// 除算
-	Vector2Int operator/(const Vector2Int& obj) const { return Vector2Int(x / obj.x, y / obj.y); };
+	[[nodiscard]] constexpr Vector2Int operator/(const Vector2Int& obj) const noexcept { return Vector2Int(x / obj.x, y / obj.y); };
 	// 除算(スカラー)(int型)
-	Vector2Int operator/(const int& scalar) const { return Vector2Int(x / scalar, y / scalar); };
+	[[nodiscard]] constexpr Vector2Int operator/(const int& scalar) const noexcept { return Vector2Int(x / scalar, y / scalar); };
 
-	friend Vector2Int operator*(const int& scalar, const Vector2Int& vec) { return vec * scalar; }
-	friend Vector2Int operator/(const int& scalar, const Vector2Int& vec) { return vec / scalar; }
+	[[nodiscard]] friend constexpr Vector2Int operator*(const int& scalar, const Vector2Int& vec) noexcept { return vec * scalar; }
+	[[nodiscard]] friend constexpr Vector2Int operator/(const int& scalar, const Vector2Int& vec) noexcept { return vec / scalar; }
 
 	// Vector2Int の == 演算子
-	bool operator==(const Vector2Int& other) const { return x == other.x && y == other.y; }
+	[[nodiscard]] constexpr bool operator==(const Vector2Int& other) const noexcept { return x == other.x && y == other.y; }
 
 	// +=
-	Vector2Int& operator+=(const Vector2Int& other) {
+	constexpr Vector2Int& operator+=(const Vector2Int& other) noexcept {
 		x += other.x;
 		y += other.y;
 
 		return *this;
 	};
 	// -=
-	Vector2Int& operator-=(const Vector2Int& other) {
+	constexpr Vector2Int& operator-=(const Vector2Int& other) noexcept {
 		x -= other.x;
 		y -= other.y;
 
 		return *this;
 	};
 	// *=
-	Vector2Int& operator*=(const Vector2Int& other) {
+	constexpr Vector2Int& operator*=(const Vector2Int& other) noexcept {
 		x *= other.x;
 		y *= other.y;
 
 		return *this;
 	};
 	// /=
-	Vector2Int& operator/=(const Vector2Int& other) {
+	constexpr Vector2Int& operator/=(const Vector2Int& other) noexcept {
 		x /= other.x;
 		y /= other.y;
 		return *this;
@@ -7,24 +7,44 @@ public:
 	float y;
 	float z;
 
-	Vector3(float x_ = 0, float y_ = 0, float z_ = 0) : x(x_), y(y_), z(z_) {}
+	constexpr Vector3(float x_ = 0, float y_ = 0, float z_ = 0) noexcept : x(x_), y(y_), z(z_) {}
 
 	// 加算
-	Vector3 operator+(const Vector3& obj) const;
+	[[nodiscard]] constexpr Vector3 operator+(const Vector3& obj) const noexcept { return Vector3(x + obj.x, y + obj.y, z + obj.z); }
 	// 減算
-	Vector3 operator-(const Vector3& obj) const;
+	[[nodiscard]] constexpr Vector3 operator-(const Vector3& obj) const noexcept { return Vector3(x - obj.x, y - obj.y, z - obj.z); }
 	// 乗算
-	Vector3 operator*(const Vector3& obj) const;
+	[[nodiscard]] constexpr Vector3 operator*(const Vector3& obj) const noexcept { return Vector3(x * obj.x, y * obj.y, z * obj.z); }
 	// 乗算(スカラー倍)
-	Vector3 operator*(const float& scalar) const;
+	[[nodiscard]] constexpr Vector3 operator*(const float& scalar) const noexcept { return Vector3(x * scalar, y * scalar, z * scalar); }
 	// 除算
-	Vector3 operator/(const Vector3& obj) const;
+	[[nodiscard]] constexpr Vector3 operator/(const Vector3& obj) const noexcept { return Vector3(x / obj.x, y / obj.y, z / obj.z); }
 	// +=
-	Vector3& operator+=(const Vector3& obj);
+	constexpr Vector3& operator+=(const Vector3& obj) noexcept {
+		x += obj.x;
+		y += obj.y;
+		z += obj.z;
+		return *this;
+	}
 	// -=
-	Vector3& operator-=(const Vector3& obj);
+	constexpr Vector3& operator-=(const Vector3& obj) noexcept {
+		x -= obj.x;
+		y -= obj.y;
+		z -= obj.z;
+		return *this;
+	}
 	// *=
-	Vector3& operator*=(const Vector3& obj);
+	constexpr Vector3& operator*=(const Vector3& obj) noexcept {
+		x *= obj.x;
+		y *= obj.y;
+		z *= obj.z;
+		return *this;
+	}
 	// /=
-	Vector3& operator/=(const Vector3& obj);
-};
\ No newline at end of file
+	constexpr Vector3& operator/=(const Vector3& obj) noexcept {
+		x /= obj.x;
+		y /= obj.y;
+		z /= obj.z;
+		return *this;
+	}
+};
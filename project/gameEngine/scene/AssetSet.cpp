@@ -0,0 +1,104 @@
+#include "AssetSet.h"
+#include <algorithm>
+
+TextureHandle AssetSet::LoadTexture(const std::string& filePath)
+{
+	TextureHandle texture = TextureManager::GetInstance()->AcquireTexture(filePath);
+	textures_.push_back(texture);
+	return texture;
+}
+
+void AssetSet::LoadTextures(const std::vector<std::string>& filePaths)
+{
+	// --- 先にまとめてクックしてから参照を取る ---
+	TextureManager::GetInstance()->LoadTextures(filePaths);
+	for (const std::string& filePath : filePaths) {
+		textures_.push_back(TextureManager::GetInstance()->AcquireTexture(filePath));
+	}
+}
+
+ModelHandle AssetSet::LoadModel(const std::string& filePath)
+{
+	ModelHandle model = ModelManager::GetInstance()->AcquireModel(filePath);
+	models_.push_back(model);
+	return model;
+}
+
+void AssetSet::Clear()
+{
+	// モデルはテクスチャを参照しているので先に手放す
+	models_.clear();
+	textures_.clear();
+
+	std::lock_guard<std::mutex> lock(pendingMutex_);
+	pendingTextures_.clear();
+	pendingModels_.clear();
+}
+
+void AssetSet::RequestTextures(const std::vector<std::string>& filePaths)
+{
+	requestedCount_ += uint32_t(filePaths.size());
+
+	// --- クックはこのスレッドで待つ(GPUには触らない) ---
+	TextureManager::GetInstance()->PrepareTextures(filePaths);
+	preparedCount_ += uint32_t(filePaths.size());
+
+	std::lock_guard<std::mutex> lock(pendingMutex_);
+	pendingTextures_.insert(pendingTextures_.end(), filePaths.begin(), filePaths.end());
+}
+
+void AssetSet::RequestModel(const std::string& filePath)
+{
+	requestedCount_++;
+
+	// --- 解析だけ済ませる ---
+	ModelManager::GetInstance()->PrepareModel(filePath);
+	preparedCount_++;
+
+	std::lock_guard<std::mutex> lock(pendingMutex_);
+	pendingModels_.push_back(filePath);
+}
+
+bool AssetSet::Resolve(std::chrono::microseconds budget)
+{
+	// 1回に最低1つは進める
+	auto start = std::chrono::steady_clock::now();
+	bool isOverBudget = false;
+
+	std::lock_guard<std::mutex> lock(pendingMutex_);
+
+	// --- テクスチャ(マップして粗いミップを転送するだけ) ---
+	size_t textureCount = 0;
+	while (textureCount < pendingTextures_.size() && !isOverBudget) {
+		textures_.push_back(TextureManager::GetInstance()->AcquireTexture(pendingTextures_[textureCount]));
+		textureCount++;
+		isOverBudget = std::chrono::steady_clock::now() - start >= budget;
+	}
+	pendingTextures_.erase(pendingTextures_.begin(), pendingTextures_.begin() + textureCount);
+
+	// --- モデル(頂点バッファを作ってテクスチャを参照する) ---
+	size_t modelCount = 0;
+	while (modelCount < pendingModels_.size() && !isOverBudget) {
+		models_.push_back(ModelManager::GetInstance()->AcquireModel(pendingModels_[modelCount]));
+		modelCount++;
+		isOverBudget = std::chrono::steady_clock::now() - start >= budget;
+	}
+	pendingModels_.erase(pendingModels_.begin(), pendingModels_.begin() + modelCount);
+
+	resolvedCount_ += uint32_t(textureCount + modelCount);
+	return pendingTextures_.empty() && pendingModels_.empty();
+}
+
+float AssetSet::UpdateProgress(bool isRequestFinished)
+{
+	uint32_t requestedCount = requestedCount_;
+	float progress = 1.0f;
+	if (requestedCount != 0) {
+		progress = float(preparedCount_ + resolvedCount_) / float(requestedCount * 2);
+	}
+	if (!isRequestFinished) {
+		progress = (std::min)(progress, 0.99f);
+	}
+	progress_ = (std::max)(progress_, progress);
+	return progress_;
+}
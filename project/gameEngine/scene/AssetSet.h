@@ -0,0 +1,76 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "ModelManager.h"
+#include "TextureManager.h"
+
+// シーン単位のアセット
+// シーンで使うテクスチャ・モデルの参照をまとめて持ち、シーンの破棄と一緒に手放す
+// 次のシーンでも使うものは参照が残るので読み直さない
+//
+// Request系はデコード・解析だけを行い(ワーカースレッドから呼べる)、
+// GPUリソースの作成はメインスレッドのResolveで少しずつ行う
+class AssetSet
+{
+public:
+	AssetSet() = default;
+	~AssetSet() { Clear(); }
+	AssetSet(const AssetSet&) = delete;
+	AssetSet& operator=(const AssetSet&) = delete;
+
+public:
+	// テクスチャの読み込み
+	TextureHandle LoadTexture(const std::string& filePath);
+	// 複数のテクスチャをまとめて読み込み(未クックのものは並列にクックする)
+	void LoadTextures(const std::vector<std::string>& filePaths);
+
+	// モデルの読み込み
+	ModelHandle LoadModel(const std::string& filePath);
+
+	// 全ての参照を手放す
+	void Clear();
+
+public:
+	// テクスチャの読み込みを要求(クックまで済ませる。ワーカースレッドから呼べる)
+	void RequestTextures(const std::vector<std::string>& filePaths);
+	// モデルの読み込みを要求(解析まで済ませる。ワーカースレッドから呼べる)
+	void RequestModel(const std::string& filePath);
+
+	// 要求済みのアセットのGPUリソースを作る(メインスレッドで呼ぶ)
+	// budgetを超えたら残りは次回に回す。全て終わったらtrue
+	bool Resolve(std::chrono::microseconds budget);
+
+	// 要求されたアセット数
+	uint32_t GetRequestedCount() const { return requestedCount_; }
+	// 解析・クックの終わったアセット数
+	uint32_t GetPreparedCount() const { return preparedCount_; }
+	// GPUリソースまで作り終えたアセット数
+	uint32_t GetResolvedCount() const { return resolvedCount_; }
+
+	// 進捗(0〜1。クックと転送を半分ずつ。メインスレッドで呼ぶ)
+	// 後から要求が増えても戻らない。isRequestFinishedになるまでは1にしない
+	float UpdateProgress(bool isRequestFinished);
+
+public:
+	size_t GetTextureCount() const { return textures_.size(); }
+	size_t GetModelCount() const { return models_.size(); }
+
+private:
+	std::vector<TextureHandle> textures_;
+	std::vector<ModelHandle> models_;
+
+	// --- GPUリソースを作っていない要求 ---
+	std::vector<std::string> pendingTextures_;
+	std::vector<std::string> pendingModels_;
+	std::mutex pendingMutex_;
+
+	// --- 進捗 ---
+	std::atomic<uint32_t> requestedCount_ = 0;
+	std::atomic<uint32_t> preparedCount_ = 0;
+	uint32_t resolvedCount_ = 0;
+	float progress_ = 0.0f;
+};
@@ -1,5 +1,9 @@
 #include "BaseScene.h"
 
+void BaseScene::LoadAssets()
+{
+}
+
 void BaseScene::Initialize()
 {
 }
@@ -1,4 +1,8 @@
 #pragma once
+#include <utility>
+
+#include "AssetSet.h"
+#include "MemoryArena.h"
 
 // 前方宣言
 class SceneManager;
@@ -10,6 +14,10 @@ public:
 	// デストラクタ
 	virtual ~BaseScene() = default;
 
+	// アセットの読み込み(Initializeの前に呼ばれる)
+	// 先読みではワーカースレッドで呼ばれるので、assetsのRequest系とAudio::LoadWavなどGPUに触らない処理だけを書く
+	virtual void LoadAssets();
+
 	// 初期化
 	virtual void Initialize();
 
@@ -26,6 +34,20 @@ public:
 	// シーンマネージャを設定
 	virtual void SetSceneManager(SceneManager* sceneManager) { sceneManager_ = sceneManager; }
 
+	// シーンで使うアセットを取得
+	AssetSet& GetAssets() { return assets; }
+
+protected:
+	// シーンのメモリ領域にオブジェクトを生成(deleteしない。シーンの破棄でまとめて破棄される)
+	template<typename T, typename... Args>
+	T* Create(Args&&... args) { return arena.Create<T>(std::forward<Args>(args)...); }
+
+protected:
+	// シーンで使うアセット(シーンの破棄で参照を手放す)
+	AssetSet assets;
+	// シーンのメモリ領域(アセットの参照を持つオブジェクトが先に破棄されるようassetsの後に置く)
+	MemoryArena arena;
+
 private:
 	// シーンマネージャ
 	SceneManager* sceneManager_ = nullptr;
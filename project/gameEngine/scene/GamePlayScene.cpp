@@ -1,63 +1,107 @@
 #include "GamePlayScene.h"
+#include <algorithm>
+#include <cassert>
+
+// レベル(開発中はResources/levels/gameplay.txtから作られる)
+static const char* const kLevelFile = "Resources/levels/gameplay.level";
+
+void GamePlayScene::LoadAssets()
+{
+	// --- レベル ---
+	bool isLoaded = level.Load(kLevelFile);
+	assert(isLoaded);
+
+	// --- テクスチャ(未クックのものは並列にクックされる。シーンの終了で解放) ---
+	std::vector<std::string> textureFiles;
+	for (uint32_t i = 0; i < level.GetTextureCount(); ++i) {
+		textureFiles.emplace_back(level.GetTextureName(i));
+	}
+	assets.RequestTextures(textureFiles);
+
+	// --- 3Dモデル ---
+	for (uint32_t i = 0; i < level.GetModelCount(); ++i) {
+		assets.RequestModel(std::string(level.GetModelName(i)));
+	}
+
+	// --- オーディオ ---
+	for (uint32_t i = 0; i < level.GetSoundCount(); ++i) {
+		sounds.push_back(Audio::GetInstance()->LoadWav(std::string(level.GetSoundName(i)).c_str()));
+	}
+}
 
 void GamePlayScene::Initialize()
 {
 	
 	// --- カメラ ---
-	camera = new Camera();
+	camera = Create<Camera>();
 	camera->SetRotate({ 0.3f,0.0f,0.0f });
 	camera->SetTranslate({ 0.0f,4.0f,-10.0f });
 	Object3dCommon::GetInstance()->SetDefaultCamera(camera);
 
-	// --- スプライト ---
-	std::string textureFile[] = {"Resources/images/uvChecker.png","Resources/images/monsterBall.png" };
+	// --- プール(バッファはここでまとめて作り、以降の生成・破棄では作らない) ---
+	std::string defaultTexture(level.GetTextureName(0));
+	spritePool.Initialize(kSpriteCapacity,
+		[&defaultTexture](Sprite& sprite) { sprite.Initialize(SpriteCommon::GetInstance(), defaultTexture); },
+		[](Sprite& sprite) { sprite.Reset(); });
+	std::span<const LevelFile::ObjectRecord> records = level.GetObjects();
+	object3dPool.Initialize(uint32_t(records.size()) + kObject3dSpawnCapacity,
+		[](Object3d& object) { object.Initialize(Object3dCommon::GetInstance()); },
+		[](Object3d& object) { object.Reset(); });
+
+	// --- スプライト(テクスチャはLoadAssetsで読み込み済み) ---
 	for (uint32_t i = 0; i < 1; ++i) {
-		Sprite* sprite = new Sprite();
-		sprite->Initialize(SpriteCommon::GetInstance(), textureFile[i]);
+		Sprite* sprite = spritePool.Acquire();
+		sprite->SetTexture(std::string(level.GetTextureName(i)));
 		
 		sprites.push_back(sprite);
 	}
 
-	// --- 3Dオブジェクト ----　
-	ModelManager::GetInstance()->LoadModel("plane.obj");
-	ModelManager::GetInstance()->LoadModel("axis.obj");
-
-	for (uint32_t i = 0; i < 2; ++i) {
-		Object3d* object = new Object3d();
-		object->Initialize(Object3dCommon::GetInstance());
-
-		Vector3 position;
-		position.x = i * 2.0f;
-
-		object->SetPosition(position);
-
-		if (i == 0) {
-			object->SetModel("plane.obj");
-		}
-		if (i == 1) {
-			object->SetModel("axis.obj");
-		}
+	// --- 3Dオブジェクト(レベルの配置から生成) ----　
+	object3ds.reserve(object3dPool.GetCapacity());
+	object3dColliders.reserve(object3dPool.GetCapacity());
+	for (const LevelFile::ObjectRecord& record : records) {
+		SpawnObject3d(std::string(level.GetModelName(record.modelIndex)), record.scale, record.rotate, record.translate);
+	}
+}
 
-		object3ds.push_back(object);
+Object3d* GamePlayScene::SpawnObject3d(const std::string& modelName, const Vector3& scale, const Vector3& rotate, const Vector3& translate)
+{
+	// --- プールから取り出す(バッファは前の使用者のものをそのまま使う) ---
+	Object3d* object = object3dPool.Acquire();
+	if (!object) {
+		return nullptr;
 	}
+	object->SetSize(scale);
+	object->SetRotate(rotate);
+	object->SetPosition(translate);
+	object->SetModel(modelName);
+
+	object3ds.push_back(object);
+	object3dColliders.push_back(collisionWorld.AddCollider(object));
+	return object;
+}
 
-	// --- オーディオ ---
-	soundData = Audio::GetInstance()->LoadWav("fanfare.wav");
+void GamePlayScene::DespawnObject3d(Object3d* object)
+{
+	// --- 並びを保ったまま外す(先頭の数個は回転のさせ方が決まっている) ---
+	auto it = std::find(object3ds.begin(), object3ds.end(), object);
+	assert(it != object3ds.end());
+	size_t index = size_t(it - object3ds.begin());
+	collisionWorld.RemoveCollider(object3dColliders[index]);
+	object3ds.erase(it);
+	object3dColliders.erase(object3dColliders.begin() + index);
+
+	// --- プールに返す(バッファは初期値で上書きされる) ---
+	object3dPool.Release(object);
 }
 
 void GamePlayScene::Finalize()
 {
 	// 各解放処理
-	delete camera;
-	for (auto& obj : object3ds) {
-		delete obj;
-	}
-	for (Sprite* sprite : sprites) {
-		delete sprite;
+	// カメラ・スプライト・3Dオブジェクトはシーンのメモリ領域と一緒に破棄される
+	for (SoundData& sound : sounds) {
+		Audio::GetInstance()->SoundUnload(Audio::GetInstance()->GetXAudio2(), &sound);
 	}
-	Object3dCommon::GetInstance()->Finalize();
-	ModelManager::GetInstance()->Finalize();
-	Audio::GetInstance()->SoundUnload(Audio::GetInstance()->GetXAudio2(), &soundData);
 }
 
 void GamePlayScene::Update()
@@ -104,6 +148,9 @@ void GamePlayScene::Update()
 		obj->SetRotate(rotate);
 	}
 
+	// オブジェクトのワールド行列が決まってから判定する
+	collisionWorld.Update();
+
 #pragma endregion 3Dオブジェクト
 }
 
@@ -3,10 +3,16 @@
 #include <BaseScene.h>
 #include <Sprite.h>
 #include <Object3d.h>
+#include <LevelFile.h>
+#include <CollisionWorld.h>
+#include <ObjectPool.h>
 
 class GamePlayScene : public BaseScene
 {
 public:
+	// アセットの読み込み(ワーカースレッドで呼ばれることがある)
+	void LoadAssets() override;
+
 	// 初期化
 	void Initialize() override;
 
@@ -19,16 +25,35 @@ public:
 	// 描画処理
 	void Draw() override;
 
+public:
+	// 3Dオブジェクトを出す(プールから取り出すのでバッファは作らない。空きが無ければnullptr)
+	Object3d* SpawnObject3d(const std::string& modelName, const Vector3& scale, const Vector3& rotate, const Vector3& translate);
+	// 3Dオブジェクトを消す(当たり判定から外してプールに返す)
+	void DespawnObject3d(Object3d* object);
+
+private: // 定数
+	// レベルの配置に加えて実行中に出せる3Dオブジェクトの数
+	static const uint32_t kObject3dSpawnCapacity = 64;
+	// スプライトの数
+	static const uint32_t kSpriteCapacity = 8;
+
 private: // メンバ変数
 	// カメラ
 	Camera* camera = nullptr;
+	// レベル
+	LevelFile level;
 	// サウンド
-	SoundData soundData;
+	std::vector<SoundData> sounds;
 
 	// 2Dスプライト
+	ObjectPool<Sprite> spritePool;
 	std::vector<Sprite*> sprites;
 	// 3Dオブジェクト
+	ObjectPool<Object3d> object3dPool;
 	std::vector<Object3d*> object3ds;
+	std::vector<CollisionWorld::ColliderId> object3dColliders;	// object3dsと同じ並び
+	// 当たり判定
+	CollisionWorld collisionWorld;
 
 };
 
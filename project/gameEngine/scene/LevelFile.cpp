@@ -0,0 +1,224 @@
+#include "LevelFile.h"
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "Logger.h"
+
+// "LEVL"
+const uint32_t LevelFile::kMagic = 0x4C56454C;
+// 形式のバージョン
+const uint32_t LevelFile::kVersion = 1;
+
+// マップしたメモリをそのまま配列として読むため
+static_assert(std::is_trivially_copyable_v<LevelFile::ObjectRecord>);
+static_assert(sizeof(LevelFile::ObjectRecord) == 40);
+
+namespace
+{
+	// 境界に揃える
+	uint64_t AlignUp(uint64_t value, uint64_t alignment)
+	{
+		return (value + alignment - 1) / alignment * alignment;
+	}
+
+	// 配置の配列の位置
+	uint64_t GetObjectsOffset(uint64_t nameCount)
+	{
+		return AlignUp(sizeof(LevelFile::Header) + nameCount * sizeof(LevelFile::StringRef), LevelFile::kAlignment);
+	}
+
+	// 変換中の名前の一覧(重複は1つにまとめる)
+	struct NameTable {
+		std::vector<std::string> names;
+		std::unordered_map<std::string, uint32_t> indices;
+
+		uint32_t Add(const std::string& name) {
+			auto [it, isInserted] = indices.emplace(name, uint32_t(names.size()));
+			if (isInserted) {
+				names.push_back(name);
+			}
+			return it->second;
+		}
+	};
+}
+
+bool LevelFile::Load(const std::filesystem::path& levelPath)
+{
+	// --- 開発中は元のテキストから作り直す ---
+	std::filesystem::path sourcePath = GetSourcePath(levelPath);
+	std::error_code ec;
+	if (!VirtualFileSystem::GetInstance()->IsPackMounted() && std::filesystem::exists(sourcePath, ec)) {
+		bool isStale = !std::filesystem::exists(levelPath, ec) ||
+			std::filesystem::last_write_time(sourcePath, ec) > std::filesystem::last_write_time(levelPath, ec);
+		// 形式が古ければ開けないので作り直す
+		if (!isStale && Open(levelPath)) {
+			return true;
+		}
+		Close();
+		if (!Convert(sourcePath, levelPath)) {
+			return false;
+		}
+	}
+	return Open(levelPath);
+}
+
+bool LevelFile::Open(const std::filesystem::path& levelPath)
+{
+	Close();
+	file_ = VirtualFileSystem::GetInstance()->Open(levelPath);
+	if (!file_.IsValid()) {
+		return false;
+	}
+
+	// --- ヘッダの確認 ---
+	std::span<const uint8_t> data = file_.GetSpan();
+	if (data.size() < sizeof(Header)) {
+		Close();
+		return false;
+	}
+	const Header* header = reinterpret_cast<const Header*>(data.data());
+	uint64_t nameCount = uint64_t(header->modelCount) + header->textureCount + header->soundCount;
+	uint64_t objectsOffset = GetObjectsOffset(nameCount);
+	uint64_t stringsOffset = objectsOffset + uint64_t(header->objectCount) * sizeof(ObjectRecord);
+	if (header->magic != kMagic || header->version != kVersion || stringsOffset + header->stringsSize != data.size()) {
+		Logger::Log("LevelFile: invalid level " + levelPath.string() + "\n");
+		Close();
+		return false;
+	}
+
+	// --- 各領域を直接参照する ---
+	names_ = { reinterpret_cast<const StringRef*>(data.data() + sizeof(Header)), size_t(nameCount) };
+	objects_ = { reinterpret_cast<const ObjectRecord*>(data.data() + objectsOffset), header->objectCount };
+	strings_ = reinterpret_cast<const char*>(data.data() + stringsOffset);
+
+	// 範囲外を指すものがあれば壊れている
+	for (const StringRef& name : names_) {
+		if (name.offset > header->stringsSize || header->stringsSize - name.offset < name.length) {
+			Logger::Log("LevelFile: name out of range in " + levelPath.string() + "\n");
+			Close();
+			return false;
+		}
+	}
+	for (const ObjectRecord& object : objects_) {
+		if (object.modelIndex >= header->modelCount) {
+			Logger::Log("LevelFile: model index out of range in " + levelPath.string() + "\n");
+			Close();
+			return false;
+		}
+	}
+	header_ = header;
+	return true;
+}
+
+void LevelFile::Close()
+{
+	header_ = nullptr;
+	names_ = {};
+	objects_ = {};
+	strings_ = nullptr;
+	file_ = FileData();
+}
+
+bool LevelFile::Convert(const std::filesystem::path& textPath, const std::filesystem::path& levelPath)
+{
+	std::ifstream in(textPath);
+	if (!in.is_open()) {
+		Logger::Log("LevelFile: failed to open " + textPath.string() + "\n");
+		return false;
+	}
+
+	// --- 1行ずつ解析 ---
+	NameTable models;
+	NameTable textures;
+	NameTable sounds;
+	std::vector<ObjectRecord> objects;
+	std::string line;
+	for (uint32_t lineNumber = 1; std::getline(in, line); ++lineNumber) {
+		line = line.substr(0, line.find('#'));
+		std::istringstream s(line);
+		std::string identifier;
+		if (!(s >> identifier)) {
+			continue;
+		}
+
+		auto error = [&](const std::string& message) {
+			Logger::Log("LevelFile: " + textPath.string() + "(" + std::to_string(lineNumber) + "): " + message + "\n");
+			return false;
+		};
+
+		std::string name;
+		if (identifier == "model" || identifier == "texture" || identifier == "sound") {
+			if (!(s >> name)) {
+				return error("missing file name");
+			}
+			NameTable& table = identifier == "model" ? models : identifier == "texture" ? textures : sounds;
+			table.Add(name);
+		}
+		else if (identifier == "object") {
+			if (!(s >> name)) {
+				return error("missing model name");
+			}
+			ObjectRecord object{ models.Add(name), { 1.0f, 1.0f, 1.0f }, {}, {} };
+			std::string key;
+			while (s >> key) {
+				Vector3* target = key == "translate" ? &object.translate : key == "rotate" ? &object.rotate : key == "scale" ? &object.scale : nullptr;
+				if (!target) {
+					return error("unknown key " + key);
+				}
+				if (!(s >> target->x >> target->y >> target->z)) {
+					return error("expected 3 numbers after " + key);
+				}
+			}
+			objects.push_back(object);
+		}
+		else {
+			return error("unknown identifier " + identifier);
+		}
+	}
+
+	// --- 名前を文字列領域に詰める ---
+	std::vector<StringRef> names;
+	std::string strings;
+	for (const NameTable* table : { &models, &textures, &sounds }) {
+		for (const std::string& name : table->names) {
+			names.push_back({ uint32_t(strings.size()), uint32_t(name.size()) });
+			strings += name;
+		}
+	}
+
+	// --- 書き出す(読み込み中・書き込み途中のファイルを開かないように一時ファイルから置き換える) ---
+	std::filesystem::path tempPath = levelPath;
+	tempPath += ".tmp";
+	std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+	if (!out.is_open()) {
+		Logger::Log("LevelFile: failed to open " + tempPath.string() + "\n");
+		return false;
+	}
+	Header header{ kMagic, kVersion, uint32_t(models.names.size()), uint32_t(textures.names.size()), uint32_t(sounds.names.size()),
+		uint32_t(objects.size()), uint32_t(strings.size()), 0 };
+	out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	out.write(reinterpret_cast<const char*>(names.data()), std::streamsize(names.size() * sizeof(StringRef)));
+	static const char kPadding[kAlignment] = {};
+	uint64_t offset = sizeof(Header) + names.size() * sizeof(StringRef);
+	out.write(kPadding, std::streamsize(GetObjectsOffset(names.size()) - offset));
+	out.write(reinterpret_cast<const char*>(objects.data()), std::streamsize(objects.size() * sizeof(ObjectRecord)));
+	out.write(strings.data(), std::streamsize(strings.size()));
+	out.close();
+
+	std::error_code ec;
+	if (!out.good()) {
+		std::filesystem::remove(tempPath, ec);
+		return false;
+	}
+	std::filesystem::rename(tempPath, levelPath, ec);
+	if (ec) {
+		Logger::Log("LevelFile: failed to replace " + levelPath.string() + "\n");
+		std::filesystem::remove(tempPath, ec);
+		return false;
+	}
+	return true;
+}
@@ -0,0 +1,100 @@
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string_view>
+
+#include "Vector3.h"
+#include "VirtualFileSystem.h"
+
+// レベルファイル
+// シーンで使うモデル・テクスチャ・サウンドの一覧とオブジェクトの配置を持つバイナリ形式
+// 丸ごとマップして、配置はそのまま配列として参照する(オブジェクトごとの解析はしない)
+// [ヘッダ][名前の参照(モデル・テクスチャ・サウンドの順)][kAlignmentに揃えた配置の配列][名前の文字列]
+class LevelFile
+{
+public:
+	// ファイル先頭の識別子
+	static const uint32_t kMagic;
+	// 形式のバージョン(変えたら元のテキストから作り直される)
+	static const uint32_t kVersion;
+	// 配置の配列の先頭を揃える境界
+	static const uint32_t kAlignment = 16;
+
+	// ヘッダ
+	struct Header {
+		uint32_t magic;
+		uint32_t version;
+		uint32_t modelCount;
+		uint32_t textureCount;
+		uint32_t soundCount;
+		uint32_t objectCount;
+		uint32_t stringsSize;	// 文字列領域のバイト数
+		uint32_t reserved;
+	};
+
+	// 文字列領域の中の名前
+	struct StringRef {
+		uint32_t offset;
+		uint32_t length;
+	};
+
+	// オブジェクトの配置
+	struct ObjectRecord {
+		uint32_t modelIndex;	// モデル一覧の番号
+		Vector3 scale;
+		Vector3 rotate;
+		Vector3 translate;
+	};
+
+public:
+	// レベルを読み込む
+	// パックを使っていなければ、元のテキスト(拡張子.txt)の方が新しい・形式が古いときに変換し直す
+	bool Load(const std::filesystem::path& levelPath);
+
+	// バイナリを開く(形式が違えばfalse)
+	bool Open(const std::filesystem::path& levelPath);
+	// 閉じる
+	void Close();
+
+public:
+	// 開いているか
+	bool IsOpen() const { return header_ != nullptr; }
+
+	// モデル
+	uint32_t GetModelCount() const { return header_->modelCount; }
+	std::string_view GetModelName(uint32_t index) const { return GetString(names_[index]); }
+	// テクスチャ
+	uint32_t GetTextureCount() const { return header_->textureCount; }
+	std::string_view GetTextureName(uint32_t index) const { return GetString(names_[header_->modelCount + index]); }
+	// サウンド
+	uint32_t GetSoundCount() const { return header_->soundCount; }
+	std::string_view GetSoundName(uint32_t index) const { return GetString(names_[header_->modelCount + header_->textureCount + index]); }
+
+	// オブジェクトの配置(マップしたファイルを直接参照)
+	std::span<const ObjectRecord> GetObjects() const { return objects_; }
+
+public:
+	// テキストからバイナリに変換する
+	// 1行1件で、"#"以降はコメント
+	//   model    <ファイル名>
+	//   texture  <ファイルパス>
+	//   sound    <ファイル名>
+	//   object   <モデルのファイル名> [translate x y z] [rotate x y z] [scale x y z]
+	static bool Convert(const std::filesystem::path& textPath, const std::filesystem::path& levelPath);
+
+	// 元のテキストのパス
+	static std::filesystem::path GetSourcePath(const std::filesystem::path& levelPath) {
+		return std::filesystem::path(levelPath).replace_extension(".txt");
+	}
+
+private:
+	std::string_view GetString(const StringRef& ref) const { return { strings_ + ref.offset, ref.length }; }
+
+private:
+	FileData file_;
+	const Header* header_ = nullptr;
+	std::span<const StringRef> names_;
+	std::span<const ObjectRecord> objects_;
+	const char* strings_ = nullptr;
+};
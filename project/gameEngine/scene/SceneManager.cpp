@@ -1,8 +1,12 @@
 #include "SceneManager.h"
 #include <cassert>
 
+#include "Logger.h"
+
 SceneManager* SceneManager::instance = nullptr;
 
+const std::chrono::microseconds SceneManager::kPreloadBudget{ 2000 };
+
 SceneManager* SceneManager::GetInstance()
 {
 	if (instance == nullptr) {
@@ -13,6 +17,22 @@ SceneManager* SceneManager::GetInstance()
 
 void SceneManager::Finalize()
 {
+	// --- 先読み中ならワーカーを待ってから終了・破棄(使わなかったシーンも音声などを読み込んでいる) ---
+	if (preloadTask_.valid()) {
+		FinishPreloadTask();
+	}
+	if (preloadScene_) {
+		if (nextScene_ == preloadScene_) {
+			nextScene_ = nullptr;
+		}
+		preloadScene_->Finalize();
+		delete preloadScene_;
+	}
+	ResetPreload();
+	// 先読みしていない次のシーンはまだ何も読み込んでいない
+	delete nextScene_;
+	nextScene_ = nullptr;
+
 	scene_->Finalize();
 	delete scene_;
 
@@ -22,8 +42,14 @@ void SceneManager::Finalize()
 
 void SceneManager::Update()
 {
+	// --- 先読みを進める(今のシーンは動かし続ける) ---
+	if (preloadScene_ && !isPreloadReady_) {
+		isPreloadReady_ = UpdatePreload();
+	}
+
 	// --- シーン切り替え機構 ---
-	if (nextScene_) {
+	// 先読み中のシーンは読み込みが終わるまで待つ
+	if (nextScene_ && (nextScene_ != preloadScene_ || isPreloadReady_)) {
 		// 旧シーン終了
 		if (scene_) {
 			scene_->Finalize();
@@ -34,8 +60,19 @@ void SceneManager::Update()
 		scene_ = nextScene_;
 		nextScene_ = nullptr;
 
-		// シーンマネージャをセット
-		scene_->SetSceneManager(this);
+		if (scene_ == preloadScene_) {
+			// 先読み済みならアセットは揃っている
+			ResetPreload();
+		}
+		else {
+			// シーンマネージャをセット
+			scene_->SetSceneManager(this);
+
+			// アセットをこのフレームで全て読み込む
+			scene_->LoadAssets();
+			while (!scene_->GetAssets().Resolve(kPreloadBudget)) {
+			}
+		}
 
 		// 次のシーンを初期化
 		scene_->Initialize();
@@ -56,6 +93,83 @@ void SceneManager::ChangeScene(const std::string& sceneName)
 	assert(sceneFactory_);
 	assert(nextScene_ == nullptr);
 
+	// --- 先読み中のシーンならそれを使う ---
+	if (preloadScene_ && preloadSceneName_ == sceneName) {
+		nextScene_ = preloadScene_;
+		return;
+	}
+
 	// 次のシーンを生成
 	nextScene_ = sceneFactory_->CreateScene(sceneName);
 }
+
+void SceneManager::PreloadScene(const std::string& sceneName)
+{
+	assert(sceneFactory_);
+	// 同時に先読みできるのは1つまで
+	assert(preloadScene_ == nullptr);
+
+	if (!threadPool_) {
+		threadPool_ = std::make_unique<ThreadPool>(1);
+	}
+
+	// --- シーンを生成してワーカーでアセットを読み込む ---
+	preloadScene_ = sceneFactory_->CreateScene(sceneName);
+	preloadSceneName_ = sceneName;
+	preloadScene_->SetSceneManager(this);
+	isPreloadReady_ = false;
+	preloadProgress_ = 0.0f;
+	BaseScene* scene = preloadScene_;
+	preloadTask_ = threadPool_->Submit([scene]() { scene->LoadAssets(); });
+}
+
+bool SceneManager::UpdatePreload()
+{
+	// --- ワーカーでの読み込みが終わったか(先に見ておき、要求の出そろった後だけ完了とする) ---
+	bool isLoaded = !preloadTask_.valid() || preloadTask_.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+
+	// --- 読み込みに失敗したら先読みをやめる(読み込み途中のシーンには切り替えない) ---
+	if (preloadTask_.valid() && isLoaded && !FinishPreloadTask()) {
+		// 切り替え予約済みなら作り直し、切り替えるフレームにメインスレッドで読み込み直す
+		bool isNextScene = nextScene_ == preloadScene_;
+		std::string sceneName = preloadSceneName_;
+		preloadScene_->Finalize();
+		delete preloadScene_;
+		ResetPreload();
+		if (isNextScene) {
+			nextScene_ = sceneFactory_->CreateScene(sceneName);
+		}
+		return false;
+	}
+
+	// --- 要求済みの分からGPUリソースを作る(読み込みと並行して進める) ---
+	AssetSet& assets = preloadScene_->GetAssets();
+	bool isResolved = assets.Resolve(kPreloadBudget);
+
+	// --- 進捗(後から要求が増えても戻らない) ---
+	preloadProgress_ = assets.UpdateProgress(isLoaded);
+
+	return isLoaded && isResolved;
+}
+
+bool SceneManager::FinishPreloadTask()
+{
+	// --- ワーカーで投げられた例外をここで受け取る ---
+	try {
+		preloadTask_.get();
+	}
+	catch (const std::exception& e) {
+		Logger::Log("Error: Failed to preload scene: " + preloadSceneName_ + " (" + e.what() + ")\n");
+		return false;
+	}
+	return true;
+}
+
+void SceneManager::ResetPreload()
+{
+	preloadScene_ = nullptr;
+	preloadSceneName_.clear();
+	preloadTask_ = {};
+	isPreloadReady_ = false;
+	preloadProgress_ = 0.0f;
+}
@@ -1,5 +1,10 @@
 #pragma once
+#include <chrono>
+#include <future>
+#include <memory>
+#include <string>
 #include <BaseScene.h>
+#include <ThreadPool.h>
 
 #include <AbstractSceneFactory.h>
 
@@ -30,12 +35,34 @@ public:
 	void Draw();
 
 	// 次のシーンを予約	
+	// 先読み中のシーンなら読み込みが終わるまで今のシーンを続け、終わったフレームで切り替える
 	void ChangeScene(const std::string& sceneName);
 
+	// 次のシーンを裏で読み込み始める
+	// LoadAssetsをワーカーで実行し、GPUリソースは毎フレームkPreloadBudgetまで作る
+	void PreloadScene(const std::string& sceneName);
+
+	// 先読み中か
+	bool IsPreloading() const { return preloadScene_ != nullptr; }
+	// 先読みの進捗(0～1。ロード画面用)
+	float GetPreloadProgress() const { return preloadProgress_; }
+
 	// シーンファクトリーを設定
 	void SetSceneFactory(AbstractSceneFactory* sceneFactory) { sceneFactory_ = sceneFactory; }
 
 
+public:
+	// 先読みで1フレームにGPUリソースの作成に使う時間
+	static const std::chrono::microseconds kPreloadBudget;
+
+private:
+	// 先読みを1フレーム分進める(全て終わったらtrue。失敗したら先読みをやめてfalse)
+	bool UpdatePreload();
+	// ワーカーでのLoadAssetsの結果を受け取る(例外が投げられていればログに出してfalse)
+	bool FinishPreloadTask();
+	// 先読みの後始末(シーンは破棄しない)
+	void ResetPreload();
+
 private:
 	// 実行中のシーン
 	BaseScene* scene_ = nullptr;
@@ -44,5 +71,13 @@ private:
 
 	// シーンファクトリー
 	AbstractSceneFactory* sceneFactory_ = nullptr;
+
+	// --- 先読み ---
+	BaseScene* preloadScene_ = nullptr;		// 先読み中のシーン
+	std::string preloadSceneName_;
+	std::future<void> preloadTask_;			// ワーカーでのLoadAssets
+	bool isPreloadReady_ = false;			// GPUリソースまで作り終えた
+	float preloadProgress_ = 0.0f;
+	std::unique_ptr<ThreadPool> threadPool_;
 };
 
@@ -1,31 +1,39 @@
 #include "TitleScene.h"
 
+// スプライトに使うテクスチャ
+static const std::vector<std::string> kTextureFiles = { "Resources/images/monsterBall.png" };
+
+void TitleScene::LoadAssets()
+{
+	// --- テクスチャ(シーンの終了で解放) ---
+	assets.RequestTextures(kTextureFiles);
+}
+
 void TitleScene::Initialize()
 {
 	// --- カメラ ---
-	camera = new Camera();
+	camera = Create<Camera>();
 	camera->SetRotate({ 0.3f,0.0f,0.0f });
 	camera->SetTranslate({ 0.0f,4.0f,-10.0f });
 	Object3dCommon::GetInstance()->SetDefaultCamera(camera);
 
-	// --- スプライト ---
-	std::string textureFile[] = { "Resources/images/monsterBall.png" };
+	// --- スプライト(テクスチャはLoadAssetsで読み込み済み) ---
 	for (uint32_t i = 0; i < 1; ++i) {
-		Sprite* sprite = new Sprite();
-		sprite->Initialize(SpriteCommon::GetInstance(), textureFile[i]);
+		Sprite* sprite = Create<Sprite>();
+		sprite->Initialize(SpriteCommon::GetInstance(), kTextureFiles[i]);
 
 		sprites.push_back(sprite);
 	}
 	sceneManager_ = SceneManager::GetInstance();
+
+	// --- 次のシーンをタイトル表示中に読み込んでおく ---
+	sceneManager_->PreloadScene("GAMEPLAY");
 }
 
 void TitleScene::Finalize()
 {
 	// 各解放処理
-	delete camera;
-	for (Sprite* sprite : sprites) {
-		delete sprite;
-	}
+	// カメラ・スプライト・3Dオブジェクトはシーンのメモリ領域と一緒に破棄される
 	Audio::GetInstance()->SoundUnload(Audio::GetInstance()->GetXAudio2(), &soundData);
 }
 
@@ -53,7 +61,7 @@ void TitleScene::Update()
 	// --- シーン移行処理 ---
 	// ENTERキーを押したら
 	if (Input::GetInstance()->TriggerKey(DIK_RETURN)) {
-		// 次のシーンを生成
+		// 次のシーンへ(先読みが終わっていればこのフレームで切り替わる)
 		SceneManager::GetInstance()->ChangeScene("GAMEPLAY");
 	}
 }
@@ -8,6 +8,9 @@
 class TitleScene : public BaseScene
 {
 public:
+	// アセットの読み込み(ワーカースレッドで呼ばれることがある)
+	void LoadAssets() override;
+
 	// 初期化
 	void Initialize() override;
 
@@ -24,7 +27,7 @@ private: // メンバ変数
 	// カメラ
 	Camera* camera = nullptr;
 	// サウンド
-	SoundData soundData;
+	SoundData soundData{};
 
 	// 2Dスプライト
 	std::vector<Sprite*> sprites;
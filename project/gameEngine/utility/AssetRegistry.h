@@ -0,0 +1,242 @@
+#pragma once
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "FenceRetireQueue.h"
+
+// 参照カウント付きアセットの登録簿
+// 名前→スロット番号で管理し、参照が0になったらその時点のフェンス値で破棄待ちにする
+// GPUがそのフェンス値を追い越したらCollectで破棄する(デバイスには触らない)
+template<typename T>
+class AssetRegistry
+{
+public:
+	static constexpr uint32_t kInvalidId = UINT32_MAX;
+
+	// 登録されている1件分
+	struct Entry {
+		std::string name;
+		std::unique_ptr<T> asset;
+		uint32_t refCount = 0;
+		bool isRetired = false;			// 参照が0になって破棄待ち
+		uint64_t retireFenceValue = 0;	// 破棄してよくなるフェンス値
+	};
+
+public:
+	AssetRegistry() = default;
+	AssetRegistry(const AssetRegistry&) = delete;
+	AssetRegistry& operator=(const AssetRegistry&) = delete;
+
+public:
+	// 名前で検索(破棄待ちのものも見つかる。無ければkInvalidId)
+	uint32_t Find(const std::string& name) const {
+		auto it = ids_.find(name);
+		return it != ids_.end() ? it->second : kInvalidId;
+	}
+
+	// 追加(参照カウント0で作る。ハンドルを作るまでは破棄されない)
+	uint32_t Add(const std::string& name, std::unique_ptr<T> asset) {
+		assert(!ids_.contains(name));
+		uint32_t id;
+		if (!freeIds_.empty()) {
+			id = freeIds_.back();
+			freeIds_.pop_back();
+		}
+		else {
+			id = uint32_t(entries_.size());
+			entries_.emplace_back();
+		}
+		Entry& entry = entries_[id];
+		entry.name = name;
+		entry.asset = std::move(asset);
+		entry.refCount = 0;
+		entry.isRetired = false;
+		ids_.emplace(name, id);
+		return id;
+	}
+
+	// アセットの取得(破棄済みならnullptr)
+	T* Get(uint32_t id) const {
+		return id < entries_.size() ? entries_[id].asset.get() : nullptr;
+	}
+	// 名前で取得
+	T* Get(const std::string& name) const { return Get(Find(name)); }
+
+	// 名前の取得
+	const std::string& GetName(uint32_t id) const { return entries_[id].name; }
+	// 参照カウントの取得
+	uint32_t GetRefCount(uint32_t id) const { return entries_[id].refCount; }
+
+	// 参照を増やす(破棄待ちなら復活させる)
+	void AddRef(uint32_t id) {
+		Entry& entry = entries_[id];
+		assert(entry.asset);
+		entry.refCount++;
+		entry.isRetired = false;
+	}
+
+	// 参照を減らす(0になったら現在のフェンス値で破棄待ちにする)
+	void Release(uint32_t id) {
+		Entry& entry = entries_[id];
+		assert(entry.asset && entry.refCount > 0);
+		if (--entry.refCount > 0) {
+			return;
+		}
+		entry.isRetired = true;
+		entry.retireFenceValue = retireFenceValue_;
+		retireQueue_.Push(retireFenceValue_, id);
+	}
+
+	// 今記録しているコマンドの完了時にシグナルされるフェンス値(以降のReleaseはこの値を待つ)
+	void SetRetireFenceValue(uint64_t fenceValue) {
+		assert(retireFenceValue_ <= fenceValue);
+		retireFenceValue_ = fenceValue;
+	}
+
+	// completedFenceValueまでに使い終わった破棄待ちを破棄する
+	// onDestroy(id, T&)は破棄の直前に呼ばれる(SRVの返却など)。破棄した数を返す
+	template<typename F>
+	size_t Collect(uint64_t completedFenceValue, F&& onDestroy) {
+		size_t count = 0;
+		retireQueue_.Retire(completedFenceValue, [&](uint32_t id) {
+			Entry& entry = entries_[id];
+			// 復活したもの・後から破棄待ちになり直したものは残す
+			if (!entry.asset || !entry.isRetired || entry.retireFenceValue > completedFenceValue) {
+				return;
+			}
+			onDestroy(id, *entry.asset);
+			ids_.erase(entry.name);
+			// 破棄中に他のアセットを解放してもよいように、先にスロットから外す
+			std::unique_ptr<T> asset = std::move(entry.asset);
+			entry = Entry{};
+			freeIds_.push_back(id);
+			asset.reset();
+			count++;
+			});
+		return count;
+	}
+	size_t Collect(uint64_t completedFenceValue) {
+		return Collect(completedFenceValue, [](uint32_t, T&) {});
+	}
+
+	// 破棄待ちを含む全てのアセットを巡回(func(id, Entry&))
+	template<typename F>
+	void ForEach(F&& func) {
+		for (uint32_t id = 0; id < entries_.size(); ++id) {
+			if (entries_[id].asset) {
+				func(id, entries_[id]);
+			}
+		}
+	}
+	template<typename F>
+	void ForEach(F&& func) const {
+		for (uint32_t id = 0; id < entries_.size(); ++id) {
+			if (entries_[id].asset) {
+				func(id, entries_[id]);
+			}
+		}
+	}
+
+	// 使用状況の一覧(bytesOf(const T&)でメモリ量を求める)
+	template<typename F>
+	std::string BuildReport(const std::string& label, F&& bytesOf) const {
+		std::string report;
+		uint64_t totalBytes = 0;
+		char line[96];
+		ForEach([&](uint32_t, const Entry& entry) {
+			uint64_t bytes = bytesOf(*entry.asset);
+			totalBytes += bytes;
+			std::snprintf(line, sizeof(line), " refs=%u%s %.1fKB\n",
+				entry.refCount, entry.isRetired ? " (retired)" : "", double(bytes) / 1024.0);
+			report += "  " + entry.name + line;
+			});
+		std::snprintf(line, sizeof(line), ": %zu live, %zu pending destroy, %.1fKB\n", GetLiveCount(), GetPendingCount(), double(totalBytes) / 1024.0);
+		return label + line + report;
+	}
+
+public:
+	// 生存しているアセット数(破棄待ちを含む)
+	size_t GetLiveCount() const { return ids_.size(); }
+	// 破棄待ちの数
+	size_t GetPendingCount() const {
+		size_t count = 0;
+		ForEach([&count](uint32_t, const Entry& entry) { count += entry.isRetired ? 1 : 0; });
+		return count;
+	}
+
+private:
+	std::vector<Entry> entries_;
+	std::unordered_map<std::string, uint32_t> ids_;
+	std::vector<uint32_t> freeIds_;
+
+	// 破棄待ちのスロット番号
+	FenceRetireQueue<uint32_t> retireQueue_;
+	uint64_t retireFenceValue_ = 0;
+};
+
+// 参照カウント付きアセットハンドル
+// コピーで参照が増え、破棄で減る。最後のハンドルが無くなるとAssetRegistryで破棄待ちになる
+template<typename T>
+class AssetHandle
+{
+public:
+	AssetHandle() = default;
+	AssetHandle(AssetRegistry<T>* registry, uint32_t id) : registry_(registry), id_(id) {
+		if (registry_) {
+			registry_->AddRef(id_);
+		}
+	}
+	~AssetHandle() { Reset(); }
+
+	AssetHandle(const AssetHandle& other) : AssetHandle(other.registry_, other.id_) {}
+	AssetHandle& operator=(const AssetHandle& other) {
+		if (this != &other) {
+			// 自分と同じアセットでも先に参照を増やすので破棄されない
+			AssetHandle copy(other);
+			*this = std::move(copy);
+		}
+		return *this;
+	}
+	AssetHandle(AssetHandle&& other) noexcept
+		: registry_(std::exchange(other.registry_, nullptr)), id_(std::exchange(other.id_, AssetRegistry<T>::kInvalidId)) {}
+	AssetHandle& operator=(AssetHandle&& other) noexcept {
+		if (this != &other) {
+			Reset();
+			registry_ = std::exchange(other.registry_, nullptr);
+			id_ = std::exchange(other.id_, AssetRegistry<T>::kInvalidId);
+		}
+		return *this;
+	}
+
+	// 参照を手放す
+	void Reset() {
+		if (registry_) {
+			registry_->Release(id_);
+			registry_ = nullptr;
+			id_ = AssetRegistry<T>::kInvalidId;
+		}
+	}
+
+public:
+	T* Get() const { return registry_ ? registry_->Get(id_) : nullptr; }
+	T* operator->() const { return Get(); }
+	T& operator*() const { return *Get(); }
+	explicit operator bool() const { return registry_ != nullptr; }
+
+	// スロット番号(同じアセットなら同じ)
+	uint32_t GetId() const { return id_; }
+	// 登録名
+	const std::string& GetName() const { return registry_->GetName(id_); }
+
+	bool operator==(const AssetHandle& other) const { return registry_ == other.registry_ && id_ == other.id_; }
+
+private:
+	AssetRegistry<T>* registry_ = nullptr;
+	uint32_t id_ = AssetRegistry<T>::kInvalidId;
+};
@@ -0,0 +1,193 @@
+#include "BlockCompression.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+#include "ThreadPool.h"
+
+namespace
+{
+	// "BLZ4"
+	const uint32_t kMagic = 0x345A4C42;
+	// 格納サイズの最上位ビットが立っていれば無圧縮
+	const uint32_t kRawFlag = 0x80000000u;
+
+	// ヘッダ
+	struct Header {
+		uint32_t magic;
+		uint32_t blockSize;
+		uint64_t size;
+		uint32_t blockCount;
+		uint32_t reserved;
+	};
+
+	// 読み込んだストリームの情報
+	struct Stream {
+		Header header;
+		std::vector<uint64_t> offsets;	// 各ブロックの開始位置(src先頭から。blockCount+1個)
+		std::vector<bool> isRaw;		// 無圧縮で格納されているか
+	};
+
+	// ヘッダとブロック表を読んで範囲を検証
+	bool ReadStream(std::span<const uint8_t> src, Stream& stream)
+	{
+		if (src.size() < sizeof(Header)) {
+			return false;
+		}
+		std::memcpy(&stream.header, src.data(), sizeof(Header));
+		const Header& header = stream.header;
+		if (header.magic != kMagic || header.blockSize == 0 ||
+			uint64_t(header.blockCount) != (header.size + header.blockSize - 1) / header.blockSize) {
+			return false;
+		}
+
+		size_t tableSize = size_t(header.blockCount) * sizeof(uint32_t);
+		if (src.size() - sizeof(Header) < tableSize) {
+			return false;
+		}
+
+		// --- 格納サイズの累積で各ブロックの位置を求める ---
+		stream.offsets.resize(size_t(header.blockCount) + 1);
+		stream.isRaw.resize(header.blockCount);
+		uint64_t offset = sizeof(Header) + tableSize;
+		for (uint32_t i = 0; i < header.blockCount; ++i) {
+			uint32_t storedSize;
+			std::memcpy(&storedSize, src.data() + sizeof(Header) + size_t(i) * sizeof(uint32_t), sizeof(storedSize));
+			stream.offsets[i] = offset;
+			stream.isRaw[i] = (storedSize & kRawFlag) != 0;
+			offset += storedSize & ~kRawFlag;
+		}
+		stream.offsets[header.blockCount] = offset;
+		return offset <= src.size();
+	}
+
+	// 1ブロックを展開(dstはそのブロックの展開後のサイズ)
+	bool DecompressBlock(std::span<const uint8_t> src, const Stream& stream, uint32_t index, std::span<uint8_t> dst)
+	{
+		std::span<const uint8_t> stored = src.subspan(size_t(stream.offsets[index]), size_t(stream.offsets[index + 1] - stream.offsets[index]));
+		if (stream.isRaw[index]) {
+			if (stored.size() != dst.size()) {
+				return false;
+			}
+			std::memcpy(dst.data(), stored.data(), dst.size());
+			return true;
+		}
+		return Lz4::Decompress(stored, dst);
+	}
+}
+
+void BlockCompression::Compress(std::span<const uint8_t> src, std::vector<uint8_t>& dst, Lz4::Level level, uint32_t blockSize, ThreadPool* threadPool)
+{
+	Header header{ kMagic, blockSize, src.size(), uint32_t((src.size() + blockSize - 1) / blockSize), 0 };
+
+	// --- ブロックごとに独立に圧縮 ---
+	std::vector<std::vector<uint8_t>> blocks(header.blockCount);
+	auto compressBlocks = [&](uint32_t begin, uint32_t end) {
+		for (uint32_t i = begin; i < end; ++i) {
+			std::span<const uint8_t> block = src.subspan(size_t(i) * blockSize, std::min<size_t>(blockSize, src.size() - size_t(i) * blockSize));
+			Lz4::Compress(block, blocks[i], level);
+			// 小さくならなければそのまま格納
+			if (blocks[i].size() >= block.size()) {
+				blocks[i].assign(block.begin(), block.end());
+			}
+		}
+		};
+	if (threadPool) {
+		threadPool->ParallelFor(header.blockCount, compressBlocks);
+	} else {
+		compressBlocks(0, header.blockCount);
+	}
+
+	// --- ヘッダ・ブロック表・ブロックの順に書き出す ---
+	const uint8_t* headerBytes = reinterpret_cast<const uint8_t*>(&header);
+	dst.insert(dst.end(), headerBytes, headerBytes + sizeof(header));
+	for (uint32_t i = 0; i < header.blockCount; ++i) {
+		size_t blockBytes = std::min<size_t>(blockSize, src.size() - size_t(i) * blockSize);
+		uint32_t storedSize = uint32_t(blocks[i].size()) | (blocks[i].size() == blockBytes ? kRawFlag : 0);
+		const uint8_t* sizeBytes = reinterpret_cast<const uint8_t*>(&storedSize);
+		dst.insert(dst.end(), sizeBytes, sizeBytes + sizeof(storedSize));
+	}
+	for (const std::vector<uint8_t>& block : blocks) {
+		dst.insert(dst.end(), block.begin(), block.end());
+	}
+}
+
+bool BlockCompression::IsBlockStream(std::span<const uint8_t> src)
+{
+	uint64_t size = 0;
+	return GetSize(src, size);
+}
+
+bool BlockCompression::GetSize(std::span<const uint8_t> src, uint64_t& size)
+{
+	if (src.size() < sizeof(Header)) {
+		return false;
+	}
+	Header header;
+	std::memcpy(&header, src.data(), sizeof(Header));
+	if (header.magic != kMagic) {
+		return false;
+	}
+	size = header.size;
+	return true;
+}
+
+bool BlockCompression::Decompress(std::span<const uint8_t> src, std::span<uint8_t> dst, ThreadPool* threadPool)
+{
+	uint64_t size = 0;
+	if (!GetSize(src, size) || size != dst.size()) {
+		return false;
+	}
+	return DecompressRange(src, 0, dst, threadPool);
+}
+
+bool BlockCompression::DecompressRange(std::span<const uint8_t> src, uint64_t offset, std::span<uint8_t> dst, ThreadPool* threadPool)
+{
+	Stream stream;
+	if (!ReadStream(src, stream) || offset > stream.header.size || stream.header.size - offset < dst.size()) {
+		return false;
+	}
+	if (dst.empty()) {
+		return true;
+	}
+
+	// --- 範囲にかかるブロック ---
+	const uint64_t blockSize = stream.header.blockSize;
+	const uint64_t end = offset + dst.size();
+	const uint32_t firstBlock = uint32_t(offset / blockSize);
+	const uint32_t lastBlock = uint32_t((end - 1) / blockSize);
+
+	// --- 各ブロックを展開先に直接展開(端のブロックだけ一時バッファを経由) ---
+	std::atomic<bool> isValid = true;
+	auto decompressBlocks = [&](uint32_t begin, uint32_t blockEnd) {
+		std::vector<uint8_t> temporary;
+		for (uint32_t i = firstBlock + begin; i < firstBlock + blockEnd; ++i) {
+			uint64_t blockBegin = uint64_t(i) * blockSize;
+			uint64_t blockBytes = std::min(blockSize, stream.header.size - blockBegin);
+			uint64_t copyBegin = std::max(blockBegin, offset);
+			uint64_t copyEnd = std::min(blockBegin + blockBytes, end);
+			std::span<uint8_t> target = dst.subspan(size_t(copyBegin - offset), size_t(copyEnd - copyBegin));
+
+			if (copyBegin == blockBegin && copyEnd == blockBegin + blockBytes) {
+				if (!DecompressBlock(src, stream, i, target)) {
+					isValid = false;
+				}
+				continue;
+			}
+			temporary.resize(size_t(blockBytes));
+			if (!DecompressBlock(src, stream, i, temporary)) {
+				isValid = false;
+				continue;
+			}
+			std::memcpy(target.data(), temporary.data() + (copyBegin - blockBegin), target.size());
+		}
+		};
+
+	uint32_t blockCount = lastBlock - firstBlock + 1;
+	if (threadPool && blockCount > 1) {
+		threadPool->ParallelFor(blockCount, decompressBlocks);
+	} else {
+		decompressBlocks(0, blockCount);
+	}
+	return isValid;
+}
@@ -0,0 +1,34 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "Lz4.h"
+
+class ThreadPool;
+
+// ブロック単位の圧縮ストリーム
+// 一定サイズ(64~256KB)のブロックを独立にLZ4圧縮するので、ワーカーで並列に・必要な範囲だけ展開できる
+// [ヘッダ][ブロックごとの格納サイズ][各ブロック]
+namespace BlockCompression
+{
+	// 既定のブロックサイズ
+	constexpr uint32_t kDefaultBlockSize = 128 * 1024;
+
+	// 圧縮してdstの末尾に追加(threadPoolがあればブロックを並列に圧縮する)
+	void Compress(std::span<const uint8_t> src, std::vector<uint8_t>& dst, Lz4::Level level,
+		uint32_t blockSize = kDefaultBlockSize, ThreadPool* threadPool = nullptr);
+
+	// ブロックストリームか
+	bool IsBlockStream(std::span<const uint8_t> src);
+
+	// 展開後のサイズ(ブロックストリームでなければfalse)
+	bool GetSize(std::span<const uint8_t> src, uint64_t& size);
+
+	// 全体を展開(dstは展開後のサイズぴったりであること)
+	bool Decompress(std::span<const uint8_t> src, std::span<uint8_t> dst, ThreadPool* threadPool = nullptr);
+
+	// 展開後のoffsetからdst.size()分だけを展開(範囲にかかるブロックだけを展開する)
+	bool DecompressRange(std::span<const uint8_t> src, uint64_t offset, std::span<uint8_t> dst, ThreadPool* threadPool = nullptr);
+};
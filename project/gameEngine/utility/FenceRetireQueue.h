@@ -0,0 +1,40 @@
+#pragma once
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <utility>
+
+// フェンス値で解放を待つキュー
+// GPUがfenceValueまで進んだら、その値で積まれた要素を取り出す(デバイスには触らない)
+template<typename T>
+class FenceRetireQueue
+{
+public:
+	// fenceValueのコマンドが終わるまで保持する(fenceValueは単調増加で積むこと)
+	void Push(uint64_t fenceValue, T item) {
+		assert(pending_.empty() || pending_.back().first <= fenceValue);
+		pending_.emplace_back(fenceValue, std::move(item));
+	}
+
+	// completedFenceValueまでに終わった要素を古い順にonRetireへ渡す
+	// 取り出した数を返す
+	template<typename F>
+	size_t Retire(uint64_t completedFenceValue, F&& onRetire) {
+		size_t count = 0;
+		while (!pending_.empty() && pending_.front().first <= completedFenceValue) {
+			onRetire(std::move(pending_.front().second));
+			pending_.pop_front();
+			count++;
+		}
+		return count;
+	}
+
+	// 待っている要素数
+	size_t GetPendingCount() const { return pending_.size(); }
+	bool IsEmpty() const { return pending_.empty(); }
+
+private:
+	// (フェンス値, 要素)
+	std::deque<std::pair<uint64_t, T>> pending_;
+};
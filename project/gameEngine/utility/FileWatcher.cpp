@@ -0,0 +1,112 @@
+#include "FileWatcher.h"
+#include <cassert>
+
+FileWatcher::~FileWatcher()
+{
+	Stop();
+}
+
+bool FileWatcher::Start(const std::filesystem::path& directory)
+{
+	Stop();
+	directory_ = directory;
+
+	// --- ディレクトリを非同期で開く ---
+	directoryHandle_ = CreateFileW(directory.c_str(), FILE_LIST_DIRECTORY,
+		FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING,
+		FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, nullptr);
+	if (directoryHandle_ == INVALID_HANDLE_VALUE) {
+		return false;
+	}
+
+	// --- 終了通知用のイベントと監視スレッド ---
+	stopEvent_ = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+	assert(stopEvent_ != nullptr);
+	thread_ = std::thread([this]() { WatchLoop(); });
+	return true;
+}
+
+void FileWatcher::Stop()
+{
+	if (thread_.joinable()) {
+		SetEvent(stopEvent_);
+		thread_.join();
+	}
+	if (stopEvent_) {
+		CloseHandle(stopEvent_);
+		stopEvent_ = nullptr;
+	}
+	if (directoryHandle_ != INVALID_HANDLE_VALUE) {
+		CloseHandle(directoryHandle_);
+		directoryHandle_ = INVALID_HANDLE_VALUE;
+	}
+}
+
+std::vector<std::filesystem::path> FileWatcher::PollChanges()
+{
+	std::vector<std::filesystem::path> result;
+	auto now = std::chrono::steady_clock::now();
+
+	std::lock_guard<std::mutex> lock(mutex_);
+	for (auto it = changes_.begin(); it != changes_.end();) {
+		// 書き込み中の可能性があるものは次回に回す
+		if (now - it->second < kSettleTime) {
+			++it;
+			continue;
+		}
+		result.push_back(it->first);
+		it = changes_.erase(it);
+	}
+	return result;
+}
+
+void FileWatcher::WatchLoop()
+{
+	// DWORD境界に揃えたバッファ
+	alignas(DWORD) uint8_t buffer[16 * 1024];
+	OVERLAPPED overlapped{};
+	overlapped.hEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+	assert(overlapped.hEvent != nullptr);
+
+	const DWORD filter = FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_SIZE;
+	while (true) {
+		// --- 変更の通知を要求 ---
+		ResetEvent(overlapped.hEvent);
+		if (!ReadDirectoryChangesW(directoryHandle_, buffer, sizeof(buffer), TRUE, filter, nullptr, &overlapped, nullptr)) {
+			break;
+		}
+
+		// --- 通知か終了を待つ ---
+		HANDLE handles[] = { overlapped.hEvent, stopEvent_ };
+		DWORD wait = WaitForMultipleObjects(_countof(handles), handles, FALSE, INFINITE);
+		if (wait != WAIT_OBJECT_0) {
+			CancelIoEx(directoryHandle_, &overlapped);
+			DWORD ignored = 0;
+			GetOverlappedResult(directoryHandle_, &overlapped, &ignored, TRUE);
+			break;
+		}
+		DWORD bytes = 0;
+		if (!GetOverlappedResult(directoryHandle_, &overlapped, &bytes, FALSE) || bytes == 0) {
+			// バッファが溢れた場合は取りこぼすが監視は続ける
+			continue;
+		}
+
+		// --- 通知を順に記録 ---
+		auto now = std::chrono::steady_clock::now();
+		std::lock_guard<std::mutex> lock(mutex_);
+		const uint8_t* entry = buffer;
+		while (true) {
+			const FILE_NOTIFY_INFORMATION* info = reinterpret_cast<const FILE_NOTIFY_INFORMATION*>(entry);
+			if (info->Action != FILE_ACTION_REMOVED && info->Action != FILE_ACTION_RENAMED_OLD_NAME) {
+				std::wstring name(info->FileName, info->FileNameLength / sizeof(WCHAR));
+				changes_[(directory_ / name).lexically_normal()] = now;
+			}
+			if (info->NextEntryOffset == 0) {
+				break;
+			}
+			entry += info->NextEntryOffset;
+		}
+	}
+
+	CloseHandle(overlapped.hEvent);
+}
@@ -0,0 +1,52 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <Windows.h>
+
+// ファイル監視
+// ディレクトリ以下の変更をバックグラウンドスレッドでReadDirectoryChangesWにより受け取る
+// 保存時は短時間に何度も通知されるので、一定時間変更が止まったファイルだけを返す
+class FileWatcher
+{
+public:
+	// 変更が止まってから通知するまでの時間
+	static constexpr std::chrono::milliseconds kSettleTime{ 20 };
+
+public:
+	FileWatcher() = default;
+	~FileWatcher();
+	FileWatcher(const FileWatcher&) = delete;
+	FileWatcher& operator=(const FileWatcher&) = delete;
+
+public:
+	// 監視の開始(サブディレクトリを含む。開けなければfalse)
+	bool Start(const std::filesystem::path& directory);
+	// 監視の終了
+	void Stop();
+
+	// 変更の落ち着いたファイルを取り出す(パスはdirectoryを含む)
+	std::vector<std::filesystem::path> PollChanges();
+
+public:
+	// 監視中か
+	bool IsWatching() const { return thread_.joinable(); }
+
+private:
+	// 監視スレッドの処理
+	void WatchLoop();
+
+private:
+	std::filesystem::path directory_;
+	HANDLE directoryHandle_ = INVALID_HANDLE_VALUE;
+	HANDLE stopEvent_ = nullptr;
+	std::thread thread_;
+
+	// 変更のあったファイル→最後に通知された時刻
+	std::map<std::filesystem::path, std::chrono::steady_clock::time_point> changes_;
+	std::mutex mutex_;
+};
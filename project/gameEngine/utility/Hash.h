@@ -0,0 +1,44 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// ハッシュ計算(FNV-1a 64bit)
+namespace Hash
+{
+	// 初期値
+	constexpr uint64_t kOffsetBasis = 14695981039346656037ull;
+	// 素数
+	constexpr uint64_t kPrime = 1099511628211ull;
+
+	// バイト列を既存のハッシュ値に混ぜる
+	inline uint64_t Combine(uint64_t hash, const void* data, size_t size) {
+		const uint8_t* bytes = static_cast<const uint8_t*>(data);
+		for (size_t i = 0; i < size; ++i) {
+			hash ^= bytes[i];
+			hash *= kPrime;
+		}
+		return hash;
+	}
+
+	// 値をそのまま混ぜる(パディングを含まない型に限る)
+	template<typename T>
+	inline uint64_t CombineValue(uint64_t hash, const T& value) {
+		return Combine(hash, &value, sizeof(T));
+	}
+
+	// 文字列を混ぜる(長さも含める)
+	inline uint64_t CombineString(uint64_t hash, const std::string& str) {
+		hash = CombineValue(hash, str.size());
+		return Combine(hash, str.data(), str.size());
+	}
+	inline uint64_t CombineString(uint64_t hash, const std::wstring& str) {
+		hash = CombineValue(hash, str.size());
+		return Combine(hash, str.data(), str.size() * sizeof(wchar_t));
+	}
+
+	// バイト列のハッシュ値
+	inline uint64_t Compute(const void* data, size_t size) {
+		return Combine(kOffsetBasis, data, size);
+	}
+}
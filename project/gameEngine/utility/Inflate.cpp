@@ -0,0 +1,386 @@
+#include "Inflate.h"
+#include <array>
+#include <cstring>
+
+namespace
+{
+	// 長さ・距離の基本値と追加ビット数
+	const uint16_t kLengthBase[29] = { 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+	const uint8_t kLengthExtra[29] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+	const uint16_t kDistanceBase[30] = { 1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+	const uint8_t kDistanceExtra[30] = { 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+	// 符号長の符号の並び順
+	const uint8_t kCodeLengthOrder[19] = { 16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+
+	// ビット単位の読み込み(LSBから)
+	class BitReader
+	{
+	public:
+		explicit BitReader(std::span<const uint8_t> src) : src_(src) {}
+
+		// nビット読む(n<=32)
+		bool Read(uint32_t n, uint32_t& value) {
+			if (!Fill(n)) {
+				return false;
+			}
+			value = uint32_t(buffer_ & ((1ull << n) - 1));
+			buffer_ >>= n;
+			count_ -= n;
+			return true;
+		}
+
+		// nビット先読み(足りない分は0)
+		uint32_t Peek(uint32_t n) {
+			Fill(n);
+			return uint32_t(buffer_ & ((1ull << n) - 1));
+		}
+
+		// nビット捨てる
+		bool Skip(uint32_t n) {
+			if (count_ < n) {
+				return false;
+			}
+			buffer_ >>= n;
+			count_ -= n;
+			return true;
+		}
+
+		// バイト境界に揃える
+		void AlignToByte() {
+			uint32_t rest = count_ % 8;
+			buffer_ >>= rest;
+			count_ -= rest;
+		}
+
+		// バイト列をそのまま読む(バイト境界にあること)
+		bool ReadBytes(size_t size, std::vector<uint8_t>& dst) {
+			// バッファに残っている分から
+			while (count_ >= 8 && size > 0) {
+				dst.push_back(uint8_t(buffer_));
+				buffer_ >>= 8;
+				count_ -= 8;
+				size--;
+			}
+			if (src_.size() - position_ < size) {
+				return false;
+			}
+			dst.insert(dst.end(), src_.begin() + position_, src_.begin() + position_ + size);
+			position_ += size;
+			return true;
+		}
+
+	private:
+		bool Fill(uint32_t n) {
+			while (count_ < n) {
+				if (position_ >= src_.size()) {
+					return false;
+				}
+				buffer_ |= uint64_t(src_[position_++]) << count_;
+				count_ += 8;
+			}
+			return true;
+		}
+
+	private:
+		std::span<const uint8_t> src_;
+		size_t position_ = 0;
+		uint64_t buffer_ = 0;
+		uint32_t count_ = 0;
+	};
+
+	// ハフマン符号表
+	// kFastBitsビットで引ける符号はテーブル1回、それ以上は正準符号として順に辿る
+	class Huffman
+	{
+	public:
+		static const uint32_t kFastBits = 9;
+		static const uint32_t kMaxBits = 15;
+
+		bool Build(const uint8_t* lengths, uint32_t count) {
+			fast_.fill(0);
+			counts_.fill(0);
+			for (uint32_t i = 0; i < count; ++i) {
+				counts_[lengths[i]]++;
+			}
+			counts_[0] = 0;
+
+			// --- 符号長ごとの先頭符号とシンボル位置 ---
+			std::array<uint16_t, kMaxBits + 1> offsets{};
+			int32_t left = 1;
+			for (uint32_t bits = 1; bits <= kMaxBits; ++bits) {
+				left = (left << 1) - counts_[bits];
+				if (left < 0) {
+					return false;
+				}
+				offsets[bits] = uint16_t(bits == 1 ? 0 : offsets[bits - 1] + counts_[bits - 1]);
+			}
+			symbolCount_ = 0;
+			for (uint32_t i = 0; i < count; ++i) {
+				if (lengths[i] != 0) {
+					symbols_[offsets[lengths[i]]++] = uint16_t(i);
+					symbolCount_++;
+				}
+			}
+
+			// --- 短い符号のテーブル(ビット順を反転して引く) ---
+			uint32_t code = 0;
+			uint32_t index = 0;
+			for (uint32_t bits = 1; bits <= kFastBits; ++bits) {
+				for (uint32_t i = 0; i < counts_[bits]; ++i, ++code, ++index) {
+					uint32_t reversed = Reverse(code, bits);
+					for (uint32_t fill = reversed; fill < (1u << kFastBits); fill += (1u << bits)) {
+						// 上位にビット数、下位にシンボル
+						fast_[fill] = uint16_t((bits << 9) | symbols_[index]);
+					}
+				}
+				code <<= 1;
+			}
+			return true;
+		}
+
+		bool Decode(BitReader& reader, uint32_t& symbol) const {
+			// --- テーブルで引ける場合 ---
+			uint32_t peek = reader.Peek(kFastBits);
+			uint16_t entry = fast_[peek];
+			if (entry != 0) {
+				symbol = entry & 0x1FF;
+				return reader.Skip(entry >> 9);
+			}
+
+			// --- 長い符号は1ビットずつ辿る ---
+			int32_t code = 0;
+			int32_t first = 0;
+			int32_t index = 0;
+			for (uint32_t bits = 1; bits <= kMaxBits; ++bits) {
+				uint32_t bit = 0;
+				if (!reader.Read(1, bit)) {
+					return false;
+				}
+				code |= int32_t(bit);
+				int32_t count = counts_[bits];
+				if (code - count < first) {
+					symbol = symbols_[index + (code - first)];
+					return true;
+				}
+				index += count;
+				first += count;
+				first <<= 1;
+				code <<= 1;
+			}
+			return false;
+		}
+
+	private:
+		static uint32_t Reverse(uint32_t code, uint32_t bits) {
+			uint32_t result = 0;
+			for (uint32_t i = 0; i < bits; ++i) {
+				result = (result << 1) | ((code >> i) & 1);
+			}
+			return result;
+		}
+
+	private:
+		std::array<uint16_t, 1u << kFastBits> fast_{};
+		std::array<uint16_t, kMaxBits + 1> counts_{};
+		std::array<uint16_t, 288> symbols_{};
+		uint32_t symbolCount_ = 0;
+	};
+
+	// 固定ハフマン符号表
+	void BuildFixed(Huffman& literal, Huffman& distance)
+	{
+		uint8_t lengths[288];
+		std::memset(lengths, 8, 144);
+		std::memset(lengths + 144, 9, 112);
+		std::memset(lengths + 256, 7, 24);
+		std::memset(lengths + 280, 8, 8);
+		literal.Build(lengths, 288);
+		uint8_t distanceLengths[30];
+		std::memset(distanceLengths, 5, 30);
+		distance.Build(distanceLengths, 30);
+	}
+
+	// 動的ハフマン符号表の読み込み
+	bool ReadDynamic(BitReader& reader, Huffman& literal, Huffman& distance)
+	{
+		uint32_t literalCount, distanceCount, codeLengthCount;
+		if (!reader.Read(5, literalCount) || !reader.Read(5, distanceCount) || !reader.Read(4, codeLengthCount)) {
+			return false;
+		}
+		literalCount += 257;
+		distanceCount += 1;
+		codeLengthCount += 4;
+
+		// --- 符号長の符号 ---
+		uint8_t codeLengths[19] = {};
+		for (uint32_t i = 0; i < codeLengthCount; ++i) {
+			uint32_t length;
+			if (!reader.Read(3, length)) {
+				return false;
+			}
+			codeLengths[kCodeLengthOrder[i]] = uint8_t(length);
+		}
+		Huffman codeLength;
+		if (!codeLength.Build(codeLengths, 19)) {
+			return false;
+		}
+
+		// --- リテラル・距離の符号長 ---
+		uint8_t lengths[288 + 32] = {};
+		uint32_t total = literalCount + distanceCount;
+		uint32_t index = 0;
+		while (index < total) {
+			uint32_t symbol;
+			if (!codeLength.Decode(reader, symbol)) {
+				return false;
+			}
+			if (symbol < 16) {
+				lengths[index++] = uint8_t(symbol);
+				continue;
+			}
+			uint32_t repeat = 0;
+			uint8_t value = 0;
+			if (symbol == 16) {
+				if (index == 0 || !reader.Read(2, repeat)) {
+					return false;
+				}
+				repeat += 3;
+				value = lengths[index - 1];
+			} else if (symbol == 17) {
+				if (!reader.Read(3, repeat)) {
+					return false;
+				}
+				repeat += 3;
+			} else {
+				if (!reader.Read(7, repeat)) {
+					return false;
+				}
+				repeat += 11;
+			}
+			if (index + repeat > total) {
+				return false;
+			}
+			std::memset(lengths + index, value, repeat);
+			index += repeat;
+		}
+
+		return literal.Build(lengths, literalCount) && distance.Build(lengths + literalCount, distanceCount);
+	}
+
+	// 圧縮ブロックの展開(dstはlimitバイトまで)
+	bool InflateBlock(BitReader& reader, const Huffman& literal, const Huffman& distance, std::vector<uint8_t>& dst, size_t limit)
+	{
+		while (true) {
+			uint32_t symbol;
+			if (!literal.Decode(reader, symbol)) {
+				return false;
+			}
+			// リテラル
+			if (symbol < 256) {
+				if (dst.size() >= limit) {
+					return false;
+				}
+				dst.push_back(uint8_t(symbol));
+				continue;
+			}
+			// ブロック終端
+			if (symbol == 256) {
+				return true;
+			}
+
+			// --- 長さ・距離の組 ---
+			symbol -= 257;
+			if (symbol >= 29) {
+				return false;
+			}
+			uint32_t extra;
+			if (!reader.Read(kLengthExtra[symbol], extra)) {
+				return false;
+			}
+			size_t length = kLengthBase[symbol] + extra;
+
+			uint32_t distanceSymbol;
+			if (!distance.Decode(reader, distanceSymbol) || distanceSymbol >= 30) {
+				return false;
+			}
+			if (!reader.Read(kDistanceExtra[distanceSymbol], extra)) {
+				return false;
+			}
+			size_t offset = kDistanceBase[distanceSymbol] + extra;
+			if (offset > dst.size() || length > limit - dst.size()) {
+				return false;
+			}
+
+			// 重なりがあるので1バイトずつ
+			size_t from = dst.size() - offset;
+			dst.resize(dst.size() + length);
+			uint8_t* out = dst.data() + dst.size() - length;
+			const uint8_t* in = dst.data() + from;
+			for (size_t i = 0; i < length; ++i) {
+				out[i] = in[i];
+			}
+		}
+	}
+}
+
+bool Inflate::Decompress(std::span<const uint8_t> src, std::vector<uint8_t>& dst, size_t maxSize)
+{
+	// 展開後のdstの大きさの上限
+	const size_t limit = maxSize > SIZE_MAX - dst.size() ? SIZE_MAX : dst.size() + maxSize;
+	BitReader reader(src);
+	Huffman literal;
+	Huffman distance;
+
+	uint32_t isFinal = 0;
+	while (!isFinal) {
+		uint32_t type;
+		if (!reader.Read(1, isFinal) || !reader.Read(2, type)) {
+			return false;
+		}
+
+		switch (type) {
+		case 0: {
+			// --- 無圧縮ブロック ---
+			reader.AlignToByte();
+			uint32_t length, complement;
+			if (!reader.Read(16, length) || !reader.Read(16, complement) || (length ^ 0xFFFF) != complement) {
+				return false;
+			}
+			if (length > limit - dst.size() || !reader.ReadBytes(length, dst)) {
+				return false;
+			}
+			break;
+		}
+		case 1:
+			// --- 固定ハフマン ---
+			BuildFixed(literal, distance);
+			if (!InflateBlock(reader, literal, distance, dst, limit)) {
+				return false;
+			}
+			break;
+		case 2:
+			// --- 動的ハフマン ---
+			if (!ReadDynamic(reader, literal, distance) || !InflateBlock(reader, literal, distance, dst, limit)) {
+				return false;
+			}
+			break;
+		default:
+			return false;
+		}
+	}
+	return true;
+}
+
+bool Inflate::DecompressZlib(std::span<const uint8_t> src, std::vector<uint8_t>& dst, size_t maxSize)
+{
+	// --- CMF/FLGの確認(Deflate、プリセット辞書なし) ---
+	if (src.size() < 2) {
+		return false;
+	}
+	uint8_t cmf = src[0];
+	uint8_t flg = src[1];
+	if ((cmf & 0x0F) != 8 || ((cmf << 8) | flg) % 31 != 0 || (flg & 0x20) != 0) {
+		return false;
+	}
+	return Decompress(src.subspan(2), dst, maxSize);
+}
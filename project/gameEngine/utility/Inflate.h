@@ -0,0 +1,17 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// Deflate(RFC1951)の展開
+// PNGなどのzlibストリームをプラットフォームに依存せずに展開する
+namespace Inflate
+{
+	// 生のDeflateストリームを展開してdstの末尾に追加(失敗したらfalse)
+	// maxSizeを超えて追加することになる壊れた・悪意のあるストリームも失敗にする
+	bool Decompress(std::span<const uint8_t> src, std::vector<uint8_t>& dst, size_t maxSize = SIZE_MAX);
+
+	// zlibストリーム(RFC1950)を展開(ヘッダを読み飛ばす。Adler-32は検証しない)
+	bool DecompressZlib(std::span<const uint8_t> src, std::vector<uint8_t>& dst, size_t maxSize = SIZE_MAX);
+};
@@ -0,0 +1,287 @@
+#include "Lz4.h"
+#include <cstring>
+
+namespace
+{
+	// 一致の最小長
+	const size_t kMinMatch = 4;
+	// 末尾のこのバイト数は必ずリテラル(形式の決まり)
+	const size_t kLastLiterals = 5;
+	// 一致の開始はこのバイト数より前でなければならない
+	const size_t kMatchFindLimit = 12;
+	// 参照できる最大距離
+	const size_t kMaxOffset = 65535;
+	// ハッシュテーブルのビット数
+	const uint32_t kHashBits = 16;
+	// kHighで辿る出現位置の最大数
+	const uint32_t kMaxChainAttempts = 256;
+
+	uint32_t Read32(const uint8_t* p)
+	{
+		uint32_t value;
+		std::memcpy(&value, p, sizeof(value));
+		return value;
+	}
+
+	uint32_t HashSequence(uint32_t sequence)
+	{
+		return (sequence * 2654435761u) >> (32 - kHashBits);
+	}
+
+	// 15以上の長さを255単位で書き出す
+	void WriteLength(std::vector<uint8_t>& dst, size_t length)
+	{
+		while (length >= 255) {
+			dst.push_back(255);
+			length -= 255;
+		}
+		dst.push_back(uint8_t(length));
+	}
+
+	// シーケンス(リテラル+一致)を書き出す。matchLengthが0なら最後のリテラルのみ
+	void WriteSequence(std::vector<uint8_t>& dst, const uint8_t* literals, size_t literalLength, size_t offset, size_t matchLength)
+	{
+		// --- トークン(上位4bitがリテラル長、下位4bitが一致長-4) ---
+		uint8_t token = uint8_t((literalLength >= 15 ? 15 : literalLength) << 4);
+		if (matchLength != 0) {
+			size_t length = matchLength - kMinMatch;
+			token |= uint8_t(length >= 15 ? 15 : length);
+		}
+		dst.push_back(token);
+		if (literalLength >= 15) {
+			WriteLength(dst, literalLength - 15);
+		}
+		dst.insert(dst.end(), literals, literals + literalLength);
+
+		// --- 距離と一致長 ---
+		if (matchLength != 0) {
+			dst.push_back(uint8_t(offset));
+			dst.push_back(uint8_t(offset >> 8));
+			if (matchLength - kMinMatch >= 15) {
+				WriteLength(dst, matchLength - kMinMatch - 15);
+			}
+		}
+	}
+
+	// 一致の長さ(limitまで)
+	size_t CountMatch(const uint8_t* base, size_t candidate, size_t position, size_t limit)
+	{
+		size_t length = 0;
+		while (position + length < limit && base[candidate + length] == base[position + length]) {
+			length++;
+		}
+		return length;
+	}
+
+	// 同じハッシュの出現位置を鎖状に辿る探索(LZ4 HC相当)
+	class MatchFinder
+	{
+	public:
+		MatchFinder(const uint8_t* base, size_t matchLimit)
+			: base_(base), matchLimit_(matchLimit), head_(size_t(1) << kHashBits, UINT32_MAX), chain_(kMaxOffset + 1, 0) {}
+
+		// positionより前の位置を全て登録してから、positionでの最長一致を探す
+		size_t Find(size_t position, size_t& candidate) {
+			while (nextInsert_ < position) {
+				Insert(nextInsert_++);
+			}
+
+			uint32_t sequence = Read32(base_ + position);
+			uint32_t current = head_[HashSequence(sequence)];
+			size_t bestLength = 0;
+			for (uint32_t attempt = 0; attempt < kMaxChainAttempts && current != UINT32_MAX; ++attempt) {
+				if (position - current > kMaxOffset) {
+					break;
+				}
+				if (Read32(base_ + current) == sequence) {
+					size_t length = CountMatch(base_, current, position, matchLimit_);
+					if (length > bestLength) {
+						bestLength = length;
+						candidate = current;
+					}
+				}
+				uint16_t delta = chain_[current & kMaxOffset];
+				if (delta == 0 || delta > current) {
+					break;
+				}
+				current -= delta;
+			}
+			return bestLength;
+		}
+
+	private:
+		void Insert(size_t position) {
+			uint32_t hash = HashSequence(Read32(base_ + position));
+			uint32_t previous = head_[hash];
+			size_t delta = (previous == UINT32_MAX) ? 0 : position - previous;
+			// 届かない距離は鎖を切る
+			chain_[position & kMaxOffset] = uint16_t(delta > kMaxOffset ? 0 : delta);
+			head_[hash] = uint32_t(position);
+		}
+
+	private:
+		const uint8_t* base_;
+		size_t matchLimit_;
+		size_t nextInsert_ = 0;
+		std::vector<uint32_t> head_;	// ハッシュ→最後の出現位置
+		std::vector<uint16_t> chain_;	// 位置→同じハッシュの1つ前の出現位置までの距離
+	};
+
+	// kHighの圧縮(1つ先の位置の方が長く一致するなら1バイト遅らせる)
+	void CompressHigh(const uint8_t* base, size_t size, std::vector<uint8_t>& dst)
+	{
+		const size_t matchLimit = size - kLastLiterals;
+		const size_t findLimit = size - kMatchFindLimit;
+		MatchFinder finder(base, matchLimit);
+		size_t anchor = 0;
+		size_t position = 0;
+		while (position < findLimit) {
+			size_t candidate = 0;
+			size_t length = finder.Find(position, candidate);
+			if (length < kMinMatch) {
+				position++;
+				continue;
+			}
+
+			// --- 遅延評価 ---
+			while (position + 1 < findLimit) {
+				size_t nextCandidate = 0;
+				size_t nextLength = finder.Find(position + 1, nextCandidate);
+				if (nextLength <= length) {
+					break;
+				}
+				position++;
+				candidate = nextCandidate;
+				length = nextLength;
+			}
+
+			WriteSequence(dst, base + anchor, position - anchor, position - candidate, length);
+			position += length;
+			anchor = position;
+		}
+
+		// --- 残りはリテラル ---
+		WriteSequence(dst, base + anchor, size - anchor, 0, 0);
+	}
+
+	// 可変長の長さを読む
+	bool ReadLength(const uint8_t*& in, const uint8_t* inEnd, size_t& length)
+	{
+		uint8_t value;
+		do {
+			if (in >= inEnd) {
+				return false;
+			}
+			value = *in++;
+			length += value;
+		} while (value == 255);
+		return true;
+	}
+}
+
+void Lz4::Compress(std::span<const uint8_t> src, std::vector<uint8_t>& dst, Level level)
+{
+	const uint8_t* base = src.data();
+	const size_t size = src.size();
+	dst.reserve(dst.size() + size + size / 255 + 16);
+
+	// 短すぎるものは全てリテラル
+	if (size < kMatchFindLimit + 1) {
+		WriteSequence(dst, base, size, 0, 0);
+		return;
+	}
+	if (level == Level::kHigh) {
+		CompressHigh(base, size, dst);
+		return;
+	}
+
+	// --- 4バイトのハッシュで直前の出現位置を引きながら一致を探す ---
+	std::vector<uint32_t> table(size_t(1) << kHashBits, UINT32_MAX);
+	const size_t matchLimit = size - kLastLiterals;
+	size_t anchor = 0;
+	size_t position = 0;
+	while (position < size - kMatchFindLimit) {
+		uint32_t sequence = Read32(base + position);
+		uint32_t hash = HashSequence(sequence);
+		uint32_t candidate = table[hash];
+		table[hash] = uint32_t(position);
+
+		if (candidate == UINT32_MAX || position - candidate > kMaxOffset || Read32(base + candidate) != sequence) {
+			position++;
+			continue;
+		}
+
+		// --- 一致を前後に伸ばす ---
+		size_t length = CountMatch(base, candidate, position, matchLimit);
+		while (position > anchor && candidate > 0 && base[position - 1] == base[candidate - 1]) {
+			position--;
+			candidate--;
+			length++;
+		}
+
+		WriteSequence(dst, base + anchor, position - anchor, position - candidate, length);
+		position += length;
+		anchor = position;
+	}
+
+	// --- 残りはリテラル ---
+	WriteSequence(dst, base + anchor, size - anchor, 0, 0);
+}
+
+bool Lz4::Decompress(std::span<const uint8_t> src, std::span<uint8_t> dst)
+{
+	const uint8_t* in = src.data();
+	const uint8_t* inEnd = in + src.size();
+	uint8_t* out = dst.data();
+	uint8_t* outEnd = out + dst.size();
+
+	while (in < inEnd) {
+		// --- リテラル ---
+		uint8_t token = *in++;
+		size_t literalLength = token >> 4;
+		if (literalLength == 15 && !ReadLength(in, inEnd, literalLength)) {
+			return false;
+		}
+		if (size_t(inEnd - in) < literalLength || size_t(outEnd - out) < literalLength) {
+			return false;
+		}
+		if (literalLength != 0) {
+			std::memcpy(out, in, literalLength);
+		}
+		in += literalLength;
+		out += literalLength;
+
+		// 最後のシーケンスは一致を持たない
+		if (in == inEnd) {
+			break;
+		}
+
+		// --- 一致 ---
+		if (inEnd - in < 2) {
+			return false;
+		}
+		size_t offset = size_t(in[0]) | (size_t(in[1]) << 8);
+		in += 2;
+		size_t matchLength = token & 0x0F;
+		if (matchLength == 15 && !ReadLength(in, inEnd, matchLength)) {
+			return false;
+		}
+		matchLength += kMinMatch;
+		if (offset == 0 || size_t(out - dst.data()) < offset || size_t(outEnd - out) < matchLength) {
+			return false;
+		}
+
+		const uint8_t* match = out - offset;
+		if (offset >= matchLength) {
+			// 重ならないならまとめてコピー
+			std::memcpy(out, match, matchLength);
+			out += matchLength;
+		} else {
+			// 重なる場合は1バイトずつ(直前の繰り返し)
+			for (size_t i = 0; i < matchLength; ++i) {
+				*out++ = match[i];
+			}
+		}
+	}
+	return out == outEnd;
+}
@@ -0,0 +1,22 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// LZ4ブロック形式の圧縮・展開
+// 展開が非常に速いのでアセットパックのエントリ単位の圧縮に使う
+namespace Lz4
+{
+	// 圧縮の強さ(どちらも同じ形式なので展開の速さは変わらない)
+	enum class Level {
+		kFast,	// 直前の出現位置だけを見る
+		kHigh,	// 同じハッシュの出現位置を辿って最長一致を探す(遅いが小さい)
+	};
+
+	// 圧縮してdstの末尾に追加
+	void Compress(std::span<const uint8_t> src, std::vector<uint8_t>& dst, Level level = Level::kFast);
+
+	// 展開(dstのサイズは元のサイズぴったりであること。壊れたデータならfalse)
+	bool Decompress(std::span<const uint8_t> src, std::span<uint8_t> dst);
+};
@@ -0,0 +1,41 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <Windows.h>
+
+// 読み込み専用のメモリマップドファイル
+// 開いている間はファイル内容をコピーせずにそのまま参照できる
+class MappedFile
+{
+public:
+	MappedFile() = default;
+	~MappedFile();
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+	MappedFile(MappedFile&& other) noexcept;
+	MappedFile& operator=(MappedFile&& other) noexcept;
+
+public:
+	// ファイルを開いてマップする(失敗したらfalse)
+	bool Open(const std::filesystem::path& filePath);
+	// マップを解除して閉じる
+	void Close();
+
+public:
+	// 開いているか
+	bool IsOpen() const { return data_ != nullptr; }
+	// 先頭アドレス
+	const uint8_t* GetData() const { return data_; }
+	// サイズ
+	size_t GetSize() const { return size_; }
+	// 内容
+	std::span<const uint8_t> GetSpan() const { return { data_, size_ }; }
+
+private:
+	HANDLE file_ = INVALID_HANDLE_VALUE;
+	HANDLE mapping_ = nullptr;
+	const uint8_t* data_ = nullptr;
+	size_t size_ = 0;
+};
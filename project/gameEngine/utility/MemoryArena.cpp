@@ -0,0 +1,87 @@
+#include "MemoryArena.h"
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+MemoryArena::MemoryArena(size_t blockSize)
+	: blockSize_(blockSize)
+{
+	assert(blockSize_ > 0);
+}
+
+MemoryArena::~MemoryArena()
+{
+	Reset();
+}
+
+void* MemoryArena::Allocate(size_t size, size_t alignment)
+{
+	assert(alignment != 0 && (alignment & (alignment - 1)) == 0);
+
+	// --- 今のブロックに収まるか(アドレスで揃える) ---
+	auto tryAllocate = [&](Block& block) -> void* {
+		uintptr_t base = reinterpret_cast<uintptr_t>(block.memory.get());
+		uintptr_t aligned = (base + block.used + alignment - 1) & ~uintptr_t(alignment - 1);
+		size_t end = size_t(aligned - base) + size;
+		if (end > block.size) {
+			return nullptr;
+		}
+		usedBytes_ += end - block.used;
+		block.used = end;
+		return reinterpret_cast<void*>(aligned);
+		};
+
+	void* memory = blocks_.empty() ? nullptr : tryAllocate(blocks_.back());
+	if (!memory) {
+		// 大きいものは専用のブロックにする
+		memory = tryAllocate(AddBlock(size + alignment));
+		assert(memory);
+	}
+
+	if (isPoisoning_) {
+		std::memset(memory, kAllocatedPattern, size);
+	}
+	return memory;
+}
+
+void MemoryArena::Reset()
+{
+	// --- 生成の逆順にデストラクタを呼ぶ ---
+	for (DestructorNode* node = destructors_; node; node = node->next) {
+		node->destroy(node->object);
+	}
+	destructors_ = nullptr;
+
+	// --- 解放したメモリを埋める ---
+	if (isPoisoning_) {
+		for (Block& block : blocks_) {
+			std::memset(block.memory.get(), kFreedPattern, block.used);
+		}
+	}
+
+	// --- 最初のブロックだけ残して返す ---
+	if (!blocks_.empty()) {
+		blocks_.resize(1);
+		blocks_.front().used = 0;
+	}
+	usedBytes_ = 0;
+	objectCount_ = 0;
+}
+
+size_t MemoryArena::GetReservedBytes() const
+{
+	size_t bytes = 0;
+	for (const Block& block : blocks_) {
+		bytes += block.size;
+	}
+	return bytes;
+}
+
+MemoryArena::Block& MemoryArena::AddBlock(size_t minimumSize)
+{
+	Block block;
+	block.size = std::max(blockSize_, minimumSize);
+	block.memory = std::make_unique_for_overwrite<uint8_t[]>(block.size);
+	blocks_.push_back(std::move(block));
+	return blocks_.back();
+}
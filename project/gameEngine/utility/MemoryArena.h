@@ -0,0 +1,108 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// 線形(モノトニック)アロケータ
+// ブロックの先頭から順に切り出すだけで個別には解放しない。Resetでまとめて破棄する
+// Createで作ったオブジェクトは作った逆順にデストラクタを呼ぶ
+class MemoryArena
+{
+public:
+	// ブロックの標準サイズ
+	static const size_t kDefaultBlockSize = 64 * 1024;
+
+	// デバッグ用の埋め値(未初期化の読み取り・解放後の使用を見つけやすくする)
+	static const uint8_t kAllocatedPattern = 0xCD;
+	static const uint8_t kFreedPattern = 0xDD;
+
+public:
+	explicit MemoryArena(size_t blockSize = kDefaultBlockSize);
+	~MemoryArena();
+	MemoryArena(const MemoryArena&) = delete;
+	MemoryArena& operator=(const MemoryArena&) = delete;
+
+public:
+	// 生のメモリを確保(alignmentは2のべき乗)
+	void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+	// オブジェクトを生成(デストラクタはResetで呼ばれる)
+	template<typename T, typename... Args>
+	T* Create(Args&&... args);
+
+	// 全てのオブジェクトを破棄してメモリを返す(最初のブロックは次に使うため残す)
+	void Reset();
+
+public:
+	// 解放したメモリを埋めるか(Debugビルドでは既定で有効)
+	void SetPoisoning(bool isEnabled) { isPoisoning_ = isEnabled; }
+	bool IsPoisoning() const { return isPoisoning_; }
+
+	// 使用中のバイト数(アラインメントの詰め物を含む)
+	size_t GetUsedBytes() const { return usedBytes_; }
+	// ブロックとして確保しているバイト数
+	size_t GetReservedBytes() const;
+	// Createで生成したオブジェクト数
+	size_t GetObjectCount() const { return objectCount_; }
+
+private:
+	// デストラクタの呼び出し記録(オブジェクトの直前に置く)
+	struct DestructorNode {
+		void (*destroy)(void* object);
+		void* object;
+		DestructorNode* next;
+	};
+
+	// メモリブロック
+	struct Block {
+		std::unique_ptr<uint8_t[]> memory;
+		size_t size = 0;
+		size_t used = 0;
+	};
+
+	// 新しいブロックを追加(minimumSize以上)
+	Block& AddBlock(size_t minimumSize);
+
+private:
+	std::vector<Block> blocks_;
+	size_t blockSize_;
+
+	// 最後に生成したオブジェクトから辿るリスト
+	DestructorNode* destructors_ = nullptr;
+
+	size_t usedBytes_ = 0;
+	size_t objectCount_ = 0;
+
+#ifdef _DEBUG
+	bool isPoisoning_ = true;
+#else
+	bool isPoisoning_ = false;
+#endif
+};
+
+template<typename T, typename... Args>
+T* MemoryArena::Create(Args&&... args)
+{
+	// --- デストラクタが不要な型は記録しない ---
+	if constexpr (std::is_trivially_destructible_v<T>) {
+		void* memory = Allocate(sizeof(T), alignof(T));
+		objectCount_++;
+		return new (memory) T(std::forward<Args>(args)...);
+	}
+	else {
+		DestructorNode* node = static_cast<DestructorNode*>(Allocate(sizeof(DestructorNode), alignof(DestructorNode)));
+		T* object = new (Allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+
+		// 生成に成功してからリストにつなぐ
+		node->destroy = [](void* p) { static_cast<T*>(p)->~T(); };
+		node->object = object;
+		node->next = destructors_;
+		destructors_ = node;
+		objectCount_++;
+		return object;
+	}
+}
@@ -0,0 +1,100 @@
+#pragma once
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+// オブジェクトプール
+// 最初にcapacity個を生成・初期化(GPUバッファの確保を含む)しておき、
+// 取得・返却はO(1)で行う。取得・返却ではデバイスに触らない
+template<typename T>
+class ObjectPool
+{
+public:
+	ObjectPool() = default;
+	ObjectPool(const ObjectPool&) = delete;
+	ObjectPool& operator=(const ObjectPool&) = delete;
+
+	// capacity個を生成してinitializerで初期化する
+	// resetterは返却時に呼ばれ、次に取得されたときに前の状態が残らないようにする
+	template<typename F>
+	void Initialize(uint32_t capacity, F&& initializer, std::function<void(T&)> resetter = nullptr) {
+		objects_ = std::make_unique<T[]>(capacity);
+		capacity_ = capacity;
+		isActive_.assign(capacity, false);
+		freeIndices_.resize(capacity);
+		for (uint32_t i = 0; i < capacity; ++i) {
+			initializer(objects_[i]);
+			// 先頭から取り出されるよう逆順に積む
+			freeIndices_[i] = capacity - 1 - i;
+		}
+		resetter_ = std::move(resetter);
+		activeCount_ = 0;
+		highWaterMark_ = 0;
+		exhaustedCount_ = 0;
+	}
+
+	// 取得(空きが無ければnullptr)
+	T* Acquire() {
+		if (freeIndices_.empty()) {
+			exhaustedCount_++;
+			return nullptr;
+		}
+		uint32_t index = freeIndices_.back();
+		freeIndices_.pop_back();
+		isActive_[index] = true;
+		activeCount_++;
+		highWaterMark_ = (std::max)(highWaterMark_, activeCount_);
+		return &objects_[index];
+	}
+
+	// 返却
+	void Release(T* object) {
+		assert(Contains(object));
+		uint32_t index = uint32_t(object - objects_.get());
+		assert(isActive_[index]);
+		if (resetter_) {
+			resetter_(*object);
+		}
+		isActive_[index] = false;
+		activeCount_--;
+		freeIndices_.push_back(index);
+	}
+
+	// 使用中のオブジェクトを巡回
+	template<typename F>
+	void ForEachActive(F&& func) {
+		for (uint32_t i = 0; i < capacity_; ++i) {
+			if (isActive_[i]) {
+				func(objects_[i]);
+			}
+		}
+	}
+
+	// このプールのオブジェクトか
+	bool Contains(const T* object) const {
+		return object >= objects_.get() && object < objects_.get() + capacity_;
+	}
+
+public:
+	uint32_t GetCapacity() const { return capacity_; }
+	// 使用中の数
+	uint32_t GetActiveCount() const { return activeCount_; }
+	// 同時に使用された最大数(容量の見積もり用)
+	uint32_t GetHighWaterMark() const { return highWaterMark_; }
+	// 空きが無くて取得に失敗した回数
+	uint32_t GetExhaustedCount() const { return exhaustedCount_; }
+
+private:
+	std::unique_ptr<T[]> objects_;
+	std::vector<uint32_t> freeIndices_;
+	std::vector<bool> isActive_;
+	std::function<void(T&)> resetter_;
+
+	uint32_t capacity_ = 0;
+	uint32_t activeCount_ = 0;
+	uint32_t highWaterMark_ = 0;
+	uint32_t exhaustedCount_ = 0;
+};
@@ -0,0 +1,59 @@
+#pragma once
+#include <cassert>
+#include <cstdint>
+#include <iterator>
+#include <map>
+#include <utility>
+
+// 大きさ付きの空き要素の一覧(アップロードバッファの再利用など)
+// 要求が入る中で最も小さいものを返し、上限を超えた分は大きいものから捨てる(デバイスには触らない)
+template<typename T>
+class SizedFreeList
+{
+public:
+	// maxOversize:要求の何倍までの大きさを再利用するか(大きすぎるものは小さな要求に使わない)
+	explicit SizedFreeList(uint64_t maxOversize = 4) : maxOversize_(maxOversize) {}
+
+	// 空きに追加
+	void Add(uint64_t size, T item) {
+		freeBytes_ += size;
+		free_.emplace(size, std::move(item));
+	}
+
+	// size以上で最も小さい空きを取り出す(無ければfalse)
+	bool Take(uint64_t size, T& item) {
+		auto it = free_.lower_bound(size);
+		if (it == free_.end() || it->first > size * maxOversize_) {
+			return false;
+		}
+		item = std::move(it->second);
+		freeBytes_ -= it->first;
+		free_.erase(it);
+		return true;
+	}
+
+	// 空きの合計がmaxFreeBytes以下になるまで大きいものから捨てる
+	// 捨てた数を返す
+	size_t Trim(uint64_t maxFreeBytes) {
+		size_t count = 0;
+		while (freeBytes_ > maxFreeBytes && !free_.empty()) {
+			auto it = std::prev(free_.end());
+			freeBytes_ -= it->first;
+			free_.erase(it);
+			count++;
+		}
+		return count;
+	}
+
+public:
+	// 空きの合計バイト数
+	uint64_t GetFreeBytes() const { return freeBytes_; }
+	// 空きの数
+	size_t GetFreeCount() const { return free_.size(); }
+
+private:
+	// (大きさ, 要素)を大きさ順に
+	std::multimap<uint64_t, T> free_;
+	uint64_t freeBytes_ = 0;
+	uint64_t maxOversize_;
+};
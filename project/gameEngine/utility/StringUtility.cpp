@@ -29,4 +29,22 @@ namespace StringUtility
 		WideCharToMultiByte(CP_UTF8, 0, str.data(), static_cast<int>(str.size()), result.data(), sizeNeeded, NULL, NULL);
 		return result;
 	}
+
+	bool ReadLine(std::string_view text, size_t& position, std::string& line) {
+		if (position >= text.size()) {
+			return false;
+		}
+
+		size_t end = text.find('\n', position);
+		if (end == std::string_view::npos) {
+			end = text.size();
+		}
+		std::string_view result = text.substr(position, end - position);
+		if (!result.empty() && result.back() == '\r') {
+			result.remove_suffix(1);
+		}
+		line.assign(result);
+		position = end + 1;
+		return true;
+	}
 }
\ No newline at end of file
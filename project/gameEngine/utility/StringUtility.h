@@ -1,4 +1,5 @@
 #include <string>
+#include <string_view>
 #include <WinNls.h>
 namespace StringUtility
 {
@@ -6,5 +7,7 @@ namespace StringUtility
 	std::wstring ConvertString(const std::string& str);
 	// wstring->string
 	std::string ConvertString(const std::wstring& str);
+	// textのposition以降から1行取り出して進める(改行・CRは含まない。終端ならfalse)
+	bool ReadLine(std::string_view text, size_t& position, std::string& line);
 };
 
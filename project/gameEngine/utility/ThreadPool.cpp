@@ -0,0 +1,69 @@
+#include "ThreadPool.h"
+#include <algorithm>
+
+ThreadPool::ThreadPool(uint32_t threadCount)
+{
+	if (threadCount == 0) {
+		threadCount = std::max(1u, std::thread::hardware_concurrency());
+	}
+
+	// --- ワーカースレッドの生成 ---
+	workers_.reserve(threadCount);
+	for (uint32_t i = 0; i < threadCount; ++i) {
+		workers_.emplace_back([this]() { WorkerLoop(); });
+	}
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		stop_ = true;
+	}
+	condition_.notify_all();
+	for (std::thread& worker : workers_) {
+		worker.join();
+	}
+}
+
+void ThreadPool::ParallelFor(uint32_t count, const std::function<void(uint32_t begin, uint32_t end)>& func)
+{
+	if (count == 0) {
+		return;
+	}
+
+	// --- スレッド数で均等に分割 ---
+	uint32_t taskCount = std::min(count, GetThreadCount());
+	uint32_t chunk = (count + taskCount - 1) / taskCount;
+
+	std::vector<std::future<void>> futures;
+	futures.reserve(taskCount);
+	for (uint32_t begin = chunk; begin < count; begin += chunk) {
+		uint32_t end = std::min(begin + chunk, count);
+		futures.push_back(Submit([&func, begin, end]() { func(begin, end); }));
+	}
+
+	// 先頭の範囲は呼び出しスレッドで処理する
+	func(0, std::min(chunk, count));
+
+	for (std::future<void>& future : futures) {
+		future.get();
+	}
+}
+
+void ThreadPool::WorkerLoop()
+{
+	while (true) {
+		std::function<void()> task;
+		{
+			std::unique_lock<std::mutex> lock(mutex_);
+			condition_.wait(lock, [this]() { return stop_ || !tasks_.empty(); });
+			if (stop_ && tasks_.empty()) {
+				return;
+			}
+			task = std::move(tasks_.front());
+			tasks_.pop();
+		}
+		task();
+	}
+}
@@ -0,0 +1,59 @@
+#pragma once
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+// スレッドプール
+class ThreadPool
+{
+public:
+	// コンストラクタ(0ならハードウェアスレッド数)
+	explicit ThreadPool(uint32_t threadCount = 0);
+	// デストラクタ(残りのタスクを処理してから終了)
+	~ThreadPool();
+
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	// タスクの投入
+	template<typename F>
+	auto Submit(F&& func) -> std::future<decltype(func())>;
+
+	// [0, count)をワーカーに分割して実行し、全て終わるまで待つ
+	void ParallelFor(uint32_t count, const std::function<void(uint32_t begin, uint32_t end)>& func);
+
+public:
+	// スレッド数の取得
+	uint32_t GetThreadCount() const { return uint32_t(workers_.size()); }
+
+private:
+	// ワーカースレッドの処理
+	void WorkerLoop();
+
+private:
+	std::vector<std::thread> workers_;
+	std::queue<std::function<void()>> tasks_;
+	std::mutex mutex_;
+	std::condition_variable condition_;
+	bool stop_ = false;
+};
+
+template<typename F>
+auto ThreadPool::Submit(F&& func) -> std::future<decltype(func())>
+{
+	using Result = decltype(func());
+	auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(func));
+	std::future<Result> future = task->get_future();
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		tasks_.emplace([task]() { (*task)(); });
+	}
+	condition_.notify_one();
+	return future;
+}
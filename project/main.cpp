@@ -10,9 +10,17 @@
 
 // Windowsアプリでのエントリーポイント
 int WINAPI WinMain(HINSTANCE, HINSTANCE, LPSTR, int) {
+	// 起動オプション
+	Framework::LaunchOptions options = Framework::ParseCommandLine();
+
+	// アセットパックを作るだけならウィンドウを出さずに終了(リリースビルドのビルド後イベントから呼ばれる)
+	if (options.isBuildPack) {
+		return Framework::BuildAssetPack(options.packPath) ? 0 : 1;
+	}
+
 	Framework* game = new MyGame();
 
-	game->Run();
+	game->Run(options);
 
 	delete game;
 	
@@ -0,0 +1,101 @@
+#include "Affine3x4.h"
+#include "CalculateMath.h"
+#include "TestCommon.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+namespace {
+	// 成分ごとの差の最大
+	float MaxDifference(const Matrix4x4& a, const Matrix4x4& b) {
+		float difference = 0.0f;
+		for (int i = 0; i < 4; ++i) {
+			for (int j = 0; j < 4; ++j) {
+				difference = (std::max)(difference, std::fabs(a.m[i][j] - b.m[i][j]));
+			}
+		}
+		return difference;
+	}
+	float MaxDifference(const Vector3& a, const Vector3& b) {
+		return (std::max)({ std::fabs(a.x - b.x), std::fabs(a.y - b.y), std::fabs(a.z - b.z) });
+	}
+
+	// 拡縮0.5～2、回転・平行移動-3～3の範囲で比べる(誤差は逆行列で一番大きくなる)
+	const float kTolerance = 1e-3f;
+
+	// --- Matrix4x4で計算したものと一致する ---
+	void TestMatchesMatrix4x4()
+	{
+		std::mt19937 rng(1);
+		std::uniform_real_distribution<float> range(-3.0f, 3.0f);
+		std::uniform_real_distribution<float> scaleRange(0.5f, 2.0f);
+		auto randomTransform = [&](Vector3& scale, Vector3& rotate, Vector3& translate) {
+			scale = { scaleRange(rng), scaleRange(rng), scaleRange(rng) };
+			rotate = { range(rng), range(rng), range(rng) };
+			translate = { range(rng), range(rng), range(rng) };
+			};
+
+		float buildError = 0.0f;
+		float composeError = 0.0f;
+		float inverseError = 0.0f;
+		float multiplyError = 0.0f;
+		float transformError = 0.0f;
+		float quaternionError = 0.0f;
+		float conversionError = 0.0f;
+		for (int i = 0; i < 100000; ++i) {
+			Vector3 scale, rotate, translate, scale2, rotate2, translate2;
+			randomTransform(scale, rotate, translate);
+			randomTransform(scale2, rotate2, translate2);
+			Matrix4x4 a = MakeAffineMatrix(scale, rotate, translate);
+			Matrix4x4 b = MakeAffineMatrix(scale2, rotate2, translate2);
+			Affine3x4 affineA = MakeAffine3x4(scale, rotate, translate);
+			Affine3x4 affineB = MakeAffine3x4(scale2, rotate2, translate2);
+
+			buildError = (std::max)(buildError, MaxDifference(ToMatrix4x4(affineA), a));
+			composeError = (std::max)(composeError, MaxDifference(ToMatrix4x4(affineA * affineB), a * b));
+			inverseError = (std::max)(inverseError, MaxDifference(ToMatrix4x4(Inverse(affineA)), Inverse(a)));
+			multiplyError = (std::max)(multiplyError, MaxDifference(Multiply(affineA, b), a * b));
+			transformError = (std::max)(transformError, MaxDifference(Transform(translate2, affineA), Transform(translate2, a)));
+			transformError = (std::max)(transformError, MaxDifference(TransformNormal(translate2, affineA), TransformNormal(translate2, a)));
+
+			Quaternion rotation = MakeRotateQuaternion(rotate);
+			quaternionError = (std::max)(quaternionError,
+				MaxDifference(ToMatrix4x4(MakeAffine3x4(scale, rotation, translate)), MakeAffineMatrix(scale, rotation, translate)));
+			conversionError = (std::max)(conversionError, MaxDifference(ToMatrix4x4(ToAffine3x4(a)), a));
+		}
+		CHECK(buildError < kTolerance);
+		CHECK(composeError < kTolerance);
+		CHECK(inverseError < kTolerance);
+		CHECK(multiplyError < kTolerance);
+		CHECK(transformError < kTolerance);
+		CHECK(quaternionError < kTolerance);
+		CHECK(conversionError == 0.0f);
+	}
+
+	// --- 単位行列・逆行列との合成 ---
+	void TestIdentity()
+	{
+		Affine3x4 affine = MakeAffine3x4({ 2.0f, 1.0f, 0.5f }, { 0.3f, -1.2f, 2.0f }, { 1.0f, 2.0f, 3.0f });
+		Matrix4x4 identity = MakeIdentity4x4();
+		CHECK(MaxDifference(ToMatrix4x4(MakeIdentityAffine3x4()), identity) == 0.0f);
+		CHECK(MaxDifference(ToMatrix4x4(affine * MakeIdentityAffine3x4()), ToMatrix4x4(affine)) == 0.0f);
+		CHECK(MaxDifference(ToMatrix4x4(affine * Inverse(affine)), identity) < 1e-5f);
+		CHECK(MaxDifference(ToMatrix4x4(Inverse(affine) * affine), identity) < 1e-5f);
+
+		Affine3x4 composed = affine;
+		composed *= affine;
+		CHECK(MaxDifference(ToMatrix4x4(composed), ToMatrix4x4(affine * affine)) == 0.0f);
+
+		// 平行移動は最後の列に入る(シェーダーのfloat3x4と同じ並び)
+		Affine3x4 translation = MakeAffine3x4({ 1.0f, 1.0f, 1.0f }, { 0.0f, 0.0f, 0.0f }, { 4.0f, 5.0f, 6.0f });
+		CHECK(translation.m[0][3] == 4.0f && translation.m[1][3] == 5.0f && translation.m[2][3] == 6.0f);
+	}
+}
+
+int main()
+{
+	TestMatchesMatrix4x4();
+	TestIdentity();
+	return Test::Finish("Affine3x4Test");
+}
@@ -0,0 +1,73 @@
+#include <fstream>
+
+#include "AssetPack.h"
+#include "BenchmarkCommon.h"
+#include "VirtualFileSystem.h"
+
+// 多数の小さいアセットをばらのファイルから読む場合とパックから読む場合の比較
+// テストではMappedFileの代わりにファイル全体を読み込む実装を使うので、ばらのファイルの数字はopen+readの費用
+namespace
+{
+	const std::filesystem::path kWorkDirectory = std::filesystem::temp_directory_path() / "AssetPackBenchmark";
+	const std::filesystem::path kRootDirectory = kWorkDirectory / "resources";
+	const uint32_t kFileCount = 2000;
+	const size_t kFileSize = 16 * 1024;
+
+	// シェーダー・マテリアル程度に圧縮できる内容
+	void WriteSources(std::vector<std::filesystem::path>& paths)
+	{
+		std::error_code ec;
+		std::filesystem::remove_all(kWorkDirectory, ec);
+		uint32_t state = 1;
+		std::vector<char> data(kFileSize);
+		for (uint32_t i = 0; i < kFileCount; ++i) {
+			std::filesystem::path path = kRootDirectory / ("dir" + std::to_string(i % 16)) / ("asset" + std::to_string(i) + ".bin");
+			std::filesystem::create_directories(path.parent_path());
+			for (size_t j = 0; j < data.size(); ++j) {
+				state ^= state << 13;
+				state ^= state >> 17;
+				state ^= state << 5;
+				data[j] = (state & 3) == 0 ? char(state >> 8) : "float4 color : SV_TARGET;\n"[j % 26];
+			}
+			std::ofstream file(path, std::ios::binary | std::ios::trunc);
+			file.write(data.data(), std::streamsize(data.size()));
+			paths.push_back(path);
+		}
+	}
+
+	// 全ファイルをVirtualFileSystemで開いて読む
+	double ReadAll(const std::filesystem::path& packPath, const std::vector<std::filesystem::path>& paths)
+	{
+		VirtualFileSystem* vfs = VirtualFileSystem::GetInstance();
+		vfs->Initialize(packPath);
+		double seconds = Benchmark::Measure(5, [&]() {
+			uint64_t sum = 0;
+			for (const std::filesystem::path& path : paths) {
+				FileData file = vfs->Open(path);
+				sum += file.GetSize() + file.GetSpan()[file.GetSize() / 2];
+			}
+			Benchmark::Keep(sum);
+		});
+		vfs->Finalize();
+		return seconds;
+	}
+}
+
+int main()
+{
+	std::vector<std::filesystem::path> paths;
+	WriteSources(paths);
+	const std::filesystem::path rawPack = kWorkDirectory / "raw.pak";
+	const std::filesystem::path lz4Pack = kWorkDirectory / "lz4.pak";
+	AssetPack::Build(kRootDirectory, rawPack, false);
+	AssetPack::Build(kRootDirectory, lz4Pack, true);
+
+	std::printf("%u files of %zu KB (items = files)\n", kFileCount, kFileSize / 1024);
+	Benchmark::Report("loose files", ReadAll(kWorkDirectory / "missing.pak", paths), kFileCount);
+	Benchmark::Report("pack (uncompressed)", ReadAll(rawPack, paths), kFileCount);
+	Benchmark::Report("pack (LZ4)", ReadAll(lz4Pack, paths), kFileCount);
+
+	std::error_code ec;
+	std::filesystem::remove_all(kWorkDirectory, ec);
+	return 0;
+}
@@ -0,0 +1,312 @@
+#include "AssetPack.h"
+#include <fstream>
+
+#include "BlockCompression.h"
+#include "TestCommon.h"
+#include "VirtualFileSystem.h"
+
+namespace
+{
+	// テスト用のファイルを置く場所
+	const std::filesystem::path kWorkDirectory = std::filesystem::temp_directory_path() / "AssetPackTest";
+	const std::filesystem::path kRootDirectory = kWorkDirectory / "resources";
+	const std::filesystem::path kPackPath = kWorkDirectory / "resources.pak";
+
+	void WriteFile(const std::filesystem::path& path, const std::vector<uint8_t>& data)
+	{
+		std::filesystem::create_directories(path.parent_path());
+		std::ofstream file(path, std::ios::binary | std::ios::trunc);
+		file.write(reinterpret_cast<const char*>(data.data()), std::streamsize(data.size()));
+	}
+
+	// 圧縮できないデータ
+	std::vector<uint8_t> MakeRandom(size_t size, uint32_t seed)
+	{
+		std::vector<uint8_t> data(size);
+		uint32_t state = seed;
+		for (uint8_t& value : data) {
+			state ^= state << 13;
+			state ^= state >> 17;
+			state ^= state << 5;
+			value = uint8_t(state);
+		}
+		return data;
+	}
+
+	// よく圧縮できるデータ
+	std::vector<uint8_t> MakeRepetitive(size_t size)
+	{
+		std::vector<uint8_t> data(size);
+		for (size_t i = 0; i < size; ++i) {
+			data[i] = uint8_t("material diffuse texture.png\n"[i % 29]);
+		}
+		return data;
+	}
+
+	// テストするファイル(パス・内容)
+	struct SourceFile {
+		std::filesystem::path path;
+		std::vector<uint8_t> data;
+	};
+	std::vector<SourceFile> MakeSources()
+	{
+		return {
+			{ kRootDirectory / "shaders/Object3d.VS.hlsl", MakeRepetitive(3000) },		// 全体をLZ4
+			{ kRootDirectory / "textures/noise.bin", MakeRandom(5000, 1) },				// 圧縮しない
+			{ kRootDirectory / "models/big.obj", MakeRepetitive(BlockCompression::kDefaultBlockSize * 3 + 777) },	// ブロック単位
+			{ kRootDirectory / "models/big_noise.bin", MakeRandom(BlockCompression::kDefaultBlockSize * 2 + 5, 2) },	// 大きいが圧縮しない
+			{ kRootDirectory / "empty.txt", {} },
+		};
+	}
+
+	void WriteSources(const std::vector<SourceFile>& sources)
+	{
+		std::error_code ec;
+		std::filesystem::remove_all(kWorkDirectory, ec);
+		for (const SourceFile& source : sources) {
+			WriteFile(source.path, source.data);
+		}
+	}
+
+	// 展開した内容とoffsetからの部分読み込みが元と一致するか
+	void CheckEntry(const AssetPack& pack, const SourceFile& source)
+	{
+		const AssetPack::Entry* entry = pack.Find(source.path);
+		CHECK(entry != nullptr);
+		if (!entry) {
+			return;
+		}
+		CHECK(entry->size == source.data.size());
+		CHECK(entry->offset % AssetPack::kAlignment == 0);
+
+		std::vector<uint8_t> data(source.data.size());
+		CHECK(pack.Decompress(*entry, data));
+		CHECK(data == source.data);
+
+		// 大きさが違えば失敗
+		std::vector<uint8_t> wrongSize(source.data.size() + 1);
+		CHECK(!pack.Decompress(*entry, wrongSize));
+
+		// ブロック境界をまたぐ範囲・末尾まで・範囲外
+		if (source.data.size() > 100) {
+			uint64_t offset = (std::min)(uint64_t(BlockCompression::kDefaultBlockSize - 50), uint64_t(source.data.size() / 2));
+			std::vector<uint8_t> part(100);
+			CHECK(pack.Read(*entry, offset, part));
+			CHECK(std::equal(part.begin(), part.end(), source.data.begin() + ptrdiff_t(offset)));
+			CHECK(pack.Read(*entry, source.data.size() - 100, part));
+			CHECK(std::equal(part.begin(), part.end(), source.data.end() - 100));
+			CHECK(!pack.Read(*entry, source.data.size() - 99, part));
+		}
+	}
+
+	void TestRoundTrip()
+	{
+		std::vector<SourceFile> sources = MakeSources();
+		WriteSources(sources);
+
+		for (bool isCompressionEnabled : { false, true }) {
+			for (Lz4::Level level : { Lz4::Level::kFast, Lz4::Level::kHigh }) {
+				CHECK(AssetPack::Build(kRootDirectory, kPackPath, isCompressionEnabled, level));
+				AssetPack pack;
+				CHECK(pack.Open(kPackPath));
+				CHECK(pack.GetEntryCount() == sources.size());
+				for (const SourceFile& source : sources) {
+					CheckEntry(pack, source);
+				}
+
+				// --- 圧縮の仕方は内容と大きさで決まる ---
+				uint32_t compressedFlags = AssetPack::kCompressedLZ4 | AssetPack::kCompressedBlocks;
+				const AssetPack::Entry* small = pack.Find(sources[0].path);
+				const AssetPack::Entry* noise = pack.Find(sources[1].path);
+				const AssetPack::Entry* big = pack.Find(sources[2].path);
+				const AssetPack::Entry* bigNoise = pack.Find(sources[3].path);
+				if (small && noise && big && bigNoise) {
+					CHECK(small->flags == (isCompressionEnabled ? uint32_t(AssetPack::kCompressedLZ4) : 0u));
+					CHECK(big->flags == (isCompressionEnabled ? uint32_t(AssetPack::kCompressedBlocks) : 0u));
+					CHECK((noise->flags & compressedFlags) == 0);
+					CHECK((bigNoise->flags & compressedFlags) == 0);
+					CHECK(!isCompressionEnabled || big->storedSize < big->size / 4);
+				}
+				pack.Close();
+				CHECK(!pack.IsOpen());
+			}
+		}
+	}
+
+	void TestFind()
+	{
+		std::vector<SourceFile> sources = MakeSources();
+		WriteSources(sources);
+		CHECK(AssetPack::Build(kRootDirectory, kPackPath, true));
+		AssetPack pack;
+		CHECK(pack.Open(kPackPath));
+
+		// 大文字小文字・"./"・".."の違いは同じパス
+		std::filesystem::path upper = kRootDirectory / "SHADERS/./Object3d.vs.HLSL";
+		std::filesystem::path dotDot = kRootDirectory / "textures/../shaders/Object3d.VS.hlsl";
+		CHECK(pack.Find(upper) == pack.Find(sources[0].path));
+		CHECK(pack.Find(dotDot) == pack.Find(sources[0].path));
+		CHECK(AssetPack::NormalizePath("A/B/../C.txt") == "a/c.txt");
+
+		// 無いパス
+		CHECK(pack.Find(kRootDirectory / "missing.txt") == nullptr);
+		CHECK(pack.Find("shaders/Object3d.VS.hlsl") == nullptr);
+	}
+
+	void TestInvalidPack()
+	{
+		std::vector<SourceFile> sources = MakeSources();
+		WriteSources(sources);
+		CHECK(AssetPack::Build(kRootDirectory, kPackPath, true));
+
+		// 読み込んでから壊す
+		std::ifstream in(kPackPath, std::ios::binary);
+		std::vector<uint8_t> original((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+		in.close();
+		AssetPack pack;
+		const std::filesystem::path brokenPath = kWorkDirectory / "broken.pak";
+
+		// 識別子が違う
+		std::vector<uint8_t> broken = original;
+		broken[0] ^= 0xFF;
+		WriteFile(brokenPath, broken);
+		CHECK(!pack.Open(brokenPath));
+
+		// バージョンが違う
+		broken = original;
+		broken[4] ^= 0xFF;
+		WriteFile(brokenPath, broken);
+		CHECK(!pack.Open(brokenPath));
+
+		// 索引の途中で切れている
+		broken.assign(original.begin(), original.begin() + sizeof(AssetPack::Header) + sizeof(AssetPack::Entry));
+		WriteFile(brokenPath, broken);
+		CHECK(!pack.Open(brokenPath));
+
+		// エントリの格納データがファイルをはみ出す
+		broken.assign(original.begin(), original.end() - 1);
+		WriteFile(brokenPath, broken);
+		CHECK(!pack.Open(brokenPath));
+
+		// 無いファイル
+		CHECK(!pack.Open(kWorkDirectory / "missing.pak"));
+		CHECK(!pack.IsOpen());
+	}
+
+	void TestVirtualFileSystem()
+	{
+		std::vector<SourceFile> sources = MakeSources();
+		WriteSources(sources);
+		CHECK(AssetPack::Build(kRootDirectory, kPackPath, true));
+		// パックを作った後に足したファイル(ばらのファイルから読む)
+		const std::filesystem::path loosePath = kRootDirectory / "loose.txt";
+		const std::vector<uint8_t> looseData = MakeRepetitive(200);
+		WriteFile(loosePath, looseData);
+
+		VirtualFileSystem* vfs = VirtualFileSystem::GetInstance();
+		vfs->Initialize(kPackPath);
+		CHECK(vfs->IsPackMounted());
+
+		// --- パックから(圧縮・無圧縮・空) ---
+		for (const SourceFile& source : sources) {
+			FileData file = vfs->Open(source.path);
+			CHECK(file.IsValid());
+			CHECK(std::equal(file.GetSpan().begin(), file.GetSpan().end(), source.data.begin(), source.data.end()));
+			uint64_t size = 0;
+			CHECK(vfs->GetFileSize(source.path, size));
+			CHECK(size == source.data.size());
+			CHECK(vfs->Exists(source.path));
+		}
+		CHECK(vfs->GetPackReadCount() == sources.size());
+		std::vector<uint8_t> part(64);
+		CHECK(vfs->Read(sources[2].path, BlockCompression::kDefaultBlockSize - 32, part));
+		CHECK(std::equal(part.begin(), part.end(), sources[2].data.begin() + BlockCompression::kDefaultBlockSize - 32));
+
+		// --- ばらのファイルから ---
+		FileData loose = vfs->Open(loosePath);
+		CHECK(loose.IsValid());
+		CHECK(std::equal(loose.GetSpan().begin(), loose.GetSpan().end(), looseData.begin(), looseData.end()));
+		CHECK(vfs->GetLooseReadCount() == 1);
+		CHECK(vfs->Read(loosePath, 10, part));
+		CHECK(std::equal(part.begin(), part.end(), looseData.begin() + 10));
+		CHECK(!vfs->Read(loosePath, looseData.size() - 10, part));
+
+		// --- 無いファイル ---
+		const std::filesystem::path missing = kRootDirectory / "missing.txt";
+		CHECK(!vfs->Open(missing).IsValid());
+		CHECK(!vfs->Exists(missing));
+		uint64_t value = 0;
+		CHECK(!vfs->GetFileSize(missing, value));
+		CHECK(!vfs->GetFileStamp(missing, value));
+		vfs->Finalize();
+
+		// --- パック必須ならばらのファイルは見ない ---
+		vfs = VirtualFileSystem::GetInstance();
+		vfs->Initialize(kPackPath, true);
+		CHECK(!vfs->IsLooseFileEnabled());
+		CHECK(vfs->Open(sources[0].path).IsValid());
+		CHECK(!vfs->Open(loosePath).IsValid());
+		CHECK(!vfs->Exists(loosePath));
+		CHECK(!vfs->GetFileStamp(loosePath, value));
+		vfs->Finalize();
+	}
+
+	void TestFileStamp()
+	{
+		std::vector<SourceFile> sources = MakeSources();
+		WriteSources(sources);
+		CHECK(AssetPack::Build(kRootDirectory, kPackPath, true));
+		const std::filesystem::path loosePath = kWorkDirectory / "loose/settings.json";
+		WriteFile(loosePath, MakeRepetitive(100));
+
+		// --- パック内: エントリごとに違い、呼ぶたびには変わらない ---
+		VirtualFileSystem* vfs = VirtualFileSystem::GetInstance();
+		vfs->Initialize(kPackPath);
+		uint64_t stamps[2] = {};
+		CHECK(vfs->GetFileStamp(sources[0].path, stamps[0]));
+		CHECK(vfs->GetFileStamp(sources[1].path, stamps[1]));
+		CHECK(stamps[0] != stamps[1]);
+		uint64_t again = 0;
+		CHECK(vfs->GetFileStamp(sources[0].path, again));
+		CHECK(again == stamps[0]);
+
+		// --- ばら: サイズか更新日時が変われば変わる ---
+		uint64_t looseStamp = 0;
+		CHECK(vfs->GetFileStamp(loosePath, looseStamp));
+		WriteFile(loosePath, MakeRepetitive(101));
+		uint64_t resized = 0;
+		CHECK(vfs->GetFileStamp(loosePath, resized));
+		CHECK(resized != looseStamp);
+		std::filesystem::last_write_time(loosePath, std::filesystem::last_write_time(loosePath) + std::chrono::seconds(10));
+		uint64_t touched = 0;
+		CHECK(vfs->GetFileStamp(loosePath, touched));
+		CHECK(touched != resized);
+		vfs->Finalize();
+
+		// --- 内容を変えてパックを作り直すと変わる ---
+		sources[0].data.back() ^= 1;
+		sources[0].data.push_back('x');
+		WriteFile(sources[0].path, sources[0].data);
+		CHECK(AssetPack::Build(kRootDirectory, kPackPath, true));
+		std::filesystem::last_write_time(kPackPath, std::filesystem::last_write_time(kPackPath) + std::chrono::seconds(10));
+		vfs = VirtualFileSystem::GetInstance();
+		vfs->Initialize(kPackPath);
+		uint64_t rebuilt = 0;
+		CHECK(vfs->GetFileStamp(sources[0].path, rebuilt));
+		CHECK(rebuilt != stamps[0]);
+		vfs->Finalize();
+	}
+}
+
+int main()
+{
+	TestRoundTrip();
+	TestFind();
+	TestInvalidPack();
+	TestVirtualFileSystem();
+	TestFileStamp();
+
+	std::error_code ec;
+	std::filesystem::remove_all(kWorkDirectory, ec);
+	return Test::Finish("AssetPackTest");
+}
@@ -0,0 +1,171 @@
+#include "AssetRegistry.h"
+#include "TestCommon.h"
+
+namespace {
+	struct TestAsset {
+		int value = 0;
+		int* destroyCount = nullptr;
+		// 破棄時に別のアセットの参照を手放す(モデルがテクスチャを持つ場合)
+		AssetHandle<TestAsset> dependency;
+		~TestAsset() {
+			if (destroyCount) {
+				(*destroyCount)++;
+			}
+		}
+	};
+	using Registry = AssetRegistry<TestAsset>;
+	using Handle = AssetHandle<TestAsset>;
+
+	std::unique_ptr<TestAsset> MakeAsset(int value, int* destroyCount) {
+		auto asset = std::make_unique<TestAsset>();
+		asset->value = value;
+		asset->destroyCount = destroyCount;
+		return asset;
+	}
+
+	// --- ハンドルのコピー・ムーブで参照カウントが合う ---
+	void TestHandleRefCount()
+	{
+		Registry registry;
+		int destroyCount = 0;
+		uint32_t id = registry.Add("a", MakeAsset(1, &destroyCount));
+		CHECK(registry.Find("a") == id);
+		CHECK(registry.Find("b") == Registry::kInvalidId);
+		CHECK(registry.GetRefCount(id) == 0);
+		{
+			Handle handle(&registry, id);
+			CHECK(registry.GetRefCount(id) == 1);
+			CHECK(handle->value == 1);
+			CHECK(handle.GetName() == "a");
+
+			Handle copy = handle;
+			CHECK(registry.GetRefCount(id) == 2);
+			Handle moved = std::move(copy);
+			CHECK(registry.GetRefCount(id) == 2);
+			CHECK(!copy);
+			// 自分自身・同じアセットの代入で破棄待ちにならない
+			moved = handle;
+			CHECK(registry.GetRefCount(id) == 2);
+			CHECK(registry.GetPendingCount() == 0);
+		}
+		CHECK(registry.GetRefCount(id) == 0);
+		CHECK(registry.GetPendingCount() == 1);
+		CHECK(destroyCount == 0);
+	}
+
+	// --- 破棄はフェンスを追い越してから ---
+	void TestRetireAfterFence()
+	{
+		Registry registry;
+		int destroyCount = 0;
+		uint32_t id = registry.Add("a", MakeAsset(1, &destroyCount));
+		registry.SetRetireFenceValue(5);
+		{
+			Handle handle(&registry, id);
+		}
+		std::vector<uint32_t> destroyed;
+		auto onDestroy = [&destroyed](uint32_t destroyedId, TestAsset&) { destroyed.push_back(destroyedId); };
+		CHECK(registry.Collect(4, onDestroy) == 0);
+		CHECK(registry.Get(id) != nullptr);
+		CHECK(registry.Collect(5, onDestroy) == 1);
+		CHECK(destroyed.size() == 1 && destroyed[0] == id);
+		CHECK(destroyCount == 1);
+		CHECK(registry.Get(id) == nullptr);
+		CHECK(registry.Find("a") == Registry::kInvalidId);
+		CHECK(registry.GetLiveCount() == 0);
+
+		// 空いた番号は再利用する
+		uint32_t reused = registry.Add("b", MakeAsset(2, &destroyCount));
+		CHECK(reused == id);
+		CHECK(registry.Get("b")->value == 2);
+	}
+
+	// --- 破棄待ちの間に参照されたら復活する ---
+	void TestRevive()
+	{
+		Registry registry;
+		int destroyCount = 0;
+		uint32_t id = registry.Add("a", MakeAsset(1, &destroyCount));
+		registry.SetRetireFenceValue(1);
+		Handle(&registry, id).Reset();
+		CHECK(registry.GetPendingCount() == 1);
+
+		Handle revived(&registry, registry.Find("a"));
+		CHECK(registry.GetPendingCount() == 0);
+		CHECK(registry.Collect(100) == 0);
+		CHECK(destroyCount == 0);
+
+		// 後のフレームで破棄待ちになり直したら、古い記録では破棄しない
+		registry.SetRetireFenceValue(10);
+		revived.Reset();
+		CHECK(registry.Collect(9) == 0);
+		CHECK(registry.Get(id) != nullptr);
+		CHECK(registry.Collect(10) == 1);
+		CHECK(destroyCount == 1);
+	}
+
+	// --- 破棄中に別のアセットを手放してもよい ---
+	void TestReleaseDuringDestroy()
+	{
+		Registry registry;
+		int destroyCount = 0;
+		uint32_t texture = registry.Add("texture", MakeAsset(1, &destroyCount));
+		uint32_t model = registry.Add("model", MakeAsset(2, &destroyCount));
+		registry.Get(model)->dependency = Handle(&registry, texture);
+		registry.SetRetireFenceValue(1);
+		Handle(&registry, model).Reset();
+
+		// モデルの破棄でテクスチャが破棄待ちになる(同じフェンス値は終わっているので同じCollectで破棄)
+		CHECK(registry.Collect(1) == 2);
+		CHECK(destroyCount == 2);
+		CHECK(registry.GetLiveCount() == 0);
+	}
+
+	// --- 一覧 ---
+	void TestReport()
+	{
+		Registry registry;
+		uint32_t id = registry.Add("a", MakeAsset(1, nullptr));
+		registry.Add("b", MakeAsset(2, nullptr));
+		Handle handle(&registry, id);
+		std::string report = registry.BuildReport("Test", [](const TestAsset&) { return uint64_t(2048); });
+		CHECK(report.find("Test: 2 live, 0 pending destroy, 4.0KB") == 0);
+		CHECK(report.find("a refs=1 2.0KB") != std::string::npos);
+		CHECK(report.find("b refs=0 2.0KB") != std::string::npos);
+
+		// 長い名前・ラベルも切れない
+		const std::string longName = "resources/" + std::string(200, 'x') + ".png";
+		registry.Add(longName, MakeAsset(3, nullptr));
+		report = registry.BuildReport(std::string(100, 'L'), [](const TestAsset&) { return uint64_t(1024); });
+		CHECK(report.find(std::string(100, 'L') + ": 3 live, 0 pending destroy, 3.0KB\n") == 0);
+		CHECK(report.find("  " + longName + " refs=0 1.0KB\n") != std::string::npos);
+	}
+
+	// --- フェンス値の順に取り出す ---
+	void TestFenceRetireQueue()
+	{
+		FenceRetireQueue<int> queue;
+		queue.Push(1, 10);
+		queue.Push(1, 11);
+		queue.Push(3, 30);
+		std::vector<int> retired;
+		auto onRetire = [&retired](int item) { retired.push_back(item); };
+		CHECK(queue.Retire(0, onRetire) == 0);
+		CHECK(queue.Retire(2, onRetire) == 2);
+		CHECK(retired.size() == 2 && retired[0] == 10 && retired[1] == 11);
+		CHECK(queue.GetPendingCount() == 1);
+		CHECK(queue.Retire(3, onRetire) == 1);
+		CHECK(queue.IsEmpty());
+	}
+}
+
+int main()
+{
+	TestHandleRefCount();
+	TestRetireAfterFence();
+	TestRevive();
+	TestReleaseDuringDestroy();
+	TestReport();
+	TestFenceRetireQueue();
+	return Test::Finish("AssetRegistryTest");
+}
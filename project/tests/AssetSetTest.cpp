@@ -0,0 +1,193 @@
+#include "AssetSet.h"
+#include <thread>
+
+#include "TestCommon.h"
+
+namespace
+{
+	// SceneManager::kPreloadBudgetと同じ
+	const std::chrono::microseconds kPreloadBudget{ 2000 };
+	// 1つあたりのGPUリソース作成にかかる時間
+	const std::chrono::microseconds kItemCost{ 300 };
+
+	std::vector<std::string> MakePaths(const std::string& prefix, uint32_t count)
+	{
+		std::vector<std::string> paths;
+		for (uint32_t i = 0; i < count; ++i) {
+			paths.push_back(prefix + std::to_string(i));
+		}
+		return paths;
+	}
+
+	void ResetManagers()
+	{
+		TextureManager* textureManager = TextureManager::GetInstance();
+		textureManager->acquireCost = kItemCost;
+		textureManager->prepareCount = 0;
+		textureManager->acquireCount = 0;
+		ModelManager* modelManager = ModelManager::GetInstance();
+		modelManager->acquireCost = kItemCost;
+		modelManager->prepareCount = 0;
+		modelManager->acquireCount = 0;
+	}
+
+	void TestResolveBudget()
+	{
+		ResetManagers();
+		AssetSet assets;
+		const uint32_t kTextureCount = 20;
+		const uint32_t kModelCount = 10;
+		assets.RequestTextures(MakePaths("texture", kTextureCount));
+		for (const std::string& path : MakePaths("model", kModelCount)) {
+			assets.RequestModel(path);
+		}
+		CHECK(assets.GetRequestedCount() == kTextureCount + kModelCount);
+		CHECK(assets.GetPreparedCount() == kTextureCount + kModelCount);
+		CHECK(TextureManager::GetInstance()->acquireCount == 0);
+
+		// 1つにkItemCost以上かかるので、予算を超えるまでに作れるのは予算/kItemCost+1個まで
+		const uint32_t kMaxPerCall = uint32_t(kPreloadBudget / kItemCost) + 1;
+		uint32_t callCount = 0;
+		uint32_t previousResolved = 0;
+		bool isResolved = false;
+		while (!isResolved && callCount < 100) {
+			auto start = std::chrono::steady_clock::now();
+			isResolved = assets.Resolve(kPreloadBudget);
+			auto elapsed = std::chrono::steady_clock::now() - start;
+			callCount++;
+
+			uint32_t resolved = assets.GetResolvedCount() - previousResolved;
+			previousResolved = assets.GetResolvedCount();
+			// 毎回少なくとも1つは進め、予算+1つ分で止まる
+			CHECK(resolved >= 1);
+			CHECK(resolved <= kMaxPerCall);
+			// 時間でも確認する(他のプロセスに邪魔されることがあるので余裕を持たせる)
+			CHECK(elapsed < kPreloadBudget + kItemCost + std::chrono::milliseconds(20));
+		}
+		CHECK(isResolved);
+		CHECK(assets.GetResolvedCount() == kTextureCount + kModelCount);
+		CHECK(callCount >= (kTextureCount + kModelCount + kMaxPerCall - 1) / kMaxPerCall);
+		CHECK(assets.GetTextureCount() == kTextureCount);
+		CHECK(assets.GetModelCount() == kModelCount);
+		CHECK(TextureManager::GetInstance()->acquireCount == kTextureCount);
+		CHECK(ModelManager::GetInstance()->acquireCount == kModelCount);
+
+		// 要求が無ければすぐに終わる
+		CHECK(assets.Resolve(kPreloadBudget));
+		CHECK(assets.GetResolvedCount() == kTextureCount + kModelCount);
+	}
+
+	void TestResolveZeroBudget()
+	{
+		// 予算が0でも1つずつは進む
+		ResetManagers();
+		TextureManager::GetInstance()->acquireCost = std::chrono::microseconds(0);
+		ModelManager::GetInstance()->acquireCost = std::chrono::microseconds(0);
+		AssetSet assets;
+		assets.RequestTextures(MakePaths("texture", 3));
+		assets.RequestModel("model");
+		uint32_t callCount = 0;
+		while (!assets.Resolve(std::chrono::microseconds(0))) {
+			callCount++;
+			CHECK(assets.GetResolvedCount() == callCount);
+		}
+		CHECK(callCount == 3);
+		CHECK(assets.GetResolvedCount() == 4);
+	}
+
+	void TestProgress()
+	{
+		ResetManagers();
+		AssetSet assets;
+
+		// 要求が無ければ、要求が終わったときに1
+		{
+			AssetSet empty;
+			CHECK(empty.UpdateProgress(false) == 0.99f);
+			CHECK(empty.UpdateProgress(true) == 1.0f);
+		}
+
+		// クックで半分、転送で残り半分
+		assets.RequestTextures(MakePaths("texture", 4));
+		CHECK(assets.UpdateProgress(false) == 0.5f);
+
+		// 全部転送しても要求が終わるまでは1にしない
+		while (!assets.Resolve(kPreloadBudget)) {
+		}
+		CHECK(assets.UpdateProgress(false) == 0.99f);
+
+		// 後から要求が増えても戻らない
+		assets.RequestTextures(MakePaths("more", 12));
+		CHECK(assets.UpdateProgress(false) == 0.99f);
+		while (!assets.Resolve(kPreloadBudget)) {
+			CHECK(assets.UpdateProgress(false) == 0.99f);
+		}
+		CHECK(assets.UpdateProgress(true) == 1.0f);
+	}
+
+	void TestProgressWithWorker()
+	{
+		// ワーカーが要求を出し続ける間、メインスレッドで毎フレームResolveする(SceneManager::UpdatePreloadと同じ流れ)
+		ResetManagers();
+		TextureManager::GetInstance()->acquireCost = std::chrono::microseconds(50);
+		ModelManager::GetInstance()->acquireCost = std::chrono::microseconds(50);
+		AssetSet assets;
+		std::atomic<bool> isLoaded = false;
+		std::thread worker([&]() {
+			for (uint32_t batch = 0; batch < 20; ++batch) {
+				assets.RequestTextures(MakePaths("texture" + std::to_string(batch) + "_", 5));
+				assets.RequestModel("model" + std::to_string(batch));
+				std::this_thread::sleep_for(std::chrono::microseconds(200));
+			}
+			isLoaded = true;
+		});
+
+		float previous = 0.0f;
+		bool isDone = false;
+		uint32_t frameCount = 0;
+		while (!isDone && frameCount < 100000) {
+			// 完了の確認は先に(要求の出そろった後のResolveで終わったときだけ完了とする)
+			bool isRequestFinished = isLoaded;
+			bool isResolved = assets.Resolve(std::chrono::microseconds(300));
+			float progress = assets.UpdateProgress(isRequestFinished);
+			CHECK(progress >= previous);
+			CHECK(progress <= 1.0f);
+			CHECK(isRequestFinished || progress < 1.0f);
+			previous = progress;
+			isDone = isRequestFinished && isResolved;
+			frameCount++;
+			// フレームの残り
+			std::this_thread::sleep_for(std::chrono::microseconds(100));
+		}
+		worker.join();
+		CHECK(isDone);
+		CHECK(previous == 1.0f);
+		CHECK(assets.GetResolvedCount() == 20 * 6);
+	}
+
+	void TestClear()
+	{
+		ResetManagers();
+		AssetSet assets;
+		assets.LoadTexture("a");
+		assets.LoadModel("b");
+		assets.RequestTextures(MakePaths("texture", 5));
+		CHECK(assets.GetTextureCount() == 1);
+		assets.Clear();
+		CHECK(assets.GetTextureCount() == 0);
+		CHECK(assets.GetModelCount() == 0);
+		// 要求も捨てるので作らない
+		CHECK(assets.Resolve(kPreloadBudget));
+		CHECK(TextureManager::GetInstance()->acquireCount == 1);
+	}
+}
+
+int main()
+{
+	TestResolveBudget();
+	TestResolveZeroBudget();
+	TestProgress();
+	TestProgressWithWorker();
+	TestClear();
+	return Test::Finish("AssetSetTest");
+}
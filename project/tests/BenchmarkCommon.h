@@ -0,0 +1,32 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+
+// ベンチマーク用の計測
+// 何回か試して最速の時間を使う(他のプロセスの影響を減らす)
+namespace Benchmark {
+	// 最適化で計算が消されないように結果を書き込む先
+	inline volatile uint64_t sink = 0;
+	inline void Keep(uint64_t value) { sink = value; }
+
+	// funcを1回実行する時間(秒)。trialCount回のうち最速
+	template<typename F>
+	double Measure(int trialCount, F&& func) {
+		double best = 1.0e30;
+		for (int trial = 0; trial < trialCount; ++trial) {
+			auto start = std::chrono::steady_clock::now();
+			func();
+			std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+			best = (std::min)(best, elapsed.count());
+		}
+		return best;
+	}
+
+	// 結果の表示(itemCountは1回で処理した数。1件あたりの時間と秒あたりの数に直して出す)
+	inline void Report(const char* name, double seconds, double itemCount) {
+		std::printf("%-52s %10.3f ms %12.1f ns/item %10.2f M/s\n",
+			name, seconds * 1000.0, seconds / itemCount * 1.0e9, itemCount / seconds / 1.0e6);
+	}
+}
@@ -0,0 +1,142 @@
+#include <cmath>
+#include <random>
+#include <thread>
+
+#include "BenchmarkCommon.h"
+#include "CollisionWorld.h"
+
+// 動く箱が10k〜100kのときの1フレーム(全部SetBoundsで動かしてUpdate)
+// 少しずつ動く場合(前フレームの並びが使える)と、毎フレームばらばらに置き直す場合、スレッド数ごとの比較
+namespace
+{
+	const uint32_t kBodyCounts[] = { 10000, 30000, 100000 };
+	const int kTrialCount = 10;
+	// 箱の大きさ(1辺)
+	const float kBoxSize = 1.0f;
+	// 高さ方向の広さ(地面の上に散らばる)
+	const float kHeight = 4.0f;
+
+	// 動く箱
+	struct Body {
+		Vector3 position;
+		Vector3 velocity;
+		CollisionWorld::ColliderId collider;
+	};
+
+	AABB MakeBounds(const Vector3& position)
+	{
+		return { position, position + Vector3(kBoxSize, kBoxSize, kBoxSize) };
+	}
+
+	// 重なる組の数が箱の数の1割程度になる密度で散らす
+	class Scene
+	{
+	public:
+		explicit Scene(uint32_t bodyCount) : rng_(bodyCount) {
+			size_ = std::sqrt(float(bodyCount) * 8.0f * kBoxSize * kBoxSize * kBoxSize / kHeight);
+			bodies_.resize(bodyCount);
+			for (Body& body : bodies_) {
+				body.position = RandomPosition();
+				body.velocity = { Random(-0.05f, 0.05f), 0.0f, Random(-0.05f, 0.05f) };
+				// 敵・弾・プレイヤーのように3種類のレイヤーに分ける
+				uint32_t layer = 1u << (rng_() % 3);
+				body.collider = world_.AddCollider(MakeBounds(body.position), layer, CollisionWorld::kAllLayers);
+			}
+		}
+
+		// 少しずつ動かす(端で跳ね返る)
+		void Move() {
+			for (Body& body : bodies_) {
+				body.position += body.velocity;
+				if (body.position.x < -size_ || body.position.x > size_) {
+					body.velocity.x = -body.velocity.x;
+				}
+				if (body.position.z < -size_ || body.position.z > size_) {
+					body.velocity.z = -body.velocity.z;
+				}
+				world_.SetBounds(body.collider, MakeBounds(body.position));
+			}
+		}
+
+		// ばらばらに置き直す
+		void Scatter() {
+			for (Body& body : bodies_) {
+				body.position = RandomPosition();
+				world_.SetBounds(body.collider, MakeBounds(body.position));
+			}
+		}
+
+		CollisionWorld& GetWorld() { return world_; }
+
+	private:
+		float Random(float min, float max) { return std::uniform_real_distribution<float>(min, max)(rng_); }
+		Vector3 RandomPosition() { return { Random(-size_, size_), Random(0.0f, kHeight), Random(-size_, size_) }; }
+
+		std::mt19937 rng_;
+		float size_ = 0.0f;
+		std::vector<Body> bodies_;
+		CollisionWorld world_;
+	};
+
+	// 総当たり(比べるための基準。箱はCollisionWorldに入っているものを使う)
+	uint32_t CountPairsBruteForce(CollisionWorld& world, uint32_t bodyCount)
+	{
+		uint32_t pairCount = 0;
+		for (CollisionWorld::ColliderId a = 0; a < bodyCount; ++a) {
+			for (CollisionWorld::ColliderId b = a + 1; b < bodyCount; ++b) {
+				pairCount += IsCollision(world.GetBounds(a), world.GetBounds(b));
+			}
+		}
+		return pairCount;
+	}
+}
+
+int main()
+{
+	std::printf("items = bodies per frame\n");
+	uint32_t maxThreads = (std::max)(1u, std::thread::hardware_concurrency());
+	for (uint32_t bodyCount : kBodyCounts) {
+		Scene scene(bodyCount);
+		CollisionWorld& world = scene.GetWorld();
+		world.Update();
+		char name[80];
+
+		// --- 少しずつ動く(挿入ソートで並びを直す) ---
+		double coherent = Benchmark::Measure(kTrialCount, [&]() {
+			scene.Move();
+			world.Update();
+		});
+		std::snprintf(name, sizeof(name), "%uk moving serial (pairs %u)", bodyCount / 1000, world.GetPairCount());
+		Benchmark::Report(name, coherent, bodyCount);
+
+		for (uint32_t threadCount = 1; threadCount <= maxThreads; threadCount *= 2) {
+			ThreadPool threadPool(threadCount);
+			double parallel = Benchmark::Measure(kTrialCount, [&]() {
+				scene.Move();
+				world.Update(&threadPool);
+			});
+			std::snprintf(name, sizeof(name), "%uk moving threads=%u (pairs %u)", bodyCount / 1000, threadCount, world.GetPairCount());
+			Benchmark::Report(name, parallel, bodyCount);
+		}
+
+		// --- 毎フレーム置き直す(まとめてソートし直す) ---
+		double scattered = Benchmark::Measure(kTrialCount, [&]() {
+			scene.Scatter();
+			world.Update();
+		});
+		std::snprintf(name, sizeof(name), "%uk scattered serial (pairs %u)", bodyCount / 1000, world.GetPairCount());
+		Benchmark::Report(name, scattered, bodyCount);
+
+		// --- 総当たり(O(n^2)なので一番少ないときだけ) ---
+		if (bodyCount == kBodyCounts[0]) {
+			uint32_t pairCount = 0;
+			double bruteForce = Benchmark::Measure(1, [&]() {
+				pairCount = CountPairsBruteForce(world, bodyCount);
+			});
+			std::snprintf(name, sizeof(name), "%uk brute force AABB pairs (pairs %u)", bodyCount / 1000, pairCount);
+			Benchmark::Report(name, bruteForce, bodyCount);
+		}
+		Benchmark::Keep(world.GetEvents().size());
+	}
+	return 0;
+}
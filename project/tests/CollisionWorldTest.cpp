@@ -0,0 +1,288 @@
+#include "CollisionWorld.h"
+#include "Object3d.h"
+#include "TestCommon.h"
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <random>
+#include <set>
+
+namespace {
+	using Key = uint64_t;
+	Key MakeKey(uint32_t a, uint32_t b) { return a < b ? (Key(a) << 32 | b) : (Key(b) << 32 | a); }
+
+	bool Equals(const AABB& a, const AABB& b) {
+		return a.min.x == b.min.x && a.min.y == b.min.y && a.min.z == b.min.z &&
+			a.max.x == b.max.x && a.max.y == b.max.y && a.max.z == b.max.z;
+	}
+
+	// 比較用に覚えておくコライダー
+	struct ReferenceCollider {
+		Object3d* object = nullptr;
+		bool useModelBounds = false;
+		AABB localBounds{};
+		AABB bounds{};	// Object3dを持たないもの
+		uint32_t layer = 0;
+		uint32_t collideMask = 0;
+
+		AABB GetWorldBounds() const {
+			if (!object) {
+				return bounds;
+			}
+			return Transform(useModelBounds ? object->GetLocalBounds() : localBounds, object->GetWorldMatrix());
+		}
+	};
+
+	// 同じ操作を1スレッドと並列の2つのCollisionWorldに行い、総当たりと比べる
+	class Harness
+	{
+	public:
+		Harness(uint32_t seed, float worldSize) : rng_(seed), worldSize_(worldSize) {}
+
+		float Random(float min, float max) { return std::uniform_real_distribution<float>(min, max)(rng_); }
+		Vector3 RandomPosition() { return { Random(-worldSize_, worldSize_), Random(-worldSize_, worldSize_), Random(-worldSize_, worldSize_) }; }
+		uint32_t RandomLayer() { return 1u << (rng_() % 3); }
+		uint32_t RandomMask() { return rng_() % 4 == 0 ? RandomLayer() : CollisionWorld::kAllLayers; }
+
+		// ランダムな種類のコライダーを足す
+		void Add() {
+			ReferenceCollider reference;
+			reference.layer = RandomLayer();
+			reference.collideMask = RandomMask();
+			CollisionWorld::ColliderId ids[2];
+			uint32_t kind = rng_() % 3;
+			if (kind == 2) {
+				Vector3 min = RandomPosition();
+				reference.bounds = { min, min + Vector3(Random(0.5f, 3.0f), Random(0.5f, 3.0f), Random(0.5f, 3.0f)) };
+				for (int i = 0; i < 2; ++i) {
+					ids[i] = worlds_[i].AddCollider(reference.bounds, reference.layer, reference.collideMask);
+				}
+			}
+			else {
+				objects_.push_back(std::make_unique<Object3d>());
+				reference.object = objects_.back().get();
+				reference.object->SetWorldMatrix(MakeAffine3x4({ 1.0f, 1.0f, 1.0f }, { Random(0.0f, 3.0f), Random(0.0f, 3.0f), 0.0f }, RandomPosition()));
+				reference.useModelBounds = kind == 0;
+				reference.localBounds = { { -1.0f, -0.5f, -0.5f }, { 1.0f, 0.5f, 0.5f } };
+				for (int i = 0; i < 2; ++i) {
+					ids[i] = reference.useModelBounds ?
+						worlds_[i].AddCollider(reference.object, reference.layer, reference.collideMask) :
+						worlds_[i].AddCollider(reference.object, reference.localBounds, reference.layer, reference.collideMask);
+				}
+			}
+			CHECK(ids[0] == ids[1]);
+			// 削除された番号は次の次のUpdateまで再利用されない
+			CHECK(!recentlyRemoved_.contains(ids[0]));
+			references_[ids[0]] = reference;
+		}
+
+		// ランダムに1つ消す
+		void Remove() {
+			if (references_.empty()) {
+				return;
+			}
+			auto it = references_.begin();
+			std::advance(it, rng_() % references_.size());
+			for (CollisionWorld& world : worlds_) {
+				world.RemoveCollider(it->first);
+			}
+			removedThisFrame_.insert(it->first);
+			references_.erase(it);
+		}
+
+		// 全てを少しずつ動かし、たまにレイヤーを変える
+		void Move(float speed) {
+			for (auto& [id, reference] : references_) {
+				if (reference.object) {
+					Affine3x4 world = reference.object->GetWorldMatrix();
+					world.m[0][3] += Random(-speed, speed);
+					world.m[1][3] += Random(-speed, speed);
+					reference.object->SetWorldMatrix(world);
+				}
+				else {
+					Vector3 offset = { Random(-speed, speed), Random(-speed, speed), 0.0f };
+					reference.bounds.min += offset;
+					reference.bounds.max += offset;
+					for (CollisionWorld& world : worlds_) {
+						world.SetBounds(id, reference.bounds);
+					}
+				}
+				if (rng_() % 200 == 0) {
+					reference.layer = RandomLayer();
+					reference.collideMask = RandomMask();
+					for (CollisionWorld& world : worlds_) {
+						world.SetLayer(id, reference.layer, reference.collideMask);
+					}
+				}
+			}
+		}
+
+		// 更新して総当たりと比べる(不一致の数を返す)
+		int UpdateAndCompare(ThreadPool& threadPool) {
+			worlds_[0].Update();
+			worlds_[1].Update(&threadPool);
+			int mismatchCount = 0;
+
+			// --- 総当たり ---
+			std::vector<std::pair<CollisionWorld::ColliderId, AABB>> live;
+			for (const auto& [id, reference] : references_) {
+				live.emplace_back(id, reference.GetWorldBounds());
+				mismatchCount += Equals(worlds_[0].GetBounds(id), live.back().second) ? 0 : 1;
+			}
+			std::set<Key> pairs;
+			for (size_t a = 0; a < live.size(); ++a) {
+				const ReferenceCollider& referenceA = references_[live[a].first];
+				for (size_t b = a + 1; b < live.size(); ++b) {
+					const ReferenceCollider& referenceB = references_[live[b].first];
+					if ((referenceA.layer & referenceB.collideMask) && (referenceB.layer & referenceA.collideMask) &&
+						IsCollision(live[a].second, live[b].second)) {
+						pairs.insert(MakeKey(live[a].first, live[b].first));
+					}
+				}
+			}
+
+			// --- イベントが前フレームとの差になっている ---
+			for (const CollisionWorld& world : worlds_) {
+				std::set<Key> enters, stays, exits;
+				for (const CollisionWorld::Event& event : world.GetEvents()) {
+					mismatchCount += event.collider1 < event.collider2 ? 0 : 1;
+					Key key = MakeKey(event.collider1, event.collider2);
+					std::set<Key>& events = event.type == CollisionWorld::EventType::Enter ? enters :
+						event.type == CollisionWorld::EventType::Stay ? stays : exits;
+					mismatchCount += events.insert(key).second ? 0 : 1;
+				}
+				for (Key key : pairs) {
+					bool wasOverlapping = previousPairs_.contains(key);
+					mismatchCount += (wasOverlapping ? stays.contains(key) : enters.contains(key)) ? 0 : 1;
+				}
+				for (Key key : previousPairs_) {
+					mismatchCount += (pairs.contains(key) || exits.contains(key)) ? 0 : 1;
+				}
+				mismatchCount += enters.size() + stays.size() == pairs.size() ? 0 : 1;
+				mismatchCount += exits.size() <= previousPairs_.size() ? 0 : 1;
+				mismatchCount += world.GetPairCount() == pairs.size() ? 0 : 1;
+				mismatchCount += world.GetColliderCount() == references_.size() ? 0 : 1;
+			}
+
+			// --- 1スレッドと並列で同じイベントが同じ順に出る ---
+			std::span<const CollisionWorld::Event> events0 = worlds_[0].GetEvents();
+			std::span<const CollisionWorld::Event> events1 = worlds_[1].GetEvents();
+			bool isSame = events0.size() == events1.size();
+			for (size_t i = 0; isSame && i < events0.size(); ++i) {
+				isSame = events0[i].type == events1[i].type && events0[i].collider1 == events1[i].collider1 && events0[i].collider2 == events1[i].collider2;
+			}
+			mismatchCount += isSame ? 0 : 1;
+
+			previousPairs_ = std::move(pairs);
+			recentlyRemoved_ = std::move(removedThisFrame_);
+			removedThisFrame_.clear();
+			return mismatchCount;
+		}
+
+		size_t GetColliderCount() const { return references_.size(); }
+		size_t GetPairCount() const { return previousPairs_.size(); }
+
+	private:
+		std::mt19937 rng_;
+		float worldSize_;
+		CollisionWorld worlds_[2];
+		std::vector<std::unique_ptr<Object3d>> objects_;
+		std::map<CollisionWorld::ColliderId, ReferenceCollider> references_;
+		std::set<Key> previousPairs_;
+		std::set<CollisionWorld::ColliderId> removedThisFrame_;
+		std::set<CollisionWorld::ColliderId> recentlyRemoved_;
+	};
+
+	// --- 少ない数で追加・削除を繰り返す ---
+	void TestAgainstBruteForce()
+	{
+		ThreadPool threadPool(4);
+		Harness harness(3, 20.0f);
+		for (int i = 0; i < 200; ++i) {
+			harness.Add();
+		}
+		int mismatchCount = 0;
+		size_t pairCount = 0;
+		for (int frame = 0; frame < 300; ++frame) {
+			harness.Move(1.0f);
+			// 削除と追加(まとめて消すフレームも混ぜる)
+			int removeCount = frame % 50 == 25 ? 40 : int(frame % 3);
+			for (int i = 0; i < removeCount; ++i) {
+				harness.Remove();
+			}
+			int addCount = frame % 50 == 30 ? 40 : int(frame % 2) * 2;
+			for (int i = 0; i < addCount; ++i) {
+				harness.Add();
+			}
+			mismatchCount += harness.UpdateAndCompare(threadPool);
+			pairCount += harness.GetPairCount();
+		}
+		CHECK(mismatchCount == 0);
+		CHECK(pairCount > 0);
+	}
+
+	// --- 並列に掃く数で比べる ---
+	void TestParallelAgainstBruteForce()
+	{
+		ThreadPool threadPool(4);
+		Harness harness(9, 40.0f);
+		for (uint32_t i = 0; i < CollisionWorld::kMinParallelColliders + 500; ++i) {
+			harness.Add();
+		}
+		int mismatchCount = 0;
+		size_t pairCount = 0;
+		for (int frame = 0; frame < 6; ++frame) {
+			harness.Move(0.5f);
+			for (int i = 0; i < 20; ++i) {
+				harness.Remove();
+				harness.Add();
+			}
+			mismatchCount += harness.UpdateAndCompare(threadPool);
+			pairCount += harness.GetPairCount();
+		}
+		CHECK(harness.GetColliderCount() >= CollisionWorld::kMinParallelColliders);
+		CHECK(mismatchCount == 0);
+		CHECK(pairCount > 0);
+	}
+
+	// --- 削除した組はExitになり、Clearではイベントを出さない ---
+	void TestRemoveAndClear()
+	{
+		CollisionWorld world;
+		AABB box{ { 0.0f, 0.0f, 0.0f }, { 1.0f, 1.0f, 1.0f } };
+		CollisionWorld::ColliderId a = world.AddCollider(box, 1, CollisionWorld::kAllLayers);
+		CollisionWorld::ColliderId b = world.AddCollider(box, 1, CollisionWorld::kAllLayers);
+		// レイヤーが相手のマスクに無ければ判定しない
+		CollisionWorld::ColliderId c = world.AddCollider(box, 2, 2);
+		world.Update();
+		CHECK(world.GetEvents().size() == 1);
+		CHECK(world.GetEvents()[0].type == CollisionWorld::EventType::Enter);
+		CHECK(world.GetEvents()[0].collider1 == a && world.GetEvents()[0].collider2 == b);
+
+		world.RemoveCollider(b);
+		CHECK(!world.IsAlive(b));
+		world.Update();
+		CHECK(world.GetEvents().size() == 1);
+		CHECK(world.GetEvents()[0].type == CollisionWorld::EventType::Exit);
+
+		// 削除した番号は次の次のUpdateまで使われない
+		CHECK(world.AddCollider(box, 4, 4) != b);
+		world.Update();
+		CHECK(world.AddCollider(box, 4, 4) == b);
+
+		world.Clear();
+		world.Update();
+		CHECK(world.GetEvents().empty());
+		CHECK(world.GetColliderCount() == 0);
+		CHECK(!world.IsAlive(c));
+	}
+}
+
+int main()
+{
+	TestAgainstBruteForce();
+	TestParallelAgainstBruteForce();
+	TestRemoveAndClear();
+	return Test::Finish("CollisionWorldTest");
+}
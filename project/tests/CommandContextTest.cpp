@@ -0,0 +1,170 @@
+#include "CommandContext.h"
+#include "TestCommon.h"
+
+namespace {
+	// 実際に積まれたコマンドを数えるコマンドリスト
+	struct RecordingCommandList : ID3D12GraphicsCommandList {
+		int commandCount = 0;
+		void SetGraphicsRootSignature(ID3D12RootSignature*) override { commandCount++; }
+		void SetPipelineState(ID3D12PipelineState*) override { commandCount++; }
+		void IASetPrimitiveTopology(D3D12_PRIMITIVE_TOPOLOGY) override { commandCount++; }
+		void SetDescriptorHeaps(UINT, ID3D12DescriptorHeap* const*) override { commandCount++; }
+		void IASetVertexBuffers(UINT, UINT, const D3D12_VERTEX_BUFFER_VIEW*) override { commandCount++; }
+		void IASetIndexBuffer(const D3D12_INDEX_BUFFER_VIEW*) override { commandCount++; }
+		void SetGraphicsRootConstantBufferView(UINT, D3D12_GPU_VIRTUAL_ADDRESS) override { commandCount++; }
+		void SetGraphicsRootDescriptorTable(UINT, D3D12_GPU_DESCRIPTOR_HANDLE) override { commandCount++; }
+		void DrawInstanced(UINT, UINT, UINT, UINT) override { commandCount++; }
+		void DrawIndexedInstanced(UINT, UINT, UINT, INT, UINT) override { commandCount++; }
+	};
+
+	ID3D12RootSignature rootSignatures[2];
+	ID3D12PipelineState pipelineStates[2];
+	ID3D12DescriptorHeap descriptorHeaps[2];
+
+	// --- 同じ値の再設定だけが捨てられる ---
+	void TestRedundantState()
+	{
+		RecordingCommandList commandList;
+		CommandContext context;
+		context.Initialize(&commandList);
+
+		context.SetGraphicsRootSignature(&rootSignatures[0]);
+		context.SetGraphicsRootSignature(&rootSignatures[0]);
+		context.SetPipelineState(&pipelineStates[0]);
+		context.SetPipelineState(&pipelineStates[0]);
+		context.SetPipelineState(&pipelineStates[1]);
+		context.IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+		context.IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+		CHECK(context.GetStatistics().issued == 4);
+		CHECK(context.GetStatistics().skipped == 3);
+		CHECK(commandList.commandCount == 4);
+		CHECK(context.GetRootSignature() == &rootSignatures[0]);
+		CHECK(context.GetPipelineState() == &pipelineStates[1]);
+
+		// 描画は毎回発行する
+		context.DrawInstanced(3, 1, 0, 0);
+		context.DrawInstanced(3, 1, 0, 0);
+		context.DrawIndexedInstanced(6, 1, 0, 0, 0);
+		CHECK(commandList.commandCount == 7);
+		CHECK(context.GetStatistics().skipped == 3);
+	}
+
+	// --- 頂点・インデックスバッファは中身で比べる ---
+	void TestBufferViews()
+	{
+		RecordingCommandList commandList;
+		CommandContext context;
+		context.Initialize(&commandList);
+
+		D3D12_VERTEX_BUFFER_VIEW vertexBuffer = { 0x1000, 256, 32 };
+		context.IASetVertexBuffers(0, 1, &vertexBuffer);
+		D3D12_VERTEX_BUFFER_VIEW sameVertexBuffer = vertexBuffer;
+		context.IASetVertexBuffers(0, 1, &sameVertexBuffer);
+		CHECK(commandList.commandCount == 1);
+
+		// 大きさが違えば別のバッファ
+		sameVertexBuffer.SizeInBytes = 128;
+		context.IASetVertexBuffers(0, 1, &sameVertexBuffer);
+		CHECK(commandList.commandCount == 2);
+
+		// 0番スロット以外は保持しないので毎回発行する
+		D3D12_VERTEX_BUFFER_VIEW vertexBuffers[2] = { vertexBuffer, vertexBuffer };
+		context.IASetVertexBuffers(0, 2, vertexBuffers);
+		context.IASetVertexBuffers(0, 2, vertexBuffers);
+		CHECK(commandList.commandCount == 4);
+		// 保持していないので0番スロット1つでも発行する
+		context.IASetVertexBuffers(0, 1, &vertexBuffer);
+		CHECK(commandList.commandCount == 5);
+
+		D3D12_INDEX_BUFFER_VIEW indexBuffer = { 0x2000, 64, DXGI_FORMAT_R32_UINT };
+		context.IASetIndexBuffer(&indexBuffer);
+		context.IASetIndexBuffer(&indexBuffer);
+		CHECK(commandList.commandCount == 6);
+		indexBuffer.Format = DXGI_FORMAT_R16_UINT;
+		context.IASetIndexBuffer(&indexBuffer);
+		CHECK(commandList.commandCount == 7);
+	}
+
+	// --- ルート引数はルートシグネチャ・ヒープが変わると設定し直す ---
+	void TestRootArguments()
+	{
+		RecordingCommandList commandList;
+		CommandContext context;
+		context.Initialize(&commandList);
+
+		context.SetGraphicsRootSignature(&rootSignatures[0]);
+		context.SetGraphicsRootConstantBufferView(0, 0x100);
+		context.SetGraphicsRootConstantBufferView(0, 0x100);
+		context.SetGraphicsRootDescriptorTable(2, { 0x300 });
+		context.SetGraphicsRootDescriptorTable(2, { 0x300 });
+		CHECK(commandList.commandCount == 3);
+
+		// ルートシグネチャが変わると全て未定義になる
+		context.SetGraphicsRootSignature(&rootSignatures[1]);
+		context.SetGraphicsRootConstantBufferView(0, 0x100);
+		context.SetGraphicsRootDescriptorTable(2, { 0x300 });
+		CHECK(commandList.commandCount == 6);
+
+		// ヒープが変わるとDescriptorTableを指し直す
+		ID3D12DescriptorHeap* heap = &descriptorHeaps[0];
+		context.SetDescriptorHeaps(1, &heap);
+		context.SetDescriptorHeaps(1, &heap);
+		CHECK(commandList.commandCount == 7);
+		context.SetGraphicsRootDescriptorTable(2, { 0x300 });
+		CHECK(commandList.commandCount == 8);
+
+		// 複数のヒープは保持しない
+		ID3D12DescriptorHeap* heaps[2] = { &descriptorHeaps[0], &descriptorHeaps[1] };
+		context.SetDescriptorHeaps(2, heaps);
+		context.SetDescriptorHeaps(2, heaps);
+		CHECK(commandList.commandCount == 10);
+	}
+
+	// --- 破棄・フレーム終了の後は全て発行し直す ---
+	void TestInvalidate()
+	{
+		RecordingCommandList commandList;
+		CommandContext context;
+		context.Initialize(&commandList);
+
+		context.SetPipelineState(&pipelineStates[0]);
+		context.SetGraphicsRootConstantBufferView(1, 0x100);
+		context.Invalidate();
+		CHECK(context.GetPipelineState() == nullptr);
+		context.SetPipelineState(&pipelineStates[0]);
+		context.SetGraphicsRootConstantBufferView(1, 0x100);
+		CHECK(commandList.commandCount == 4);
+
+		// フレーム終了で統計が前フレーム分になる
+		context.SetPipelineState(&pipelineStates[0]);
+		context.EndFrame();
+		CHECK(context.GetLastFrameStatistics().issued == 4);
+		CHECK(context.GetLastFrameStatistics().skipped == 1);
+		CHECK(context.GetStatistics().issued == 0);
+		context.SetPipelineState(&pipelineStates[0]);
+		CHECK(commandList.commandCount == 5);
+	}
+
+	// --- コマンドリストが無くても状態と統計だけ更新する ---
+	void TestRecordOnly()
+	{
+		CommandContext context;
+		context.Initialize(nullptr);
+		context.SetPipelineState(&pipelineStates[0]);
+		context.SetPipelineState(&pipelineStates[0]);
+		context.DrawInstanced(3, 1, 0, 0);
+		CHECK(context.GetPipelineState() == &pipelineStates[0]);
+		CHECK(context.GetStatistics().issued == 2);
+		CHECK(context.GetStatistics().skipped == 1);
+	}
+}
+
+int main()
+{
+	TestRedundantState();
+	TestBufferViews();
+	TestRootArguments();
+	TestInvalidate();
+	TestRecordOnly();
+	return Test::Finish("CommandContextTest");
+}
@@ -0,0 +1,133 @@
+#include <algorithm>
+#include <memory>
+#include <random>
+
+#include "BenchmarkCommon.h"
+#include "World.h"
+
+// 1M個のエンティティの移動更新
+// ECS(アーキタイプのチャンクを連続して回す)と、個別に確保したオブジェクトのポインタ配列(仮想関数で更新)の比較
+namespace
+{
+	const uint32_t kEntityCount = 1000000;
+	const float kDeltaTime = 1.0f / 60.0f;
+
+	struct Position {
+		float x = 0.0f, y = 0.0f, z = 0.0f;
+	};
+	struct Velocity {
+		float x = 0.0f, y = 0.0f, z = 0.0f;
+	};
+	// 更新では使わないコンポーネント(アーキタイプを分ける)
+	struct Health {
+		float value = 100.0f;
+	};
+	struct RenderInfo {
+		uint32_t modelIndex = 0;
+		float color[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+	};
+
+	// 従来のゲームオブジェクト(更新で使わないメンバも一緒に並ぶ)
+	class GameObject
+	{
+	public:
+		virtual ~GameObject() = default;
+		virtual void Update(float deltaTime) {
+			position.x += velocity.x * deltaTime;
+			position.y += velocity.y * deltaTime;
+			position.z += velocity.z * deltaTime;
+		}
+
+		Position position;
+		Velocity velocity;
+		Health health;
+		RenderInfo renderInfo;
+		float matrix[16] = {};
+	};
+
+	Velocity MakeVelocity(uint32_t i)
+	{
+		return { float(i % 7), float(i % 11) * 0.5f, -float(i % 5) };
+	}
+}
+
+int main()
+{
+	std::printf("%u entities (items = entities)\n", kEntityCount);
+
+	// --- ポインタ配列(確保順に回す場合と、生成・破棄を繰り返した後のように順番がばらばらな場合) ---
+	{
+		std::vector<std::unique_ptr<GameObject>> objects(kEntityCount);
+		for (uint32_t i = 0; i < kEntityCount; ++i) {
+			objects[i] = std::make_unique<GameObject>();
+			objects[i]->velocity = MakeVelocity(i);
+		}
+		double sequential = Benchmark::Measure(10, [&]() {
+			for (const std::unique_ptr<GameObject>& object : objects) {
+				object->Update(kDeltaTime);
+			}
+			Benchmark::Keep(uint64_t(objects[kEntityCount / 2]->position.x));
+		});
+		Benchmark::Report("pointer vector (allocation order)", sequential, kEntityCount);
+
+		std::shuffle(objects.begin(), objects.end(), std::mt19937(1));
+		double shuffled = Benchmark::Measure(10, [&]() {
+			for (const std::unique_ptr<GameObject>& object : objects) {
+				object->Update(kDeltaTime);
+			}
+			Benchmark::Keep(uint64_t(objects[kEntityCount / 2]->position.x));
+		});
+		Benchmark::Report("pointer vector (shuffled)", shuffled, kEntityCount);
+	}
+
+	// --- ECS(4種類のアーキタイプに分かれる) ---
+	World world;
+	for (uint32_t i = 0; i < kEntityCount; ++i) {
+		switch (i % 4) {
+		case 0: world.CreateEntity(Position{}, MakeVelocity(i)); break;
+		case 1: world.CreateEntity(Position{}, MakeVelocity(i), Health{}); break;
+		case 2: world.CreateEntity(Position{}, MakeVelocity(i), RenderInfo{}); break;
+		default: world.CreateEntity(Position{}, MakeVelocity(i), Health{}, RenderInfo{}); break;
+		}
+	}
+
+	double forEach = Benchmark::Measure(10, [&]() {
+		world.ForEach<Position, Velocity>([](Position& position, const Velocity& velocity) {
+			position.x += velocity.x * kDeltaTime;
+			position.y += velocity.y * kDeltaTime;
+			position.z += velocity.z * kDeltaTime;
+		});
+	});
+	Benchmark::Report("World::ForEach", forEach, kEntityCount);
+
+	double forEachChunk = Benchmark::Measure(10, [&]() {
+		world.ForEachChunk<Position, Velocity>([](uint32_t count, Entity*, Position* positions, Velocity* velocities) {
+			for (uint32_t i = 0; i < count; ++i) {
+				positions[i].x += velocities[i].x * kDeltaTime;
+				positions[i].y += velocities[i].y * kDeltaTime;
+				positions[i].z += velocities[i].z * kDeltaTime;
+			}
+		});
+	});
+	Benchmark::Report("World::ForEachChunk", forEachChunk, kEntityCount);
+
+	uint32_t maxThreads = (std::max)(1u, std::thread::hardware_concurrency());
+	for (uint32_t threadCount = 1; threadCount <= maxThreads; threadCount *= 2) {
+		ThreadPool threadPool(threadCount);
+		double parallel = Benchmark::Measure(10, [&]() {
+			world.ParallelForEach<Position, Velocity>(threadPool, [](Position& position, const Velocity& velocity) {
+				position.x += velocity.x * kDeltaTime;
+				position.y += velocity.y * kDeltaTime;
+				position.z += velocity.z * kDeltaTime;
+			});
+		});
+		char name[64];
+		std::snprintf(name, sizeof(name), "World::ParallelForEach threads=%u", threadCount);
+		Benchmark::Report(name, parallel, kEntityCount);
+	}
+
+	uint64_t sum = 0;
+	world.ForEach<Position>([&sum](const Position& position) { sum += uint64_t(position.x); });
+	Benchmark::Keep(sum);
+	return 0;
+}
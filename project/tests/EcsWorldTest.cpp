@@ -0,0 +1,213 @@
+#include "World.h"
+#include "TestCommon.h"
+
+#include <map>
+#include <optional>
+#include <random>
+#include <string>
+
+namespace {
+	struct Position {
+		float x = 0.0f;
+	};
+	struct Velocity {
+		float x = 0.0f;
+	};
+	// 構築・破棄の数を数える(移動で二重に破棄・取りこぼしがないか)
+	struct Name {
+		static inline int liveCount = 0;
+		std::string value;
+		explicit Name(std::string value) : value(std::move(value)) { liveCount++; }
+		Name(const Name& other) : value(other.value) { liveCount++; }
+		Name(Name&& other) noexcept : value(std::move(other.value)) { liveCount++; }
+		Name& operator=(const Name&) = default;
+		Name& operator=(Name&&) = default;
+		~Name() { liveCount--; }
+	};
+	// チャンクをまたぐように大きくする
+	struct Payload {
+		float data[60] = {};
+	};
+
+	// 比較用の素直な実装
+	struct Reference {
+		std::optional<float> position;
+		std::optional<float> velocity;
+		std::optional<std::string> name;
+		bool hasPayload = false;
+	};
+
+	// --- ランダムな操作の結果が素直な実装と一致する ---
+	void TestRandomOperations()
+	{
+		std::mt19937 rng(11);
+		World world;
+		std::map<uint32_t, std::pair<Entity, Reference>> reference;
+		std::vector<Entity> destroyed;
+		int mismatchCount = 0;
+
+		auto pickAlive = [&]() {
+			auto it = reference.begin();
+			std::advance(it, rng() % reference.size());
+			return it;
+			};
+
+		for (int step = 0; step < 20000; ++step) {
+			uint32_t operation = reference.empty() ? 0 : rng() % 8;
+			float value = float(step);
+			if (operation <= 1) {
+				// 生成(組み合わせはいくつかの型から選ぶ)
+				Entity entity;
+				Reference ref;
+				switch (rng() % 4) {
+				case 0:
+					entity = world.CreateEntity(Position{ value });
+					ref.position = value;
+					break;
+				case 1:
+					entity = world.CreateEntity(Position{ value }, Velocity{ -value });
+					ref.position = value;
+					ref.velocity = -value;
+					break;
+				case 2:
+					entity = world.CreateEntity(Name(std::to_string(step)), Position{ value });
+					ref.name = std::to_string(step);
+					ref.position = value;
+					break;
+				default:
+					entity = world.CreateEntity(Payload{}, Velocity{ value });
+					ref.hasPayload = true;
+					ref.velocity = value;
+					break;
+				}
+				reference[entity.index] = { entity, ref };
+			}
+			else if (operation == 2) {
+				// 破棄
+				auto it = pickAlive();
+				world.DestroyEntity(it->second.first);
+				destroyed.push_back(it->second.first);
+				reference.erase(it);
+			}
+			else if (operation == 3) {
+				auto it = pickAlive();
+				world.AddComponent(it->second.first, Velocity{ value });
+				it->second.second.velocity = value;
+			}
+			else if (operation == 4) {
+				auto it = pickAlive();
+				world.RemoveComponent<Velocity>(it->second.first);
+				it->second.second.velocity.reset();
+			}
+			else if (operation == 5) {
+				auto it = pickAlive();
+				world.AddComponent(it->second.first, Name(std::to_string(-step)));
+				it->second.second.name = std::to_string(-step);
+			}
+			else if (operation == 6) {
+				auto it = pickAlive();
+				world.RemoveComponent<Name>(it->second.first);
+				it->second.second.name.reset();
+			}
+			else {
+				auto it = pickAlive();
+				world.RemoveComponent<Position>(it->second.first);
+				it->second.second.position.reset();
+			}
+		}
+
+		// --- 全てのエンティティのコンポーネントを比べる ---
+		for (const auto& [index, item] : reference) {
+			const auto& [entity, ref] = item;
+			Position* position = world.GetComponent<Position>(entity);
+			Velocity* velocity = world.GetComponent<Velocity>(entity);
+			Name* name = world.GetComponent<Name>(entity);
+			bool isMatch = world.IsAlive(entity) &&
+				(position ? ref.position && position->x == *ref.position : !ref.position) &&
+				(velocity ? ref.velocity && velocity->x == *ref.velocity : !ref.velocity) &&
+				(name ? ref.name && name->value == *ref.name : !ref.name) &&
+				world.HasComponent<Payload>(entity) == ref.hasPayload;
+			mismatchCount += isMatch ? 0 : 1;
+		}
+		CHECK(mismatchCount == 0);
+		CHECK(world.GetEntityCount() == reference.size());
+
+		// 破棄したエンティティは(スロットが再利用されていても)無効
+		int aliveDestroyedCount = 0;
+		for (const Entity& entity : destroyed) {
+			aliveDestroyedCount += world.IsAlive(entity) ? 1 : 0;
+		}
+		CHECK(aliveDestroyedCount == 0);
+
+		// Nameの構築と破棄が釣り合っている
+		int nameCount = 0;
+		for (const auto& [index, item] : reference) {
+			nameCount += item.second.name ? 1 : 0;
+		}
+		CHECK(Name::liveCount == nameCount);
+
+		// --- 巡回で全て見つかる ---
+		size_t positionCount = 0;
+		size_t bothCount = 0;
+		for (const auto& [index, item] : reference) {
+			positionCount += item.second.position ? 1 : 0;
+			bothCount += item.second.position && item.second.velocity ? 1 : 0;
+		}
+		size_t visited = 0;
+		world.ForEach<Position>([&visited](Position&) { visited++; });
+		CHECK(visited == positionCount);
+		visited = 0;
+		int wrongEntityCount = 0;
+		world.ForEach<Position, Velocity>([&](Entity entity, Position& position, Velocity&) {
+			visited++;
+			wrongEntityCount += world.GetComponent<Position>(entity) == &position ? 0 : 1;
+			});
+		CHECK(visited == bothCount);
+		CHECK(wrongEntityCount == 0);
+		visited = 0;
+		world.ForEachChunk<Position, Velocity>([&visited](uint32_t count, Entity*, Position*, Velocity*) { visited += count; });
+		CHECK(visited == bothCount);
+
+		// --- 全て破棄 ---
+		world.Clear();
+		CHECK(world.GetEntityCount() == 0);
+		CHECK(Name::liveCount == 0);
+		CHECK(!world.IsAlive(reference.begin()->second.first));
+	}
+
+	// --- 並列巡回は全てのエンティティを1回ずつ処理する ---
+	void TestParallelForEach()
+	{
+		World world;
+		const int kEntityCount = 50000;
+		for (int i = 0; i < kEntityCount; ++i) {
+			if (i % 3 == 0) {
+				world.CreateEntity(Position{ float(i) }, Velocity{ 1.0f });
+			}
+			else {
+				world.CreateEntity(Position{ float(i) }, Velocity{ 1.0f }, Payload{});
+			}
+		}
+		ThreadPool threadPool(4);
+		world.ParallelForEach<Position, Velocity>(threadPool, [](Position& position, const Velocity& velocity) {
+			position.x += velocity.x;
+			});
+
+		double sum = 0.0;
+		size_t count = 0;
+		world.ForEach<Position>([&](const Position& position) {
+			sum += position.x;
+			count++;
+			});
+		double expected = double(kEntityCount) * double(kEntityCount - 1) / 2.0 + kEntityCount;
+		CHECK(count == size_t(kEntityCount));
+		CHECK(sum == expected);
+	}
+}
+
+int main()
+{
+	TestRandomOperations();
+	TestParallelForEach();
+	return Test::Finish("EcsWorldTest");
+}
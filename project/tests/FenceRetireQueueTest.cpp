@@ -0,0 +1,193 @@
+#include "FenceRetireQueue.h"
+#include "SizedFreeList.h"
+#include "TestCommon.h"
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace {
+	// GPUの代わりのフェンス(Signalした値は、Completeで指定した値まで終わったことにする)
+	struct FakeFence {
+		uint64_t signaledValue = 0;
+		uint64_t completedValue = 0;
+		uint64_t Signal() { return ++signaledValue; }
+		void Complete(uint64_t value) { completedValue = (std::max)(completedValue, (std::min)(value, signaledValue)); }
+	};
+
+	std::vector<int> RetireAll(FenceRetireQueue<int>& queue, uint64_t completedFenceValue) {
+		std::vector<int> retired;
+		queue.Retire(completedFenceValue, [&retired](int item) { retired.push_back(item); });
+		return retired;
+	}
+
+	// --- 積んだ順に、終わったフェンス値の分だけ取り出す ---
+	void TestInOrderRetire()
+	{
+		FenceRetireQueue<int> queue;
+		CHECK(queue.IsEmpty());
+		CHECK(RetireAll(queue, 100).empty());
+
+		FakeFence fence;
+		for (int i = 0; i < 5; ++i) {
+			queue.Push(fence.Signal(), i);
+		}
+		CHECK(queue.GetPendingCount() == 5);
+
+		// まだ何も終わっていない
+		CHECK(RetireAll(queue, fence.completedValue).empty());
+
+		// 全て終われば古い順に出てくる
+		fence.Complete(5);
+		CHECK(RetireAll(queue, fence.completedValue) == std::vector<int>({ 0, 1, 2, 3, 4 }));
+		CHECK(queue.IsEmpty());
+	}
+
+	// --- 途中のフェンス値ではそこまでだけ ---
+	void TestPartialRetire()
+	{
+		FenceRetireQueue<int> queue;
+		for (int i = 1; i <= 10; ++i) {
+			queue.Push(uint64_t(i) * 10, i);
+		}
+		// 値の間で止まる
+		CHECK(RetireAll(queue, 35) == std::vector<int>({ 1, 2, 3 }));
+		CHECK(queue.GetPendingCount() == 7);
+		// 同じ値でもう一度呼んでも何も出ない
+		CHECK(RetireAll(queue, 35).empty());
+		// ちょうどの値は終わっている
+		CHECK(RetireAll(queue, 40) == std::vector<int>({ 4 }));
+		// 戻ったフェンス値(古い値)では何も出ない
+		CHECK(RetireAll(queue, 20).empty());
+		CHECK(RetireAll(queue, UINT64_MAX).size() == 6);
+	}
+
+	// --- 同じフェンス値で積んだものはまとめて出る ---
+	void TestRepeatedValues()
+	{
+		FenceRetireQueue<std::unique_ptr<int>> queue;
+		// 1フレームに何度もアップロードすると同じフェンス値になる
+		for (int i = 0; i < 3; ++i) {
+			queue.Push(7, std::make_unique<int>(i));
+		}
+		for (int i = 3; i < 5; ++i) {
+			queue.Push(8, std::make_unique<int>(i));
+		}
+		std::vector<int> retired;
+		auto collect = [&retired](std::unique_ptr<int> item) { retired.push_back(*item); };
+		CHECK(queue.Retire(6, collect) == 0);
+		CHECK(queue.Retire(7, collect) == 3);
+		CHECK(retired == std::vector<int>({ 0, 1, 2 }));
+		// 終わった値と同じ値で後から積んでも、次のRetireで出る
+		queue.Push(8, std::make_unique<int>(5));
+		CHECK(queue.Retire(8, collect) == 3);
+		CHECK(retired == std::vector<int>({ 0, 1, 2, 3, 4, 5 }));
+		CHECK(queue.IsEmpty());
+	}
+
+	// --- 大きさで選ぶ再利用 ---
+	void TestSizedFreeList()
+	{
+		SizedFreeList<int> freeList(4);
+		int item = -1;
+		CHECK(!freeList.Take(1, item));
+
+		freeList.Add(64, 0);
+		freeList.Add(256, 1);
+		freeList.Add(1024, 2);
+		freeList.Add(256, 3);
+		CHECK(freeList.GetFreeBytes() == 64 + 256 + 1024 + 256);
+
+		// 入る中で最も小さいもの
+		CHECK(freeList.Take(100, item) && (item == 1 || item == 3));
+		// ちょうどの大きさも使える
+		CHECK(freeList.Take(256, item) && (item == 1 || item == 3));
+		// 4倍を超える大きさは使わない(1024 > 200 * 4)
+		CHECK(!freeList.Take(200, item));
+		CHECK(freeList.Take(256, item) && item == 2);
+		// 入るものが無い
+		CHECK(!freeList.Take(2048, item));
+		CHECK(freeList.GetFreeCount() == 1);
+		CHECK(freeList.GetFreeBytes() == 64);
+
+		// 上限を超えた分は大きいものから捨てる
+		freeList.Add(512, 4);
+		freeList.Add(128, 5);
+		CHECK(freeList.Trim(200) == 1);
+		CHECK(freeList.GetFreeBytes() == 64 + 128);
+		CHECK(freeList.Trim(0) == 2);
+		CHECK(freeList.GetFreeCount() == 0);
+	}
+
+	// --- StagingPoolと同じ流れ(返却→フェンス待ち→空き→再利用)をフェンスを遅らせて回す ---
+	void TestStagingFlow()
+	{
+		// GPUが使い終わるフェンス値を持つバッファ
+		struct Buffer {
+			uint64_t size = 0;
+			uint64_t lastFenceValue = 0;
+		};
+		const uint64_t kAlignment = 64 * 1024;
+		const uint64_t kMaxFreeBytes = 4 * 1024 * 1024;
+
+		FakeFence fence;
+		FenceRetireQueue<std::unique_ptr<Buffer>> pending;
+		SizedFreeList<std::unique_ptr<Buffer>> freeList(4);
+		std::mt19937 rng(5);
+		uint32_t createdCount = 0;
+		uint32_t reusedCount = 0;
+		uint32_t reusedInFlightCount = 0;
+		uint32_t overLimitCount = 0;
+
+		for (int frame = 0; frame < 500; ++frame) {
+			uint64_t fenceValue = fence.Signal();
+			int uploadCount = int(rng() % 4);
+			for (int i = 0; i < uploadCount; ++i) {
+				uint64_t size = (uint64_t(rng() % (1024 * 1024)) + kAlignment - 1) / kAlignment * kAlignment;
+				std::unique_ptr<Buffer> buffer;
+				if (freeList.Take(size, buffer)) {
+					reusedCount++;
+					// 再利用するものはGPUが使い終わっている
+					reusedInFlightCount += buffer->lastFenceValue > fence.completedValue ? 1 : 0;
+				}
+				else {
+					buffer = std::make_unique<Buffer>();
+					buffer->size = size;
+					createdCount++;
+				}
+				buffer->lastFenceValue = fenceValue;
+				pending.Push(fenceValue, std::move(buffer));
+			}
+
+			// GPUは2フレーム遅れで、たまにさらに遅れる
+			if (fence.signaledValue > 2 && rng() % 5 != 0) {
+				fence.Complete(fence.signaledValue - 2);
+			}
+			pending.Retire(fence.completedValue, [&freeList](std::unique_ptr<Buffer> buffer) {
+				uint64_t size = buffer->size;
+				freeList.Add(size, std::move(buffer));
+				});
+			freeList.Trim(kMaxFreeBytes);
+			overLimitCount += freeList.GetFreeBytes() > kMaxFreeBytes ? 1 : 0;
+		}
+		CHECK(reusedInFlightCount == 0);
+		CHECK(overLimitCount == 0);
+		CHECK(reusedCount > createdCount);
+
+		// 全て終われば待ちは空になる
+		fence.Complete(fence.signaledValue);
+		pending.Retire(fence.completedValue, [](std::unique_ptr<Buffer>) {});
+		CHECK(pending.IsEmpty());
+	}
+}
+
+int main()
+{
+	TestInOrderRetire();
+	TestPartialRetire();
+	TestRepeatedValues();
+	TestSizedFreeList();
+	TestStagingFlow();
+	return Test::Finish("FenceRetireQueueTest");
+}
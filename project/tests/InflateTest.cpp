@@ -0,0 +1,190 @@
+#include "Inflate.h"
+#include <algorithm>
+#include <cstdio>
+#include <string>
+
+#include "TestCommon.h"
+
+namespace
+{
+	// --- 期待するデータ ---
+	// 固定ハフマン: 距離3の繰り返しと距離1の重なったコピー
+	std::vector<uint8_t> MakeFixedData()
+	{
+		std::string text = "abcabcabcabcabcabc" + std::string(40, 'a') + "xyz";
+		return std::vector<uint8_t>(text.begin(), text.end());
+	}
+	// 動的ハフマン: 番号付きの行の繰り返し
+	std::vector<uint8_t> MakeDynamicData()
+	{
+		std::string text;
+		for (int i = 0; i < 20; ++i) {
+			char line[64];
+			std::snprintf(line, sizeof(line), "line %d: the quick brown fox jumps over the lazy dog\n", i);
+			text += line;
+		}
+		return std::vector<uint8_t>(text.begin(), text.end());
+	}
+
+	// --- 上のデータをzlib(レベル9)で圧縮したもの ---
+	// 最初のブロックはBTYPE=1(固定ハフマン)
+	const std::vector<uint8_t> kFixedStream = {
+		0x78, 0xDA, 0x4B, 0x4C, 0x4A, 0x4E, 0x44, 0x43, 0x44, 0x82, 0x8A, 0xCA, 0x2A, 0x00, 0xD1, 0x11, 0x17, 0x78,
+	};
+	// 最初のブロックはBTYPE=2(動的ハフマン)
+	const std::vector<uint8_t> kDynamicStream = {
+		0x78, 0xDA, 0x9D, 0xD2, 0x5D, 0x16, 0x42, 0x50, 0x18, 0x85, 0xE1, 0x7B, 0xA3, 0xF8, 0x86, 0x60,
+		0x4B, 0x3F, 0x9A, 0x8D, 0x38, 0x4A, 0x0E, 0x27, 0x0A, 0x65, 0xF4, 0x96, 0x66, 0xE0, 0xBD, 0xDE,
+		0xEB, 0xBD, 0xDA, 0x8F, 0xAF, 0x3B, 0x67, 0xF1, 0xD5, 0x3E, 0x0F, 0x67, 0xFD, 0x58, 0x17, 0x8D,
+		0xDD, 0x86, 0x30, 0x77, 0x56, 0x85, 0xAF, 0x3D, 0xC7, 0xF6, 0xF5, 0xB6, 0x30, 0xB9, 0xE1, 0x3F,
+		0xFB, 0x7C, 0xF9, 0x59, 0x19, 0xEE, 0x91, 0xDF, 0x1A, 0x81, 0x26, 0x01, 0xCD, 0x01, 0x34, 0x29,
+		0x68, 0x8E, 0xA0, 0x39, 0x81, 0xE6, 0x0C, 0x9A, 0x0B, 0x68, 0x32, 0xF2, 0x29, 0x82, 0x40, 0x24,
+		0x88, 0x50, 0x10, 0xB1, 0x20, 0x82, 0x41, 0x44, 0x83, 0x08, 0x07, 0x11, 0x0F, 0x22, 0x20, 0xB4,
+		0x53, 0xC4, 0x0A, 0xAF, 0x3E, 0x70, 0xF8,
+	};
+
+	// 非圧縮ブロックだけのDeflateストリームを作る(blockSizeごとに区切る)
+	std::vector<uint8_t> MakeStored(const std::vector<uint8_t>& data, size_t blockSize)
+	{
+		std::vector<uint8_t> stream;
+		size_t offset = 0;
+		do {
+			size_t length = (std::min)(blockSize, data.size() - offset);
+			bool isFinal = offset + length == data.size();
+			stream.push_back(isFinal ? 1 : 0);
+			stream.push_back(uint8_t(length));
+			stream.push_back(uint8_t(length >> 8));
+			stream.push_back(uint8_t(~length));
+			stream.push_back(uint8_t(~length >> 8));
+			stream.insert(stream.end(), data.begin() + offset, data.begin() + offset + length);
+			offset += length;
+		} while (offset < data.size());
+		return stream;
+	}
+
+	void TestStored()
+	{
+		std::vector<uint8_t> data(70000);
+		for (size_t i = 0; i < data.size(); ++i) {
+			data[i] = uint8_t(i * 7 % 251);
+		}
+
+		// 複数ブロック(1ブロックは最大65535バイト)
+		for (size_t blockSize : { size_t(65535), size_t(40000), size_t(1000) }) {
+			std::vector<uint8_t> out;
+			CHECK(Inflate::Decompress(MakeStored(data, blockSize), out));
+			CHECK(out == data);
+		}
+
+		// 空のブロック
+		std::vector<uint8_t> out;
+		CHECK(Inflate::Decompress(MakeStored({}, 1), out));
+		CHECK(out.empty());
+
+		// 既にあるdstの末尾に追加される
+		out = { 1, 2, 3 };
+		std::vector<uint8_t> small = { 9, 8 };
+		CHECK(Inflate::Decompress(MakeStored(small, 16), out));
+		CHECK(out == std::vector<uint8_t>({ 1, 2, 3, 9, 8 }));
+	}
+
+	void TestFixed()
+	{
+		CHECK(((kFixedStream[2] >> 1) & 3) == 1);
+		std::vector<uint8_t> out;
+		CHECK(Inflate::DecompressZlib(kFixedStream, out));
+		CHECK(out == MakeFixedData());
+	}
+
+	void TestDynamic()
+	{
+		CHECK(((kDynamicStream[2] >> 1) & 3) == 2);
+		std::vector<uint8_t> out;
+		CHECK(Inflate::DecompressZlib(kDynamicStream, out));
+		CHECK(out == MakeDynamicData());
+	}
+
+	void TestMaxSize()
+	{
+		const std::vector<uint8_t> expected = MakeDynamicData();
+		std::vector<uint8_t> out;
+
+		// ちょうどの大きさは通る
+		CHECK(Inflate::DecompressZlib(kDynamicStream, out, expected.size()));
+		CHECK(out == expected);
+
+		// 1バイトでも超えれば失敗(リテラル・一致・非圧縮のどれで超えても)
+		out.clear();
+		CHECK(!Inflate::DecompressZlib(kDynamicStream, out, expected.size() - 1));
+		CHECK(out.size() <= expected.size() - 1);
+		out.clear();
+		CHECK(!Inflate::DecompressZlib(kFixedStream, out, 10));
+		CHECK(out.size() <= 10);
+		std::vector<uint8_t> stored(100, 0x55);
+		out.clear();
+		CHECK(!Inflate::Decompress(MakeStored(stored, 100), out, 99));
+		CHECK(out.size() <= 99);
+
+		// 上限はdstに追加する分に対してかかる
+		out.assign(1000, 0);
+		CHECK(Inflate::Decompress(MakeStored(stored, 100), out, 100));
+		CHECK(out.size() == 1100);
+	}
+
+	void TestCorrupt()
+	{
+		std::vector<uint8_t> out;
+
+		// BTYPE=3は予約
+		const std::vector<uint8_t> reserved = { 0x07, 0x00 };
+		CHECK(!Inflate::Decompress(reserved, out));
+
+		// 非圧縮ブロックのLENとNLENが合わない
+		std::vector<uint8_t> stored = MakeStored({ 1, 2, 3, 4 }, 16);
+		stored[3] ^= 1;
+		out.clear();
+		CHECK(!Inflate::Decompress(stored, out));
+
+		// 非圧縮ブロックのデータが足りない
+		stored = MakeStored({ 1, 2, 3, 4 }, 16);
+		stored.pop_back();
+		out.clear();
+		CHECK(!Inflate::Decompress(stored, out));
+
+		// 出力より前を指す距離(固定ハフマン: 長さ3・距離1を最初に置く)
+		// BFINAL=1,BTYPE=01 / 長さ符号257(0000001) / 距離符号0(00000)
+		const std::vector<uint8_t> farDistance = { 0x03, 0x02, 0x00, 0x00 };
+		out.clear();
+		CHECK(!Inflate::Decompress(farDistance, out));
+
+		// 途中で切れたストリーム
+		for (size_t length : { size_t(3), kDynamicStream.size() / 2, kDynamicStream.size() - 5 }) {
+			std::vector<uint8_t> truncated(kDynamicStream.begin(), kDynamicStream.begin() + length);
+			out.clear();
+			CHECK(!Inflate::DecompressZlib(truncated, out));
+		}
+
+		// zlibヘッダが不正(圧縮方式が8でない・チェック値が合わない・短い)
+		std::vector<uint8_t> badMethod = kFixedStream;
+		badMethod[0] = 0x79;
+		out.clear();
+		CHECK(!Inflate::DecompressZlib(badMethod, out));
+		std::vector<uint8_t> badCheck = kFixedStream;
+		badCheck[1] ^= 1;
+		out.clear();
+		CHECK(!Inflate::DecompressZlib(badCheck, out));
+		const std::vector<uint8_t> tooShort = { 0x78 };
+		out.clear();
+		CHECK(!Inflate::DecompressZlib(tooShort, out));
+	}
+}
+
+int main()
+{
+	TestStored();
+	TestFixed();
+	TestDynamic();
+	TestMaxSize();
+	TestCorrupt();
+	return Test::Finish("InflateTest");
+}
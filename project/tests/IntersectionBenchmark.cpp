@@ -0,0 +1,181 @@
+#include <random>
+#include <vector>
+
+#include "BenchmarkCommon.h"
+#include "CalculateMath.h"
+#include "Intersection.h"
+
+// 判定の速さ(1秒あたりの判定数)
+// 1つずつ判定するものと、4つまとめて(SoA・SIMD)判定するものの比較
+namespace
+{
+	const uint32_t kShapeCount = 1 << 18;
+	const int kTrialCount = 10;
+
+	std::mt19937 rng(1);
+	float Random(float min, float max) { return std::uniform_real_distribution<float>(min, max)(rng); }
+	Vector3 RandomVector(float min, float max) { return { Random(min, max), Random(min, max), Random(min, max) }; }
+
+	// 形状を並べたもの(1つずつ用と4つまとめた用の両方)
+	struct Shapes {
+		std::vector<Triangle> triangles;
+		std::vector<AABB> aabbs;
+		std::vector<Sphere> spheres;
+		std::vector<TriangleX4> triangleX4s;
+		std::vector<AABBX4> aabbX4s;
+		std::vector<SphereX4> sphereX4s;
+	};
+
+	// 範囲・視錐台の判定は半分くらいが当たるように散らす(半直線はほとんど外れる)
+	Shapes MakeShapes()
+	{
+		Shapes shapes;
+		shapes.triangleX4s.resize(kShapeCount / 4);
+		shapes.aabbX4s.resize(kShapeCount / 4);
+		shapes.sphereX4s.resize(kShapeCount / 4);
+		for (uint32_t i = 0; i < kShapeCount; ++i) {
+			Vector3 center = RandomVector(-20.0f, 20.0f);
+			Triangle triangle{ center + RandomVector(-2.0f, 2.0f), center + RandomVector(-2.0f, 2.0f), center + RandomVector(-2.0f, 2.0f) };
+			Vector3 extent = RandomVector(0.1f, 2.0f);
+			AABB aabb{ center - extent, center + extent };
+			Sphere sphere{ center, Random(0.1f, 2.0f) };
+			shapes.triangles.push_back(triangle);
+			shapes.aabbs.push_back(aabb);
+			shapes.spheres.push_back(sphere);
+			shapes.triangleX4s[i / 4].Set(i % 4, triangle);
+			shapes.aabbX4s[i / 4].Set(i % 4, aabb);
+			shapes.sphereX4s[i / 4].Set(i % 4, sphere);
+		}
+		return shapes;
+	}
+
+	// 1つずつと4つまとめたものを測って並べて出す(当たった数も出して同じ結果であることを見る)
+	template<typename Scalar, typename X4>
+	void Compare(const char* name, Scalar&& scalar, X4&& x4)
+	{
+		uint32_t scalarHits = 0;
+		double scalarSeconds = Benchmark::Measure(kTrialCount, [&]() {
+			scalarHits = scalar();
+			Benchmark::Keep(scalarHits);
+		});
+		uint32_t x4Hits = 0;
+		double x4Seconds = Benchmark::Measure(kTrialCount, [&]() {
+			x4Hits = x4();
+			Benchmark::Keep(x4Hits);
+		});
+		char label[80];
+		std::snprintf(label, sizeof(label), "%s scalar (hits %u)", name, scalarHits);
+		Benchmark::Report(label, scalarSeconds, kShapeCount);
+		std::snprintf(label, sizeof(label), "%s x4 (hits %u)", name, x4Hits);
+		Benchmark::Report(label, x4Seconds, kShapeCount);
+	}
+
+	uint32_t CountBits(uint32_t mask) { return (mask & 1) + ((mask >> 1) & 1) + ((mask >> 2) & 1) + ((mask >> 3) & 1); }
+}
+
+int main()
+{
+	Shapes shapes = MakeShapes();
+	const Ray ray{ { -30.0f, 0.5f, 0.3f }, { 1.0f, 0.01f, -0.02f } };
+	const Sphere probe{ { 0.0f, 0.0f, 0.0f }, 15.0f };
+	Matrix4x4 view = Inverse(MakeAffineMatrix({ 1.0f, 1.0f, 1.0f }, { 0.2f, 0.4f, 0.0f }, { 0.0f, 2.0f, -30.0f }));
+	const Frustum frustum = MakeFrustum(view * MakePerspectiveFovMatrix(0.8f, 16.0f / 9.0f, 0.1f, 60.0f));
+	std::printf("%u shapes per pass (items = tests, M/s = million tests/sec)\n", kShapeCount);
+
+	// --- 半直線(ピッキング) ---
+	Compare("ray vs triangle",
+		[&]() {
+			uint32_t hits = 0;
+			float distance;
+			for (const Triangle& triangle : shapes.triangles) {
+				hits += IsCollision(ray, triangle, distance);
+			}
+			return hits;
+		},
+		[&]() {
+			uint32_t hits = 0;
+			float distances[4];
+			for (const TriangleX4& triangles : shapes.triangleX4s) {
+				hits += CountBits(IsCollision(ray, triangles, distances));
+			}
+			return hits;
+		});
+	Compare("ray vs AABB",
+		[&]() {
+			uint32_t hits = 0;
+			float distance;
+			for (const AABB& aabb : shapes.aabbs) {
+				hits += IsCollision(ray, aabb, distance);
+			}
+			return hits;
+		},
+		[&]() {
+			uint32_t hits = 0;
+			float distances[4];
+			for (const AABBX4& aabbs : shapes.aabbX4s) {
+				hits += CountBits(IsCollision(ray, aabbs, distances));
+			}
+			return hits;
+		});
+
+	// --- 球どうし(範囲攻撃など) ---
+	Compare("sphere vs sphere",
+		[&]() {
+			uint32_t hits = 0;
+			for (const Sphere& sphere : shapes.spheres) {
+				hits += IsCollision(probe, sphere);
+			}
+			return hits;
+		},
+		[&]() {
+			uint32_t hits = 0;
+			for (const SphereX4& spheres : shapes.sphereX4s) {
+				hits += CountBits(IsCollision(probe, spheres));
+			}
+			return hits;
+		});
+
+	// --- 視錐台カリング ---
+	Compare("sphere vs frustum",
+		[&]() {
+			uint32_t hits = 0;
+			for (const Sphere& sphere : shapes.spheres) {
+				hits += IsCollision(sphere, frustum);
+			}
+			return hits;
+		},
+		[&]() {
+			uint32_t hits = 0;
+			for (const SphereX4& spheres : shapes.sphereX4s) {
+				hits += CountBits(IsCollision(spheres, frustum));
+			}
+			return hits;
+		});
+	Compare("AABB vs frustum",
+		[&]() {
+			uint32_t hits = 0;
+			for (const AABB& aabb : shapes.aabbs) {
+				hits += IsCollision(aabb, frustum);
+			}
+			return hits;
+		},
+		[&]() {
+			uint32_t hits = 0;
+			for (const AABBX4& aabbs : shapes.aabbX4s) {
+				hits += CountBits(IsCollision(aabbs, frustum));
+			}
+			return hits;
+		});
+
+	// --- AABBどうし(4つまとめたものは無い) ---
+	const AABB box{ { -10.0f, -10.0f, -10.0f }, { 10.0f, 10.0f, 10.0f } };
+	double aabbSeconds = Benchmark::Measure(kTrialCount, [&]() {
+		uint32_t hits = 0;
+		for (const AABB& aabb : shapes.aabbs) {
+			hits += IsCollision(box, aabb);
+		}
+		Benchmark::Keep(hits);
+	});
+	Benchmark::Report("AABB vs AABB scalar", aabbSeconds, kShapeCount);
+	return 0;
+}
@@ -0,0 +1,150 @@
+#include "Intersection.h"
+#include "CalculateMath.h"
+#include "TestCommon.h"
+
+#include <cmath>
+#include <numbers>
+#include <random>
+
+namespace {
+	std::mt19937 rng(7);
+	float Random(float min, float max) { return std::uniform_real_distribution<float>(min, max)(rng); }
+	Vector3 RandomVector(float min, float max) { return { Random(min, max), Random(min, max), Random(min, max) }; }
+
+	Frustum MakeTestFrustum() {
+		Matrix4x4 view = Inverse(MakeAffineMatrix({ 1.0f, 1.0f, 1.0f }, { 0.3f, 0.5f, 0.0f }, { 1.0f, 2.0f, -10.0f }));
+		return MakeFrustum(view * MakePerspectiveFovMatrix(0.8f, 16.0f / 9.0f, 0.1f, 50.0f));
+	}
+
+	// --- 4つまとめた判定が1つずつの判定と完全に一致する(距離もビット単位で同じ) ---
+	void TestSimdMatchesScalar()
+	{
+		const int kCaseCount = 200000;
+		Frustum frustum = MakeTestFrustum();
+		int mismatchCount = 0;
+		long hitCounts[5] = {};
+
+		for (int i = 0; i < kCaseCount; ++i) {
+			// 軸に平行な半直線・厚さ0の箱も混ぜる(0除算の扱いがずれやすい)
+			Ray ray{ RandomVector(-5.0f, 5.0f), RandomVector(-1.0f, 1.0f) };
+			if (i % 7 == 0) {
+				ray.direction.y = 0.0f;
+			}
+			Triangle triangles[4];
+			AABB aabbs[4];
+			Sphere spheres[4];
+			TriangleX4 triangleX4;
+			AABBX4 aabbX4;
+			SphereX4 sphereX4;
+			for (uint32_t j = 0; j < 4; ++j) {
+				Vector3 center = RandomVector(-5.0f, 5.0f);
+				triangles[j] = { center + RandomVector(-2.0f, 2.0f), center + RandomVector(-2.0f, 2.0f), center + RandomVector(-2.0f, 2.0f) };
+				Vector3 extent = RandomVector(0.0f, 2.0f);
+				aabbs[j] = { center - extent, center + extent };
+				if (i % 5 == 0) {
+					aabbs[j].min.y = aabbs[j].max.y = ray.origin.y;
+				}
+				spheres[j] = { RandomVector(-30.0f, 30.0f), Random(0.0f, 5.0f) };
+				triangleX4.Set(j, triangles[j]);
+				aabbX4.Set(j, aabbs[j]);
+				sphereX4.Set(j, spheres[j]);
+			}
+
+			float distances[4];
+			uint32_t mask = IsCollision(ray, triangleX4, distances);
+			for (uint32_t j = 0; j < 4; ++j) {
+				float distance = 0.0f;
+				bool isHit = IsCollision(ray, triangles[j], distance);
+				hitCounts[0] += isHit;
+				mismatchCount += (isHit != bool(mask >> j & 1) || (isHit && distance != distances[j])) ? 1 : 0;
+			}
+
+			mask = IsCollision(ray, aabbX4, distances);
+			for (uint32_t j = 0; j < 4; ++j) {
+				float distance = 0.0f;
+				bool isHit = IsCollision(ray, aabbs[j], distance);
+				hitCounts[1] += isHit;
+				mismatchCount += (isHit != bool(mask >> j & 1) || (isHit && distance != distances[j])) ? 1 : 0;
+			}
+
+			mask = IsCollision(spheres[0], sphereX4);
+			for (uint32_t j = 0; j < 4; ++j) {
+				bool isHit = IsCollision(spheres[0], spheres[j]);
+				hitCounts[2] += j != 0 && isHit;
+				mismatchCount += isHit != bool(mask >> j & 1) ? 1 : 0;
+			}
+
+			mask = IsCollision(sphereX4, frustum);
+			for (uint32_t j = 0; j < 4; ++j) {
+				bool isHit = IsCollision(spheres[j], frustum);
+				hitCounts[3] += isHit;
+				mismatchCount += isHit != bool(mask >> j & 1) ? 1 : 0;
+			}
+
+			// 視錐台と交わるものが増えるよう箱を広げる
+			for (uint32_t j = 0; j < 4; ++j) {
+				aabbs[j].min = aabbs[j].min * 4.0f;
+				aabbs[j].max = aabbs[j].max * 4.0f;
+				aabbX4.Set(j, aabbs[j]);
+			}
+			mask = IsCollision(aabbX4, frustum);
+			for (uint32_t j = 0; j < 4; ++j) {
+				bool isHit = IsCollision(aabbs[j], frustum);
+				hitCounts[4] += isHit;
+				mismatchCount += isHit != bool(mask >> j & 1) ? 1 : 0;
+			}
+		}
+		CHECK(mismatchCount == 0);
+
+		// 当たり・外れの両方を試せている
+		for (long hitCount : hitCounts) {
+			CHECK(hitCount > 0);
+			CHECK(hitCount < long(kCaseCount) * 4);
+		}
+	}
+
+	// --- 1つずつの判定の基本 ---
+	void TestScalar()
+	{
+		float distance = 0.0f;
+		Ray ray{ { 0.0f, 0.0f, -5.0f }, { 0.0f, 0.0f, 2.0f } };
+		Triangle triangle{ { -1.0f, -1.0f, 0.0f }, { 1.0f, -1.0f, 0.0f }, { 0.0f, 1.0f, 0.0f } };
+		CHECK(IsCollision(ray, triangle, distance) && distance == 2.5f);
+		// 裏からも当たる・後ろには当たらない
+		CHECK(IsCollision(Ray{ { 0.0f, 0.0f, 5.0f }, { 0.0f, 0.0f, -1.0f } }, triangle, distance) && distance == 5.0f);
+		CHECK(!IsCollision(Ray{ { 0.0f, 0.0f, 5.0f }, { 0.0f, 0.0f, 1.0f } }, triangle, distance));
+
+		AABB box{ { -1.0f, -1.0f, -1.0f }, { 1.0f, 1.0f, 1.0f } };
+		CHECK(IsCollision(ray, box, distance) && distance == 2.0f);
+		// 始点が中なら0
+		CHECK(IsCollision(Ray{ {}, { 1.0f, 0.0f, 0.0f } }, box, distance) && distance == 0.0f);
+		// 接していれば重なり
+		CHECK(IsCollision(box, AABB{ { 1.0f, -1.0f, -1.0f }, { 2.0f, 1.0f, 1.0f } }));
+		CHECK(!IsCollision(box, AABB{ { 1.1f, -1.0f, -1.0f }, { 2.0f, 1.0f, 1.0f } }));
+
+		CHECK(IsCollision(Sphere{ {}, 1.0f }, Sphere{ { 1.5f, 0.0f, 0.0f }, 1.0f }));
+		CHECK(!IsCollision(Sphere{ {}, 1.0f }, Sphere{ { 2.5f, 0.0f, 0.0f }, 1.0f }));
+
+		// 回転した箱を囲む箱
+		Affine3x4 rotate = MakeAffine3x4({ 1.0f, 1.0f, 1.0f }, { 0.0f, 0.0f, std::numbers::pi_v<float> / 4.0f }, { 10.0f, 0.0f, 0.0f });
+		AABB rotated = Transform(box, rotate);
+		CHECK(std::fabs(rotated.max.x - (10.0f + std::sqrt(2.0f))) < 1e-5f);
+		CHECK(std::fabs(rotated.min.y + std::sqrt(2.0f)) < 1e-5f);
+		CHECK(rotated.max.z == 1.0f);
+
+		// カメラの前は中、後ろは外
+		Frustum frustum = MakeFrustum(MakePerspectiveFovMatrix(0.8f, 1.0f, 0.1f, 50.0f));
+		CHECK(IsCollision(Sphere{ { 0.0f, 0.0f, 10.0f }, 0.5f }, frustum));
+		CHECK(!IsCollision(Sphere{ { 0.0f, 0.0f, -10.0f }, 0.5f }, frustum));
+		CHECK(!IsCollision(Sphere{ { 0.0f, 0.0f, 60.0f }, 0.5f }, frustum));
+		CHECK(IsCollision(AABB{ { -1.0f, -1.0f, 5.0f }, { 1.0f, 1.0f, 6.0f } }, frustum));
+		CHECK(!IsCollision(AABB{ { 100.0f, -1.0f, 5.0f }, { 101.0f, 1.0f, 6.0f } }, frustum));
+	}
+}
+
+int main()
+{
+	TestSimdMatchesScalar();
+	TestScalar();
+	return Test::Finish("IntersectionTest");
+}
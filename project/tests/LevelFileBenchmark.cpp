@@ -0,0 +1,62 @@
+#include <fstream>
+#include <string>
+
+#include "BenchmarkCommon.h"
+#include "LevelFile.h"
+
+// 100kオブジェクトのレベルの読み込み
+// テキストの解析(Convert。変換前に毎回していたのと同じ量)と、変換済みバイナリのOpen(ヘッダと範囲の確認だけ)の比較
+namespace
+{
+	const uint32_t kObjectCount = 100000;
+	const uint32_t kModelCount = 200;
+
+	const std::filesystem::path kWorkDirectory = std::filesystem::temp_directory_path() / "LevelFileBenchmark";
+	const std::filesystem::path kLevelPath = kWorkDirectory / "stage.level";
+
+	void WriteText(const std::filesystem::path& path)
+	{
+		std::filesystem::create_directories(path.parent_path());
+		std::ofstream file(path, std::ios::trunc);
+		for (uint32_t i = 0; i < kModelCount; ++i) {
+			file << "model model" << i << ".obj\n";
+		}
+		for (uint32_t i = 0; i < 50; ++i) {
+			file << "texture resources/texture" << i << ".png\n";
+		}
+		for (uint32_t i = 0; i < kObjectCount; ++i) {
+			file << "object model" << (i * 7) % kModelCount << ".obj translate " << float(i % 100) << " 0.5 " << float(i / 100)
+				<< " rotate 0 " << float(i % 360) * 0.0174533f << " 0 scale 1 1 1\n";
+		}
+	}
+}
+
+int main()
+{
+	std::filesystem::path textPath = LevelFile::GetSourcePath(kLevelPath);
+	WriteText(textPath);
+	std::printf("%u objects, %u models (items = objects)\n", kObjectCount, kModelCount);
+
+	double convert = Benchmark::Measure(5, [&]() {
+		LevelFile::Convert(textPath, kLevelPath);
+	});
+	Benchmark::Report("Convert (parse text + write binary)", convert, kObjectCount);
+
+	// 読み込んで配置を1回なめる(シーンがオブジェクトを作るときと同じ)
+	LevelFile level;
+	double open = Benchmark::Measure(20, [&]() {
+		level.Open(kLevelPath);
+		double sum = 0.0;
+		for (const LevelFile::ObjectRecord& object : level.GetObjects()) {
+			sum += object.translate.x + object.modelIndex;
+		}
+		Benchmark::Keep(uint64_t(sum));
+	});
+	Benchmark::Report("Open binary + read objects", open, kObjectCount);
+
+	bool isValid = level.IsOpen() && level.GetObjects().size() == kObjectCount;
+	level.Close();
+	std::error_code ec;
+	std::filesystem::remove_all(kWorkDirectory, ec);
+	return isValid ? 0 : 1;
+}
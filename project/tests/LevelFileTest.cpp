@@ -0,0 +1,243 @@
+#include "LevelFile.h"
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "TestCommon.h"
+
+namespace
+{
+	// テスト用のファイルを置く場所
+	const std::filesystem::path kWorkDirectory = std::filesystem::temp_directory_path() / "LevelFileTest";
+	const std::filesystem::path kLevelPath = kWorkDirectory / "stage.level";
+	const std::filesystem::path kTextPath = LevelFile::GetSourcePath(kLevelPath);
+
+	const char* const kText =
+		"# テスト用のレベル\n"
+		"model    player.obj\n"
+		"model    enemy.obj   # 後ろのコメント\n"
+		"texture  resources/ground.png\n"
+		"texture  resources/sky.png\n"
+		"sound    bgm.wav\n"
+		"\n"
+		"object   player.obj translate 1 2 3\n"
+		"object   enemy.obj  translate -1 0 5 rotate 0 1.5 0 scale 2 2 2\n"
+		"object   enemy.obj\n"
+		"object   rock.obj   scale 0.5 0.5 0.5\n";
+
+	void WriteText(const std::filesystem::path& path, const std::string& text)
+	{
+		std::filesystem::create_directories(path.parent_path());
+		std::ofstream file(path, std::ios::binary | std::ios::trunc);
+		file.write(text.data(), std::streamsize(text.size()));
+	}
+
+	std::vector<uint8_t> ReadBinary(const std::filesystem::path& path)
+	{
+		std::ifstream file(path, std::ios::binary);
+		return { std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+	}
+
+	void WriteBinary(const std::filesystem::path& path, const std::vector<uint8_t>& data)
+	{
+		std::ofstream file(path, std::ios::binary | std::ios::trunc);
+		file.write(reinterpret_cast<const char*>(data.data()), std::streamsize(data.size()));
+	}
+
+	// 変換したバイナリの中の各領域
+	LevelFile::Header& HeaderOf(std::vector<uint8_t>& data)
+	{
+		return *reinterpret_cast<LevelFile::Header*>(data.data());
+	}
+	LevelFile::StringRef* NamesOf(std::vector<uint8_t>& data)
+	{
+		return reinterpret_cast<LevelFile::StringRef*>(data.data() + sizeof(LevelFile::Header));
+	}
+	LevelFile::ObjectRecord* ObjectsOf(std::vector<uint8_t>& data)
+	{
+		const LevelFile::Header& header = HeaderOf(data);
+		size_t nameBytes = size_t(header.modelCount + header.textureCount + header.soundCount) * sizeof(LevelFile::StringRef);
+		size_t offset = (sizeof(LevelFile::Header) + nameBytes + LevelFile::kAlignment - 1) / LevelFile::kAlignment * LevelFile::kAlignment;
+		return reinterpret_cast<LevelFile::ObjectRecord*>(data.data() + offset);
+	}
+
+	bool IsEqual(const Vector3& a, float x, float y, float z)
+	{
+		return a.x == x && a.y == y && a.z == z;
+	}
+
+	void TestRoundTrip()
+	{
+		WriteText(kTextPath, kText);
+		CHECK(LevelFile::Convert(kTextPath, kLevelPath));
+		// 一時ファイルは置き換えで消えている
+		std::filesystem::path tempPath = kLevelPath;
+		tempPath += ".tmp";
+		CHECK(!std::filesystem::exists(tempPath));
+
+		LevelFile level;
+		CHECK(level.Open(kLevelPath));
+		CHECK(level.IsOpen());
+
+		// --- 名前(重複はまとめ、objectだけに出てくるモデルも足す) ---
+		CHECK(level.GetModelCount() == 3);
+		CHECK(level.GetModelName(0) == "player.obj");
+		CHECK(level.GetModelName(1) == "enemy.obj");
+		CHECK(level.GetModelName(2) == "rock.obj");
+		CHECK(level.GetTextureCount() == 2);
+		CHECK(level.GetTextureName(0) == "resources/ground.png");
+		CHECK(level.GetTextureName(1) == "resources/sky.png");
+		CHECK(level.GetSoundCount() == 1);
+		CHECK(level.GetSoundName(0) == "bgm.wav");
+
+		// --- 配置(指定の無いものは既定値) ---
+		std::span<const LevelFile::ObjectRecord> objects = level.GetObjects();
+		CHECK(objects.size() == 4);
+		CHECK(reinterpret_cast<uintptr_t>(objects.data()) % alignof(LevelFile::ObjectRecord) == 0);
+		CHECK(objects[0].modelIndex == 0);
+		CHECK(IsEqual(objects[0].translate, 1.0f, 2.0f, 3.0f));
+		CHECK(IsEqual(objects[0].rotate, 0.0f, 0.0f, 0.0f));
+		CHECK(IsEqual(objects[0].scale, 1.0f, 1.0f, 1.0f));
+		CHECK(objects[1].modelIndex == 1);
+		CHECK(IsEqual(objects[1].translate, -1.0f, 0.0f, 5.0f));
+		CHECK(IsEqual(objects[1].rotate, 0.0f, 1.5f, 0.0f));
+		CHECK(IsEqual(objects[1].scale, 2.0f, 2.0f, 2.0f));
+		CHECK(objects[2].modelIndex == 1);
+		CHECK(IsEqual(objects[2].translate, 0.0f, 0.0f, 0.0f));
+		CHECK(objects[3].modelIndex == 2);
+		CHECK(IsEqual(objects[3].scale, 0.5f, 0.5f, 0.5f));
+
+		// 閉じれば開いていない
+		level.Close();
+		CHECK(!level.IsOpen());
+		CHECK(level.GetObjects().empty());
+
+		// --- 空のレベル ---
+		WriteText(kTextPath, "# 何も無い\n");
+		CHECK(LevelFile::Convert(kTextPath, kLevelPath));
+		CHECK(level.Open(kLevelPath));
+		CHECK(level.GetModelCount() == 0);
+		CHECK(level.GetObjects().empty());
+	}
+
+	void TestConvertError()
+	{
+		// --- 書式の誤りでは前のバイナリを残す ---
+		WriteText(kTextPath, kText);
+		CHECK(LevelFile::Convert(kTextPath, kLevelPath));
+		std::vector<uint8_t> previous = ReadBinary(kLevelPath);
+		for (const char* text : { "object\n", "object a.obj translate 1 2\n", "object a.obj position 1 2 3\n", "mesh a.obj\n", "model\n" }) {
+			WriteText(kTextPath, text);
+			CHECK(!LevelFile::Convert(kTextPath, kLevelPath));
+			CHECK(ReadBinary(kLevelPath) == previous);
+		}
+		CHECK(!LevelFile::Convert(kWorkDirectory / "missing.txt", kLevelPath));
+
+		// --- 書き込めなければ失敗し、一時ファイルも残らない ---
+		WriteText(kTextPath, kText);
+		CHECK(!LevelFile::Convert(kTextPath, kWorkDirectory / "missing" / "stage.level"));
+		CHECK(!std::filesystem::exists(kWorkDirectory / "missing"));
+	}
+
+	// 変換したものを書き換えて開けないことを確かめる
+	template<typename F>
+	bool OpenCorrupted(const std::vector<uint8_t>& original, F&& corrupt)
+	{
+		std::vector<uint8_t> data = original;
+		corrupt(data);
+		WriteBinary(kLevelPath, data);
+		LevelFile level;
+		bool isOpen = level.Open(kLevelPath);
+		// 失敗したら何も参照していない
+		CHECK(isOpen == level.IsOpen());
+		CHECK(isOpen || level.GetObjects().empty());
+		return isOpen;
+	}
+
+	void TestInvalidFile()
+	{
+		WriteText(kTextPath, kText);
+		CHECK(LevelFile::Convert(kTextPath, kLevelPath));
+		const std::vector<uint8_t> original = ReadBinary(kLevelPath);
+
+		// 書き換えなければ開ける
+		CHECK(OpenCorrupted(original, [](std::vector<uint8_t>&) {}));
+
+		// --- 途中で切れている・余分がある ---
+		for (size_t size : { size_t(0), size_t(4), sizeof(LevelFile::Header) - 1, sizeof(LevelFile::Header), original.size() / 2, original.size() - 1 }) {
+			CHECK(!OpenCorrupted(original, [size](std::vector<uint8_t>& data) { data.resize(size); }));
+		}
+		CHECK(!OpenCorrupted(original, [](std::vector<uint8_t>& data) { data.push_back(0); }));
+
+		// --- 識別子・バージョン違い ---
+		CHECK(!OpenCorrupted(original, [](std::vector<uint8_t>& data) { HeaderOf(data).magic ^= 1; }));
+		CHECK(!OpenCorrupted(original, [](std::vector<uint8_t>& data) { HeaderOf(data).version = LevelFile::kVersion + 1; }));
+
+		// --- 数が大きすぎる(サイズが合わない) ---
+		CHECK(!OpenCorrupted(original, [](std::vector<uint8_t>& data) { HeaderOf(data).objectCount = UINT32_MAX; }));
+		CHECK(!OpenCorrupted(original, [](std::vector<uint8_t>& data) { HeaderOf(data).soundCount = UINT32_MAX; }));
+
+		// --- 範囲外のモデル番号 ---
+		CHECK(!OpenCorrupted(original, [](std::vector<uint8_t>& data) { ObjectsOf(data)[3].modelIndex = HeaderOf(data).modelCount; }));
+		CHECK(!OpenCorrupted(original, [](std::vector<uint8_t>& data) { ObjectsOf(data)[0].modelIndex = UINT32_MAX; }));
+		// 最後のモデルは指せる
+		CHECK(OpenCorrupted(original, [](std::vector<uint8_t>& data) { ObjectsOf(data)[0].modelIndex = HeaderOf(data).modelCount - 1; }));
+
+		// --- 文字列領域の外を指す名前 ---
+		CHECK(!OpenCorrupted(original, [](std::vector<uint8_t>& data) { NamesOf(data)[0].offset = HeaderOf(data).stringsSize + 1; }));
+		CHECK(!OpenCorrupted(original, [](std::vector<uint8_t>& data) { NamesOf(data)[5].length += 1; }));
+		// 足すとあふれる組み合わせ
+		CHECK(!OpenCorrupted(original, [](std::vector<uint8_t>& data) { NamesOf(data)[1].offset = 1; NamesOf(data)[1].length = UINT32_MAX; }));
+		// 末尾ちょうどの空の名前はよい
+		CHECK(OpenCorrupted(original, [](std::vector<uint8_t>& data) { NamesOf(data)[2] = { HeaderOf(data).stringsSize, 0 }; }));
+	}
+
+	void TestLoadRebuilds()
+	{
+		// --- バイナリが無ければテキストから作る ---
+		std::error_code ec;
+		std::filesystem::remove(kLevelPath, ec);
+		WriteText(kTextPath, kText);
+		LevelFile level;
+		CHECK(level.Load(kLevelPath));
+		CHECK(std::filesystem::exists(kLevelPath));
+		CHECK(level.GetObjects().size() == 4);
+
+		// --- 形式が古ければテキストの方が古くても作り直す ---
+		std::vector<uint8_t> data = ReadBinary(kLevelPath);
+		level.Close();
+		HeaderOf(data).version = LevelFile::kVersion - 1;
+		WriteBinary(kLevelPath, data);
+		std::filesystem::last_write_time(kTextPath, std::filesystem::last_write_time(kLevelPath) - std::chrono::seconds(10));
+		CHECK(level.Load(kLevelPath));
+		CHECK(level.GetModelCount() == 3);
+		CHECK(HeaderOf(data = ReadBinary(kLevelPath)).version == LevelFile::kVersion);
+
+		// --- テキストの方が新しければ作り直す ---
+		level.Close();
+		WriteText(kTextPath, "model a.obj\nobject a.obj\n");
+		std::filesystem::last_write_time(kTextPath, std::filesystem::last_write_time(kLevelPath) + std::chrono::seconds(10));
+		CHECK(level.Load(kLevelPath));
+		CHECK(level.GetModelCount() == 1);
+		CHECK(level.GetObjects().size() == 1);
+
+		// --- テキストの誤りは失敗にする ---
+		level.Close();
+		WriteText(kTextPath, "object\n");
+		std::filesystem::last_write_time(kTextPath, std::filesystem::last_write_time(kLevelPath) + std::chrono::seconds(10));
+		CHECK(!level.Load(kLevelPath));
+		CHECK(!level.IsOpen());
+	}
+}
+
+int main()
+{
+	TestRoundTrip();
+	TestConvertError();
+	TestInvalidFile();
+	TestLoadRebuilds();
+
+	std::error_code ec;
+	std::filesystem::remove_all(kWorkDirectory, ec);
+	return Test::Finish("LevelFileTest");
+}
@@ -0,0 +1,80 @@
+#include <thread>
+
+#include "BenchmarkCommon.h"
+#include "BlockCompression.h"
+#include "Lz4.h"
+#include "ThreadPool.h"
+
+// LZ4の展開速度
+// 1ストリームの展開と、ブロック単位のストリームをスレッド数を変えて並列に展開したときの比較
+namespace
+{
+	const size_t kSize = 64 * 1024 * 1024;
+	// kHighは圧縮が遅い(パック作成時だけ使う)ので先頭だけで測る
+	const size_t kHighSize = 4 * 1024 * 1024;
+
+	// アセットに近い、ほどほどに圧縮できるデータ(kFastで約半分になる)
+	std::vector<uint8_t> MakeData()
+	{
+		std::vector<uint8_t> data(kSize);
+		uint32_t state = 1;
+		for (size_t i = 0; i < data.size(); ++i) {
+			state ^= state << 13;
+			state ^= state >> 17;
+			state ^= state << 5;
+			data[i] = (state & 7) == 0 ? uint8_t(state >> 8) : uint8_t("struct VertexShaderOutput { float4 position; };\n"[i % 48]);
+		}
+		return data;
+	}
+}
+
+int main()
+{
+	std::vector<uint8_t> data = MakeData();
+	std::vector<uint8_t> output(data.size());
+	std::printf("%zu MB input (items = bytes, M/s = MB/s)\n", kSize / (1024 * 1024));
+
+	// --- 1ストリーム ---
+	for (Lz4::Level level : { Lz4::Level::kFast, Lz4::Level::kHigh }) {
+		const char* levelName = level == Lz4::Level::kFast ? "kFast" : "kHigh";
+		std::span<const uint8_t> input(data.data(), level == Lz4::Level::kFast ? kSize : kHighSize);
+		std::span<uint8_t> inputOutput(output.data(), input.size());
+		std::vector<uint8_t> compressed;
+		double compressSeconds = Benchmark::Measure(1, [&]() {
+			compressed.clear();
+			Lz4::Compress(input, compressed, level);
+		});
+		char name[64];
+		std::snprintf(name, sizeof(name), "compress %s %zuMB (ratio %.3f)", levelName, input.size() >> 20, double(compressed.size()) / double(input.size()));
+		Benchmark::Report(name, compressSeconds, double(input.size()));
+
+		double seconds = Benchmark::Measure(5, [&]() {
+			Lz4::Decompress(compressed, inputOutput);
+			Benchmark::Keep(inputOutput[inputOutput.size() / 2]);
+		});
+		std::snprintf(name, sizeof(name), "decompress %s %zuMB single stream", levelName, input.size() >> 20);
+		Benchmark::Report(name, seconds, double(input.size()));
+	}
+
+	// --- ブロック単位(スレッド数ごと) ---
+	std::vector<uint8_t> blocks;
+	BlockCompression::Compress(data, blocks, Lz4::Level::kFast);
+	double serialSeconds = Benchmark::Measure(5, [&]() {
+		BlockCompression::Decompress(blocks, output);
+		Benchmark::Keep(output[output.size() / 2]);
+	});
+	Benchmark::Report("decompress blocks threads=0 (calling thread)", serialSeconds, double(data.size()));
+
+	uint32_t maxThreads = (std::max)(1u, std::thread::hardware_concurrency());
+	for (uint32_t threadCount = 1; threadCount <= maxThreads; threadCount *= 2) {
+		ThreadPool threadPool(threadCount);
+		double seconds = Benchmark::Measure(5, [&]() {
+			BlockCompression::Decompress(blocks, output, &threadPool);
+			Benchmark::Keep(output[output.size() / 2]);
+		});
+		char name[64];
+		std::snprintf(name, sizeof(name), "decompress blocks threads=%u", threadCount);
+		Benchmark::Report(name, seconds, double(data.size()));
+	}
+	return output == data ? 0 : 1;
+}
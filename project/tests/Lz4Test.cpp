@@ -0,0 +1,232 @@
+#include "Lz4.h"
+#include <algorithm>
+
+#include "BlockCompression.h"
+#include "TestCommon.h"
+#include "ThreadPool.h"
+
+namespace
+{
+	const Lz4::Level kLevels[] = { Lz4::Level::kFast, Lz4::Level::kHigh };
+
+	// 圧縮できないデータ
+	std::vector<uint8_t> MakeRandom(size_t size, uint32_t seed)
+	{
+		std::vector<uint8_t> data(size);
+		uint32_t state = seed;
+		for (uint8_t& value : data) {
+			state ^= state << 13;
+			state ^= state >> 17;
+			state ^= state << 5;
+			value = uint8_t(state);
+		}
+		return data;
+	}
+
+	// 繰り返しの多いデータ(短い周期・長い一致・ときどき乱れる)
+	std::vector<uint8_t> MakeRepetitive(size_t size)
+	{
+		std::vector<uint8_t> data(size);
+		uint32_t state = 99;
+		for (size_t i = 0; i < size; ++i) {
+			state = state * 1103515245u + 12345u;
+			data[i] = (state >> 28) == 0 ? uint8_t(state >> 16) : uint8_t("vertex normal texcoord "[i % 23]);
+		}
+		return data;
+	}
+
+	// テストするデータ(空・1バイト・圧縮できない・同じ値の連続・繰り返し・64KBを超える)
+	std::vector<std::vector<uint8_t>> MakeInputs()
+	{
+		return {
+			{},
+			{ 42 },
+			MakeRandom(1000, 1),
+			std::vector<uint8_t>(5000, 0xAB),
+			MakeRepetitive(4000),
+			MakeRepetitive(200 * 1024),
+			MakeRandom(70 * 1024, 2),
+		};
+	}
+
+	void TestRoundTrip()
+	{
+		for (Lz4::Level level : kLevels) {
+			for (const std::vector<uint8_t>& input : MakeInputs()) {
+				std::vector<uint8_t> compressed;
+				Lz4::Compress(input, compressed, level);
+				std::vector<uint8_t> output(input.size());
+				CHECK(Lz4::Decompress(compressed, output));
+				CHECK(output == input);
+			}
+		}
+
+		// 繰り返しは小さくなり、kHighはkFast以下になる
+		std::vector<uint8_t> repetitive = MakeRepetitive(200 * 1024);
+		std::vector<uint8_t> fast;
+		std::vector<uint8_t> high;
+		Lz4::Compress(repetitive, fast, Lz4::Level::kFast);
+		Lz4::Compress(repetitive, high, Lz4::Level::kHigh);
+		CHECK(fast.size() < repetitive.size() / 2);
+		CHECK(high.size() <= fast.size());
+
+		// dstの末尾に追加される
+		std::vector<uint8_t> appended = { 1, 2, 3 };
+		Lz4::Compress(repetitive, appended, Lz4::Level::kFast);
+		CHECK(appended.size() == fast.size() + 3);
+		CHECK(std::equal(fast.begin(), fast.end(), appended.begin() + 3));
+	}
+
+	void TestCorrupt()
+	{
+		std::vector<uint8_t> input = MakeRepetitive(4000);
+		std::vector<uint8_t> compressed;
+		Lz4::Compress(input, compressed, Lz4::Level::kFast);
+		std::vector<uint8_t> output(input.size());
+
+		// 大きさが合わない
+		std::vector<uint8_t> shorter(input.size() - 1);
+		CHECK(!Lz4::Decompress(compressed, shorter));
+		std::vector<uint8_t> longer(input.size() + 1);
+		CHECK(!Lz4::Decompress(compressed, longer));
+
+		// 途中で切れている
+		for (size_t length : { size_t(1), compressed.size() / 2, compressed.size() - 1 }) {
+			std::span<const uint8_t> truncated(compressed.data(), length);
+			CHECK(!Lz4::Decompress(truncated, output));
+		}
+
+		// 距離が出力の先頭より前を指す(リテラル無し・長さ4・距離1)
+		const std::vector<uint8_t> farOffset = { 0x00, 0x01, 0x00 };
+		std::vector<uint8_t> four(4);
+		CHECK(!Lz4::Decompress(farOffset, four));
+		// 距離0
+		const std::vector<uint8_t> zeroOffset = { 0x10, 'a', 0x00, 0x00 };
+		std::vector<uint8_t> five(5);
+		CHECK(!Lz4::Decompress(zeroOffset, five));
+
+		// どのバイトを壊しても範囲外に書かずに終わる(結果は問わない)
+		for (size_t i = 0; i < compressed.size(); i += 7) {
+			std::vector<uint8_t> broken = compressed;
+			broken[i] ^= 0x5A;
+			Lz4::Decompress(broken, output);
+		}
+	}
+
+	void TestBlockRoundTrip()
+	{
+		ThreadPool threadPool(4);
+		for (Lz4::Level level : kLevels) {
+			for (const std::vector<uint8_t>& input : MakeInputs()) {
+				for (ThreadPool* pool : { static_cast<ThreadPool*>(nullptr), &threadPool }) {
+					std::vector<uint8_t> compressed;
+					BlockCompression::Compress(input, compressed, level, 16 * 1024, pool);
+					CHECK(BlockCompression::IsBlockStream(compressed));
+					uint64_t size = 0;
+					CHECK(BlockCompression::GetSize(compressed, size));
+					CHECK(size == input.size());
+					std::vector<uint8_t> output(input.size());
+					CHECK(BlockCompression::Decompress(compressed, output, pool));
+					CHECK(output == input);
+				}
+			}
+		}
+	}
+
+	void TestDecompressRange()
+	{
+		const uint32_t kBlockSize = 16 * 1024;
+		ThreadPool threadPool(4);
+		// 圧縮するブロックと無圧縮で格納するブロックが混ざるように
+		std::vector<uint8_t> input = MakeRepetitive(kBlockSize * 5);
+		std::vector<uint8_t> noise = MakeRandom(kBlockSize * 2, 3);
+		input.insert(input.begin() + kBlockSize * 2, noise.begin(), noise.end());
+		input.resize(input.size() + 1000, 7);
+		std::vector<uint8_t> compressed;
+		BlockCompression::Compress(input, compressed, Lz4::Level::kFast, kBlockSize, &threadPool);
+
+		struct Range {
+			uint64_t offset;
+			size_t size;
+		};
+		const Range ranges[] = {
+			{ 0, 0 },								// 空
+			{ 0, 1 },								// 先頭1バイト
+			{ kBlockSize - 1, 2 },					// ブロック境界をまたぐ
+			{ kBlockSize, kBlockSize },				// ちょうど1ブロック
+			{ kBlockSize - 10, kBlockSize * 3 },	// 複数ブロック(途中から途中まで)
+			{ kBlockSize * 2 - 5, 10 },				// 圧縮→無圧縮の境界
+			{ input.size() - 1500, 1500 },			// 最後の端数ブロックまで
+			{ 0, input.size() },					// 全体
+		};
+		for (const Range& range : ranges) {
+			for (ThreadPool* pool : { static_cast<ThreadPool*>(nullptr), &threadPool }) {
+				std::vector<uint8_t> output(range.size, 0xCD);
+				CHECK(BlockCompression::DecompressRange(compressed, range.offset, output, pool));
+				CHECK(std::equal(output.begin(), output.end(), input.begin() + ptrdiff_t(range.offset)));
+			}
+		}
+
+		// 範囲外
+		std::vector<uint8_t> output(10);
+		CHECK(!BlockCompression::DecompressRange(compressed, input.size() - 9, output));
+		CHECK(!BlockCompression::DecompressRange(compressed, input.size() + 1, std::span<uint8_t>()));
+	}
+
+	void TestBlockCorrupt()
+	{
+		const uint32_t kBlockSize = 16 * 1024;
+		std::vector<uint8_t> input = MakeRepetitive(kBlockSize * 3 + 100);
+		std::vector<uint8_t> compressed;
+		BlockCompression::Compress(input, compressed, Lz4::Level::kFast, kBlockSize);
+		std::vector<uint8_t> output(input.size());
+
+		// ブロックストリームでない
+		std::vector<uint8_t> plain;
+		Lz4::Compress(input, plain, Lz4::Level::kFast);
+		uint64_t size = 0;
+		CHECK(!BlockCompression::IsBlockStream(plain));
+		CHECK(!BlockCompression::GetSize(plain, size));
+		CHECK(!BlockCompression::Decompress(plain, output));
+
+		// 大きさが合わない
+		std::vector<uint8_t> shorter(input.size() - 1);
+		CHECK(!BlockCompression::Decompress(compressed, shorter));
+
+		// ヘッダ・ブロック表・データの途中で切れている
+		for (size_t length : { size_t(8), size_t(30), compressed.size() / 2, compressed.size() - 1 }) {
+			std::span<const uint8_t> truncated(compressed.data(), length);
+			CHECK(!BlockCompression::Decompress(truncated, output));
+		}
+
+		// ブロック数が元のサイズと合わない(ヘッダのblockCountを書き換える)
+		std::vector<uint8_t> broken = compressed;
+		broken[16] ^= 1;
+		CHECK(!BlockCompression::Decompress(broken, output));
+
+		// ブロックの中身が壊れている(最初のブロックのリテラル長を入力より長くする)
+		// 並列に展開しても失敗が返る
+		broken = compressed;
+		const size_t firstBlock = 24 + 4 * 4;
+		broken[firstBlock] = 0xF0;
+		for (size_t i = 1; i <= 8; ++i) {
+			broken[firstBlock + i] = 0xFF;
+		}
+		ThreadPool threadPool(2);
+		CHECK(!BlockCompression::Decompress(broken, output));
+		CHECK(!BlockCompression::Decompress(broken, output, &threadPool));
+		CHECK(!BlockCompression::DecompressRange(broken, 10, std::span<uint8_t>(output.data(), 10), &threadPool));
+		// 壊れていないブロックだけの範囲は読める
+		CHECK(BlockCompression::DecompressRange(broken, kBlockSize, std::span<uint8_t>(output.data(), 10), &threadPool));
+	}
+}
+
+int main()
+{
+	TestRoundTrip();
+	TestCorrupt();
+	TestBlockRoundTrip();
+	TestDecompressRange();
+	TestBlockCorrupt();
+	return Test::Finish("Lz4Test");
+}
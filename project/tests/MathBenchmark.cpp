@@ -0,0 +1,287 @@
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "Affine3x4.h"
+#include "BenchmarkCommon.h"
+#include "CalculateMath.h"
+#include "Quaternion.h"
+
+// オブジェクトごとのワールド行列の計算
+// オイラー角(X→Y→Zの回転行列の積)とクォータニオン、Matrix4x4とAffine3x4の比較
+// 四則演算だけの関数をヘッダに置いて(constexpr)インライン展開させた場合と、別の翻訳単位に置いていた場合の比較
+namespace
+{
+	const uint32_t kObjectCount = 100000;
+	const int kTrialCount = 20;
+
+	struct ObjectTransform {
+		Vector3 scale;
+		Vector3 rotate;
+		Vector3 translate;
+		Quaternion rotation;	// rotateと同じ回転
+	};
+
+	std::vector<ObjectTransform> MakeTransforms()
+	{
+		std::mt19937 rng(1);
+		std::uniform_real_distribution<float> range(-3.0f, 3.0f);
+		std::uniform_real_distribution<float> scaleRange(0.5f, 2.0f);
+		std::vector<ObjectTransform> transforms(kObjectCount);
+		for (ObjectTransform& transform : transforms) {
+			transform.scale = { scaleRange(rng), scaleRange(rng), scaleRange(rng) };
+			transform.rotate = { range(rng), range(rng), range(rng) };
+			transform.translate = { range(rng), range(rng), range(rng) };
+			transform.rotation = MakeRotateQuaternion(transform.rotate);
+		}
+		return transforms;
+	}
+
+	// 結果を1つ残す
+	void KeepValue(const Matrix4x4& value) { Benchmark::Keep(uint64_t(value.m[3][0] * 1000.0f)); }
+	void KeepValue(const Quaternion& value) { Benchmark::Keep(uint64_t(value.w * 1000.0f)); }
+	void KeepValue(const Vector3& value) { Benchmark::Keep(uint64_t(value.x * 1000.0f)); }
+	void KeepValue(const Affine3x4& value) { Benchmark::Keep(uint64_t(value.m[0][3] * 1000.0f)); }
+
+	// --- 別の翻訳単位に置いていたとき(呼び出しのまま残る)の代わり ---
+#ifdef _MSC_VER
+#define BENCHMARK_NOINLINE __declspec(noinline)
+#else
+#define BENCHMARK_NOINLINE __attribute__((noinline))
+#endif
+	BENCHMARK_NOINLINE Vector3 OutOfLineAdd(const Vector3& a, const Vector3& b) { return a + b; }
+	BENCHMARK_NOINLINE Vector3 OutOfLineSubtract(const Vector3& a, const Vector3& b) { return a - b; }
+	BENCHMARK_NOINLINE Vector3 OutOfLineScale(const Vector3& v, float scalar) { return v * scalar; }
+	BENCHMARK_NOINLINE float OutOfLineDot(const Vector3& a, const Vector3& b) { return Dot(a, b); }
+	BENCHMARK_NOINLINE Vector3 OutOfLineCross(const Vector3& a, const Vector3& b) { return Cross(a, b); }
+	BENCHMARK_NOINLINE Vector3 OutOfLineTransform(const Vector3& v, const Matrix4x4& m) { return Transform(v, m); }
+
+	// 1オブジェクト分の更新(目標に向かって加速し、向きと画面上の位置を求める)
+	struct Mover {
+		Vector3 position;
+		Vector3 velocity;
+		Vector3 right;
+		Vector3 screen;
+	};
+	const float kDeltaTime = 1.0f / 60.0f;
+	const float kAcceleration = 4.0f;
+
+	void UpdateInline(Mover& mover, const Vector3& target, const Matrix4x4& viewProjection)
+	{
+		Vector3 toTarget = target - mover.position;
+		Vector3 direction = toTarget * (1.0f / std::sqrt(Dot(toTarget, toTarget) + 1.0e-6f));
+		mover.velocity += direction * (kAcceleration * kDeltaTime);
+		mover.position += mover.velocity * kDeltaTime;
+		mover.right = Cross({ 0.0f, 1.0f, 0.0f }, direction);
+		mover.screen = Transform(mover.position, viewProjection);
+	}
+
+	void UpdateOutOfLine(Mover& mover, const Vector3& target, const Matrix4x4& viewProjection)
+	{
+		Vector3 toTarget = OutOfLineSubtract(target, mover.position);
+		Vector3 direction = OutOfLineScale(toTarget, 1.0f / std::sqrt(OutOfLineDot(toTarget, toTarget) + 1.0e-6f));
+		mover.velocity = OutOfLineAdd(mover.velocity, OutOfLineScale(direction, kAcceleration * kDeltaTime));
+		mover.position = OutOfLineAdd(mover.position, OutOfLineScale(mover.velocity, kDeltaTime));
+		mover.right = OutOfLineCross({ 0.0f, 1.0f, 0.0f }, direction);
+		mover.screen = OutOfLineTransform(mover.position, viewProjection);
+	}
+}
+
+int main()
+{
+	std::vector<ObjectTransform> transforms = MakeTransforms();
+	std::printf("%u objects (items = objects)\n", kObjectCount);
+
+	// --- ワールド行列の作成 ---
+	std::vector<Matrix4x4> matrices(kObjectCount);
+	double eulerChain = Benchmark::Measure(kTrialCount, [&]() {
+		// 以前のMakeAffineMatrix(回転行列を3つ作って掛ける)
+		for (uint32_t i = 0; i < kObjectCount; ++i) {
+			const ObjectTransform& t = transforms[i];
+			matrices[i] = MakeScaleMatrix(t.scale) *
+				(MakeRotateXMatrix(t.rotate.x) * MakeRotateYMatrix(t.rotate.y) * MakeRotateZMatrix(t.rotate.z)) *
+				MakeTranslateMatrix(t.translate);
+		}
+		KeepValue(matrices[kObjectCount / 2]);
+	});
+	Benchmark::Report("Matrix4x4 S*Rx*Ry*Rz*T chain", eulerChain, kObjectCount);
+
+	double euler = Benchmark::Measure(kTrialCount, [&]() {
+		for (uint32_t i = 0; i < kObjectCount; ++i) {
+			const ObjectTransform& t = transforms[i];
+			matrices[i] = MakeAffineMatrix(t.scale, t.rotate, t.translate);
+		}
+		KeepValue(matrices[kObjectCount / 2]);
+	});
+	Benchmark::Report("MakeAffineMatrix(Euler)", euler, kObjectCount);
+
+	double quaternion = Benchmark::Measure(kTrialCount, [&]() {
+		for (uint32_t i = 0; i < kObjectCount; ++i) {
+			const ObjectTransform& t = transforms[i];
+			matrices[i] = MakeAffineMatrix(t.scale, t.rotation, t.translate);
+		}
+		KeepValue(matrices[kObjectCount / 2]);
+	});
+	Benchmark::Report("MakeAffineMatrix(Quaternion)", quaternion, kObjectCount);
+
+	// --- 回転の合成(親の回転に子の回転を重ねる) ---
+	std::vector<Matrix4x4> rotations(kObjectCount);
+	for (uint32_t i = 0; i < kObjectCount; ++i) {
+		rotations[i] = MakeRotateMatrix(transforms[i].rotation);
+	}
+	std::vector<Matrix4x4> composedMatrices(kObjectCount);
+	double composeMatrix = Benchmark::Measure(kTrialCount, [&]() {
+		for (uint32_t i = 0; i < kObjectCount; ++i) {
+			composedMatrices[i] = rotations[i] * rotations[(i + 1) % kObjectCount];
+		}
+		KeepValue(composedMatrices[kObjectCount / 2]);
+	});
+	Benchmark::Report("compose rotation Matrix4x4 * Matrix4x4", composeMatrix, kObjectCount);
+
+	std::vector<Quaternion> composedQuaternions(kObjectCount);
+	double composeQuaternion = Benchmark::Measure(kTrialCount, [&]() {
+		for (uint32_t i = 0; i < kObjectCount; ++i) {
+			composedQuaternions[i] = transforms[(i + 1) % kObjectCount].rotation * transforms[i].rotation;
+		}
+		KeepValue(composedQuaternions[kObjectCount / 2]);
+	});
+	Benchmark::Report("compose rotation Quaternion * Quaternion", composeQuaternion, kObjectCount);
+
+	// --- 補間(アニメーション) ---
+	double slerp = Benchmark::Measure(kTrialCount, [&]() {
+		for (uint32_t i = 0; i < kObjectCount; ++i) {
+			composedQuaternions[i] = Slerp(transforms[i].rotation, transforms[(i + 1) % kObjectCount].rotation, 0.3f);
+		}
+		KeepValue(composedQuaternions[kObjectCount / 2]);
+	});
+	Benchmark::Report("Slerp", slerp, kObjectCount);
+
+	double nlerp = Benchmark::Measure(kTrialCount, [&]() {
+		for (uint32_t i = 0; i < kObjectCount; ++i) {
+			composedQuaternions[i] = Nlerp(transforms[i].rotation, transforms[(i + 1) % kObjectCount].rotation, 0.3f);
+		}
+		KeepValue(composedQuaternions[kObjectCount / 2]);
+	});
+	Benchmark::Report("Nlerp", nlerp, kObjectCount);
+
+	// --- ベクトルの回転 ---
+	std::vector<Vector3> vectors(kObjectCount);
+	double rotateMatrix = Benchmark::Measure(kTrialCount, [&]() {
+		for (uint32_t i = 0; i < kObjectCount; ++i) {
+			vectors[i] = TransformNormal(transforms[i].translate, rotations[i]);
+		}
+		KeepValue(vectors[kObjectCount / 2]);
+	});
+	Benchmark::Report("rotate vector by Matrix4x4", rotateMatrix, kObjectCount);
+
+	double rotateQuaternion = Benchmark::Measure(kTrialCount, [&]() {
+		for (uint32_t i = 0; i < kObjectCount; ++i) {
+			vectors[i] = RotateVector(transforms[i].translate, transforms[i].rotation);
+		}
+		KeepValue(vectors[kObjectCount / 2]);
+	});
+	Benchmark::Report("rotate vector by Quaternion", rotateQuaternion, kObjectCount);
+
+	// --- Affine3x4(最後の列を持たない) ---
+	std::vector<Affine3x4> affines(kObjectCount);
+	double affineEuler = Benchmark::Measure(kTrialCount, [&]() {
+		for (uint32_t i = 0; i < kObjectCount; ++i) {
+			const ObjectTransform& t = transforms[i];
+			affines[i] = MakeAffine3x4(t.scale, t.rotate, t.translate);
+		}
+		KeepValue(affines[kObjectCount / 2]);
+	});
+	Benchmark::Report("MakeAffine3x4(Euler)", affineEuler, kObjectCount);
+
+	double affineQuaternion = Benchmark::Measure(kTrialCount, [&]() {
+		for (uint32_t i = 0; i < kObjectCount; ++i) {
+			const ObjectTransform& t = transforms[i];
+			affines[i] = MakeAffine3x4(t.scale, t.rotation, t.translate);
+		}
+		KeepValue(affines[kObjectCount / 2]);
+	});
+	Benchmark::Report("MakeAffine3x4(Quaternion)", affineQuaternion, kObjectCount);
+
+	// 親のワールド行列との合成(local * parentWorld)
+	for (uint32_t i = 0; i < kObjectCount; ++i) {
+		matrices[i] = ToMatrix4x4(affines[i]);
+	}
+	double composeWorldMatrix = Benchmark::Measure(kTrialCount, [&]() {
+		for (uint32_t i = 0; i < kObjectCount; ++i) {
+			composedMatrices[i] = matrices[i] * matrices[i / 8];
+		}
+		KeepValue(composedMatrices[kObjectCount / 2]);
+	});
+	Benchmark::Report("compose world Matrix4x4 * Matrix4x4", composeWorldMatrix, kObjectCount);
+
+	std::vector<Affine3x4> composedAffines(kObjectCount);
+	double composeWorldAffine = Benchmark::Measure(kTrialCount, [&]() {
+		for (uint32_t i = 0; i < kObjectCount; ++i) {
+			composedAffines[i] = affines[i] * affines[i / 8];
+		}
+		KeepValue(composedAffines[kObjectCount / 2]);
+	});
+	Benchmark::Report("compose world Affine3x4 * Affine3x4", composeWorldAffine, kObjectCount);
+
+	// ワールド × ビュープロジェクション(描画前に毎フレーム)
+	const Matrix4x4 viewProjection = Inverse(MakeAffineMatrix({ 1.0f, 1.0f, 1.0f }, { 0.3f, 0.0f, 0.0f }, { 0.0f, 5.0f, -20.0f })) *
+		MakePerspectiveFovMatrix(0.45f, 16.0f / 9.0f, 0.1f, 1000.0f);
+	double wvpMatrix = Benchmark::Measure(kTrialCount, [&]() {
+		for (uint32_t i = 0; i < kObjectCount; ++i) {
+			composedMatrices[i] = matrices[i] * viewProjection;
+		}
+		KeepValue(composedMatrices[kObjectCount / 2]);
+	});
+	Benchmark::Report("world*viewProjection Matrix4x4", wvpMatrix, kObjectCount);
+
+	double wvpAffine = Benchmark::Measure(kTrialCount, [&]() {
+		for (uint32_t i = 0; i < kObjectCount; ++i) {
+			composedMatrices[i] = Multiply(affines[i], viewProjection);
+		}
+		KeepValue(composedMatrices[kObjectCount / 2]);
+	});
+	Benchmark::Report("world*viewProjection Affine3x4", wvpAffine, kObjectCount);
+
+	// 逆行列(法線用の逆転置・カメラ)
+	double inverseMatrix = Benchmark::Measure(kTrialCount, [&]() {
+		for (uint32_t i = 0; i < kObjectCount; ++i) {
+			composedMatrices[i] = Inverse(matrices[i]);
+		}
+		KeepValue(composedMatrices[kObjectCount / 2]);
+	});
+	Benchmark::Report("Inverse Matrix4x4", inverseMatrix, kObjectCount);
+
+	double inverseAffine = Benchmark::Measure(kTrialCount, [&]() {
+		for (uint32_t i = 0; i < kObjectCount; ++i) {
+			composedAffines[i] = Inverse(affines[i]);
+		}
+		KeepValue(composedAffines[kObjectCount / 2]);
+	});
+	Benchmark::Report("Inverse Affine3x4", inverseAffine, kObjectCount);
+
+	// --- オブジェクトごとの更新ループ(インライン展開の有無) ---
+	std::vector<Mover> movers(kObjectCount);
+	for (uint32_t i = 0; i < kObjectCount; ++i) {
+		movers[i].position = transforms[i].translate;
+	}
+	const Vector3 target = { 0.0f, 1.0f, 0.0f };
+	double updateInline = Benchmark::Measure(kTrialCount, [&]() {
+		for (Mover& mover : movers) {
+			UpdateInline(mover, target, viewProjection);
+		}
+		KeepValue(movers[kObjectCount / 2].screen);
+	});
+	Benchmark::Report("per-object update, header constexpr (inlined)", updateInline, kObjectCount);
+
+	double updateOutOfLine = Benchmark::Measure(kTrialCount, [&]() {
+		for (Mover& mover : movers) {
+			UpdateOutOfLine(mover, target, viewProjection);
+		}
+		KeepValue(movers[kObjectCount / 2].screen);
+	});
+	Benchmark::Report("per-object update, out-of-line calls", updateOutOfLine, kObjectCount);
+
+	// GPUに送る量(1オブジェクトあたり)
+	std::printf("upload size per world matrix: Matrix4x4 %zu bytes, Affine3x4 %zu bytes\n", sizeof(Matrix4x4), sizeof(Affine3x4));
+	return 0;
+}
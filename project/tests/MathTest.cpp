@@ -0,0 +1,138 @@
+#include "Affine3x4.h"
+#include "CalculateMath.h"
+#include "Quaternion.h"
+#include "Vector2.h"
+#include "TestCommon.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <random>
+
+// --- 四則演算だけのものはコンパイル時に計算できる ---
+namespace {
+	constexpr bool Equals(const Matrix4x4& a, const Matrix4x4& b) {
+		for (int i = 0; i < 4; ++i) {
+			for (int j = 0; j < 4; ++j) {
+				if (a.m[i][j] != b.m[i][j]) {
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+	constexpr bool Equals(const Vector3& a, const Vector3& b) { return a.x == b.x && a.y == b.y && a.z == b.z; }
+
+	static_assert(Dot(Vector3(1.0f, 2.0f, 3.0f), Vector3(4.0f, 5.0f, 6.0f)) == 32.0f);
+	static_assert(Equals(Cross(Vector3(1.0f, 0.0f, 0.0f), Vector3(0.0f, 1.0f, 0.0f)), Vector3(0.0f, 0.0f, 1.0f)));
+	static_assert(Equals(Vector3(1.0f, 2.0f, 3.0f) + Vector3(1.0f, 1.0f, 1.0f) * 2.0f, Vector3(3.0f, 4.0f, 5.0f)));
+	static_assert(Vector2(1.0f, 2.0f) * 2.0f == Vector2(2.0f, 4.0f));
+	static_assert(Equals(MakeIdentity4x4() * MakeIdentity4x4(), MakeIdentity4x4()));
+	static_assert(Equals(Transpose(Transpose(MakeTranslateMatrix({ 1.0f, 2.0f, 3.0f }))), MakeTranslateMatrix({ 1.0f, 2.0f, 3.0f })));
+	// 拡縮してから平行移動
+	static_assert(Equals(Transform({ 1.0f, 1.0f, 1.0f }, MakeScaleMatrix({ 2.0f, 3.0f, 4.0f }) * MakeTranslateMatrix({ 1.0f, 2.0f, 3.0f })), Vector3(3.0f, 5.0f, 7.0f)));
+	static_assert(Equals(TransformNormal({ 1.0f, 1.0f, 1.0f }, MakeTranslateMatrix({ 1.0f, 2.0f, 3.0f })), Vector3(1.0f, 1.0f, 1.0f)));
+	static_assert(Equals(Transform({ -1.0f, 1.0f, 0.0f }, MakeViewportMatrix(0.0f, 0.0f, 1280.0f, 720.0f, 0.0f, 1.0f)), Vector3(0.0f, 0.0f, 0.0f)));
+	static_assert(Equals(Transform({ 0.0f, 0.0f, 0.0f }, MakeOrthographicMatrix(-1.0f, 1.0f, 1.0f, -1.0f, 0.0f, 1.0f)), Vector3(0.0f, 0.0f, 0.0f)));
+	static_assert(Dot(Conjugate(Quaternion(1.0f, 2.0f, 3.0f, 4.0f)), IdentityQuaternion()) == 4.0f);
+	// アフィン
+	static_assert(Equals(ToMatrix4x4(ToAffine3x4(MakeScaleMatrix({ 2.0f, 4.0f, 8.0f }) * MakeTranslateMatrix({ 1.0f, 2.0f, 3.0f }))),
+		MakeScaleMatrix({ 2.0f, 4.0f, 8.0f }) * MakeTranslateMatrix({ 1.0f, 2.0f, 3.0f })));
+	static_assert(Equals(Transform({ 1.0f, 1.0f, 1.0f }, ToAffine3x4(MakeScaleMatrix({ 2.0f, 4.0f, 8.0f }) * MakeTranslateMatrix({ 1.0f, 2.0f, 3.0f }))), Vector3(3.0f, 6.0f, 11.0f)));
+	static_assert(Equals(ToMatrix4x4(MakeIdentityAffine3x4()), MakeIdentity4x4()));
+
+	float MaxDifference(const Matrix4x4& a, const Matrix4x4& b) {
+		float difference = 0.0f;
+		for (int i = 0; i < 4; ++i) {
+			for (int j = 0; j < 4; ++j) {
+				difference = (std::max)(difference, std::fabs(a.m[i][j] - b.m[i][j]));
+			}
+		}
+		return difference;
+	}
+	float MaxDifference(const Vector3& a, const Vector3& b) {
+		return (std::max)({ std::fabs(a.x - b.x), std::fabs(a.y - b.y), std::fabs(a.z - b.z) });
+	}
+	// 同じ回転か(qと-qは同じ回転)
+	float RotationDifference(const Quaternion& a, const Quaternion& b) {
+		return 1.0f - std::fabs(Dot(a, b));
+	}
+
+	const float kTolerance = 1e-4f;
+
+	// --- クォータニオンの変換が行列と一致する ---
+	void TestQuaternionMatchesMatrix()
+	{
+		std::mt19937 rng(5);
+		std::uniform_real_distribution<float> angle(-std::numbers::pi_v<float>, std::numbers::pi_v<float>);
+		std::uniform_real_distribution<float> range(-3.0f, 3.0f);
+
+		float eulerError = 0.0f;
+		float composeError = 0.0f;
+		float rotateError = 0.0f;
+		float fromMatrixError = 0.0f;
+		float inverseError = 0.0f;
+		for (int i = 0; i < 10000; ++i) {
+			Vector3 rotate = { angle(rng), angle(rng), angle(rng) };
+			Vector3 rotate2 = { angle(rng), angle(rng), angle(rng) };
+			Vector3 vector = { range(rng), range(rng), range(rng) };
+			Quaternion q = MakeRotateQuaternion(rotate);
+			Quaternion q2 = MakeRotateQuaternion(rotate2);
+			Matrix4x4 matrix = MakeAffineMatrix({ 1.0f, 1.0f, 1.0f }, rotate, {});
+			Matrix4x4 matrix2 = MakeAffineMatrix({ 1.0f, 1.0f, 1.0f }, rotate2, {});
+
+			eulerError = (std::max)(eulerError, MaxDifference(MakeRotateMatrix(q), matrix));
+			// q2 * q は「qの後にq2」
+			composeError = (std::max)(composeError, MaxDifference(MakeRotateMatrix(q2 * q), matrix * matrix2));
+			rotateError = (std::max)(rotateError, MaxDifference(RotateVector(vector, q), TransformNormal(vector, matrix)));
+			fromMatrixError = (std::max)(fromMatrixError, RotationDifference(MakeRotateQuaternion(matrix), q));
+			inverseError = (std::max)(inverseError, RotationDifference(q * Inverse(q), IdentityQuaternion()));
+		}
+		CHECK(eulerError < kTolerance);
+		CHECK(composeError < kTolerance);
+		CHECK(rotateError < kTolerance);
+		CHECK(fromMatrixError < kTolerance);
+		CHECK(inverseError < kTolerance);
+	}
+
+	// --- 任意軸回転・正規化 ---
+	void TestAxisAngle()
+	{
+		Quaternion q = MakeRotateAxisAngleQuaternion({ 0.0f, 1.0f, 0.0f }, std::numbers::pi_v<float> / 2.0f);
+		CHECK(MaxDifference(MakeRotateMatrix(q), MakeRotateYMatrix(std::numbers::pi_v<float> / 2.0f)) < kTolerance);
+		CHECK(std::fabs(Norm(q) - 1.0f) < kTolerance);
+
+		Quaternion normalized = Normalize(Quaternion(1.0f, 2.0f, 3.0f, 4.0f));
+		CHECK(std::fabs(Norm(normalized) - 1.0f) < kTolerance);
+		CHECK(std::fabs(normalized.w - 4.0f / std::sqrt(30.0f)) < kTolerance);
+	}
+
+	// --- 補間 ---
+	void TestInterpolation()
+	{
+		Quaternion q0 = IdentityQuaternion();
+		Quaternion q1 = MakeRotateAxisAngleQuaternion({ 0.0f, 0.0f, 1.0f }, 2.0f);
+		Quaternion half = MakeRotateAxisAngleQuaternion({ 0.0f, 0.0f, 1.0f }, 1.0f);
+		CHECK(RotationDifference(Slerp(q0, q1, 0.0f), q0) < kTolerance);
+		CHECK(RotationDifference(Slerp(q0, q1, 1.0f), q1) < kTolerance);
+		CHECK(RotationDifference(Slerp(q0, q1, 0.5f), half) < kTolerance);
+		// 符号が逆でも近い方を回る
+		CHECK(RotationDifference(Slerp(q0, -q1, 0.5f), half) < kTolerance);
+		// Nlerpは中間で同じ向きになり、正規化されている
+		Quaternion nlerp = Nlerp(q0, q1, 0.5f);
+		CHECK(RotationDifference(nlerp, half) < kTolerance);
+		CHECK(std::fabs(Norm(nlerp) - 1.0f) < kTolerance);
+		// ほぼ同じ向きでも壊れない
+		Quaternion nearby = MakeRotateAxisAngleQuaternion({ 0.0f, 0.0f, 1.0f }, 1e-6f);
+		Quaternion slerp = Slerp(q0, nearby, 0.5f);
+		CHECK(std::isfinite(slerp.w) && std::fabs(Norm(slerp) - 1.0f) < kTolerance);
+	}
+}
+
+int main()
+{
+	TestQuaternionMatchesMatrix();
+	TestAxisAngle();
+	TestInterpolation();
+	return Test::Finish("MathTest");
+}
@@ -0,0 +1,133 @@
+#include "MemoryArena.h"
+
+#include "BenchmarkCommon.h"
+
+// フレームごとの一時オブジェクトをMemoryArenaで確保する場合とnew/deleteの比較
+// 1フレーム分(100kオブジェクト)の確保→1回走査→全解放を1回として測る
+namespace
+{
+	const uint32_t kObjectCount = 100000;
+	const int kTrialCount = 20;
+	// 1フレーム分が1ブロックに収まる大きさ
+	const size_t kFrameBlockSize = 16 * 1024 * 1024;
+
+	// デストラクタの要らない一時データ(描画コマンド程度の大きさ)
+	struct TrivialObject {
+		explicit TrivialObject(uint32_t value) : id(value) {}
+		float position[3] = {};
+		float velocity[3] = {};
+		uint32_t id;
+	};
+
+	// デストラクタのあるもの(Resetでデストラクタを呼ぶ分の費用も含めて測る)
+	struct ObjectWithDestructor {
+		explicit ObjectWithDestructor(uint32_t value) : id(value) {}
+		~ObjectWithDestructor() { destroyedSum += id; }
+		uint32_t id;
+		float data[5] = {};
+		static inline uint64_t destroyedSum = 0;
+	};
+
+	template<typename T>
+	double MeasureNewDelete()
+	{
+		std::vector<T*> objects(kObjectCount);
+		return Benchmark::Measure(kTrialCount, [&]() {
+			for (uint32_t i = 0; i < kObjectCount; ++i) {
+				objects[i] = new T(i);
+			}
+			uint64_t sum = 0;
+			for (T* object : objects) {
+				sum += object->id;
+			}
+			for (T* object : objects) {
+				delete object;
+			}
+			Benchmark::Keep(sum);
+		});
+	}
+
+	// blockSizeが1フレーム分より小さいとResetで返した2つ目以降のブロックを毎フレーム確保し直すので、その差も見る
+	template<typename T>
+	double MeasureArena(size_t blockSize)
+	{
+		MemoryArena arena(blockSize);
+		arena.SetPoisoning(false);
+		std::vector<T*> objects(kObjectCount);
+		return Benchmark::Measure(kTrialCount, [&]() {
+			for (uint32_t i = 0; i < kObjectCount; ++i) {
+				objects[i] = arena.Create<T>(i);
+			}
+			uint64_t sum = 0;
+			for (T* object : objects) {
+				sum += object->id;
+			}
+			arena.Reset();
+			Benchmark::Keep(sum);
+		});
+	}
+
+	// 大きさがばらばらの生のメモリ(文字列・配列の一時領域)
+	double MeasureMixedMalloc()
+	{
+		std::vector<uint8_t*> blocks(kObjectCount);
+		return Benchmark::Measure(kTrialCount, [&]() {
+			for (uint32_t i = 0; i < kObjectCount; ++i) {
+				blocks[i] = new uint8_t[16 + (i * 37) % 240];
+				blocks[i][0] = uint8_t(i);
+			}
+			uint64_t sum = 0;
+			for (uint8_t* block : blocks) {
+				sum += block[0];
+				delete[] block;
+			}
+			Benchmark::Keep(sum);
+		});
+	}
+
+	double MeasureMixedArena(size_t blockSize)
+	{
+		MemoryArena arena(blockSize);
+		arena.SetPoisoning(false);
+		std::vector<uint8_t*> blocks(kObjectCount);
+		return Benchmark::Measure(kTrialCount, [&]() {
+			for (uint32_t i = 0; i < kObjectCount; ++i) {
+				blocks[i] = static_cast<uint8_t*>(arena.Allocate(16 + (i * 37) % 240, 16));
+				blocks[i][0] = uint8_t(i);
+			}
+			uint64_t sum = 0;
+			for (uint8_t* block : blocks) {
+				sum += block[0];
+			}
+			arena.Reset();
+			Benchmark::Keep(sum);
+		});
+	}
+}
+
+int main()
+{
+	std::printf("%u objects per frame (items = objects)\n", kObjectCount);
+	Benchmark::Report("trivial new/delete", MeasureNewDelete<TrivialObject>(), kObjectCount);
+	Benchmark::Report("trivial MemoryArena 64KB blocks", MeasureArena<TrivialObject>(MemoryArena::kDefaultBlockSize), kObjectCount);
+	Benchmark::Report("trivial MemoryArena frame-sized block", MeasureArena<TrivialObject>(kFrameBlockSize), kObjectCount);
+	Benchmark::Report("with destructor new/delete", MeasureNewDelete<ObjectWithDestructor>(), kObjectCount);
+	Benchmark::Report("with destructor MemoryArena 64KB blocks", MeasureArena<ObjectWithDestructor>(MemoryArena::kDefaultBlockSize), kObjectCount);
+	Benchmark::Report("with destructor MemoryArena frame-sized block", MeasureArena<ObjectWithDestructor>(kFrameBlockSize), kObjectCount);
+	Benchmark::Report("mixed sizes new[]/delete[]", MeasureMixedMalloc(), kObjectCount);
+	Benchmark::Report("mixed sizes MemoryArena 64KB blocks", MeasureMixedArena(MemoryArena::kDefaultBlockSize), kObjectCount);
+	Benchmark::Report("mixed sizes MemoryArena frame-sized block", MeasureMixedArena(kFrameBlockSize), kObjectCount);
+
+	// 埋め値あり(Debugビルドの既定)の費用
+	MemoryArena arena(kFrameBlockSize);
+	arena.SetPoisoning(true);
+	double poisoned = Benchmark::Measure(kTrialCount, [&]() {
+		for (uint32_t i = 0; i < kObjectCount; ++i) {
+			arena.Create<TrivialObject>(i);
+		}
+		arena.Reset();
+	});
+	Benchmark::Report("trivial MemoryArena frame-sized with poisoning", poisoned, kObjectCount);
+	Benchmark::Keep(ObjectWithDestructor::destroyedSum);
+	return 0;
+}
@@ -0,0 +1,130 @@
+#include "MemoryArena.h"
+#include "TestCommon.h"
+
+#include <stdexcept>
+#include <string>
+
+namespace {
+	// 破棄の順番を記録する
+	struct Tracked {
+		std::vector<int>* order;
+		int id;
+		Tracked(std::vector<int>* order, int id) : order(order), id(id) {}
+		~Tracked() { order->push_back(id); }
+	};
+
+	// コンストラクタで例外を投げる
+	struct Throwing {
+		std::string name;
+		explicit Throwing(bool isThrow) : name("throwing") {
+			if (isThrow) {
+				throw std::runtime_error("construct");
+			}
+		}
+	};
+
+	struct alignas(64) Aligned {
+		float values[4];
+	};
+
+	bool IsAligned(const void* p, size_t alignment) {
+		return (reinterpret_cast<uintptr_t>(p) & (alignment - 1)) == 0;
+	}
+
+	// --- アラインメント・ブロックの追加 ---
+	void TestAllocate()
+	{
+		MemoryArena arena(256);
+		void* a = arena.Allocate(3, 1);
+		void* b = arena.Allocate(8, 8);
+		void* c = arena.Allocate(16, 32);
+		CHECK(IsAligned(b, 8));
+		CHECK(IsAligned(c, 32));
+		CHECK(static_cast<uint8_t*>(b) >= static_cast<uint8_t*>(a) + 3);
+		CHECK(arena.GetReservedBytes() == 256);
+
+		// 収まらなければ次のブロック
+		arena.Allocate(250, 1);
+		CHECK(arena.GetReservedBytes() == 512);
+
+		// 大きいものは専用のブロック
+		void* large = arena.Allocate(1000, 16);
+		CHECK(IsAligned(large, 16));
+		CHECK(arena.GetReservedBytes() == 512 + 1016);
+
+		Aligned* aligned = arena.Create<Aligned>();
+		CHECK(IsAligned(aligned, 64));
+		CHECK(arena.GetObjectCount() == 1);
+	}
+
+	// --- 生成の逆順に破棄し、デストラクタが不要なものは記録しない ---
+	void TestDestructionOrder()
+	{
+		std::vector<int> order;
+		{
+			MemoryArena arena(128);
+			for (int i = 0; i < 20; ++i) {
+				arena.Create<Tracked>(&order, i);
+				arena.Create<int>(i);
+			}
+			CHECK(arena.GetObjectCount() == 40);
+			CHECK(order.empty());
+		}
+		CHECK(order.size() == 20);
+		bool isReversed = true;
+		for (int i = 0; i < int(order.size()); ++i) {
+			isReversed = isReversed && order[i] == 19 - i;
+		}
+		CHECK(isReversed);
+	}
+
+	// --- 生成に失敗したものは破棄しない ---
+	void TestThrowingConstructor()
+	{
+		MemoryArena arena;
+		arena.Create<Throwing>(false);
+		bool isThrown = false;
+		try {
+			arena.Create<Throwing>(true);
+		}
+		catch (const std::runtime_error&) {
+			isThrown = true;
+		}
+		CHECK(isThrown);
+		CHECK(arena.GetObjectCount() == 1);
+		// 失敗したものの破棄が呼ばれればここで壊れる
+		arena.Reset();
+		CHECK(arena.GetObjectCount() == 0);
+	}
+
+	// --- Resetで最初のブロックを残して使い回す ---
+	void TestReset()
+	{
+		MemoryArena arena(256);
+		arena.SetPoisoning(true);
+		uint8_t* first = static_cast<uint8_t*>(arena.Allocate(16, 16));
+		CHECK(first[0] == MemoryArena::kAllocatedPattern && first[15] == MemoryArena::kAllocatedPattern);
+		arena.Allocate(1000, 16);
+		CHECK(arena.GetUsedBytes() >= 1016);
+
+		arena.Reset();
+		CHECK(arena.GetUsedBytes() == 0);
+		CHECK(arena.GetReservedBytes() == 256);
+		// 解放したメモリは埋められている
+		CHECK(first[0] == MemoryArena::kFreedPattern && first[15] == MemoryArena::kFreedPattern);
+
+		// 同じ場所から切り出し直す
+		void* again = arena.Allocate(16, 16);
+		CHECK(again == first);
+		CHECK(arena.GetUsedBytes() == 16);
+	}
+}
+
+int main()
+{
+	TestAllocate();
+	TestDestructionOrder();
+	TestThrowingConstructor();
+	TestReset();
+	return Test::Finish("MemoryArenaTest");
+}
@@ -0,0 +1,165 @@
+#include "ObjectPool.h"
+
+#include "TestCommon.h"
+
+namespace
+{
+	// 生成・初期化・リセットの回数を数えるオブジェクト
+	// initializerがGPUバッファの作成、resetterが返却時の初期値への書き戻しに当たる
+	struct Counted {
+		Counted() { constructCount++; }
+		~Counted() { destroyCount++; }
+
+		int buffer = 0;		// initializerで作る(0なら未初期化)
+		int state = 0;		// 使用者が書き換える
+
+		static inline int constructCount = 0;
+		static inline int destroyCount = 0;
+	};
+
+	struct Counters {
+		int initializeCount = 0;
+		int resetCount = 0;
+	};
+
+	void InitializePool(ObjectPool<Counted>& pool, uint32_t capacity, Counters& counters)
+	{
+		pool.Initialize(capacity,
+			[&counters](Counted& object) { object.buffer = ++counters.initializeCount; },
+			[&counters](Counted& object) { object.state = 0; counters.resetCount++; });
+	}
+
+	void TestChurnDoesNotConstruct()
+	{
+		const uint32_t kCapacity = 16;
+		Counted::constructCount = 0;
+		Counted::destroyCount = 0;
+		Counters counters;
+		{
+			ObjectPool<Counted> pool;
+			InitializePool(pool, kCapacity, counters);
+			CHECK(Counted::constructCount == int(kCapacity));
+			CHECK(counters.initializeCount == int(kCapacity));
+
+			// --- 全部出して戻すのを繰り返す(GamePlaySceneの生成・破棄と同じ使い方) ---
+			std::vector<Counted*> acquired;
+			for (int churn = 0; churn < 100; ++churn) {
+				while (Counted* object = pool.Acquire()) {
+					// 前の使用者の状態は残っていない
+					CHECK(object->state == 0);
+					CHECK(object->buffer != 0);
+					object->state = churn + 1;
+					acquired.push_back(object);
+				}
+				for (Counted* object : acquired) {
+					pool.Release(object);
+				}
+				acquired.clear();
+			}
+
+			// 取得・返却では生成も初期化もしない
+			CHECK(Counted::constructCount == int(kCapacity));
+			CHECK(Counted::destroyCount == 0);
+			CHECK(counters.initializeCount == int(kCapacity));
+			CHECK(counters.resetCount == int(kCapacity) * 100);
+		}
+		CHECK(Counted::destroyCount == int(kCapacity));
+	}
+
+	void TestAcquireRelease()
+	{
+		Counters counters;
+		ObjectPool<Counted> pool;
+		InitializePool(pool, 4, counters);
+
+		// 先頭から順に取り出され、返したものが次に取り出される
+		Counted* a = pool.Acquire();
+		Counted* b = pool.Acquire();
+		CHECK(b == a + 1);
+		CHECK(pool.Contains(a));
+		CHECK(pool.GetActiveCount() == 2);
+		pool.Release(a);
+		CHECK(pool.Acquire() == a);
+
+		// プール外のものは含まない
+		Counted outside;
+		CHECK(!pool.Contains(&outside));
+
+		// 使用中のものだけを巡回
+		a->state = 10;
+		b->state = 20;
+		int sum = 0;
+		int count = 0;
+		pool.ForEachActive([&](Counted& object) { sum += object.state; count++; });
+		CHECK(count == 2);
+		CHECK(sum == 30);
+	}
+
+	void TestStatistics()
+	{
+		Counters counters;
+		ObjectPool<Counted> pool;
+		InitializePool(pool, 8, counters);
+		CHECK(pool.GetHighWaterMark() == 0);
+		CHECK(pool.GetExhaustedCount() == 0);
+
+		// --- 同時に使った最大数を覚えている ---
+		std::vector<Counted*> acquired;
+		for (int i = 0; i < 5; ++i) {
+			acquired.push_back(pool.Acquire());
+		}
+		CHECK(pool.GetHighWaterMark() == 5);
+		for (int i = 0; i < 3; ++i) {
+			pool.Release(acquired.back());
+			acquired.pop_back();
+		}
+		CHECK(pool.GetActiveCount() == 2);
+		CHECK(pool.GetHighWaterMark() == 5);
+		for (int i = 0; i < 2; ++i) {
+			acquired.push_back(pool.Acquire());
+		}
+		CHECK(pool.GetHighWaterMark() == 5);
+
+		// --- 空きが無ければnullptrで、失敗した回数を数える ---
+		while (acquired.size() < 8) {
+			acquired.push_back(pool.Acquire());
+		}
+		CHECK(pool.GetHighWaterMark() == 8);
+		CHECK(pool.Acquire() == nullptr);
+		CHECK(pool.Acquire() == nullptr);
+		CHECK(pool.GetExhaustedCount() == 2);
+		CHECK(pool.GetActiveCount() == 8);
+
+		// 返せばまた取れる(失敗した回数は減らない)
+		pool.Release(acquired.back());
+		CHECK(pool.Acquire() == acquired.back());
+		CHECK(pool.GetExhaustedCount() == 2);
+
+		// --- 初期化し直すと統計も最初から ---
+		InitializePool(pool, 2, counters);
+		CHECK(pool.GetHighWaterMark() == 0);
+		CHECK(pool.GetExhaustedCount() == 0);
+		CHECK(pool.GetActiveCount() == 0);
+		CHECK(pool.GetCapacity() == 2);
+	}
+
+	void TestWithoutResetter()
+	{
+		ObjectPool<Counted> pool;
+		pool.Initialize(2, [](Counted& object) { object.buffer = 1; });
+		Counted* object = pool.Acquire();
+		object->state = 5;
+		pool.Release(object);
+		// リセットしなければ状態は残る
+		CHECK(pool.Acquire()->state == 5);
+	}
+}
+
+int main()
+{
+	TestChurnDoesNotConstruct();
+	TestAcquireRelease();
+	TestStatistics();
+	TestWithoutResetter();
+	return Test::Finish("ObjectPoolTest");
+}
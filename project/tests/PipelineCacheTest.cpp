@@ -0,0 +1,328 @@
+#include "PipelineCache.h"
+#include "Hash.h"
+#include "TestCommon.h"
+
+#include <cstring>
+#include <functional>
+#include <string>
+
+namespace {
+	// パディングに入れるゴミ(同じ記述でもパディングの中身だけ違う2つを作る)
+	constexpr uint8_t kFills[] = { 0x00, 0xCD };
+
+	// 記述の構造体はmemsetでパディングまで埋めてからメンバを設定する
+	template<typename T>
+	void Fill(T& value, uint8_t fill) { std::memset(static_cast<void*>(&value), fill, sizeof(T)); }
+
+	// --- Object3dと同じ形のルートシグネチャ(CBV・テーブル・CBV・定数 + サンプラー) ---
+	struct RootSignatureFixture {
+		D3D12_DESCRIPTOR_RANGE ranges[2];
+		D3D12_ROOT_PARAMETER parameters[4];
+		D3D12_STATIC_SAMPLER_DESC samplers[1];
+		D3D12_ROOT_SIGNATURE_DESC desc;
+
+		explicit RootSignatureFixture(uint8_t fill) {
+			Fill(ranges, fill);
+			Fill(parameters, fill);
+			Fill(samplers, fill);
+			Fill(desc, fill);
+			for (UINT i = 0; i < 2; ++i) {
+				ranges[i].RangeType = D3D12_DESCRIPTOR_RANGE_TYPE_SRV;
+				ranges[i].NumDescriptors = 1;
+				ranges[i].BaseShaderRegister = i;
+				ranges[i].RegisterSpace = 0;
+				ranges[i].OffsetInDescriptorsFromTableStart = D3D12_DESCRIPTOR_RANGE_OFFSET_APPEND;
+			}
+			parameters[0].ParameterType = D3D12_ROOT_PARAMETER_TYPE_CBV;
+			parameters[0].ShaderVisibility = D3D12_SHADER_VISIBILITY_PIXEL;
+			parameters[0].Descriptor.ShaderRegister = 0;
+			parameters[0].Descriptor.RegisterSpace = 0;
+			parameters[1].ParameterType = D3D12_ROOT_PARAMETER_TYPE_CBV;
+			parameters[1].ShaderVisibility = D3D12_SHADER_VISIBILITY_VERTEX;
+			parameters[1].Descriptor.ShaderRegister = 0;
+			parameters[1].Descriptor.RegisterSpace = 0;
+			parameters[2].ParameterType = D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE;
+			parameters[2].ShaderVisibility = D3D12_SHADER_VISIBILITY_PIXEL;
+			parameters[2].DescriptorTable.NumDescriptorRanges = 2;
+			parameters[2].DescriptorTable.pDescriptorRanges = ranges;
+			parameters[3].ParameterType = D3D12_ROOT_PARAMETER_TYPE_32BIT_CONSTANTS;
+			parameters[3].ShaderVisibility = D3D12_SHADER_VISIBILITY_ALL;
+			parameters[3].Constants.ShaderRegister = 1;
+			parameters[3].Constants.RegisterSpace = 0;
+			parameters[3].Constants.Num32BitValues = 4;
+
+			samplers[0].Filter = D3D12_FILTER_MIN_MAG_MIP_LINEAR;
+			samplers[0].AddressU = D3D12_TEXTURE_ADDRESS_MODE_WRAP;
+			samplers[0].AddressV = D3D12_TEXTURE_ADDRESS_MODE_WRAP;
+			samplers[0].AddressW = D3D12_TEXTURE_ADDRESS_MODE_WRAP;
+			samplers[0].MipLODBias = 0.0f;
+			samplers[0].MaxAnisotropy = 16;
+			samplers[0].ComparisonFunc = D3D12_COMPARISON_FUNC_NEVER;
+			samplers[0].BorderColor = D3D12_STATIC_BORDER_COLOR_OPAQUE_BLACK;
+			samplers[0].MinLOD = 0.0f;
+			samplers[0].MaxLOD = D3D12_FLOAT32_MAX;
+			samplers[0].ShaderRegister = 0;
+			samplers[0].RegisterSpace = 0;
+			samplers[0].ShaderVisibility = D3D12_SHADER_VISIBILITY_PIXEL;
+
+			desc.Flags = D3D12_ROOT_SIGNATURE_FLAG_ALLOW_INPUT_ASSEMBLER_INPUT_LAYOUT;
+			desc.NumParameters = 4;
+			desc.pParameters = parameters;
+			desc.NumStaticSamplers = 1;
+			desc.pStaticSamplers = samplers;
+		}
+		RootSignatureFixture(const RootSignatureFixture&) = delete;
+		RootSignatureFixture& operator=(const RootSignatureFixture&) = delete;
+
+		std::vector<uint8_t> Serialize() const { return PipelineCache::SerializeRootSignature(desc); }
+	};
+
+	// --- Object3dと同じ形のPSO ---
+	struct PipelineFixture {
+		// シェーダーとセマンティクス名は毎回別のメモリに置く(ポインタではなく中身で比べていることを見る)
+		std::vector<uint8_t> vertexShader;
+		std::vector<uint8_t> pixelShader;
+		std::string semanticNames[3];
+		D3D12_INPUT_ELEMENT_DESC elements[3];
+		D3D12_GRAPHICS_PIPELINE_STATE_DESC desc;
+		std::vector<uint8_t> rootSignatureDescription;
+
+		explicit PipelineFixture(uint8_t fill) {
+			vertexShader = { 'D', 'X', 'B', 'C', 1, 2, 3, 4 };
+			pixelShader = { 'D', 'X', 'B', 'C', 5, 6, 7, 8, 9 };
+			semanticNames[0] = "POSITION";
+			semanticNames[1] = "TEXCOORD";
+			semanticNames[2] = "NORMAL";
+			const DXGI_FORMAT formats[3] = { DXGI_FORMAT_R32G32B32A32_FLOAT, DXGI_FORMAT_R32G32_FLOAT, DXGI_FORMAT_R32G32B32_FLOAT };
+			Fill(elements, fill);
+			for (UINT i = 0; i < 3; ++i) {
+				elements[i].SemanticName = semanticNames[i].c_str();
+				elements[i].SemanticIndex = 0;
+				elements[i].Format = formats[i];
+				elements[i].InputSlot = 0;
+				elements[i].AlignedByteOffset = D3D12_APPEND_ALIGNED_ELEMENT;
+				elements[i].InputSlotClass = D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA;
+				elements[i].InstanceDataStepRate = 0;
+			}
+
+			Fill(desc, fill);
+			// ルートシグネチャはポインタではなく記述で比べるので、毎回違うポインタにする
+			desc.pRootSignature = reinterpret_cast<ID3D12RootSignature*>(uintptr_t(0x1000) * (fill + 1));
+			desc.VS = { vertexShader.data(), vertexShader.size() };
+			desc.PS = { pixelShader.data(), pixelShader.size() };
+			desc.DS = { nullptr, 0 };
+			desc.HS = { nullptr, 0 };
+			desc.GS = { nullptr, 0 };
+			desc.StreamOutput.NumEntries = 0;
+
+			desc.BlendState.AlphaToCoverageEnable = false;
+			desc.BlendState.IndependentBlendEnable = false;
+			for (D3D12_RENDER_TARGET_BLEND_DESC& blend : desc.BlendState.RenderTarget) {
+				blend.BlendEnable = true;
+				blend.LogicOpEnable = false;
+				blend.SrcBlend = D3D12_BLEND_SRC_ALPHA;
+				blend.DestBlend = D3D12_BLEND_INV_SRC_ALPHA;
+				blend.BlendOp = D3D12_BLEND_OP_ADD;
+				blend.SrcBlendAlpha = D3D12_BLEND_ONE;
+				blend.DestBlendAlpha = D3D12_BLEND_ZERO;
+				blend.BlendOpAlpha = D3D12_BLEND_OP_ADD;
+				blend.LogicOp = D3D12_LOGIC_OP_NOOP;
+				blend.RenderTargetWriteMask = D3D12_COLOR_WRITE_ENABLE_ALL;
+			}
+			desc.SampleMask = UINT32_MAX;
+
+			desc.RasterizerState.FillMode = D3D12_FILL_MODE_SOLID;
+			desc.RasterizerState.CullMode = D3D12_CULL_MODE_BACK;
+			desc.RasterizerState.FrontCounterClockwise = false;
+			desc.RasterizerState.DepthBias = 0;
+			desc.RasterizerState.DepthBiasClamp = 0.0f;
+			desc.RasterizerState.SlopeScaledDepthBias = 0.0f;
+			desc.RasterizerState.DepthClipEnable = true;
+			desc.RasterizerState.MultisampleEnable = false;
+			desc.RasterizerState.AntialiasedLineEnable = false;
+			desc.RasterizerState.ForcedSampleCount = 0;
+			desc.RasterizerState.ConservativeRaster = D3D12_CONSERVATIVE_RASTERIZATION_MODE_OFF;
+
+			desc.DepthStencilState.DepthEnable = true;
+			desc.DepthStencilState.DepthWriteMask = D3D12_DEPTH_WRITE_MASK_ALL;
+			desc.DepthStencilState.DepthFunc = D3D12_COMPARISON_FUNC_LESS_EQUAL;
+			desc.DepthStencilState.StencilEnable = false;
+			desc.DepthStencilState.StencilReadMask = 0xff;
+			desc.DepthStencilState.StencilWriteMask = 0xff;
+			for (D3D12_DEPTH_STENCILOP_DESC* face : { &desc.DepthStencilState.FrontFace, &desc.DepthStencilState.BackFace }) {
+				face->StencilFailOp = D3D12_STENCIL_OP_KEEP;
+				face->StencilDepthFailOp = D3D12_STENCIL_OP_KEEP;
+				face->StencilPassOp = D3D12_STENCIL_OP_KEEP;
+				face->StencilFunc = D3D12_COMPARISON_FUNC_ALWAYS;
+			}
+
+			desc.InputLayout = { elements, 3 };
+			desc.IBStripCutValue = D3D12_INDEX_BUFFER_STRIP_CUT_VALUE_DISABLED;
+			desc.PrimitiveTopologyType = D3D12_PRIMITIVE_TOPOLOGY_TYPE_TRIANGLE;
+			desc.NumRenderTargets = 1;
+			for (DXGI_FORMAT& format : desc.RTVFormats) {
+				format = DXGI_FORMAT_UNKNOWN;
+			}
+			desc.RTVFormats[0] = DXGI_FORMAT_R8G8B8A8_UNORM_SRGB;
+			desc.DSVFormat = DXGI_FORMAT_D24_UNORM_S8_UINT;
+			desc.SampleDesc = { 1, 0 };
+			desc.NodeMask = 0;
+			desc.CachedPSO = { nullptr, 0 };
+			desc.Flags = D3D12_PIPELINE_STATE_FLAG_NONE;
+
+			RootSignatureFixture rootSignature(fill);
+			rootSignatureDescription = rootSignature.Serialize();
+		}
+		PipelineFixture(const PipelineFixture&) = delete;
+		PipelineFixture& operator=(const PipelineFixture&) = delete;
+
+		std::vector<uint8_t> Serialize() const { return PipelineCache::SerializeGraphicsPipeline(desc, rootSignatureDescription); }
+	};
+
+	uint64_t KeyOf(const std::vector<uint8_t>& description) { return Hash::Compute(description.data(), description.size()); }
+
+	// --- 同じ記述は、パディングの中身やポインタが違っても同じキーになる ---
+	void TestIdenticalDescriptions()
+	{
+		RootSignatureFixture rootSignatureA(kFills[0]);
+		RootSignatureFixture rootSignatureB(kFills[1]);
+		CHECK(rootSignatureA.Serialize() == rootSignatureB.Serialize());
+		CHECK(KeyOf(rootSignatureA.Serialize()) == KeyOf(rootSignatureB.Serialize()));
+
+		PipelineFixture pipelineA(kFills[0]);
+		PipelineFixture pipelineB(kFills[1]);
+		CHECK(pipelineA.desc.VS.pShaderBytecode != pipelineB.desc.VS.pShaderBytecode);
+		CHECK(pipelineA.elements[0].SemanticName != pipelineB.elements[0].SemanticName);
+		CHECK(pipelineA.Serialize() == pipelineB.Serialize());
+		CHECK(KeyOf(pipelineA.Serialize()) == KeyOf(pipelineB.Serialize()));
+
+		// キャッシュ済みPSOのBlobは作り方の指定で、記述には含めない
+		uint8_t cachedBlob[4] = {};
+		pipelineB.desc.CachedPSO = { cachedBlob, sizeof(cachedBlob) };
+		CHECK(pipelineA.Serialize() == pipelineB.Serialize());
+	}
+
+	// --- パディングの中身がバイト列に出てこない ---
+	void TestPaddingNeverReachesKey()
+	{
+		// 埋める値を変えるとバイト列のどこかが変わるなら、そこはパディングを読んでいる
+		// 全バイトで試すのは重いので、0x00とよく使われる値・全ビットの組で見る
+		const std::vector<uint8_t> reference = PipelineFixture(0x00).Serialize();
+		const std::vector<uint8_t> referenceRoot = RootSignatureFixture(0x00).Serialize();
+		for (uint8_t fill : { uint8_t(0x01), uint8_t(0x5A), uint8_t(0xA5), uint8_t(0xCD), uint8_t(0xFF) }) {
+			CHECK(PipelineFixture(fill).Serialize() == reference);
+			CHECK(RootSignatureFixture(fill).Serialize() == referenceRoot);
+		}
+	}
+
+	// --- どのメンバを変えてもキーが変わる ---
+	void TestEveryFieldChangesKey()
+	{
+		const std::vector<std::function<void(RootSignatureFixture&)>> rootSignatureChanges = {
+			[](RootSignatureFixture& f) { f.desc.Flags = D3D12_ROOT_SIGNATURE_FLAG_NONE; },
+			[](RootSignatureFixture& f) { f.desc.NumParameters = 3; },
+			[](RootSignatureFixture& f) { f.parameters[0].ParameterType = D3D12_ROOT_PARAMETER_TYPE_SRV; },
+			[](RootSignatureFixture& f) { f.parameters[0].ShaderVisibility = D3D12_SHADER_VISIBILITY_ALL; },
+			[](RootSignatureFixture& f) { f.parameters[0].Descriptor.ShaderRegister = 1; },
+			[](RootSignatureFixture& f) { f.parameters[1].Descriptor.RegisterSpace = 1; },
+			[](RootSignatureFixture& f) { f.parameters[2].DescriptorTable.NumDescriptorRanges = 1; },
+			[](RootSignatureFixture& f) { f.ranges[1].RangeType = D3D12_DESCRIPTOR_RANGE_TYPE_CBV; },
+			[](RootSignatureFixture& f) { f.ranges[1].NumDescriptors = 2; },
+			[](RootSignatureFixture& f) { f.ranges[1].BaseShaderRegister = 3; },
+			[](RootSignatureFixture& f) { f.ranges[1].RegisterSpace = 1; },
+			[](RootSignatureFixture& f) { f.ranges[0].OffsetInDescriptorsFromTableStart = 0; },
+			[](RootSignatureFixture& f) { f.parameters[3].Constants.ShaderRegister = 2; },
+			[](RootSignatureFixture& f) { f.parameters[3].Constants.Num32BitValues = 8; },
+			[](RootSignatureFixture& f) { f.desc.NumStaticSamplers = 0; },
+			[](RootSignatureFixture& f) { f.samplers[0].Filter = D3D12_FILTER_ANISOTROPIC; },
+			[](RootSignatureFixture& f) { f.samplers[0].AddressV = D3D12_TEXTURE_ADDRESS_MODE_CLAMP; },
+			[](RootSignatureFixture& f) { f.samplers[0].MipLODBias = 0.5f; },
+			[](RootSignatureFixture& f) { f.samplers[0].MaxLOD = 4.0f; },
+			[](RootSignatureFixture& f) { f.samplers[0].BorderColor = D3D12_STATIC_BORDER_COLOR_OPAQUE_WHITE; },
+			[](RootSignatureFixture& f) { f.samplers[0].ShaderRegister = 1; },
+			[](RootSignatureFixture& f) { f.samplers[0].ShaderVisibility = D3D12_SHADER_VISIBILITY_ALL; },
+		};
+		const uint64_t rootSignatureKey = KeyOf(RootSignatureFixture(0).Serialize());
+		for (const auto& change : rootSignatureChanges) {
+			RootSignatureFixture fixture(0);
+			change(fixture);
+			CHECK(KeyOf(fixture.Serialize()) != rootSignatureKey);
+		}
+
+		const std::vector<std::function<void(PipelineFixture&)>> pipelineChanges = {
+			[](PipelineFixture& f) { f.vertexShader[5] ^= 1; },
+			[](PipelineFixture& f) { f.desc.VS.BytecodeLength--; },
+			[](PipelineFixture& f) { f.pixelShader[8] ^= 1; },
+			// 同じバイト列がVSとPSのどちらにあるかも区別する
+			[](PipelineFixture& f) { std::swap(f.desc.VS, f.desc.PS); },
+			[](PipelineFixture& f) { f.desc.GS = f.desc.PS; },
+			[](PipelineFixture& f) { f.desc.StreamOutput.NumEntries = 1; },
+			[](PipelineFixture& f) { f.desc.BlendState.AlphaToCoverageEnable = true; },
+			[](PipelineFixture& f) { f.desc.BlendState.IndependentBlendEnable = true; },
+			[](PipelineFixture& f) { f.desc.BlendState.RenderTarget[0].BlendEnable = false; },
+			[](PipelineFixture& f) { f.desc.BlendState.RenderTarget[0].LogicOpEnable = true; },
+			[](PipelineFixture& f) { f.desc.BlendState.RenderTarget[0].SrcBlend = D3D12_BLEND_ONE; },
+			[](PipelineFixture& f) { f.desc.BlendState.RenderTarget[0].DestBlend = D3D12_BLEND_ONE; },
+			[](PipelineFixture& f) { f.desc.BlendState.RenderTarget[0].BlendOp = D3D12_BLEND_OP_SUBTRACT; },
+			[](PipelineFixture& f) { f.desc.BlendState.RenderTarget[0].SrcBlendAlpha = D3D12_BLEND_ZERO; },
+			[](PipelineFixture& f) { f.desc.BlendState.RenderTarget[0].DestBlendAlpha = D3D12_BLEND_ONE; },
+			[](PipelineFixture& f) { f.desc.BlendState.RenderTarget[0].BlendOpAlpha = D3D12_BLEND_OP_SUBTRACT; },
+			[](PipelineFixture& f) { f.desc.BlendState.RenderTarget[0].LogicOp = D3D12_LOGIC_OP_CLEAR; },
+			[](PipelineFixture& f) { f.desc.BlendState.RenderTarget[7].RenderTargetWriteMask = D3D12_COLOR_WRITE_ENABLE_RED; },
+			[](PipelineFixture& f) { f.desc.SampleMask = 1; },
+			[](PipelineFixture& f) { f.desc.RasterizerState.FillMode = D3D12_FILL_MODE_WIREFRAME; },
+			[](PipelineFixture& f) { f.desc.RasterizerState.CullMode = D3D12_CULL_MODE_NONE; },
+			[](PipelineFixture& f) { f.desc.RasterizerState.FrontCounterClockwise = true; },
+			[](PipelineFixture& f) { f.desc.RasterizerState.DepthBias = 1; },
+			[](PipelineFixture& f) { f.desc.RasterizerState.SlopeScaledDepthBias = 1.0f; },
+			[](PipelineFixture& f) { f.desc.RasterizerState.DepthClipEnable = false; },
+			[](PipelineFixture& f) { f.desc.RasterizerState.ConservativeRaster = D3D12_CONSERVATIVE_RASTERIZATION_MODE_ON; },
+			[](PipelineFixture& f) { f.desc.DepthStencilState.DepthEnable = false; },
+			[](PipelineFixture& f) { f.desc.DepthStencilState.DepthWriteMask = D3D12_DEPTH_WRITE_MASK_ZERO; },
+			[](PipelineFixture& f) { f.desc.DepthStencilState.DepthFunc = D3D12_COMPARISON_FUNC_LESS; },
+			[](PipelineFixture& f) { f.desc.DepthStencilState.StencilEnable = true; },
+			[](PipelineFixture& f) { f.desc.DepthStencilState.StencilReadMask = 0x0f; },
+			[](PipelineFixture& f) { f.desc.DepthStencilState.StencilWriteMask = 0x0f; },
+			[](PipelineFixture& f) { f.desc.DepthStencilState.FrontFace.StencilPassOp = D3D12_STENCIL_OP_REPLACE; },
+			[](PipelineFixture& f) { f.desc.DepthStencilState.BackFace.StencilFunc = D3D12_COMPARISON_FUNC_EQUAL; },
+			[](PipelineFixture& f) { f.desc.InputLayout.NumElements = 2; },
+			[](PipelineFixture& f) { f.semanticNames[1] = "COLOR"; f.elements[1].SemanticName = f.semanticNames[1].c_str(); },
+			[](PipelineFixture& f) { f.elements[1].SemanticIndex = 1; },
+			[](PipelineFixture& f) { f.elements[2].Format = DXGI_FORMAT_R32G32B32A32_FLOAT; },
+			[](PipelineFixture& f) { f.elements[2].InputSlot = 1; },
+			[](PipelineFixture& f) { f.elements[2].AlignedByteOffset = 24; },
+			[](PipelineFixture& f) { f.elements[2].InputSlotClass = D3D12_INPUT_CLASSIFICATION_PER_INSTANCE_DATA; },
+			[](PipelineFixture& f) { f.elements[2].InstanceDataStepRate = 1; },
+			[](PipelineFixture& f) { f.desc.IBStripCutValue = D3D12_INDEX_BUFFER_STRIP_CUT_VALUE_0xFFFF; },
+			[](PipelineFixture& f) { f.desc.PrimitiveTopologyType = D3D12_PRIMITIVE_TOPOLOGY_TYPE_LINE; },
+			[](PipelineFixture& f) { f.desc.NumRenderTargets = 2; },
+			[](PipelineFixture& f) { f.desc.RTVFormats[0] = DXGI_FORMAT_R8G8B8A8_UNORM; },
+			[](PipelineFixture& f) { f.desc.RTVFormats[7] = DXGI_FORMAT_R8G8B8A8_UNORM; },
+			[](PipelineFixture& f) { f.desc.DSVFormat = DXGI_FORMAT_D32_FLOAT; },
+			[](PipelineFixture& f) { f.desc.SampleDesc.Count = 4; },
+			[](PipelineFixture& f) { f.desc.SampleDesc.Quality = 1; },
+			[](PipelineFixture& f) { f.desc.NodeMask = 1; },
+			[](PipelineFixture& f) { f.desc.Flags = D3D12_PIPELINE_STATE_FLAG_TOOL_DEBUG; },
+			// ルートシグネチャの記述が変わればPSOも変わる
+			[](PipelineFixture& f) {
+				RootSignatureFixture rootSignature(0);
+				rootSignature.parameters[0].Descriptor.ShaderRegister = 1;
+				f.rootSignatureDescription = rootSignature.Serialize();
+			},
+		};
+		const uint64_t pipelineKey = KeyOf(PipelineFixture(0).Serialize());
+		for (const auto& change : pipelineChanges) {
+			PipelineFixture fixture(0);
+			change(fixture);
+			CHECK(KeyOf(fixture.Serialize()) != pipelineKey);
+		}
+	}
+}
+
+int main()
+{
+	TestIdenticalDescriptions();
+	TestPaddingNeverReachesKey();
+	TestEveryFieldChangesKey();
+	return Test::Finish("PipelineCacheTest");
+}
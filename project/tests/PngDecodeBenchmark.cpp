@@ -0,0 +1,132 @@
+#include <thread>
+#include <vector>
+#include <zlib.h>
+
+#include "BenchmarkCommon.h"
+#include "Inflate.h"
+#include "PngFilter.h"
+#include "ThreadPool.h"
+
+// PNGの展開(Inflate+フィルタ解除)を何枚も並列に行ったときのスレッド数ごとの速度
+// 圧縮はzlibで作り、PngDecoderと同じ手順で展開する(DirectXTexの出力先は含まない)
+namespace
+{
+	const uint32_t kWidth = 1024;
+	const uint32_t kHeight = 1024;
+	const size_t kBpp = 4;
+	const size_t kStride = kWidth * kBpp;
+	const uint32_t kImageCount = 32;
+
+	// グラデーション+ノイズのRGBA画像を行ごとのフィルタ(0〜4の繰り返し)付きでzlib圧縮
+	std::vector<uint8_t> MakeImage(uint32_t seed)
+	{
+		std::vector<uint8_t> raw((kStride + 1) * kHeight);
+		std::vector<uint8_t> prior(kStride, 0);
+		std::vector<uint8_t> row(kStride);
+		uint32_t state = seed * 2654435761u + 1;
+		for (uint32_t y = 0; y < kHeight; ++y) {
+			for (uint32_t x = 0; x < kWidth; ++x) {
+				state ^= state << 13;
+				state ^= state >> 17;
+				state ^= state << 5;
+				uint8_t noise = uint8_t(state & 7);
+				row[x * 4 + 0] = uint8_t(x + noise);
+				row[x * 4 + 1] = uint8_t(y + noise);
+				row[x * 4 + 2] = uint8_t((x + y + seed) / 2);
+				row[x * 4 + 3] = 255;
+			}
+			// Up/Subだけで十分だが解除側の分岐を全部通すため順に使う
+			uint8_t filter = uint8_t(y % 5);
+			uint8_t* out = raw.data() + (kStride + 1) * y;
+			out[0] = filter;
+			for (size_t i = 0; i < kStride; ++i) {
+				int32_t a = i >= kBpp ? row[i - kBpp] : 0;
+				int32_t b = prior[i];
+				int32_t c = i >= kBpp ? prior[i - kBpp] : 0;
+				int32_t predictor = 0;
+				switch (filter) {
+				case 1: predictor = a; break;
+				case 2: predictor = b; break;
+				case 3: predictor = (a + b) >> 1; break;
+				case 4: {
+					int32_t p = a + b - c;
+					int32_t pa = p > a ? p - a : a - p;
+					int32_t pb = p > b ? p - b : b - p;
+					int32_t pc = p > c ? p - c : c - p;
+					predictor = (pa <= pb && pa <= pc) ? a : (pb <= pc ? b : c);
+					break;
+				}
+				default: break;
+				}
+				out[i + 1] = uint8_t(row[i] - predictor);
+			}
+			prior = row;
+		}
+
+		uLongf size = compressBound(uLong(raw.size()));
+		std::vector<uint8_t> compressed(size);
+		compress2(compressed.data(), &size, raw.data(), uLong(raw.size()), 6);
+		compressed.resize(size);
+		return compressed;
+	}
+
+	// 1枚の展開(PngDecoder::Decodeの展開部分と同じ)
+	uint64_t Decode(const std::vector<uint8_t>& compressed)
+	{
+		const size_t rawSize = (kStride + 1) * kHeight;
+		std::vector<uint8_t> raw;
+		raw.reserve(rawSize);
+		if (!Inflate::DecompressZlib(compressed, raw, rawSize) || raw.size() < rawSize) {
+			return 0;
+		}
+		std::vector<uint8_t> zeroRow(kStride, 0);
+		const uint8_t* prior = zeroRow.data();
+		for (uint32_t y = 0; y < kHeight; ++y) {
+			uint8_t* row = raw.data() + (kStride + 1) * y;
+			PngFilter::UnfilterRow(row[0], row + 1, prior, kStride, kBpp);
+			prior = row + 1;
+		}
+		return raw[raw.size() / 2];
+	}
+}
+
+int main()
+{
+	std::vector<std::vector<uint8_t>> images;
+	for (uint32_t i = 0; i < kImageCount; ++i) {
+		images.push_back(MakeImage(i));
+	}
+
+	// --- 結果が正しいことの確認(1枚だけ) ---
+	{
+		const std::vector<uint8_t>& compressed = images[0];
+		std::vector<uint8_t> expected((kStride + 1) * kHeight);
+		uLongf size = uLongf(expected.size());
+		uncompress(expected.data(), &size, compressed.data(), uLong(compressed.size()));
+		std::vector<uint8_t> raw;
+		if (!Inflate::DecompressZlib(compressed, raw) || raw != expected) {
+			std::printf("Inflate result mismatch\n");
+			return 1;
+		}
+	}
+
+	const double pixelCount = double(kWidth) * kHeight * kImageCount;
+	std::printf("%u images of %ux%u RGBA8 (items = pixels)\n", kImageCount, kWidth, kHeight);
+	uint32_t maxThreads = (std::max)(1u, std::thread::hardware_concurrency());
+	for (uint32_t threadCount = 1; threadCount <= maxThreads; threadCount *= 2) {
+		ThreadPool pool(threadCount);
+		double seconds = Benchmark::Measure(3, [&]() {
+			pool.ParallelFor(kImageCount, [&](uint32_t begin, uint32_t end) {
+				uint64_t sum = 0;
+				for (uint32_t i = begin; i < end; ++i) {
+					sum += Decode(images[i]);
+				}
+				Benchmark::Keep(sum);
+			});
+		});
+		char name[64];
+		std::snprintf(name, sizeof(name), "decode threads=%u", threadCount);
+		Benchmark::Report(name, seconds, pixelCount);
+	}
+	return 0;
+}
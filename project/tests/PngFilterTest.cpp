@@ -0,0 +1,115 @@
+#include "PngFilter.h"
+#include <cstdlib>
+#include <vector>
+
+#include "TestCommon.h"
+
+namespace
+{
+	// 疑似乱数(xorshift)
+	uint32_t Random(uint32_t& state)
+	{
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+		return state;
+	}
+
+	// Paeth予測(PNG仕様そのまま)
+	uint8_t Paeth(int32_t a, int32_t b, int32_t c)
+	{
+		int32_t p = a + b - c;
+		int32_t pa = std::abs(p - a);
+		int32_t pb = std::abs(p - b);
+		int32_t pc = std::abs(p - c);
+		if (pa <= pb && pa <= pc) {
+			return uint8_t(a);
+		}
+		return uint8_t(pb <= pc ? b : c);
+	}
+
+	// フィルタをかける(エンコーダ側。rowとpriorはフィルタ前)
+	std::vector<uint8_t> Filter(uint8_t filter, const std::vector<uint8_t>& row, const std::vector<uint8_t>& prior, size_t bpp)
+	{
+		std::vector<uint8_t> out(row.size());
+		for (size_t i = 0; i < row.size(); ++i) {
+			int32_t a = i >= bpp ? row[i - bpp] : 0;
+			int32_t b = prior[i];
+			int32_t c = i >= bpp ? prior[i - bpp] : 0;
+			int32_t predictor = 0;
+			switch (filter) {
+			case 1: predictor = a; break;
+			case 2: predictor = b; break;
+			case 3: predictor = (a + b) >> 1; break;
+			case 4: predictor = Paeth(a, b, c); break;
+			default: break;
+			}
+			out[i] = uint8_t(row[i] - predictor);
+		}
+		return out;
+	}
+
+	void TestAllFilters()
+	{
+		uint32_t state = 12345;
+		// SIMDの4・3バイト単位の端数やピクセル途中で終わる行も含める
+		const size_t strides[] = { 1, 3, 4, 7, 15, 16, 17, 48, 63, 255 };
+		const size_t bpps[] = { 1, 2, 3, 4, 6, 8 };
+		for (uint8_t filter = 0; filter <= 4; ++filter) {
+			for (size_t bpp : bpps) {
+				for (size_t stride : strides) {
+					// --- 前の行(解除済み)と元の行 ---
+					std::vector<uint8_t> prior(stride);
+					std::vector<uint8_t> original(stride);
+					for (size_t i = 0; i < stride; ++i) {
+						prior[i] = uint8_t(Random(state));
+						original[i] = uint8_t(Random(state));
+					}
+					std::vector<uint8_t> filtered = Filter(filter, original, prior, bpp);
+
+					// --- SIMD版・スカラー版ともに元に戻る ---
+					std::vector<uint8_t> simd = filtered;
+					std::vector<uint8_t> scalar = filtered;
+					CHECK(PngFilter::UnfilterRow(filter, simd.data(), prior.data(), stride, bpp));
+					CHECK(PngFilter::UnfilterRowScalar(filter, scalar.data(), prior.data(), stride, bpp));
+					CHECK(simd == scalar);
+					CHECK(scalar == original);
+				}
+			}
+		}
+	}
+
+	void TestFirstRow()
+	{
+		// 最初の行は前の行を0として解除する
+		const size_t stride = 40;
+		const size_t bpp = 4;
+		std::vector<uint8_t> zero(stride, 0);
+		uint32_t state = 777;
+		std::vector<uint8_t> original(stride);
+		for (uint8_t& value : original) {
+			value = uint8_t(Random(state));
+		}
+		for (uint8_t filter = 0; filter <= 4; ++filter) {
+			std::vector<uint8_t> row = Filter(filter, original, zero, bpp);
+			CHECK(PngFilter::UnfilterRow(filter, row.data(), zero.data(), stride, bpp));
+			CHECK(row == original);
+		}
+	}
+
+	void TestInvalidFilter()
+	{
+		std::vector<uint8_t> row(8, 1);
+		std::vector<uint8_t> prior(8, 2);
+		CHECK(!PngFilter::UnfilterRow(5, row.data(), prior.data(), row.size(), 4));
+		CHECK(!PngFilter::UnfilterRowScalar(255, row.data(), prior.data(), row.size(), 4));
+	}
+}
+
+int main()
+{
+	TestAllFilters();
+	TestFirstRow();
+	TestInvalidFilter();
+	return Test::Finish("PngFilterTest");
+}
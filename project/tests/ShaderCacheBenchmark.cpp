@@ -0,0 +1,73 @@
+#include "ShaderCache.h"
+#include "BenchmarkCommon.h"
+
+#include <fstream>
+
+// キャッシュにヒットしたときのコスト(キーの計算 + 読み込み)
+// DXCが無いのでコンパイルとの比較はできない。ヒット1回がフレームに対してどれだけかを見る
+namespace {
+	struct TestBlob : IDxcBlobEncoding {
+		std::vector<char> data;
+		void* GetBufferPointer() override { return data.data(); }
+		size_t GetBufferSize() override { return data.size(); }
+	};
+	struct TestUtils : IDxcUtils {
+		HRESULT CreateBlob(const void* data, UINT32 size, UINT32, IDxcBlobEncoding** blob) override {
+			TestBlob* testBlob = new TestBlob;
+			testBlob->data.assign(static_cast<const char*>(data), static_cast<const char*>(data) + size);
+			*blob = testBlob;
+			return S_OK;
+		}
+	};
+
+	void WriteText(const std::filesystem::path& path, const std::string& text) {
+		std::ofstream file(path, std::ios::binary | std::ios::trunc);
+		file << text;
+	}
+}
+
+int main()
+{
+	// --- 実際のシェーダー程度の大きさ(本体 + インクルード4つ、各8KB程度)を用意 ---
+	std::filesystem::path directory = std::filesystem::temp_directory_path() / "ShaderCacheBenchmark";
+	std::filesystem::remove_all(directory);
+	std::filesystem::create_directories(directory);
+	std::string body(8 * 1024, ' ');
+	std::string source;
+	for (int i = 0; i < 4; ++i) {
+		std::string name = "Include" + std::to_string(i) + ".hlsli";
+		WriteText(directory / name, "// " + name + "\n" + body + "\n");
+		source += "#include \"" + name + "\"\n";
+	}
+	WriteText(directory / "Shader.hlsl", source + body);
+
+	const std::vector<std::wstring> arguments = { L"-E", L"main", L"-T", L"ps_6_0", L"-O3", L"-Zpr" };
+	ShaderCache cache;
+	cache.Initialize(directory / "cache", 1);
+	uint64_t key = cache.ComputeKey(directory / "Shader.hlsl", arguments);
+
+	// 64KBのDXILを保存しておく
+	TestBlob* blob = new TestBlob;
+	blob->data.assign(64 * 1024, 'D');
+	cache.Store(key, blob);
+	blob->Release();
+
+	TestUtils utils;
+	const int kCount = 1000;
+	double computeKey = Benchmark::Measure(5, [&]() {
+		for (int i = 0; i < kCount; ++i) {
+			Benchmark::Keep(cache.ComputeKey(directory / "Shader.hlsl", arguments));
+		}
+		});
+	Benchmark::Report("ComputeKey (5 files, 40KB)", computeKey, kCount);
+	double hit = Benchmark::Measure(5, [&]() {
+		for (int i = 0; i < kCount; ++i) {
+			Microsoft::WRL::ComPtr<IDxcBlob> loaded = cache.Load(&utils, cache.ComputeKey(directory / "Shader.hlsl", arguments));
+			Benchmark::Keep(loaded->GetBufferSize());
+		}
+		});
+	Benchmark::Report("ComputeKey + Load (64KB DXIL)", hit, kCount);
+
+	std::filesystem::remove_all(directory);
+	return 0;
+}
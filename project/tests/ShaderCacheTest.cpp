@@ -0,0 +1,134 @@
+#include "ShaderCache.h"
+#include "TestCommon.h"
+
+#include <cstring>
+#include <fstream>
+
+namespace {
+	// CreateBlobで受け取った内容をそのまま持つBlob
+	struct TestBlob : IDxcBlobEncoding {
+		std::vector<char> data;
+		void* GetBufferPointer() override { return data.data(); }
+		size_t GetBufferSize() override { return data.size(); }
+	};
+	struct TestUtils : IDxcUtils {
+		HRESULT CreateBlob(const void* data, UINT32 size, UINT32, IDxcBlobEncoding** blob) override {
+			TestBlob* testBlob = new TestBlob;
+			testBlob->data.assign(static_cast<const char*>(data), static_cast<const char*>(data) + size);
+			*blob = testBlob;
+			return S_OK;
+		}
+	};
+
+	void WriteText(const std::filesystem::path& path, const std::string& text) {
+		std::ofstream file(path, std::ios::binary | std::ios::trunc);
+		file << text;
+	}
+
+	// テストごとの作業フォルダ
+	std::filesystem::path MakeDirectory(const char* name) {
+		std::filesystem::path directory = std::filesystem::temp_directory_path() / "ShaderCacheTest" / name;
+		std::filesystem::remove_all(directory);
+		std::filesystem::create_directories(directory / "include");
+		return directory;
+	}
+
+	const std::vector<std::wstring> kArguments = { L"-E", L"main", L"-T", L"vs_6_0", L"-O3" };
+
+	// --- インクルード先の編集でキーが変わる ---
+	void TestIncludeInvalidation()
+	{
+		std::filesystem::path directory = MakeDirectory("include");
+		WriteText(directory / "Object3d.VS.hlsl", "#include \"include/Object3d.hlsli\"\nfloat4 main() : SV_POSITION { return Transform(); }\n");
+		WriteText(directory / "include/Object3d.hlsli", "  #include \"Common.hlsli\"\nfloat4 Transform();\n");
+		WriteText(directory / "include/Common.hlsli", "#include \"Object3d.hlsli\"\nstatic const float kScale = 1.0f;\n");
+
+		ShaderCache cache;
+		cache.Initialize(directory / "cache", 1);
+		uint64_t key = cache.ComputeKey(directory / "Object3d.VS.hlsl", kArguments);
+		// 同じ内容なら何度計算しても(別のインスタンスでも)同じ。循環するインクルードでも止まる
+		CHECK(cache.ComputeKey(directory / "Object3d.VS.hlsl", kArguments) == key);
+		ShaderCache otherCache;
+		otherCache.Initialize(directory / "cache", 1);
+		CHECK(otherCache.ComputeKey(directory / "Object3d.VS.hlsl", kArguments) == key);
+
+		// 2段先のインクルードを編集すると変わり、戻すと戻る
+		WriteText(directory / "include/Common.hlsli", "#include \"Object3d.hlsli\"\nstatic const float kScale = 2.0f;\n");
+		uint64_t editedKey = cache.ComputeKey(directory / "Object3d.VS.hlsl", kArguments);
+		CHECK(editedKey != key);
+		WriteText(directory / "include/Common.hlsli", "#include \"Object3d.hlsli\"\nstatic const float kScale = 1.0f;\n");
+		CHECK(cache.ComputeKey(directory / "Object3d.VS.hlsl", kArguments) == key);
+
+		// 無かったインクルード先ができても変わる
+		WriteText(directory / "include/Object3d.hlsli", "#include \"Common.hlsli\"\n#include \"Light.hlsli\"\nfloat4 Transform();\n");
+		uint64_t missingKey = cache.ComputeKey(directory / "Object3d.VS.hlsl", kArguments);
+		WriteText(directory / "include/Light.hlsli", "float3 kLight;\n");
+		CHECK(cache.ComputeKey(directory / "Object3d.VS.hlsl", kArguments) != missingKey);
+	}
+
+	// --- 引数・コンパイラのバージョンでキーが変わる ---
+	void TestArgumentAndVersionInvalidation()
+	{
+		std::filesystem::path directory = MakeDirectory("arguments");
+		WriteText(directory / "Object3d.PS.hlsl", "float4 main() : SV_TARGET { return 1; }\n");
+		std::filesystem::path path = directory / "Object3d.PS.hlsl";
+
+		ShaderCache cache;
+		cache.Initialize(directory / "cache", 1);
+		uint64_t key = cache.ComputeKey(path, kArguments);
+
+		std::vector<std::wstring> arguments = kArguments;
+		arguments[3] = L"ps_6_0";
+		CHECK(cache.ComputeKey(path, arguments) != key);
+		arguments = kArguments;
+		arguments.pop_back();
+		CHECK(cache.ComputeKey(path, arguments) != key);
+		// 区切りが変わるだけでも変わる(長さも混ぜている)
+		arguments = { L"-E", L"main", L"-T", L"vs_6_0-O3" };
+		CHECK(cache.ComputeKey(path, arguments) != key);
+
+		ShaderCache newCompilerCache;
+		newCompilerCache.Initialize(directory / "cache", 2);
+		CHECK(newCompilerCache.ComputeKey(path, kArguments) != key);
+	}
+
+	// --- 保存したものだけが読める ---
+	void TestStoreAndLoad()
+	{
+		std::filesystem::path directory = MakeDirectory("store");
+		ShaderCache cache;
+		cache.Initialize(directory / "cache", 1);
+		TestUtils utils;
+
+		CHECK(cache.Load(&utils, 1) == nullptr);
+		CHECK(cache.GetMissCount() == 1);
+
+		TestBlob* blob = new TestBlob;
+		blob->data = { 'D', 'X', 'I', 'L', 0, 1, 2 };
+		Microsoft::WRL::ComPtr<IDxcBlob> stored;
+		*stored.GetAddressOf() = blob;
+		cache.Store(1, stored.Get());
+		CHECK(std::filesystem::exists(cache.GetCachePath(1)));
+		CHECK(cache.GetCachePath(1).filename() == "0000000000000001.dxil");
+
+		Microsoft::WRL::ComPtr<IDxcBlob> loaded = cache.Load(&utils, 1);
+		CHECK(loaded != nullptr);
+		CHECK(loaded && loaded->GetBufferSize() == blob->data.size() &&
+			std::memcmp(loaded->GetBufferPointer(), blob->data.data(), blob->data.size()) == 0);
+		CHECK(cache.GetHitCount() == 1);
+
+		// 空のファイルは壊れているものとして読まない
+		WriteText(cache.GetCachePath(2), "");
+		CHECK(cache.Load(&utils, 2) == nullptr);
+		CHECK(cache.GetMissCount() == 2);
+	}
+}
+
+int main()
+{
+	TestIncludeInvalidation();
+	TestArgumentAndVersionInvalidation();
+	TestStoreAndLoad();
+	std::filesystem::remove_all(std::filesystem::temp_directory_path() / "ShaderCacheTest");
+	return Test::Finish("ShaderCacheTest");
+}
@@ -0,0 +1,24 @@
+#pragma once
+#include <cstdio>
+
+// テスト用の簡易チェック
+// CHECKは失敗しても続け、最後にFinishの戻り値(失敗があれば1)をmainから返す
+namespace Test {
+	inline int checkCount = 0;
+	inline int failureCount = 0;
+
+	inline void Check(bool condition, const char* expression, const char* file, int line) {
+		checkCount++;
+		if (!condition) {
+			failureCount++;
+			std::printf("%s(%d): CHECK(%s) failed\n", file, line, expression);
+		}
+	}
+
+	inline int Finish(const char* name) {
+		std::printf("%s: %d checks, %d failures\n", name, checkCount, failureCount);
+		return failureCount == 0 ? 0 : 1;
+	}
+}
+
+#define CHECK(condition) Test::Check(bool(condition), #condition, __FILE__, __LINE__)
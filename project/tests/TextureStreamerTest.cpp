@@ -0,0 +1,227 @@
+#include "TextureStreamer.h"
+#include "TestCommon.h"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+
+namespace {
+	// RGBA8・size×sizeのテクスチャのミップごとのバイト数と、64px以下になる最初のミップ
+	std::vector<uint64_t> MakeMipSizes(uint32_t size, uint32_t& tailMip) {
+		std::vector<uint64_t> mipSizes;
+		tailMip = UINT32_MAX;
+		for (uint32_t mip = 0; size >> mip; ++mip) {
+			uint64_t width = size >> mip;
+			mipSizes.push_back(width * width * 4);
+			if (tailMip == UINT32_MAX && width <= 64) {
+				tailMip = mip;
+			}
+		}
+		return mipSizes;
+	}
+
+	uint64_t BytesFrom(const std::vector<uint64_t>& mipSizes, uint32_t mip) {
+		uint64_t bytes = 0;
+		for (uint32_t i = mip; i < mipSizes.size(); ++i) {
+			bytes += mipSizes[i];
+		}
+		return bytes;
+	}
+
+	// --- 画面上の大きさからのミップ ---
+	void TestComputeMipForSize()
+	{
+		CHECK(TextureStreamer::ComputeMipForSize(1024, 1024, 1024.0f, 1024.0f, 11) == 0);
+		CHECK(TextureStreamer::ComputeMipForSize(1024, 1024, 2048.0f, 2048.0f, 11) == 0);
+		CHECK(TextureStreamer::ComputeMipForSize(1024, 1024, 512.0f, 512.0f, 11) == 1);
+		// 1ピクセルに1テクセル以上(細かすぎない範囲で最も粗い)
+		CHECK(TextureStreamer::ComputeMipForSize(1024, 1024, 511.0f, 511.0f, 11) == 1);
+		CHECK(TextureStreamer::ComputeMipForSize(1024, 1024, 513.0f, 513.0f, 11) == 0);
+		CHECK(TextureStreamer::ComputeMipForSize(1024, 1024, 256.0f, 256.0f, 11) == 2);
+		CHECK(TextureStreamer::ComputeMipForSize(1024, 1024, 100.0f, 100.0f, 11) == 3);
+		// 大きい方の軸で決める
+		CHECK(TextureStreamer::ComputeMipForSize(1024, 256, 256.0f, 256.0f, 11) == 2);
+		CHECK(TextureStreamer::ComputeMipForSize(256, 1024, 256.0f, 64.0f, 11) == 4);
+		// ミップ数で止まる・0や負の大きさは1ピクセル扱い
+		CHECK(TextureStreamer::ComputeMipForSize(1024, 1024, 1.0f, 1.0f, 11) == 10);
+		CHECK(TextureStreamer::ComputeMipForSize(1024, 1024, 1.0f, 1.0f, 4) == 3);
+		CHECK(TextureStreamer::ComputeMipForSize(1024, 1024, 0.0f, 0.0f, 11) == 10);
+		CHECK(TextureStreamer::ComputeMipForSize(1024, 1024, -256.0f, 256.0f, 11) == 2);
+	}
+
+	// --- 最も長く要求されていないものから捨てる ---
+	void TestEvictsLeastRecentlyRequested()
+	{
+		uint32_t tailMip;
+		const std::vector<uint64_t> mipSizes = MakeMipSizes(1024, tailMip);
+		const uint64_t tailBytes = BytesFrom(mipSizes, tailMip);
+		const uint64_t fullBytes = BytesFrom(mipSizes, 0);
+
+		// 4枚の粗いミップ + 2枚分の全ミップが入る予算
+		TextureStreamer streamer;
+		streamer.SetBudget(tailBytes * 4 + (fullBytes - tailBytes) * 2);
+		uint32_t ids[4];
+		for (uint32_t& id : ids) {
+			id = streamer.Register(mipSizes, tailMip);
+			CHECK(streamer.GetResidentMip(id) == tailMip);
+		}
+		CHECK(streamer.GetResidentBytes() == tailBytes * 4);
+
+		// A・Bの順に要求すると、どちらも入る
+		streamer.RequestMip(ids[0], 0);
+		streamer.Update();
+		streamer.RequestMip(ids[1], 0);
+		streamer.Update();
+		CHECK(streamer.GetResidentMip(ids[0]) == 0);
+		CHECK(streamer.GetResidentMip(ids[1]) == 0);
+
+		// Cの分はAから空ける(Bより前に要求された)
+		streamer.RequestMip(ids[2], 0);
+		std::vector<TextureStreamer::Change> changes = streamer.Update();
+		CHECK(streamer.GetResidentMip(ids[2]) == 0);
+		CHECK(streamer.GetResidentMip(ids[0]) > 0);
+		CHECK(streamer.GetResidentMip(ids[1]) == 0);
+		CHECK(streamer.GetResidentBytes() <= streamer.GetBudget());
+		// 変更はID順に、Aを捨てた分とCを読んだ分
+		CHECK(changes.size() == 2 && changes[0].id == ids[0] && changes[1].id == ids[2]);
+
+		// Dの分はAを粗いミップまで捨ててから、次に古いBから空ける
+		streamer.RequestMip(ids[3], 0);
+		streamer.Update();
+		CHECK(streamer.GetResidentMip(ids[3]) == 0);
+		CHECK(streamer.GetResidentMip(ids[0]) == tailMip);
+		CHECK(streamer.GetResidentMip(ids[1]) > 0);
+		CHECK(streamer.GetResidentMip(ids[2]) == 0);
+
+		// 今フレーム要求されたものは要求より細かい分しか捨てない
+		// (全員が要求すると入り切らないので、後から来たものが粗いミップで妥協する)
+		for (uint32_t id : ids) {
+			streamer.RequestMip(id, 0);
+		}
+		streamer.Update();
+		CHECK(streamer.GetResidentMip(ids[2]) == 0);
+		CHECK(streamer.GetResidentMip(ids[3]) == 0);
+		CHECK(streamer.GetResidentBytes() <= streamer.GetBudget());
+
+		// 予算を下げると、使われていないものから粗いミップまで捨てる
+		streamer.SetBudget(tailBytes * 4 + (fullBytes - tailBytes));
+		streamer.RequestMip(ids[3], 0);
+		streamer.Update();
+		CHECK(streamer.GetResidentMip(ids[3]) == 0);
+		CHECK(streamer.GetResidentBytes() <= streamer.GetBudget());
+
+		// 登録解除でバイト数が戻る
+		for (uint32_t id : ids) {
+			streamer.Unregister(id);
+		}
+		CHECK(streamer.GetResidentBytes() == 0);
+	}
+
+	// --- カメラの移動に沿った常駐 ---
+	void TestCameraPath()
+	{
+		// 直線上に並ぶ物体(テクスチャは256〜2048px)を、カメラが端から端まで通り過ぎる
+		struct Object {
+			float position;
+			uint32_t textureSize;
+			uint32_t id;
+			uint32_t tailMip;
+			std::vector<uint64_t> mipSizes;
+		};
+		std::vector<Object> objects;
+		uint64_t tailTotal = 0;
+		TextureStreamer streamer;
+		for (uint32_t i = 0; i < 64; ++i) {
+			Object object;
+			object.position = float(i) * 10.0f;
+			object.textureSize = 256u << (i % 4);
+			object.mipSizes = MakeMipSizes(object.textureSize, object.tailMip);
+			object.id = streamer.Register(object.mipSizes, object.tailMip);
+			tailTotal += BytesFrom(object.mipSizes, object.tailMip);
+			objects.push_back(std::move(object));
+		}
+		// 近くの数枚分しか細かいミップが入らない予算
+		streamer.SetBudget(tailTotal + 12ull * 1024 * 1024);
+
+		// 受け取った変更を適用して、こちらでもバイト数を数える(GPU側のリソースの代わり)
+		std::map<uint32_t, uint32_t> appliedMips;
+		for (const Object& object : objects) {
+			appliedMips[object.id] = object.tailMip;
+		}
+
+		const float kViewDistance = 60.0f;
+		const float kScreenSizeAtOne = 1500.0f;
+		uint32_t overBudgetFrames = 0;
+		uint32_t mismatchFrames = 0;
+		uint32_t satisfiableFrames = 0;
+		uint32_t unsatisfiedFrames = 0;
+		uint32_t fineMipFrames = 0;
+		for (float camera = -50.0f; camera < 700.0f; camera += 1.5f) {
+			// 見えている物体は、距離に応じた画面上の大きさのミップを要求する
+			uint64_t demandBytes = 0;
+			std::map<uint32_t, uint32_t> requests;
+			for (const Object& object : objects) {
+				float distance = std::abs(object.position - camera);
+				if (distance > kViewDistance) {
+					demandBytes += BytesFrom(object.mipSizes, object.tailMip);
+					continue;
+				}
+				float screenSize = kScreenSizeAtOne / (std::max)(distance, 1.0f);
+				uint32_t mip = TextureStreamer::ComputeMipForSize(object.textureSize, object.textureSize, screenSize, screenSize, uint32_t(object.mipSizes.size()));
+				streamer.RequestMip(object.id, mip);
+				// 半分だけ2回要求する(細かい方が採用される)
+				if (object.id % 2 == 0) {
+					streamer.RequestMip(object.id, mip + 1);
+				}
+				requests[object.id] = (std::min)(mip, object.tailMip);
+				demandBytes += BytesFrom(object.mipSizes, requests[object.id]);
+			}
+
+			for (const TextureStreamer::Change& change : streamer.Update()) {
+				appliedMips[change.id] = change.residentMip;
+			}
+
+			// 予算を超えない
+			overBudgetFrames += streamer.GetResidentBytes() > streamer.GetBudget() ? 1 : 0;
+			// 変更を適用した結果とバイト数が一致する
+			uint64_t appliedBytes = 0;
+			for (const Object& object : objects) {
+				appliedBytes += BytesFrom(object.mipSizes, appliedMips[object.id]);
+				mismatchFrames += appliedMips[object.id] != streamer.GetResidentMip(object.id) ? 1 : 0;
+			}
+			mismatchFrames += appliedBytes != streamer.GetResidentBytes() ? 1 : 0;
+			// 要求が全て入るフレームでは、全て要求通りになっている
+			if (demandBytes <= streamer.GetBudget()) {
+				satisfiableFrames++;
+				for (const auto& [id, mip] : requests) {
+					unsatisfiedFrames += streamer.GetResidentMip(id) > mip ? 1 : 0;
+				}
+			}
+			// 近くの物体は細かいミップになっている
+			for (const auto& [id, mip] : requests) {
+				fineMipFrames += mip == 0 && streamer.GetResidentMip(id) == 0 ? 1 : 0;
+			}
+		}
+		CHECK(overBudgetFrames == 0);
+		CHECK(mismatchFrames == 0);
+		CHECK(satisfiableFrames > 0);
+		CHECK(unsatisfiedFrames == 0);
+		CHECK(fineMipFrames > 0);
+
+		// 全て見えなくなっても、粗いミップは捨てない
+		for (int frame = 0; frame < 4; ++frame) {
+			streamer.Update();
+		}
+		for (const Object& object : objects) {
+			CHECK(streamer.GetResidentMip(object.id) <= object.tailMip);
+		}
+	}
+}
+
+int main()
+{
+	TestComputeMipForSize();
+	TestEvictsLeastRecentlyRequested();
+	TestCameraPath();
+	return Test::Finish("TextureStreamerTest");
+}
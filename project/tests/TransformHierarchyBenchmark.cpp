@@ -0,0 +1,124 @@
+#include <thread>
+
+#include "BenchmarkCommon.h"
+#include "TransformHierarchy.h"
+
+// 100kノードのワールド行列の更新
+// 深い木(長い鎖の集まり)と広い木(ルートの下に浅く並ぶ)で、全部変わった場合と一部だけ変わった場合を比べる
+namespace
+{
+	using NodeId = TransformHierarchy::NodeId;
+
+	const uint32_t kNodeCount = 100000;
+	// 深い木の1本の鎖の長さ
+	const uint32_t kChainLength = 1000;
+	// 広い木の1つの親に付く子の数
+	const uint32_t kFanOut = 32;
+	// 一部だけ変える場合に変えるノードの割合(1/kPartialStep)
+	const uint32_t kPartialStep = 100;
+
+	struct Tree {
+		std::vector<NodeId> nodes;
+		// 一部だけ変える場合に変えるノード(全体の1%。部分木が小さい末端の方)
+		std::vector<NodeId> partial;
+	};
+
+	// 長い鎖をkNodeCount / kChainLength本(各鎖の末尾1%を変える)
+	Tree MakeDeep(TransformHierarchy& hierarchy)
+	{
+		Tree tree;
+		tree.nodes.reserve(kNodeCount);
+		for (uint32_t i = 0; i < kNodeCount; ++i) {
+			NodeId parent = i % kChainLength == 0 ? TransformHierarchy::kInvalidNode : tree.nodes.back();
+			tree.nodes.push_back(hierarchy.CreateNode(parent));
+			if (i % kChainLength >= kChainLength - kChainLength / kPartialStep) {
+				tree.partial.push_back(tree.nodes.back());
+			}
+		}
+		return tree;
+	}
+
+	// 1つのルートから子をkFanOut個ずつ幅優先に付ける(深さ4程度。kPartialStep個おきに変える)
+	Tree MakeWide(TransformHierarchy& hierarchy)
+	{
+		Tree tree;
+		tree.nodes.reserve(kNodeCount);
+		tree.nodes.push_back(hierarchy.CreateNode());
+		for (uint32_t i = 1; i < kNodeCount; ++i) {
+			tree.nodes.push_back(hierarchy.CreateNode(tree.nodes[(i - 1) / kFanOut]));
+			if (i % kPartialStep == kPartialStep - 1) {
+				tree.partial.push_back(tree.nodes.back());
+			}
+		}
+		return tree;
+	}
+
+	// 変えたノードとUpdateをまとめて1回として測る
+	void Run(const char* shape, Tree(*make)(TransformHierarchy&))
+	{
+		TransformHierarchy hierarchy;
+		Tree tree = make(hierarchy);
+		const std::vector<NodeId>& nodes = tree.nodes;
+		hierarchy.Update();
+
+		float time = 0.0f;
+		auto touch = [&](bool isAll) {
+			time += 0.01f;
+			for (NodeId node : isAll ? tree.nodes : tree.partial) {
+				hierarchy.SetRotate(node, { 0.0f, time, 0.0f });
+			}
+			};
+		auto report = [&](const char* dirty, const char* threads, double seconds) {
+			char name[64];
+			std::snprintf(name, sizeof(name), "%s %s %s (updated %u)", shape, dirty, threads, hierarchy.GetUpdatedNodeCount());
+			Benchmark::Report(name, seconds, kNodeCount);
+			};
+
+		// --- 直列 ---
+		for (bool isAll : { true, false }) {
+			const char* dirty = isAll ? "all" : "1%";
+			double seconds = Benchmark::Measure(20, [&]() {
+				touch(isAll);
+				hierarchy.Update();
+				Benchmark::Keep(uint64_t(hierarchy.GetWorldMatrix(nodes.back()).m[0][3]));
+			});
+			report(dirty, "serial", seconds);
+		}
+
+		// --- スレッド数ごと ---
+		uint32_t maxThreads = (std::max)(1u, std::thread::hardware_concurrency());
+		for (uint32_t threadCount = 1; threadCount <= maxThreads; threadCount *= 2) {
+			ThreadPool threadPool(threadCount);
+			for (bool isAll : { true, false }) {
+				const char* dirty = isAll ? "all" : "1%";
+				double seconds = Benchmark::Measure(20, [&]() {
+					touch(isAll);
+					hierarchy.Update(&threadPool);
+					Benchmark::Keep(uint64_t(hierarchy.GetWorldMatrix(nodes.back()).m[0][3]));
+				});
+				char threads[32];
+				std::snprintf(threads, sizeof(threads), "threads=%u", threadCount);
+				report(dirty, threads, seconds);
+			}
+		}
+
+		// --- 構造の変更(付け替えて並べ直す)込み ---
+		double rebuild = Benchmark::Measure(10, [&]() {
+			for (uint32_t i = kPartialStep; i < kNodeCount; i += kPartialStep * 10) {
+				NodeId parent = hierarchy.GetParent(nodes[i]);
+				hierarchy.SetParent(nodes[i], TransformHierarchy::kInvalidNode);
+				hierarchy.SetParent(nodes[i], parent);
+			}
+			hierarchy.Update();
+		});
+		report("reparent+rebuild", "serial", rebuild);
+	}
+}
+
+int main()
+{
+	std::printf("%u nodes (items = nodes)\n", kNodeCount);
+	Run("deep", MakeDeep);
+	Run("wide", MakeWide);
+	return 0;
+}
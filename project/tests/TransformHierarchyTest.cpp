@@ -0,0 +1,308 @@
+#include "TransformHierarchy.h"
+#include "CalculateMath.h"
+#include "TestCommon.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+namespace
+{
+	using NodeId = TransformHierarchy::NodeId;
+	using Transform = TransformHierarchy::Transform;
+
+	// 深さ数十まで積み重ねたときの誤差(大きい値は相対誤差で見る)
+	const float kTolerance = 1e-3f;
+
+	// 参照のワールド行列(Matrix4x4で親をたどって再帰的に掛ける)
+	Matrix4x4 ReferenceWorld(const TransformHierarchy& hierarchy, NodeId node)
+	{
+		const Transform& local = hierarchy.GetLocal(node);
+		Matrix4x4 localMatrix = MakeAffineMatrix(local.scale, local.rotate, local.translate);
+		NodeId parent = hierarchy.GetParent(node);
+		return parent == TransformHierarchy::kInvalidNode ? localMatrix : localMatrix * ReferenceWorld(hierarchy, parent);
+	}
+
+	// 生存しているすべてのノードで参照と比べた差の最大(1より大きい成分は相対誤差)
+	float MaxError(const TransformHierarchy& hierarchy, const std::vector<NodeId>& nodes)
+	{
+		float error = 0.0f;
+		for (NodeId node : nodes) {
+			if (!hierarchy.IsAlive(node)) {
+				continue;
+			}
+			Matrix4x4 expected = ReferenceWorld(hierarchy, node);
+			Matrix4x4 actual = ToMatrix4x4(hierarchy.GetWorldMatrix(node));
+			for (int i = 0; i < 4; ++i) {
+				for (int j = 0; j < 4; ++j) {
+					float scale = (std::max)(1.0f, std::fabs(expected.m[i][j]));
+					error = (std::max)(error, std::fabs(expected.m[i][j] - actual.m[i][j]) / scale);
+				}
+			}
+		}
+		return error;
+	}
+
+	// 深くしても値が大きくなりすぎない範囲のローカル
+	Transform RandomTransform(std::mt19937& rng)
+	{
+		std::uniform_real_distribution<float> range(-1.0f, 1.0f);
+		std::uniform_real_distribution<float> scaleRange(0.8f, 1.2f);
+		Transform local;
+		local.scale = { scaleRange(rng), scaleRange(rng), scaleRange(rng) };
+		local.rotate = { range(rng), range(rng), range(rng) };
+		local.translate = { range(rng), range(rng), range(rng) };
+		return local;
+	}
+
+	// 生存しているノードを1つ選ぶ
+	NodeId RandomAlive(const TransformHierarchy& hierarchy, const std::vector<NodeId>& nodes, std::mt19937& rng)
+	{
+		std::uniform_int_distribution<size_t> pick(0, nodes.size() - 1);
+		for (;;) {
+			NodeId node = nodes[pick(rng)];
+			if (hierarchy.IsAlive(node)) {
+				return node;
+			}
+		}
+	}
+
+	// nodeの祖先にancestorがいるか(自分自身を含む)
+	bool IsDescendant(const TransformHierarchy& hierarchy, NodeId node, NodeId ancestor)
+	{
+		for (NodeId current = node; current != TransformHierarchy::kInvalidNode; current = hierarchy.GetParent(current)) {
+			if (current == ancestor) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void TestCreateAndUpdate()
+	{
+		std::mt19937 rng(1);
+		TransformHierarchy hierarchy;
+		std::vector<NodeId> nodes;
+		// 後から作った子が前に作った親より先に並んでいてもよい
+		for (int i = 0; i < 200; ++i) {
+			NodeId parent = nodes.empty() || i % 10 == 0 ? TransformHierarchy::kInvalidNode : nodes[rng() % nodes.size()];
+			nodes.push_back(hierarchy.CreateNode(parent, RandomTransform(rng)));
+		}
+		CHECK(hierarchy.GetNodeCount() == 200);
+		hierarchy.Update();
+		CHECK(hierarchy.GetUpdatedNodeCount() == 200);
+		CHECK(MaxError(hierarchy, nodes) < kTolerance);
+
+		// 変更が無ければ計算しない
+		hierarchy.Update();
+		CHECK(hierarchy.GetUpdatedNodeCount() == 0);
+	}
+
+	void TestSetParentBeforeUpdate()
+	{
+		std::mt19937 rng(2);
+		TransformHierarchy hierarchy;
+		// 2本の鎖
+		std::vector<NodeId> chainA;
+		std::vector<NodeId> chainB;
+		for (int i = 0; i < 5; ++i) {
+			chainA.push_back(hierarchy.CreateNode(chainA.empty() ? TransformHierarchy::kInvalidNode : chainA.back(), RandomTransform(rng)));
+			chainB.push_back(hierarchy.CreateNode(chainB.empty() ? TransformHierarchy::kInvalidNode : chainB.back(), RandomTransform(rng)));
+		}
+		std::vector<NodeId> nodes = chainA;
+		nodes.insert(nodes.end(), chainB.begin(), chainB.end());
+		hierarchy.Update();
+		CHECK(MaxError(hierarchy, nodes) < kTolerance);
+
+		// --- Updateの前に付け替え、ローカルも書き換える(親が後ろに並んだ状態になる) ---
+		hierarchy.SetParent(chainA[2], chainB[4]);
+		hierarchy.SetTranslate(chainA[3], { 0.5f, -0.5f, 0.25f });
+		// 後から作ったノードを親にする
+		NodeId newParent = hierarchy.CreateNode(TransformHierarchy::kInvalidNode, RandomTransform(rng));
+		nodes.push_back(newParent);
+		hierarchy.SetParent(chainB[0], newParent);
+		CHECK(hierarchy.GetParent(chainA[2]) == chainB[4]);
+		hierarchy.Update();
+		CHECK(MaxError(hierarchy, nodes) < kTolerance);
+		// 新しいノードの部分木(自分 + chainB + 付け替えたchainA[2..4])だけを計算する
+		CHECK(hierarchy.GetUpdatedNodeCount() == 1 + 5 + 3);
+
+		// ルートに戻す
+		hierarchy.SetParent(chainA[2], TransformHierarchy::kInvalidNode);
+		hierarchy.Update();
+		CHECK(hierarchy.GetUpdatedNodeCount() == 3);
+		CHECK(MaxError(hierarchy, nodes) < kTolerance);
+	}
+
+	void TestDestroyAndReuseBeforeUpdate()
+	{
+		std::mt19937 rng(3);
+		TransformHierarchy hierarchy;
+		NodeId root = hierarchy.CreateNode(TransformHierarchy::kInvalidNode, RandomTransform(rng));
+		NodeId child = hierarchy.CreateNode(root, RandomTransform(rng));
+		NodeId grandChild = hierarchy.CreateNode(child, RandomTransform(rng));
+		NodeId sibling = hierarchy.CreateNode(root, RandomTransform(rng));
+		hierarchy.Update();
+
+		// --- 子孫ごと破棄し、並べ直す前に同じ番号を使い回す ---
+		hierarchy.DestroyNode(child);
+		CHECK(!hierarchy.IsAlive(child));
+		CHECK(!hierarchy.IsAlive(grandChild));
+		CHECK(hierarchy.GetNodeCount() == 2);
+
+		Transform local = RandomTransform(rng);
+		NodeId reusedA = hierarchy.CreateNode(sibling, local);
+		NodeId reusedB = hierarchy.CreateNode(reusedA, RandomTransform(rng));
+		CHECK((reusedA == child || reusedA == grandChild));
+		CHECK((reusedB == child || reusedB == grandChild));
+		CHECK(reusedA != reusedB);
+		CHECK(hierarchy.GetNodeCount() == 4);
+		// 並べ直す前でも新しいノードの値を読み書きできる
+		CHECK(hierarchy.GetLocal(reusedA).translate.x == local.translate.x);
+		hierarchy.SetRotate(reusedB, { 0.1f, 0.2f, 0.3f });
+		CHECK(hierarchy.GetLocal(reusedB).rotate.z == 0.3f);
+
+		hierarchy.Update();
+		CHECK(hierarchy.GetParent(reusedA) == sibling);
+		CHECK(hierarchy.GetParent(reusedB) == reusedA);
+		CHECK(hierarchy.GetLocal(reusedB).rotate.z == 0.3f);
+		CHECK(hierarchy.GetUpdatedNodeCount() == 2);
+		CHECK(MaxError(hierarchy, { root, sibling, reusedA, reusedB }) < kTolerance);
+
+		// 破棄だけなら計算しない
+		hierarchy.DestroyNode(reusedB);
+		hierarchy.Update();
+		CHECK(hierarchy.GetUpdatedNodeCount() == 0);
+		CHECK(hierarchy.GetNodeCount() == 3);
+		CHECK(MaxError(hierarchy, { root, sibling, reusedA }) < kTolerance);
+	}
+
+	void TestDirtyOnlyUpdate()
+	{
+		// ルート -> 中間 x 4 -> 葉 x 10 ずつ
+		TransformHierarchy hierarchy;
+		NodeId root = hierarchy.CreateNode();
+		std::vector<NodeId> middles;
+		std::vector<NodeId> leaves;
+		for (int i = 0; i < 4; ++i) {
+			middles.push_back(hierarchy.CreateNode(root));
+			for (int j = 0; j < 10; ++j) {
+				leaves.push_back(hierarchy.CreateNode(middles.back()));
+			}
+		}
+		hierarchy.Update();
+		CHECK(hierarchy.GetUpdatedNodeCount() == 45);
+
+		// 葉だけ
+		hierarchy.SetTranslate(leaves[3], { 1.0f, 0.0f, 0.0f });
+		hierarchy.Update();
+		CHECK(hierarchy.GetUpdatedNodeCount() == 1);
+
+		// 中間と、その下の葉(部分木に含まれるので重ねて数えない)
+		hierarchy.SetScale(middles[1], { 2.0f, 2.0f, 2.0f });
+		hierarchy.SetTranslate(leaves[12], { 0.0f, 1.0f, 0.0f });
+		hierarchy.Update();
+		CHECK(hierarchy.GetUpdatedNodeCount() == 11);
+
+		// 別々の部分木
+		hierarchy.SetRotate(middles[0], { 0.0f, 1.0f, 0.0f });
+		hierarchy.SetRotate(middles[3], { 1.0f, 0.0f, 0.0f });
+		hierarchy.SetRotate(leaves[25], { 0.0f, 0.0f, 1.0f });
+		hierarchy.Update();
+		CHECK(hierarchy.GetUpdatedNodeCount() == 11 + 11 + 1);
+
+		// ルートなら全部
+		hierarchy.SetTranslate(root, { 0.0f, 0.0f, 5.0f });
+		hierarchy.Update();
+		CHECK(hierarchy.GetUpdatedNodeCount() == 45);
+
+		std::vector<NodeId> nodes = { root };
+		nodes.insert(nodes.end(), middles.begin(), middles.end());
+		nodes.insert(nodes.end(), leaves.begin(), leaves.end());
+		CHECK(MaxError(hierarchy, nodes) < kTolerance);
+	}
+
+	// 同じ操作を直列と並列の2つに行い、毎回参照と結果が一致するか
+	void TestParallelMatchesSerial()
+	{
+		std::mt19937 rng(4);
+		ThreadPool threadPool(4);
+		TransformHierarchy serial;
+		TransformHierarchy parallel;
+		std::vector<NodeId> nodes;
+
+		// 分割されるように、kMinParallelNodesより大きい部分木を含む木を作る
+		auto create = [&](NodeId parent) {
+			Transform local = RandomTransform(rng);
+			NodeId node = serial.CreateNode(parent, local);
+			CHECK(parallel.CreateNode(parent, local) == node);
+			if (std::find(nodes.begin(), nodes.end(), node) == nodes.end()) {
+				nodes.push_back(node);
+			}
+			return node;
+			};
+		for (int root = 0; root < 3; ++root) {
+			NodeId parent = create(TransformHierarchy::kInvalidNode);
+			for (int i = 0; i < 2000; ++i) {
+				// 近くの親を選んで、適度に深い木にする
+				parent = i % 64 == 0 ? create(parent) : parent;
+				create(parent);
+			}
+		}
+
+		for (int frame = 0; frame < 30; ++frame) {
+			// --- ローカルの変更 ---
+			for (int i = 0; i < 50; ++i) {
+				NodeId node = RandomAlive(serial, nodes, rng);
+				Transform local = RandomTransform(rng);
+				serial.SetLocal(node, local);
+				parallel.SetLocal(node, local);
+			}
+			// --- 付け替え・破棄・生成(数フレームに1回) ---
+			if (frame % 3 == 1) {
+				NodeId node = RandomAlive(serial, nodes, rng);
+				NodeId parent = RandomAlive(serial, nodes, rng);
+				if (!IsDescendant(serial, parent, node)) {
+					serial.SetParent(node, parent);
+					parallel.SetParent(node, parent);
+				}
+			}
+			if (frame % 5 == 2) {
+				NodeId node = RandomAlive(serial, nodes, rng);
+				if (serial.GetParent(node) != TransformHierarchy::kInvalidNode) {
+					serial.DestroyNode(node);
+					parallel.DestroyNode(node);
+				}
+				for (int i = 0; i < 20; ++i) {
+					create(RandomAlive(serial, nodes, rng));
+				}
+			}
+
+			serial.Update();
+			parallel.Update(&threadPool);
+			CHECK(serial.GetNodeCount() == parallel.GetNodeCount());
+			CHECK(serial.GetUpdatedNodeCount() == parallel.GetUpdatedNodeCount());
+
+			// 並列でも計算順が変わるだけなので完全に一致する
+			bool isSame = true;
+			for (NodeId node : nodes) {
+				if (serial.IsAlive(node)) {
+					isSame = isSame && std::equal(&serial.GetWorldMatrix(node).m[0][0], &serial.GetWorldMatrix(node).m[0][0] + 12,
+						&parallel.GetWorldMatrix(node).m[0][0]);
+				}
+			}
+			CHECK(isSame);
+		}
+		CHECK(MaxError(serial, nodes) < kTolerance);
+	}
+}
+
+int main()
+{
+	TestCreateAndUpdate();
+	TestSetParentBeforeUpdate();
+	TestDestroyAndReuseBeforeUpdate();
+	TestDirtyOnlyUpdate();
+	TestParallelMatchesSerial();
+	return Test::Finish("TransformHierarchyTest");
+}
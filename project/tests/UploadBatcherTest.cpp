@@ -0,0 +1,166 @@
+#include "UploadBatcher.h"
+#include "TestCommon.h"
+
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <thread>
+
+namespace {
+	struct Job {
+		int id = 0;
+	};
+	using Batcher = UploadBatcher<Job>;
+
+	// コピーキューの代わり(送られたバッチを記録し、シグナルされた値を完了値として進められる)
+	struct RecordingQueue {
+		struct Batch {
+			Batcher::Token token;
+			std::vector<Job> jobs;
+		};
+		std::vector<Batch> batches;
+		uint64_t signaledValue = 0;
+		uint64_t completedValue = 0;
+
+		void Execute(std::vector<Job> jobs, Batcher::Token token) {
+			batches.push_back({ token, std::move(jobs) });
+			signaledValue = token;
+		}
+		// GPUがvalueまで終えた
+		void Complete(uint64_t value) { completedValue = (std::min)(value, signaledValue); }
+		bool IsComplete(Batcher::Token token) const { return token == 0 || completedValue >= token; }
+	};
+
+	// UploadService::Submitと同じ流れ(取り出して送り、バッチの番号でシグナル)
+	bool Submit(Batcher& batcher, RecordingQueue& queue) {
+		std::vector<Job> jobs;
+		Batcher::Token token = 0;
+		if (!batcher.TakeBatch(jobs, token)) {
+			return false;
+		}
+		queue.Execute(std::move(jobs), token);
+		return true;
+	}
+
+	// --- 1回のバッチに入ったジョブは同じトークン・トークンは増える一方 ---
+	void TestTokens()
+	{
+		Batcher batcher;
+		RecordingQueue queue;
+		CHECK(!Submit(batcher, queue));
+		CHECK(batcher.GetSubmittedToken() == 0);
+
+		Batcher::Token a = batcher.Enqueue({ 1 });
+		Batcher::Token b = batcher.Enqueue({ 2 });
+		Batcher::Token c = batcher.Enqueue({ 3 });
+		CHECK(a == 1 && b == 1 && c == 1);
+		CHECK(!batcher.IsSubmitted(a));
+		CHECK(Submit(batcher, queue));
+		CHECK(batcher.IsSubmitted(a));
+		CHECK(queue.batches.size() == 1 && queue.batches[0].token == 1 && queue.batches[0].jobs.size() == 3);
+		// 空なら送らない(トークンも進まない)
+		CHECK(!Submit(batcher, queue));
+		CHECK(batcher.GetSubmittedToken() == 1);
+
+		Batcher::Token d = batcher.Enqueue({ 4 });
+		CHECK(d == 2);
+		CHECK(Submit(batcher, queue));
+		Batcher::Token e = batcher.Enqueue({ 5 });
+		CHECK(e == 3);
+		CHECK(!batcher.IsSubmitted(e));
+		CHECK(Submit(batcher, queue));
+		CHECK(queue.batches.size() == 3 && queue.batches[2].token == 3 && queue.batches[2].jobs[0].id == 5);
+	}
+
+	// --- 完了はそのバッチのフェンス値で決まる ---
+	void TestCompletionGatesOnFence()
+	{
+		Batcher batcher;
+		RecordingQueue queue;
+		Batcher::Token first = batcher.Enqueue({ 1 });
+		Submit(batcher, queue);
+		Batcher::Token second = batcher.Enqueue({ 2 });
+		Submit(batcher, queue);
+		Batcher::Token third = batcher.Enqueue({ 3 });
+
+		// 0は待つ必要なし
+		CHECK(queue.IsComplete(0));
+		CHECK(!queue.IsComplete(first));
+		queue.Complete(first);
+		CHECK(queue.IsComplete(first));
+		CHECK(!queue.IsComplete(second));
+		// 送っていないバッチは、GPUがどこまで進んでも完了しない
+		queue.Complete(UINT64_MAX);
+		CHECK(queue.IsComplete(second));
+		CHECK(!batcher.IsSubmitted(third));
+		CHECK(!queue.IsComplete(third));
+		Submit(batcher, queue);
+		CHECK(!queue.IsComplete(third));
+		queue.Complete(third);
+		CHECK(queue.IsComplete(third));
+	}
+
+	// --- 複数のスレッドから積んでも、返したトークンは入ったバッチの番号 ---
+	void TestConcurrentEnqueue()
+	{
+		Batcher batcher;
+		RecordingQueue queue;
+		const int kThreadCount = 4;
+		const int kJobCount = 20000;
+		std::vector<std::vector<std::pair<int, Batcher::Token>>> tokens(kThreadCount);
+		std::atomic<int> finishedCount = 0;
+
+		std::vector<std::thread> threads;
+		for (int t = 0; t < kThreadCount; ++t) {
+			threads.emplace_back([&, t]() {
+				for (int i = 0; i < kJobCount; ++i) {
+					int id = t * kJobCount + i;
+					tokens[t].emplace_back(id, batcher.Enqueue({ id }));
+				}
+				finishedCount++;
+				});
+		}
+		// 描画スレッドの代わりに送り続ける
+		while (finishedCount < kThreadCount) {
+			Submit(batcher, queue);
+		}
+		for (std::thread& thread : threads) {
+			thread.join();
+		}
+		Submit(batcher, queue);
+
+		// 各ジョブが入ったバッチ
+		std::map<int, Batcher::Token> batchOf;
+		size_t jobCount = 0;
+		bool isIncreasing = true;
+		for (size_t i = 0; i < queue.batches.size(); ++i) {
+			isIncreasing = isIncreasing && queue.batches[i].token == i + 1;
+			for (const Job& job : queue.batches[i].jobs) {
+				batchOf[job.id] = queue.batches[i].token;
+				jobCount++;
+			}
+		}
+		CHECK(isIncreasing);
+		CHECK(jobCount == size_t(kThreadCount * kJobCount));
+		CHECK(batchOf.size() == jobCount);
+
+		int mismatchCount = 0;
+		int decreaseCount = 0;
+		for (const auto& threadTokens : tokens) {
+			for (size_t i = 0; i < threadTokens.size(); ++i) {
+				mismatchCount += batchOf[threadTokens[i].first] == threadTokens[i].second ? 0 : 1;
+				decreaseCount += i > 0 && threadTokens[i].second < threadTokens[i - 1].second ? 1 : 0;
+			}
+		}
+		CHECK(mismatchCount == 0);
+		CHECK(decreaseCount == 0);
+	}
+}
+
+int main()
+{
+	TestTokens();
+	TestCompletionGatesOnFence();
+	TestConcurrentEnqueue();
+	return Test::Finish("UploadBatcherTest");
+}
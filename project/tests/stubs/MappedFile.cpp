@@ -0,0 +1,56 @@
+#include "MappedFile.h"
+#include <fstream>
+#include <utility>
+
+// テスト用のMappedFile
+// マップの代わりにファイル全体をメモリに読み込む(空のファイルは本物と同じく開けない)
+
+MappedFile::~MappedFile()
+{
+	Close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+{
+	*this = std::move(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+	if (this != &other) {
+		Close();
+		data_ = std::exchange(other.data_, nullptr);
+		size_ = std::exchange(other.size_, 0);
+	}
+	return *this;
+}
+
+bool MappedFile::Open(const std::filesystem::path& filePath)
+{
+	Close();
+
+	std::ifstream file(filePath, std::ios::binary | std::ios::ate);
+	if (!file.is_open()) {
+		return false;
+	}
+	std::streamsize size = file.tellg();
+	if (size <= 0) {
+		return false;
+	}
+	uint8_t* data = new uint8_t[size_t(size)];
+	file.seekg(0, std::ios::beg);
+	if (!file.read(reinterpret_cast<char*>(data), size)) {
+		delete[] data;
+		return false;
+	}
+	data_ = data;
+	size_ = size_t(size);
+	return true;
+}
+
+void MappedFile::Close()
+{
+	delete[] data_;
+	data_ = nullptr;
+	size_ = 0;
+}
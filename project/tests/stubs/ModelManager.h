@@ -0,0 +1,35 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+
+// テスト用のModelManager
+// AssetSetから呼ばれる関数だけを持ち、呼ばれた回数を数える
+// AcquireModelはacquireCostだけ時間をかける(頂点バッファの作成の代わり)
+using ModelHandle = std::shared_ptr<std::string>;
+
+class ModelManager
+{
+public:
+	static ModelManager* GetInstance() {
+		static ModelManager instance;
+		return &instance;
+	}
+
+	// ワーカースレッドから呼ばれる
+	void PrepareModel(const std::string&) { prepareCount++; }
+
+	ModelHandle AcquireModel(const std::string& filePath) {
+		auto start = std::chrono::steady_clock::now();
+		while (std::chrono::steady_clock::now() - start < acquireCost) {
+		}
+		acquireCount++;
+		return std::make_shared<std::string>(filePath);
+	}
+
+public:
+	std::chrono::microseconds acquireCost{ 0 };
+	std::atomic<uint32_t> prepareCount = 0;
+	uint32_t acquireCount = 0;
+};
@@ -0,0 +1,21 @@
+#pragma once
+#include "Affine3x4.h"
+#include "Intersection.h"
+
+// テスト用のObject3d
+// CollisionWorldが使うモデルの箱とワールド行列だけを持つ
+class Object3d
+{
+public:
+	// モデルの頂点を囲む箱(ローカル座標)
+	AABB GetLocalBounds() const { return localBounds_; }
+	void SetLocalBounds(const AABB& localBounds) { localBounds_ = localBounds; }
+
+	// ワールド行列
+	const Affine3x4& GetWorldMatrix() const { return worldMatrix_; }
+	void SetWorldMatrix(const Affine3x4& worldMatrix) { worldMatrix_ = worldMatrix; }
+
+private:
+	AABB localBounds_{ { -0.5f, -0.5f, -0.5f }, { 0.5f, 0.5f, 0.5f } };
+	Affine3x4 worldMatrix_ = MakeIdentityAffine3x4();
+};
@@ -0,0 +1,39 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+// テスト用のTextureManager
+// AssetSetから呼ばれる関数だけを持ち、呼ばれた回数を数える
+// AcquireTextureはacquireCostだけ時間をかける(GPUリソースの作成の代わり)
+class TextureManager
+{
+public:
+	using Handle = std::shared_ptr<std::string>;
+
+	static TextureManager* GetInstance() {
+		static TextureManager instance;
+		return &instance;
+	}
+
+	// ワーカースレッドから呼ばれる
+	void LoadTextures(const std::vector<std::string>& filePaths) { prepareCount += uint32_t(filePaths.size()); }
+	void PrepareTextures(const std::vector<std::string>& filePaths) { prepareCount += uint32_t(filePaths.size()); }
+
+	Handle AcquireTexture(const std::string& filePath) {
+		auto start = std::chrono::steady_clock::now();
+		while (std::chrono::steady_clock::now() - start < acquireCost) {
+		}
+		acquireCount++;
+		return std::make_shared<std::string>(filePath);
+	}
+
+public:
+	std::chrono::microseconds acquireCost{ 0 };
+	std::atomic<uint32_t> prepareCount = 0;
+	uint32_t acquireCount = 0;
+};
+
+using TextureHandle = TextureManager::Handle;
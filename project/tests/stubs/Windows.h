@@ -0,0 +1,45 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+#include "debugapi.h"
+
+// テスト用のWindows.h
+// エンジンが使う基本の型だけを定義する
+
+using UINT = uint32_t;
+using INT = int32_t;
+using UINT32 = uint32_t;
+using UINT64 = uint64_t;
+using ULONG = unsigned long;
+using INT8 = int8_t;
+using UINT8 = uint8_t;
+using BOOL = int;
+using FLOAT = float;
+using SIZE_T = size_t;
+using LPCSTR = const char*;
+using HRESULT = int32_t;
+using HANDLE = void*;
+
+#define INVALID_HANDLE_VALUE HANDLE(intptr_t(-1))
+
+#define S_OK HRESULT(0)
+#define E_FAIL HRESULT(0x80004005)
+#define SUCCEEDED(hr) (HRESULT(hr) >= 0)
+#define FAILED(hr) (HRESULT(hr) < 0)
+
+// 参照カウントだけを持つIUnknown(0になったら自分を破棄する)
+struct IUnknown {
+	virtual ~IUnknown() = default;
+	ULONG AddRef() { return ++refCount_; }
+	ULONG Release() {
+		ULONG count = --refCount_;
+		if (count == 0) {
+			delete this;
+		}
+		return count;
+	}
+
+private:
+	ULONG refCount_ = 1;
+};
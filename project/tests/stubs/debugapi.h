@@ -0,0 +1,6 @@
+#pragma once
+#include <cstdio>
+
+// テスト用のdebugapi.h
+// デバッグ出力は標準エラーに出す
+inline void OutputDebugStringA(const char* message) { std::fputs(message, stderr); }
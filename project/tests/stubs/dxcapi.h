@@ -0,0 +1,18 @@
+#pragma once
+#include "wrl.h"
+
+// テスト用のdxcapi.h
+// キャッシュが使うBlobとCreateBlobだけを定義する
+
+#define DXC_CP_ACP 0u
+
+struct IDxcBlob : IUnknown {
+	virtual void* GetBufferPointer() = 0;
+	virtual size_t GetBufferSize() = 0;
+};
+
+struct IDxcBlobEncoding : IDxcBlob {};
+
+struct IDxcUtils : IUnknown {
+	virtual HRESULT CreateBlob(const void* data, UINT32 size, UINT32 codePage, IDxcBlobEncoding** blob) = 0;
+};
@@ -0,0 +1,53 @@
+#pragma once
+#include <cstddef>
+#include <utility>
+
+#include "Windows.h"
+
+// テスト用のwrl.h
+// ComPtrはIUnknown(Windows.h)の参照カウントを増減する
+
+namespace Microsoft::WRL {
+	template<typename T>
+	class ComPtr
+	{
+	public:
+		ComPtr() = default;
+		ComPtr(std::nullptr_t) {}
+		ComPtr(T* ptr) : ptr_(ptr) { AddRef(); }
+		template<typename U>
+		ComPtr(const ComPtr<U>& other) : ptr_(other.Get()) { AddRef(); }
+		ComPtr(const ComPtr& other) : ptr_(other.ptr_) { AddRef(); }
+		ComPtr(ComPtr&& other) noexcept : ptr_(std::exchange(other.ptr_, nullptr)) {}
+		~ComPtr() { Reset(); }
+
+		ComPtr& operator=(ComPtr other) {
+			std::swap(ptr_, other.ptr_);
+			return *this;
+		}
+
+		T* Get() const { return ptr_; }
+		T* operator->() const { return ptr_; }
+		T** operator&() { Reset(); return &ptr_; }
+		T** GetAddressOf() { return &ptr_; }
+		T** ReleaseAndGetAddressOf() { Reset(); return &ptr_; }
+		explicit operator bool() const { return ptr_ != nullptr; }
+		bool operator==(std::nullptr_t) const { return ptr_ == nullptr; }
+
+		void Reset() {
+			if (ptr_) {
+				std::exchange(ptr_, nullptr)->Release();
+			}
+		}
+
+	private:
+		void AddRef() {
+			if (ptr_) {
+				ptr_->AddRef();
+			}
+		}
+
+	private:
+		T* ptr_ = nullptr;
+	};
+}